@@ -0,0 +1,68 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "AssetArchive.h"
+
+namespace sample {
+    AssetArchive::AssetArchive(AssetPtr file)
+        : m_file(std::move(file)) {
+        CHECK(m_file != nullptr);
+        const size_t fileSize = m_file->Size();
+        CHECK_MSG(fileSize >= sizeof(ArchiveHeader), "Truncated asset archive");
+
+        ArchiveHeader header;
+        std::memcpy(&header, m_file->Data(), sizeof(header));
+        CHECK_MSG(header.Magic == ArchiveMagic, "Not an asset archive");
+        CHECK_MSG(header.Version == ArchiveVersion, "Unsupported asset archive version");
+        CHECK_MSG(header.FileSize == fileSize, "Truncated asset archive");
+        CHECK_MSG(header.EntryCount <= (fileSize - sizeof(ArchiveHeader)) / sizeof(ArchiveEntry), "Truncated asset archive");
+
+        // The mapping is page aligned and the header size a multiple of the entry alignment.
+        m_entries = reinterpret_cast<const ArchiveEntry*>(m_file->Data() + sizeof(ArchiveHeader));
+        m_entryCount = header.EntryCount;
+
+        // Validate once, so lookups can trust the table of contents.
+        for (uint32_t i = 0; i < m_entryCount; i++) {
+            const ArchiveEntry& entry = m_entries[i];
+            CHECK_MSG(std::memchr(entry.Name, '\0', sizeof(entry.Name)) != nullptr, "Invalid asset archive entry name");
+            CHECK_MSG(entry.NameHash == ArchiveNameHash(entry.Name), "Invalid asset archive entry name");
+            CHECK_MSG(i == 0 || m_entries[i - 1].NameHash <= entry.NameHash, "Unsorted asset archive entries");
+            CHECK_MSG(entry.Offset % ArchiveAlignment == 0 && entry.Offset <= fileSize && entry.Size <= fileSize - entry.Offset,
+                      "Asset archive entry out of bounds");
+        }
+    }
+
+    const ArchiveEntry* AssetArchive::Find(std::string_view name) const {
+        const uint64_t nameHash = ArchiveNameHash(name);
+        const ArchiveEntry* const end = m_entries + m_entryCount;
+        const ArchiveEntry* it =
+            std::lower_bound(m_entries, end, nameHash, [](const ArchiveEntry& entry, uint64_t hash) { return entry.NameHash < hash; });
+        for (; it != end && it->NameHash == nameHash; ++it) {
+            if (name == it->Name) {
+                return it;
+            }
+        }
+        return nullptr;
+    }
+
+    const ArchiveEntry& AssetArchive::Get(std::string_view name, ArchiveEntryType type) const {
+        const ArchiveEntry* entry = Find(name);
+        if (entry == nullptr || entry->Type != type) {
+            THROW(xr::detail::_Fmt("Asset archive has no entry %.*s of type %u", (int)name.size(), name.data(), (uint32_t)type));
+        }
+        return *entry;
+    }
+} // namespace sample
@@ -0,0 +1,51 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include "AssetArchiveFormat.h"
+#include "AssetLoader.h"
+
+namespace sample {
+    // Read-only view of an archive produced by AssetPacker. Blobs point into the memory-mapped file and stay valid
+    // as long as the archive asset, so they can be handed to the graphics API without copy.
+    class AssetArchive {
+    public:
+        // Throws if the file is not a valid archive.
+        explicit AssetArchive(AssetPtr file);
+
+        // nullptr when the archive has no entry of that name.
+        const ArchiveEntry* Find(std::string_view name) const;
+
+        // Throws if the entry is missing or of another type.
+        const ArchiveEntry& Get(std::string_view name, ArchiveEntryType type) const;
+
+        const uint8_t* Data(const ArchiveEntry& entry) const {
+            return m_file->Data() + entry.Offset;
+        }
+
+        uint32_t EntryCount() const {
+            return m_entryCount;
+        }
+        const ArchiveEntry* Entries() const {
+            return m_entries;
+        }
+
+    private:
+        AssetPtr m_file;
+        const ArchiveEntry* m_entries{nullptr};
+        uint32_t m_entryCount{0};
+    };
+} // namespace sample
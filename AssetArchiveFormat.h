@@ -0,0 +1,84 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Layout of the asset archive written by AssetPacker and read by sample::AssetArchive. All values are little-endian.
+// [ArchiveHeader][ArchiveEntry x EntryCount, sorted by NameHash][blobs, each at an offset multiple of ArchiveAlignment]
+namespace sample {
+    constexpr uint32_t ArchiveMagic = 0x4B505258; // "XRPK"
+    constexpr uint32_t ArchiveVersion = 1;
+    constexpr uint32_t ArchiveAlignment = 16;
+    constexpr uint32_t ArchiveMaxNameLength = 47;
+
+    enum class ArchiveEntryType : uint32_t {
+        Shader,       // Binary produced by bgfx shaderc.
+        VertexStream, // Stride is the vertex size.
+        IndexStream,  // Stride is the index size, 2 or 4.
+        VertexLayout, // Array of VertexElement.
+    };
+
+    enum class VertexAttribute : uint8_t { Position, Normal, Color0, TexCoord0 };
+    enum class VertexAttributeType : uint8_t { Uint8, Int16, Float };
+
+    struct VertexElement {
+        VertexAttribute Attribute;
+        uint8_t Count;
+        VertexAttributeType Type;
+        uint8_t Normalized;
+    };
+
+    struct ArchiveHeader {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t EntryCount;
+        uint32_t Reserved;
+        uint64_t FileSize;
+        uint64_t Padding; // Keeps the entries and the first blob aligned.
+    };
+
+    struct ArchiveEntry {
+        char Name[ArchiveMaxNameLength + 1]; // Null terminated.
+        uint64_t NameHash;
+        uint64_t ContentHash; // HashContent() of the blob.
+        uint64_t Offset;      // From the start of the file.
+        uint64_t Size;
+        ArchiveEntryType Type;
+        uint32_t Stride;
+    };
+
+    static_assert(sizeof(ArchiveHeader) % ArchiveAlignment == 0 && sizeof(ArchiveEntry) % 8 == 0, "Unexpected padding");
+
+    // 64-bit FNV-1a of a blob. Asset::ContentHash() uses it too, so a shader keeps its hash whether it is loaded from a loose file
+    // or from an archive.
+    inline uint64_t HashContent(const uint8_t* data, size_t size) {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ data[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t ArchiveNameHash(std::string_view name) {
+        uint64_t hash = 14695981039346656037ull;
+        for (const char c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+        }
+        return hash;
+    }
+} // namespace sample
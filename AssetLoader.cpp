@@ -0,0 +1,141 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "AssetLoader.h"
+#include "AssetArchiveFormat.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Pending loads beyond this block LoadAsync() until a worker picks one up.
+    constexpr size_t JobQueueCapacity = 64;
+} // namespace
+
+namespace sample {
+    Asset::Asset(const std::string& path) {
+#ifdef _WIN32
+        const winrt::file_handle file{::CreateFile2(xr::utf8_to_wide(path).c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr)};
+        if (!file) {
+            THROW(xr::detail::_Fmt("Cannot open asset %s", path.c_str()));
+        }
+
+        LARGE_INTEGER size;
+        CHECK(::GetFileSizeEx(file.get(), &size));
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size > 0) {
+            // The view keeps the mapping alive once its handle is closed.
+            const winrt::handle mapping{::CreateFileMappingFromApp(file.get(), nullptr, PAGE_READONLY, 0, nullptr)};
+            CHECK(mapping);
+            m_data = static_cast<const uint8_t*>(::MapViewOfFileFromApp(mapping.get(), FILE_MAP_READ, 0, 0));
+            CHECK(m_data != nullptr);
+        }
+#else
+        const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0) {
+            THROW(xr::detail::_Fmt("Cannot open asset %s", path.c_str()));
+        }
+
+        struct stat status;
+        const bool statSucceeded = ::fstat(file, &status) == 0;
+        m_size = statSucceeded ? static_cast<size_t>(status.st_size) : 0;
+        void* const view = statSucceeded && m_size > 0 ? ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0) : nullptr;
+        ::close(file); // The mapping stays valid once the file is closed.
+        CHECK(statSucceeded && view != MAP_FAILED);
+        m_data = static_cast<const uint8_t*>(view);
+#endif
+        m_contentHash = HashContent(m_data, m_size);
+    }
+
+    Asset::~Asset() {
+        if (m_data != nullptr) {
+#ifdef _WIN32
+            ::UnmapViewOfFile(m_data);
+#else
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        }
+    }
+
+    AssetLoader::AssetLoader(uint32_t workerCount)
+        : m_jobs(JobQueueCapacity) {
+        CHECK(workerCount > 0);
+        for (uint32_t i = 0; i < workerCount; i++) {
+            m_workers.emplace_back([this] {
+                std::function<void()> job;
+                while (m_jobs.Pop(job)) {
+                    job();
+                }
+            });
+        }
+    }
+
+    AssetLoader::~AssetLoader() {
+        // Pending loads are still completed, so no future is left without a value.
+        m_jobs.Close();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    std::shared_future<AssetPtr> AssetLoader::LoadAsync(const std::string& path) {
+        auto promise = std::make_shared<std::promise<AssetPtr>>();
+        std::shared_future<AssetPtr> future;
+        {
+            std::lock_guard lock(m_mutex);
+            const auto it = m_assetsByPath.find(path);
+            if (it != m_assetsByPath.end()) {
+                return it->second;
+            }
+            future = promise->get_future().share();
+            m_assetsByPath.emplace(path, future);
+        }
+
+        CHECK(m_jobs.Push([this, path, promise] {
+            try {
+                promise->set_value(Read(path));
+            } catch (...) {
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_assetsByPath.erase(path);
+                }
+                promise->set_exception(std::current_exception());
+            }
+        }));
+        return future;
+    }
+
+    AssetPtr AssetLoader::Read(const std::string& path) {
+        auto asset = std::make_shared<const Asset>(path);
+        m_fileReadCount.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard lock(m_mutex);
+        const auto [first, last] = m_assetsByContent.equal_range(asset->ContentHash());
+        for (auto it = first; it != last; ++it) {
+            const AssetPtr& existing = it->second;
+            if (existing->Size() == asset->Size() &&
+                (asset->Size() == 0 || std::memcmp(existing->Data(), asset->Data(), asset->Size()) == 0)) {
+                return existing;
+            }
+        }
+        m_assetsByContent.emplace(asset->ContentHash(), asset);
+        return asset;
+    }
+} // namespace sample
@@ -0,0 +1,87 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <functional>
+#include <future>
+
+#include "FrameChannel.h"
+
+namespace sample {
+    // Read-only content of a file, memory-mapped for the lifetime of the asset.
+    class Asset {
+    public:
+        explicit Asset(const std::string& path);
+        ~Asset();
+
+        Asset(const Asset&) = delete;
+        Asset& operator=(const Asset&) = delete;
+
+        const uint8_t* Data() const {
+            return m_data;
+        }
+        size_t Size() const {
+            return m_size;
+        }
+
+        // Hash of the content, identical files share the same hash whatever their path.
+        uint64_t ContentHash() const {
+            return m_contentHash;
+        }
+
+    private:
+        const uint8_t* m_data{nullptr};
+        size_t m_size{0};
+        uint64_t m_contentHash{0};
+    };
+
+    using AssetPtr = std::shared_ptr<const Asset>;
+
+    // Loads assets on a pool of worker threads, and keeps them in memory until the loader is destroyed.
+    // A path is only read once, later loads of it return the same future. Files with identical content share a single Asset,
+    // so caches of objects created from assets can be keyed by Asset::ContentHash().
+    class AssetLoader {
+    public:
+        explicit AssetLoader(uint32_t workerCount = 2);
+        ~AssetLoader();
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        // The future holds the exception of a failed load, in which case the next load of the path reads it again.
+        std::shared_future<AssetPtr> LoadAsync(const std::string& path);
+
+        AssetPtr Load(const std::string& path) {
+            return LoadAsync(path).get();
+        }
+
+        // Number of files read so far, cache hits excluded.
+        uint64_t FileReadCount() const {
+            return m_fileReadCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        AssetPtr Read(const std::string& path);
+
+        std::mutex m_mutex;
+        std::unordered_map<std::string, std::shared_future<AssetPtr>> m_assetsByPath;
+        std::unordered_multimap<uint64_t, AssetPtr> m_assetsByContent;
+        std::atomic<uint64_t> m_fileReadCount{0};
+
+        FrameChannel<std::function<void()>> m_jobs;
+        std::vector<std::thread> m_workers;
+    };
+} // namespace sample
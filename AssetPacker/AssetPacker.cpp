@@ -0,0 +1,151 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Build-time tool writing the asset archive loaded by the graphics plugins, see AssetArchiveFormat.h.
+// Usage: AssetPacker output [--shader name file]... [--cube-mesh name]
+// --cube-mesh packs the compiled-in cube of CubeMesh.h as name/vertices, name/indices and name/layout.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "AssetArchiveFormat.h"
+#include "CubeMesh.h"
+
+namespace {
+    struct PendingEntry {
+        std::string Name;
+        sample::ArchiveEntryType Type;
+        uint32_t Stride;
+        std::vector<uint8_t> Content;
+    };
+
+    template <typename T, size_t N>
+    std::vector<uint8_t> Bytes(const T (&values)[N]) {
+        const uint8_t* const data = reinterpret_cast<const uint8_t*>(values);
+        return std::vector<uint8_t>(data, data + sizeof(values));
+    }
+
+    bool ReadFile(const char* path, std::vector<uint8_t>& content) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    uint64_t AlignUp(uint64_t offset) {
+        return (offset + sample::ArchiveAlignment - 1) / sample::ArchiveAlignment * sample::ArchiveAlignment;
+    }
+
+    bool WriteArchive(const char* path, const std::vector<PendingEntry>& pending) {
+        std::vector<uint64_t> nameHashes;
+        std::vector<size_t> order;
+        for (size_t i = 0; i < pending.size(); i++) {
+            nameHashes.push_back(sample::ArchiveNameHash(pending[i].Name));
+            order.push_back(i);
+        }
+
+        // Sort the table of contents by name hash, for binary search at load time.
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return nameHashes[a] < nameHashes[b]; });
+
+        std::vector<sample::ArchiveEntry> toc;
+        uint64_t offset = AlignUp(sizeof(sample::ArchiveHeader) + sizeof(sample::ArchiveEntry) * pending.size());
+        for (const size_t i : order) {
+            sample::ArchiveEntry entry{};
+            std::memcpy(entry.Name, pending[i].Name.data(), pending[i].Name.size());
+            entry.NameHash = nameHashes[i];
+            entry.ContentHash = sample::HashContent(pending[i].Content.data(), pending[i].Content.size());
+            entry.Offset = offset;
+            entry.Size = pending[i].Content.size();
+            entry.Type = pending[i].Type;
+            entry.Stride = pending[i].Stride;
+            toc.push_back(entry);
+            offset = AlignUp(offset + entry.Size);
+        }
+
+        sample::ArchiveHeader header{};
+        header.Magic = sample::ArchiveMagic;
+        header.Version = sample::ArchiveVersion;
+        header.EntryCount = (uint32_t)toc.size();
+        header.FileSize = offset;
+
+        std::vector<uint8_t> archive(offset, 0);
+        std::memcpy(archive.data(), &header, sizeof(header));
+        std::memcpy(archive.data() + sizeof(header), toc.data(), sizeof(sample::ArchiveEntry) * toc.size());
+        for (size_t slot = 0; slot < order.size(); slot++) {
+            const std::vector<uint8_t>& content = pending[order[slot]].Content;
+            std::copy(content.begin(), content.end(), archive.begin() + toc[slot].Offset);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(archive.data()), archive.size());
+        return file.good();
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s output [--shader name file]... [--cube-mesh name]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<PendingEntry> entries;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--shader") == 0 && i + 2 < argc) {
+            PendingEntry entry{argv[i + 1], sample::ArchiveEntryType::Shader, 0, {}};
+            if (!ReadFile(argv[i + 2], entry.Content)) {
+                std::fprintf(stderr, "Cannot read %s\n", argv[i + 2]);
+                return 1;
+            }
+            entries.push_back(std::move(entry));
+            i += 2;
+        } else if (std::strcmp(argv[i], "--cube-mesh") == 0 && i + 1 < argc) {
+            using namespace sample::CubeMesh;
+            const std::string name = argv[++i];
+            entries.push_back({name + "/vertices", sample::ArchiveEntryType::VertexStream, sizeof(Vertex), Bytes(c_cubeVertices)});
+            entries.push_back({name + "/indices", sample::ArchiveEntryType::IndexStream, sizeof(c_cubeIndices[0]), Bytes(c_cubeIndices)});
+            entries.push_back({name + "/layout", sample::ArchiveEntryType::VertexLayout, 0, Bytes(c_cubeLayout)});
+        } else {
+            std::fprintf(stderr, "Unexpected argument %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].Name.size() > sample::ArchiveMaxNameLength) {
+            std::fprintf(stderr, "Entry name %s is longer than %u characters\n", entries[i].Name.c_str(), sample::ArchiveMaxNameLength);
+            return 1;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (entries[i].Name == entries[j].Name) {
+                std::fprintf(stderr, "Duplicate entry %s\n", entries[i].Name.c_str());
+                return 1;
+            }
+        }
+    }
+
+    if (!WriteArchive(argv[1], entries)) {
+        std::fprintf(stderr, "Cannot write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
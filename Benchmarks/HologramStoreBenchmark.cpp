@@ -0,0 +1,222 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Measures the per-frame pass over the holograms of HologramStore against the vector of cubes it replaced, and the cost of adding
+// and removing holograms, for scenes of 10k and 100k holograms by default.
+// Usage: HologramStoreBenchmark [--holograms count]... [--frames count]
+// The spaces are fake handles, unknown to the headless runtime which fails to destroy them, and the located poses are synthetic,
+// so that only the program side of a frame is timed.
+
+#include "pch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "HologramStore.h"
+#include "OpenXrProgram.h"
+#include "XrUtility/XrMathBatch.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double NanosecondsPer(Clock::duration duration, size_t count) {
+        return std::chrono::duration<double, std::nano>(duration).count() / count;
+    }
+
+    XrSpace FakeSpace(uint32_t i) {
+        return reinterpret_cast<XrSpace>(uint64_t{0x100000000} + i);
+    }
+
+    std::vector<XrPosef> MakeLocatedPoses(uint32_t count) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(-5, 5);
+        std::vector<XrPosef> poses(count);
+        for (XrPosef& pose : poses) {
+            pose = {xr::math::Quaternion::RotationAxisAngle({0, 1, 0}, position(random)), {position(random), position(random), position(random)}};
+        }
+        return poses;
+    }
+
+    // Every 8th hologram is not located.
+    std::vector<uint8_t> MakeLocatedMask(uint32_t count) {
+        std::vector<uint8_t> mask(count);
+        for (uint32_t i = 0; i < count; i++) {
+            mask[i] = i % 8 != 0;
+        }
+        return mask;
+    }
+
+    // The cube of the program before HologramStore.
+    struct PlacedCube {
+        xr::SpaceHandle Space{};
+        std::optional<XrPosef> PoseInSpace{}; // Cube pose in above Space. Default to identity.
+        XrVector3f Scale{0.1f, 0.1f, 0.1f};
+        sample::MeshId Mesh{0};
+
+        XrPosef PoseInScene = xr::math::Pose::Identity(); // Cube pose in the scene.  Got updated every frame
+    };
+
+    // The holograms before HologramStore, a vector of cubes each owning its space, gathered by pointer every frame. Their pose in
+    // space is unset as for placed cubes, so the pose multiplication is skipped, like the store does for holograms without one.
+    struct Hologram {
+        PlacedCube Cube;
+        xr::SpatialAnchorHandle Anchor;
+    };
+
+    struct Result {
+        double AddNs;
+        double FrameNs;
+        double RemoveNs;
+    };
+
+    Result RunArrayOfStructures(uint32_t hologramCount, uint32_t frameCount) {
+        const std::vector<XrPosef> locatedPoses = MakeLocatedPoses(hologramCount);
+        const std::vector<uint8_t> locatedMask = MakeLocatedMask(hologramCount);
+
+        Clock::time_point start = Clock::now();
+        std::vector<Hologram> holograms;
+        for (uint32_t i = 0; i < hologramCount; i++) {
+            Hologram hologram;
+            *hologram.Cube.Space.Put() = FakeSpace(i);
+            holograms.push_back(std::move(hologram));
+        }
+        const Clock::duration addTime = Clock::now() - start;
+
+        std::vector<PlacedCube*> locatedCubes;
+        std::vector<XrSpace> locatedSpaces;
+        std::vector<const PlacedCube*> visibleCubes;
+        start = Clock::now();
+        for (uint32_t frame = 0; frame < frameCount; frame++) {
+            locatedCubes.clear();
+            locatedSpaces.clear();
+            for (Hologram& hologram : holograms) {
+                locatedCubes.push_back(&hologram.Cube);
+                locatedSpaces.push_back(hologram.Cube.Space.Get());
+            }
+
+            visibleCubes.clear();
+            for (size_t i = 0; i < locatedCubes.size(); i++) {
+                PlacedCube& cube = *locatedCubes[i];
+                if (locatedMask[i]) {
+                    cube.PoseInScene = cube.PoseInSpace ? xr::math::Pose::Multiply(*cube.PoseInSpace, locatedPoses[i]) : locatedPoses[i];
+                    visibleCubes.push_back(&cube);
+                }
+            }
+        }
+        const Clock::duration frameTime = Clock::now() - start;
+
+        // Without stable ids, a hologram is removed by index, shifting the ones after it.
+        const uint32_t removeCount = hologramCount / 10;
+        std::mt19937 random(7);
+        start = Clock::now();
+        for (uint32_t i = 0; i < removeCount; i++) {
+            holograms.erase(holograms.begin() + std::uniform_int_distribution<size_t>(0, holograms.size() - 1)(random));
+        }
+        const Clock::duration removeTime = Clock::now() - start;
+
+        return {NanosecondsPer(addTime, hologramCount), NanosecondsPer(frameTime, size_t{hologramCount} * frameCount),
+                NanosecondsPer(removeTime, removeCount)};
+    }
+
+    Result RunStructureOfArrays(uint32_t hologramCount, uint32_t frameCount) {
+        const std::vector<XrPosef> locatedPoses = MakeLocatedPoses(hologramCount);
+        const std::vector<uint8_t> locatedMask = MakeLocatedMask(hologramCount);
+
+        Clock::time_point start = Clock::now();
+        sample::HologramStore holograms;
+        std::vector<sample::HologramId> ids;
+        for (uint32_t i = 0; i < hologramCount; i++) {
+            xr::SpaceHandle space;
+            *space.Put() = FakeSpace(i);
+            ids.push_back(holograms.Add(std::move(space), {}, {0.1f, 0.1f, 0.1f}, 0));
+        }
+        const Clock::duration addTime = Clock::now() - start;
+
+        // The same pass as the UpdateScene() of the program.
+        std::vector<XrSpace> locatedSpaces;
+        sample::DrawList visibleCubes;
+        start = Clock::now();
+        for (uint32_t frame = 0; frame < frameCount; frame++) {
+            const uint32_t count = holograms.Size();
+            locatedSpaces.clear();
+            locatedSpaces.insert(locatedSpaces.end(), holograms.Spaces(), holograms.Spaces() + count);
+
+            const XrVector3f* scales = holograms.Scales();
+            const sample::MeshId* meshes = holograms.Meshes();
+            XrPosef* posesInScene = holograms.PosesInScene();
+            uint8_t* visible = holograms.Visible();
+            const uint32_t posedCount = holograms.PosedCount();
+            xr::math::MultiplyPoses(holograms.PosesInSpace(), locatedPoses.data(), posesInScene, posedCount);
+            std::copy(locatedPoses.begin() + posedCount, locatedPoses.begin() + count, posesInScene + posedCount);
+            std::copy(locatedMask.begin(), locatedMask.begin() + count, visible);
+
+            visibleCubes.Reserve(count);
+            visibleCubes.Resize(count);
+            size_t visibleCount = 0;
+            for (uint32_t i = 0; i < count; i++) {
+                visibleCubes.Poses[visibleCount] = posesInScene[i];
+                visibleCubes.Scales[visibleCount] = scales[i];
+                visibleCubes.Meshes[visibleCount] = meshes[i];
+                visibleCount += visible[i];
+            }
+            visibleCubes.Resize(visibleCount);
+        }
+        const Clock::duration frameTime = Clock::now() - start;
+
+        const uint32_t removeCount = hologramCount / 10;
+        std::mt19937 random(7);
+        std::shuffle(ids.begin(), ids.end(), random);
+        start = Clock::now();
+        for (uint32_t i = 0; i < removeCount; i++) {
+            holograms.Remove(ids[i]);
+        }
+        const Clock::duration removeTime = Clock::now() - start;
+
+        return {NanosecondsPer(addTime, hologramCount), NanosecondsPer(frameTime, size_t{hologramCount} * frameCount),
+                NanosecondsPer(removeTime, removeCount)};
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<uint32_t> hologramCounts;
+    uint32_t frameCount = 100;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--holograms" && hasValue) {
+            hologramCounts.push_back(std::max(10u, (uint32_t)std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--frames" && hasValue) {
+            frameCount = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Usage: %s [--holograms count]... [--frames count]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (hologramCounts.empty()) {
+        hologramCounts = {10000, 100000};
+    }
+
+    std::printf("%10s %8s %12s %12s %12s\n", "holograms", "layout", "add ns", "frame ns", "remove ns");
+    for (uint32_t hologramCount : hologramCounts) {
+        const Result aos = RunArrayOfStructures(hologramCount, frameCount);
+        std::printf("%10u %8s %12.1f %12.2f %12.1f\n", hologramCount, "AoS", aos.AddNs, aos.FrameNs, aos.RemoveNs);
+        const Result soa = RunStructureOfArrays(hologramCount, frameCount);
+        std::printf("%10u %8s %12.1f %12.2f %12.1f\n", hologramCount, "SoA", soa.AddNs, soa.FrameNs, soa.RemoveNs);
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+// Measures the ns per pose of the kernels of XrMathBatch.h against the single pose loops they replace, for the model matrices of
+// the render queue from array of structures poses and from TransformArrays, and for the pose multiplication of the scene update.
+// Usage: PoseKernelBenchmark [--poses count]... [--repeats count]
+
+#include "pch.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "XrUtility/XrMathBatch.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Scene {
+        std::vector<XrPosef> Poses;
+        std::vector<XrPosef> Origins;
+        std::vector<XrVector3f> Scales;
+        xr::math::TransformArrays Transforms;
+    };
+
+    Scene MakeScene(uint32_t count) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> value(-5, 5);
+        Scene scene;
+        scene.Transforms.Resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            const XrVector3f axis{value(random), value(random), value(random)};
+            scene.Poses.push_back({xr::math::Quaternion::RotationAxisAngle(axis, value(random)), {value(random), value(random), value(random)}});
+            scene.Origins.push_back({xr::math::Quaternion::RotationAxisAngle({0, 1, 0}, value(random)), {value(random), 0, value(random)}});
+            scene.Scales.push_back({0.1f, 0.1f, 0.1f});
+            scene.Transforms.Set(i, scene.Poses[i], scene.Scales[i]);
+        }
+        return scene;
+    }
+
+    // Runs the kernel repeatCount times and returns the ns per pose. The checksum keeps the results alive.
+    template <typename Kernel>
+    double NanosecondsPerPose(uint32_t poseCount, uint32_t repeatCount, float& checksum, Kernel&& kernel) {
+        const Clock::time_point start = Clock::now();
+        for (uint32_t repeat = 0; repeat < repeatCount; repeat++) {
+            checksum += kernel();
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (double(poseCount) * repeatCount);
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<uint32_t> poseCounts;
+    uint32_t repeatCount = 100;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--poses" && hasValue) {
+            poseCounts.push_back(std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--repeats" && hasValue) {
+            repeatCount = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Usage: %s [--poses count]... [--repeats count]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (poseCounts.empty()) {
+        poseCounts = {1000, 100000};
+    }
+
+    float checksum = 0;
+    std::printf("%10s %24s %10s\n", "poses", "kernel", "ns/pose");
+    for (uint32_t poseCount : poseCounts) {
+        Scene scene = MakeScene(poseCount);
+        std::vector<xr::math::Float4x4> matrices(poseCount);
+        std::vector<XrPosef> poses(poseCount);
+        const auto print = [&](const char* kernel, double ns) { std::printf("%10u %24s %10.2f\n", poseCount, kernel, ns); };
+
+        print("matrices scalar", NanosecondsPerPose(poseCount, repeatCount, checksum, [&] {
+                  for (uint32_t i = 0; i < poseCount; i++) {
+                      const XrVector3f& scale = scene.Scales[i];
+                      xr::math::StoreFloat4x4(&matrices[i], xr::math::MatrixScaling(scale.x, scale.y, scale.z) * xr::math::LoadXrPose(scene.Poses[i]));
+                  }
+                  return matrices.back().m[3][0];
+              }));
+        print("matrices batch AoS", NanosecondsPerPose(poseCount, repeatCount, checksum, [&] {
+                  xr::math::PosesToMatrices(scene.Poses.data(), scene.Scales.data(), matrices.data(), poseCount);
+                  return matrices.back().m[3][0];
+              }));
+        print("matrices batch SoA", NanosecondsPerPose(poseCount, repeatCount, checksum, [&] {
+                  xr::math::PosesToMatrices(scene.Transforms, 0, poseCount, matrices.data());
+                  return matrices.back().m[3][0];
+              }));
+        print("multiply scalar", NanosecondsPerPose(poseCount, repeatCount, checksum, [&] {
+                  for (uint32_t i = 0; i < poseCount; i++) {
+                      poses[i] = xr::math::Pose::Multiply(scene.Poses[i], scene.Origins[i]);
+                  }
+                  return poses.back().position.x;
+              }));
+        print("multiply batch AoS", NanosecondsPerPose(poseCount, repeatCount, checksum, [&] {
+                  xr::math::MultiplyPoses(scene.Poses.data(), scene.Origins.data(), poses.data(), poseCount);
+                  return poses.back().position.x;
+              }));
+    }
+    std::printf("Checksum: %g\n", checksum);
+    return 0;
+}
@@ -0,0 +1,134 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+
+#ifdef USE_BGFX
+#include "BgfxDrawSubmitter.h"
+#include "XrUtility/XrMathBatch.h"
+
+namespace sample {
+    BgfxDrawSubmitter::BgfxDrawSubmitter(uint32_t threadCount)
+        : m_pool(std::min<uint32_t>(std::max(threadCount, 1u), bgfx::getCaps()->limits.maxEncoders) - 1)
+        , m_rangeSubmitted(m_pool.ThreadCount()) {
+    }
+
+    void BgfxDrawSubmitter::Submit(const RenderQueue& queue, const BgfxMeshBuffers* const* batchBuffers, const BgfxDrawParameters& parameters) {
+        const uint32_t drawCount = queue.Size();
+        const uint32_t threadCount = ThreadCount();
+        if (drawCount < m_parallelDrawThreshold || threadCount == 1) {
+            bgfx::Encoder* encoder = bgfx::begin();
+            SubmitRange(encoder, queue, batchBuffers, parameters, 0, drawCount);
+            bgfx::end(encoder);
+            return;
+        }
+
+        // One contiguous range per thread, the cost of a draw does not depend on its mesh.
+        const auto rangeFirst = [&](uint32_t range) { return (uint32_t)((uint64_t)drawCount * range / threadCount); };
+        m_pool.ParallelFor(threadCount, [&](uint32_t range, uint32_t thread) {
+            // Thread 0 is the calling thread, which submits through the encoder of the API thread. The workers get their own,
+            // unless another system of the application holds the encoders.
+            bgfx::Encoder* encoder = bgfx::begin(thread != 0);
+            m_rangeSubmitted[range] = encoder != nullptr;
+            if (encoder != nullptr) {
+                SubmitRange(encoder, queue, batchBuffers, parameters, rangeFirst(range), rangeFirst(range + 1));
+                bgfx::end(encoder);
+            }
+        });
+
+        // The ranges left by a worker without encoder are submitted by the calling thread. Their depth keeps them in queue order.
+        for (uint32_t range = 0; range < threadCount; range++) {
+            if (!m_rangeSubmitted[range]) {
+                bgfx::Encoder* encoder = bgfx::begin();
+                SubmitRange(encoder, queue, batchBuffers, parameters, rangeFirst(range), rangeFirst(range + 1));
+                bgfx::end(encoder);
+            }
+        }
+    }
+
+    void BgfxDrawSubmitter::SubmitRange(bgfx::Encoder* encoder,
+                                        const RenderQueue& queue,
+                                        const BgfxMeshBuffers* const* batchBuffers,
+                                        const BgfxDrawParameters& parameters,
+                                        uint32_t first,
+                                        uint32_t end) {
+        const std::vector<RenderQueue::Batch>& batches = queue.Batches();
+        const xr::math::TransformArrays& transforms = queue.Transforms();
+        const uint32_t viewCount = parameters.ViewCount;
+
+        // The first batch overlapping the range.
+        size_t batchIndex = std::upper_bound(batches.begin(), batches.end(), first, [](uint32_t draw, const RenderQueue::Batch& batch) {
+                                return draw < batch.First;
+                            }) - batches.begin() - 1;
+
+        // The state, buffers and uniforms of a batch are set once. Submits within a batch only discard what the next draw
+        // replaces, and the last one discards everything before the next batch.
+        for (; batchIndex < batches.size() && batches[batchIndex].First < end; batchIndex++) {
+            const RenderQueue::Batch& batch = batches[batchIndex];
+            const BgfxMeshBuffers& buffers = *batchBuffers[batchIndex];
+            const uint32_t batchFirst = std::max(first, batch.First);
+            const uint32_t batchEnd = std::min(end, batch.First + batch.Count);
+
+            encoder->setUniform(parameters.ViewProjectionUniform, parameters.ViewProjections, (uint16_t)viewCount);
+            encoder->setVertexBuffer(0, buffers.Vertices);
+            encoder->setIndexBuffer(buffers.Indices);
+            encoder->setState(parameters.State);
+
+            if (parameters.Instanced) {
+                constexpr uint16_t instanceStride = sizeof(xr::math::Float4x4);
+                uint32_t firstCube = batchFirst;
+                while (firstCube < batchEnd) {
+                    // The transient instance buffer is bounded, so fall back to several submits if it cannot hold all cubes.
+                    const uint32_t requestedInstances = (batchEnd - firstCube) * viewCount;
+                    const uint32_t cubeCount = bgfx::getAvailInstanceDataBuffer(requestedInstances, instanceStride) / viewCount;
+                    if (cubeCount == 0) {
+                        DEBUG_PRINT("Out of instance data buffer, %u cubes are not drawn.", batchEnd - firstCube);
+                        encoder->discard();
+                        break;
+                    }
+
+                    bgfx::InstanceDataBuffer instanceData;
+                    bgfx::allocInstanceDataBuffer(&instanceData, cubeCount * viewCount, instanceStride);
+
+                    // Each cube takes one instance per view, the shader picks the view from the instance id.
+                    xr::math::Float4x4* models = reinterpret_cast<xr::math::Float4x4*>(instanceData.data);
+                    xr::math::PosesToMatrices(transforms, firstCube, cubeCount, models, viewCount);
+                    for (uint32_t i = 0; i < cubeCount; i++) {
+                        xr::math::Float4x4* cubeModels = &models[i * viewCount];
+                        for (uint32_t k = 1; k < viewCount; k++) {
+                            cubeModels[k] = cubeModels[0];
+                        }
+                    }
+
+                    encoder->setInstanceDataBuffer(&instanceData);
+                    const uint32_t depth = firstCube + 1;
+                    firstCube += cubeCount;
+                    encoder->submit(parameters.View, parameters.Program, depth, firstCube == batchEnd ? BGFX_DISCARD_ALL : BGFX_DISCARD_INSTANCE_DATA);
+                }
+            } else {
+                encoder->setInstanceCount(viewCount);
+                for (uint32_t i = batchFirst; i < batchEnd; i++) {
+                    // Compute and update the model transform for each cube.
+                    xr::math::Float4x4 model;
+                    xr::math::PosesToMatrices(transforms, i, 1, &model);
+
+                    encoder->setTransform(&model.m[0][0], 1);
+                    encoder->submit(parameters.View, parameters.Program, i + 1, i + 1 == batchEnd ? BGFX_DISCARD_ALL : BGFX_DISCARD_TRANSFORM);
+                }
+            }
+        }
+    }
+} // namespace sample
+#endif
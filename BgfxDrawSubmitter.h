@@ -0,0 +1,81 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include "RenderQueue.h"
+#include "TaskPool.h"
+
+namespace sample {
+    struct BgfxMeshBuffers {
+        bgfx::VertexLayout Layout;
+        bgfx::VertexBufferHandle Vertices = BGFX_INVALID_HANDLE;
+        bgfx::IndexBufferHandle Indices = BGFX_INVALID_HANDLE;
+    };
+
+    // What every draw of a view shares.
+    struct BgfxDrawParameters {
+        bgfx::ViewId View{0};
+        bgfx::ProgramHandle Program = BGFX_INVALID_HANDLE;
+        uint64_t State{BGFX_STATE_DEFAULT};
+        uint32_t ViewCount{1};
+
+        // ViewCount matrices, set to the uniform before the draws of each batch.
+        bgfx::UniformHandle ViewProjectionUniform = BGFX_INVALID_HANDLE;
+        const float* ViewProjections{nullptr};
+
+        // Draw the cubes of a batch with instanced submits, one instance per cube and view carrying the model matrix. Otherwise each
+        // cube is submitted with its transform and ViewCount instances.
+        bool Instanced{false};
+    };
+
+    // Submits the draws of a sorted render queue. Above a threshold, the draws are split in contiguous ranges across threads, each
+    // submitting through its own bgfx encoder. The position of a draw in the queue plus one is passed as its submit depth, so a view
+    // in bgfx::ViewMode::DepthAscending keeps the queue order whatever thread submitted the draw. Draws submitted with depth 0,
+    // such as a depth pre-pass, come before the queue.
+    class BgfxDrawSubmitter {
+    public:
+        // threadCount includes the thread calling Submit(). It is clamped to bgfx::Caps::limits.maxEncoders, so bgfx must be
+        // initialized.
+        explicit BgfxDrawSubmitter(uint32_t threadCount);
+
+        uint32_t ThreadCount() const {
+            return m_pool.ThreadCount();
+        }
+
+        // Below this number of draws, the calling thread submits them all, as waking the workers would cost more than it saves.
+        void SetParallelDrawThreshold(uint32_t drawCount) {
+            m_parallelDrawThreshold = drawCount;
+        }
+
+        // The queue must be sorted and have gathered the draw transforms. batchBuffers[i] are the buffers of queue.Batches()[i].
+        // Must be called from the thread calling bgfx::frame().
+        void Submit(const RenderQueue& queue, const BgfxMeshBuffers* const* batchBuffers, const BgfxDrawParameters& parameters);
+
+    private:
+        void SubmitRange(bgfx::Encoder* encoder,
+                         const RenderQueue& queue,
+                         const BgfxMeshBuffers* const* batchBuffers,
+                         const BgfxDrawParameters& parameters,
+                         uint32_t first,
+                         uint32_t end);
+
+        TaskPool m_pool;
+        uint32_t m_parallelDrawThreshold{1024};
+        std::vector<uint8_t> m_rangeSubmitted; // Indexed by range, one range per thread.
+    };
+} // namespace sample
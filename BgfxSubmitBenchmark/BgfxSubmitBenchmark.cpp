@@ -0,0 +1,206 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Measures the CPU time of BgfxDrawSubmitter for 1 to N submitting threads, with the Noop renderer so that only the
+// submission is timed.
+// Usage: BgfxSubmitBenchmark [--draws count] [--meshes count] [--frames count] [--max-threads count] [--instanced] [--shaders dir]
+// The shaders directory holds vs_instancing.bin and fs_instancing.bin, the Assets directory of the repository by default.
+
+#include "pch.h"
+
+#include <bgfx/bgfx.h>
+#include <bgfx/platform.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include "BgfxDrawSubmitter.h"
+#include "CubeMesh.h"
+
+namespace {
+    struct Options {
+        uint32_t DrawCount{20000};
+        uint32_t MeshCount{4};
+        uint32_t FrameCount{200};
+        uint32_t MaxThreadCount{0}; // 0 for the number of hardware threads.
+        bool Instanced{false};
+        std::string ShaderDirectory{"Assets"};
+    };
+
+    bool ParseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--draws" && hasValue) {
+                options.DrawCount = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--meshes" && hasValue) {
+                options.MeshCount = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--frames" && hasValue) {
+                options.FrameCount = std::max(1u, (uint32_t)std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--max-threads" && hasValue) {
+                options.MaxThreadCount = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--instanced") {
+                options.Instanced = true;
+            } else if (arg == "--shaders" && hasValue) {
+                options.ShaderDirectory = argv[++i];
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bgfx::ShaderHandle LoadShader(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        CHECK_MSG(file, xr::detail::_Fmt("Cannot open shader %s", path.c_str()));
+        const std::vector<char> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return bgfx::createShader(bgfx::copy(content.data(), (uint32_t)content.size()));
+    }
+
+    // Cubes on a grid in front of the views, spread across the meshes.
+    void MakeScene(uint32_t drawCount, uint32_t meshCount, sample::DrawList& draws) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+        const uint32_t side = (uint32_t)std::ceil(std::sqrt((float)drawCount));
+        for (uint32_t i = 0; i < drawCount; i++) {
+            const XrVector3f position{(i % side) * 0.3f - side * 0.15f + jitter(random), (i / side) * 0.3f - side * 0.15f, -2 + jitter(random)};
+            draws.Poses.push_back({{0, 0, 0, 1}, position});
+            draws.Scales.push_back({0.1f, 0.1f, 0.1f});
+            draws.Meshes.push_back(i % meshCount);
+        }
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--draws count] [--meshes count] [--frames count] [--max-threads count] [--instanced] [--shaders dir]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    try {
+        const uint32_t hardwareThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        const uint32_t maxThreadCount = options.MaxThreadCount > 0 ? options.MaxThreadCount : hardwareThreadCount;
+
+        bgfx::Init init;
+        init.type = bgfx::RendererType::Noop;
+        init.resolution.width = 1440;
+        init.resolution.height = 936;
+        init.limits.maxEncoders = (uint16_t)std::max(maxThreadCount, 1u);
+        bgfx::renderFrame(); // Single threaded rendering, as in the application.
+        CHECK_MSG(bgfx::init(init), "Cannot initialize bgfx");
+
+        // Each encoder needs a slot, bgfx may grant fewer than requested.
+        const uint32_t threadCount = std::min<uint32_t>(maxThreadCount, bgfx::getCaps()->limits.maxEncoders);
+
+        const std::string shaderDirectory = options.ShaderDirectory + "/";
+        const bgfx::ProgramHandle program = bgfx::createProgram(
+            LoadShader(shaderDirectory + "vs_instancing.bin"), LoadShader(shaderDirectory + "fs_instancing.bin"), true);
+        const bgfx::UniformHandle viewProjectionUniform = bgfx::createUniform("u_viewProjStereo", bgfx::UniformType::Mat4, 2);
+
+        // Distinct buffers per mesh, so that the batches switch buffers as in a scene with several meshes.
+        std::vector<sample::BgfxMeshBuffers> meshBuffers(options.MeshCount);
+        for (sample::BgfxMeshBuffers& buffers : meshBuffers) {
+            buffers.Layout.begin()
+                .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+                .add(bgfx::Attrib::Color0, 3, bgfx::AttribType::Float)
+                .end();
+            buffers.Vertices = bgfx::createVertexBuffer(
+                bgfx::makeRef(sample::CubeMesh::c_cubeVertices, sizeof(sample::CubeMesh::c_cubeVertices)), buffers.Layout);
+            buffers.Indices = bgfx::createIndexBuffer(bgfx::makeRef(sample::CubeMesh::c_cubeIndices, sizeof(sample::CubeMesh::c_cubeIndices)));
+        }
+
+        sample::DrawList draws;
+        MakeScene(options.DrawCount, options.MeshCount, draws);
+
+        sample::RenderQueue queue;
+        queue.Push(draws, 0, program.idx, XrVector3f{0, 0, 0});
+        queue.Sort();
+        queue.Gather(draws);
+        std::vector<const sample::BgfxMeshBuffers*> batchBuffers;
+        for (const sample::RenderQueue::Batch& batch : queue.Batches()) {
+            batchBuffers.push_back(&meshBuffers[batch.Mesh]);
+        }
+
+        xr::math::Float4x4 viewProjections[2];
+        xr::math::StoreFloat4x4(&viewProjections[0], xr::math::MatrixIdentity());
+        viewProjections[1] = viewProjections[0];
+
+        sample::BgfxDrawParameters parameters;
+        parameters.View = 0;
+        parameters.Program = program;
+        parameters.ViewCount = 2;
+        parameters.ViewProjectionUniform = viewProjectionUniform;
+        parameters.ViewProjections = &viewProjections[0].m[0][0];
+        parameters.Instanced = options.Instanced;
+
+        bgfx::setViewRect(0, 0, 0, (uint16_t)init.resolution.width, (uint16_t)init.resolution.height);
+        bgfx::setViewMode(0, bgfx::ViewMode::DepthAscending);
+
+        std::printf("%u draws of %u meshes in %zu batches, %s submits, %u frames per thread count\n",
+                    options.DrawCount,
+                    options.MeshCount,
+                    queue.Batches().size(),
+                    options.Instanced ? "instanced" : "per draw",
+                    options.FrameCount);
+        std::printf("threads  submit ms  frame ms  speedup\n");
+
+        double singleThreadSubmitMs = 0;
+        for (uint32_t threads = 1; threads <= threadCount; threads++) {
+            sample::BgfxDrawSubmitter submitter(threads);
+            submitter.SetParallelDrawThreshold(0);
+
+            using Clock = std::chrono::steady_clock;
+            Clock::duration submitTime{}, frameTime{};
+            constexpr uint32_t WarmupFrameCount = 10;
+            for (uint32_t frame = 0; frame < WarmupFrameCount + options.FrameCount; frame++) {
+                const Clock::time_point start = Clock::now();
+                bgfx::touch(0);
+                submitter.Submit(queue, batchBuffers.data(), parameters);
+                const Clock::time_point submitted = Clock::now();
+                bgfx::frame();
+                if (frame >= WarmupFrameCount) {
+                    submitTime += submitted - start;
+                    frameTime += Clock::now() - start;
+                }
+            }
+
+            const double submitMs = std::chrono::duration<double, std::milli>(submitTime).count() / options.FrameCount;
+            const double frameMs = std::chrono::duration<double, std::milli>(frameTime).count() / options.FrameCount;
+            if (threads == 1) {
+                singleThreadSubmitMs = submitMs;
+            }
+            std::printf("%7u  %9.3f  %8.3f  %6.2fx\n", threads, submitMs, frameMs, singleThreadSubmitMs / submitMs);
+        }
+
+        for (const sample::BgfxMeshBuffers& buffers : meshBuffers) {
+            bgfx::destroy(buffers.Vertices);
+            bgfx::destroy(buffers.Indices);
+        }
+        bgfx::destroy(viewProjectionUniform);
+        bgfx::destroy(program);
+        bgfx::shutdown();
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "%s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
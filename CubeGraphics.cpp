@@ -17,115 +17,26 @@
 #include "pch.h"
 #include "OpenXrProgram.h"
 #include "DxUtility.h"
+#include "XrUtility/XrMathBatch.h"
+
+#include "AssetArchive.h"
+#include "RenderQueue.h"
 
 #ifdef USE_BGFX
+#   include "BgfxDrawSubmitter.h"
 #   include <bgfx/bgfx.h>
 #   include <bgfx/platform.h>
-#   include <bx/file.h>
 #   include <bx/allocator.h>
 #endif
 
-#ifdef USE_BGFX
-static bx::FileReaderI* s_fileReader = NULL;
-
-static const bgfx::Memory* loadMem(bx::FileReaderI* _reader, const char* _filePath)
-{
-    if (bx::open(_reader, _filePath))
-    {
-        uint32_t size = (uint32_t)bx::getSize(_reader);
-        const bgfx::Memory* mem = bgfx::alloc(size + 1);
-        bx::read(_reader, mem->data, size);
-        bx::close(_reader);
-        mem->data[mem->size - 1] = '\0';
-        return mem;
-    }
-    return NULL;
-}
-
-bgfx::ShaderHandle loadShader(bx::FileReaderI* _reader, const char* _name)
-{
-    bgfx::ShaderHandle handle = bgfx::createShader(loadMem(_reader, _name));
-    bgfx::setName(handle, _name);
-
-    return handle;
-}
-
-bgfx::ShaderHandle loadShader(const char* _name)
-{
-    return loadShader(s_fileReader, _name);
-}
-
-bgfx::ProgramHandle loadProgram(bx::FileReaderI* _reader, const char* _vsName, const char* _fsName)
-{
-    bgfx::ShaderHandle vsh = loadShader(_reader, _vsName);
-    bgfx::ShaderHandle fsh = BGFX_INVALID_HANDLE;
-    if (NULL != _fsName)
-    {
-        fsh = loadShader(_reader, _fsName);
-    }
-
-    return bgfx::createProgram(vsh, fsh, true);
-}
-
-bgfx::ProgramHandle loadProgram(const char* _vsName, const char* _fsName)
-{
-    if (!s_fileReader)
-        s_fileReader = new bx::FileReader();
-    return loadProgram(s_fileReader, _vsName, _fsName);
-}
-#endif
-
 namespace {
     namespace CubeShader {
-        struct Vertex {
-            XrVector3f Position;
-            XrVector3f Color;
-        };
-
-        constexpr XrVector3f Red{1, 0, 0};
-        constexpr XrVector3f DarkRed{0.25f, 0, 0};
-        constexpr XrVector3f Green{0, 1, 0};
-        constexpr XrVector3f DarkGreen{0, 0.25f, 0};
-        constexpr XrVector3f Blue{0, 0, 1};
-        constexpr XrVector3f DarkBlue{0, 0, 0.25f};
-
-        // Vertices for a 1x1x1 meter cube. (Left/Right, Top/Bottom, Front/Back)
-        constexpr XrVector3f LBB{-0.5f, -0.5f, -0.5f};
-        constexpr XrVector3f LBF{-0.5f, -0.5f, 0.5f};
-        constexpr XrVector3f LTB{-0.5f, 0.5f, -0.5f};
-        constexpr XrVector3f LTF{-0.5f, 0.5f, 0.5f};
-        constexpr XrVector3f RBB{0.5f, -0.5f, -0.5f};
-        constexpr XrVector3f RBF{0.5f, -0.5f, 0.5f};
-        constexpr XrVector3f RTB{0.5f, 0.5f, -0.5f};
-        constexpr XrVector3f RTF{0.5f, 0.5f, 0.5f};
-
-#define CUBE_SIDE(V1, V2, V3, V4, V5, V6, COLOR) {V1, COLOR}, {V2, COLOR}, {V3, COLOR}, {V4, COLOR}, {V5, COLOR}, {V6, COLOR},
-
-        constexpr Vertex c_cubeVertices[] = {
-            CUBE_SIDE(LTB, LBF, LBB, LTB, LTF, LBF, DarkRed)   // -X
-            CUBE_SIDE(RTB, RBB, RBF, RTB, RBF, RTF, Red)       // +X
-            CUBE_SIDE(LBB, LBF, RBF, LBB, RBF, RBB, DarkGreen) // -Y
-            CUBE_SIDE(LTB, RTB, RTF, LTB, RTF, LTF, Green)     // +Y
-            CUBE_SIDE(LBB, RBB, RTB, LBB, RTB, LTB, DarkBlue)  // -Z
-            CUBE_SIDE(LBF, LTF, RTF, LBF, RTF, RBF, Blue)      // +Z
-        };
-
-        // Winding order is clockwise. Each side uses a different color.
-        constexpr unsigned short c_cubeIndices[] = {
-            0,  1,  2,  3,  4,  5,  // -X
-            6,  7,  8,  9,  10, 11, // +X
-            12, 13, 14, 15, 16, 17, // -Y
-            18, 19, 20, 21, 22, 23, // +Y
-            24, 25, 26, 27, 28, 29, // -Z
-            30, 31, 32, 33, 34, 35, // +Z
-        };
-
         struct ModelConstantBuffer {
-            DirectX::XMFLOAT4X4 Model;
+            xr::math::Float4x4 Model;
         };
 
         struct ViewProjectionConstantBuffer {
-            DirectX::XMFLOAT4X4 ViewProjection[2];
+            xr::math::Float4x4 ViewProjection[2];
         };
 
         constexpr uint32_t MaxViewInstance = 2;
@@ -157,16 +68,165 @@ namespace {
                 return output;
             }
 
+            // Batched variant: one instance per cube and view, the model matrices are read from a structured buffer.
+            StructuredBuffer<float4x4> Models : register(t0);
+
+            VSOutput MainVSBatched(VSInput input) {
+                VSOutput output;
+                const uint viewId = input.instId % 2;
+                output.Pos = mul(mul(float4(input.Pos, 1), Models[input.instId / 2]), ViewProjection[viewId]);
+                output.Color = input.Color;
+                output.viewId = viewId;
+                return output;
+            }
+
             float4 MainPS(VSOutput input) : SV_TARGET {
                 return float4(input.Color, 1);
             }
+
+            // Visibility mask pre-pass, writing depth only. x and y are normalized device coordinates, z is the index of the view
+            // the vertex belongs to. The vertices of the other views collapse to a point outside of the viewport.
+            cbuffer VisibilityMaskConstantBuffer : register(b2) {
+                float4 VisibilityMaskDepth; // x: depth of the near plane.
+            };
+            struct VSVisibilityMaskOutput {
+                float4 Pos : SV_POSITION;
+                uint viewId : SV_RenderTargetArrayIndex;
+            };
+
+            VSVisibilityMaskOutput MainVSVisibilityMask(float3 pos : POSITION, uint instId : SV_InstanceID) {
+                VSVisibilityMaskOutput output;
+                output.Pos = abs(pos.z - instId) < 0.5 ? float4(pos.xy, VisibilityMaskDepth.x, 1) : float4(2, 2, 2, 1);
+                output.viewId = instId;
+                return output;
+            }
             )_";
 
+        struct VisibilityMaskConstantBuffer {
+            float Depth[4];
+        };
+
     } // namespace CubeShader
 
-    struct CubeGraphics : sample::IGraphicsPluginD3D11 {
-        ID3D11Device* InitializeDevice(LUID adapterLuid, const std::vector<D3D_FEATURE_LEVEL>& featureLevels) override {
-            const winrt::com_ptr<IDXGIAdapter1> adapter = sample::dx::GetAdapter(adapterLuid);
+#ifdef USE_BGFX
+    // Written by AssetPacker at build time, relative to the package folder.
+    constexpr const char* AssetArchivePath = R"(Assets\Assets.pack)";
+
+    // Entries of the archive, the shaders are compiled by build_bgfx_shader.bat.
+    constexpr const char* VertexShaderEntry = "shaders/vs_instancing";
+    constexpr const char* BatchedVertexShaderEntry = "shaders/vs_instancing_batched";
+    constexpr const char* FragmentShaderEntry = "shaders/fs_instancing";
+    constexpr const char* VisibilityMaskVertexShaderEntry = "shaders/vs_visibility_mask";
+    constexpr const char* VisibilityMaskFragmentShaderEntry = "shaders/fs_visibility_mask";
+
+    bgfx::Attrib::Enum ToBgfxAttrib(sample::VertexAttribute attribute) {
+        switch (attribute) {
+        case sample::VertexAttribute::Position: return bgfx::Attrib::Position;
+        case sample::VertexAttribute::Normal: return bgfx::Attrib::Normal;
+        case sample::VertexAttribute::Color0: return bgfx::Attrib::Color0;
+        case sample::VertexAttribute::TexCoord0: return bgfx::Attrib::TexCoord0;
+        }
+        THROW("Unknown vertex attribute");
+    }
+
+    bgfx::AttribType::Enum ToBgfxAttribType(sample::VertexAttributeType type) {
+        switch (type) {
+        case sample::VertexAttributeType::Uint8: return bgfx::AttribType::Uint8;
+        case sample::VertexAttributeType::Int16: return bgfx::AttribType::Int16;
+        case sample::VertexAttributeType::Float: return bgfx::AttribType::Float;
+        }
+        THROW("Unknown vertex attribute type");
+    }
+
+    // Format of the bgfx texture wrapping a swapchain image, the sRGB ones use BGFX_TEXTURE_SRGB.
+    bgfx::TextureFormat::Enum ToBgfxTextureFormat(int64_t swapchainFormat) {
+        switch ((DXGI_FORMAT)swapchainFormat) {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: return bgfx::TextureFormat::RGBA8;
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB: return bgfx::TextureFormat::BGRA8;
+        case DXGI_FORMAT_D32_FLOAT: return bgfx::TextureFormat::D32F;
+        case DXGI_FORMAT_D16_UNORM: return bgfx::TextureFormat::D16;
+        case DXGI_FORMAT_D24_UNORM_S8_UINT: return bgfx::TextureFormat::D24S8;
+        }
+        THROW("Unsupported swapchain format");
+    }
+#else
+    const char* ToSemanticName(sample::VertexAttribute attribute) {
+        switch (attribute) {
+        case sample::VertexAttribute::Position: return "POSITION";
+        case sample::VertexAttribute::Normal: return "NORMAL";
+        case sample::VertexAttribute::Color0: return "COLOR";
+        case sample::VertexAttribute::TexCoord0: return "TEXCOORD";
+        }
+        THROW("Unknown vertex attribute");
+    }
+
+    DXGI_FORMAT ToDxgiFormat(const sample::VertexElement& element) {
+        const bool normalized = element.Normalized != 0;
+        switch (element.Type) {
+        case sample::VertexAttributeType::Uint8:
+            CHECK_MSG(element.Count == 4, "Uint8 vertex attributes must have 4 components");
+            return normalized ? DXGI_FORMAT_R8G8B8A8_UNORM : DXGI_FORMAT_R8G8B8A8_UINT;
+        case sample::VertexAttributeType::Int16:
+            CHECK_MSG(element.Count == 2 || element.Count == 4, "Int16 vertex attributes must have 2 or 4 components");
+            if (element.Count == 2) {
+                return normalized ? DXGI_FORMAT_R16G16_SNORM : DXGI_FORMAT_R16G16_SINT;
+            }
+            return normalized ? DXGI_FORMAT_R16G16B16A16_SNORM : DXGI_FORMAT_R16G16B16A16_SINT;
+        case sample::VertexAttributeType::Float: {
+            constexpr DXGI_FORMAT formats[] = {
+                DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT};
+            CHECK_MSG(element.Count >= 1 && element.Count <= 4, "Float vertex attributes must have 1 to 4 components");
+            return formats[element.Count - 1];
+        }
+        }
+        THROW("Unknown vertex attribute type");
+    }
+#endif
+
+    struct CubeGraphics : sample::IGraphicsPlugin {
+        CubeGraphics() {
+#ifdef USE_BGFX
+            // Start mapping the archive right away, so that the read overlaps the instance and system creation.
+            m_archiveAsset = m_assetLoader.LoadAsync(AssetArchivePath);
+#endif
+        }
+
+        const char* GraphicsExtensionName() const override {
+            return XR_KHR_D3D11_ENABLE_EXTENSION_NAME;
+        }
+
+        const XrBaseInStructure* InitializeDevice(XrInstance instance,
+                                                  XrSystemId systemId,
+                                                  const xr::ExtensionDispatchTable& extensions) override {
+            // Create the D3D11 device for the adapter associated with the system.
+            XrGraphicsRequirementsD3D11KHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D11_KHR};
+            CHECK_XRCMD(extensions.xrGetD3D11GraphicsRequirementsKHR(instance, systemId, &graphicsRequirements));
+
+            if (m_device && std::memcmp(&m_adapterLuid, &graphicsRequirements.adapterLuid, sizeof(LUID)) == 0) {
+                // A session restart on the same adapter keeps the device, and the shader programs and buffers created on it.
+                return reinterpret_cast<const XrBaseInStructure*>(&m_graphicsBinding);
+            }
+#ifdef USE_BGFX
+            ShutdownBgfx();
+#endif
+            m_adapterLuid = graphicsRequirements.adapterLuid;
+
+            // Create a list of feature levels which are both supported by the OpenXR runtime and this application.
+            std::vector<D3D_FEATURE_LEVEL> featureLevels = {D3D_FEATURE_LEVEL_12_1,
+                                                            D3D_FEATURE_LEVEL_12_0,
+                                                            D3D_FEATURE_LEVEL_11_1,
+                                                            D3D_FEATURE_LEVEL_11_0,
+                                                            D3D_FEATURE_LEVEL_10_1,
+                                                            D3D_FEATURE_LEVEL_10_0};
+            featureLevels.erase(std::remove_if(featureLevels.begin(),
+                                               featureLevels.end(),
+                                               [&](D3D_FEATURE_LEVEL fl) { return fl < graphicsRequirements.minFeatureLevel; }),
+                                featureLevels.end());
+            CHECK_MSG(featureLevels.size() != 0, "Unsupported minimum feature level!");
+
+            const winrt::com_ptr<IDXGIAdapter1> adapter = sample::dx::GetAdapter(graphicsRequirements.adapterLuid);
 
             sample::dx::CreateD3D11DeviceAndContext(adapter.get(), featureLevels, m_device.put(), m_deviceContext.put());
 
@@ -184,28 +244,31 @@ namespace {
 
             InitializeD3DResources();
 
-            return m_device.get();
+            m_graphicsBinding.device = m_device.get();
+            return reinterpret_cast<const XrBaseInStructure*>(&m_graphicsBinding);
         }
 
         void InitializeD3DResources() {
 #ifdef USE_BGFX
+            if (!m_archive) {
+                m_archive.emplace(m_archiveAsset.get());
+            }
+            const sample::AssetArchive& archive = *m_archive;
 
-		// Create vertex stream declaration.
-            m_inputLayout.begin()
-            .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-			.add(bgfx::Attrib::Color0,   3, bgfx::AttribType::Float)
-			.end();
+            // Mesh buffers are created on first use by RenderView.
+            m_viewProjectionCBuffer = bgfx::createUniform("u_viewProjStereo", bgfx::UniformType::Mat4, 2);
 
+            m_program = GetProgram(archive, VertexShaderEntry, FragmentShaderEntry);
 
-            m_cubeVertexBuffer = bgfx::createVertexBuffer(bgfx::makeRef(CubeShader::c_cubeVertices, sizeof(CubeShader::c_cubeVertices)), m_inputLayout);
-            m_cubeIndexBuffer = bgfx::createIndexBuffer(bgfx::makeRef(CubeShader::c_cubeIndices, sizeof(CubeShader::c_cubeIndices)));
-            m_viewProjectionCBuffer = bgfx::createUniform("u_viewProjStereo", bgfx::UniformType::Mat4, 2);
+            // Batched variant of the program, drawing all cubes of a view in one instanced submit.
+            if (0 != (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING)) {
+                m_batchedProgram = GetProgram(archive, BatchedVertexShaderEntry, FragmentShaderEntry);
+            }
 
-            //std::string path(R"(E:\tmp\proto-bgfx\bgfx.cmake\bgfx\examples\runtime\shaders\dx11\)");
-            std::string path(R"(Assets\)");
-            std::string vs = path + "vs_instancing.bin";
-            std::string fs = path + "fs_instancing.bin";
-            m_program = loadProgram(vs.c_str(), fs.c_str());
+            // Depth only pre-pass of the visibility mask, skipped if its shaders are not in the archive.
+            m_visibilityMaskProgram = GetProgram(archive, VisibilityMaskVertexShaderEntry, VisibilityMaskFragmentShaderEntry);
+            m_visibilityMaskDepthUniform = bgfx::createUniform("u_visibilityMaskDepth", bgfx::UniformType::Vec4);
+            m_visibilityMaskLayout.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
 
             m_reversedZDepthNoStencilTest = 0
                 | BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z
@@ -213,26 +276,33 @@ namespace {
                 | BGFX_STATE_CULL_CCW 
                 | BGFX_STATE_MSAA;
 
+            // The draws are submitted from several encoders, each with its position in the render queue as depth. Sorting the view
+            // by ascending depth restores the queue order.
+            bgfx::setViewMode(0, bgfx::ViewMode::DepthAscending);
+
+            if (!m_drawSubmitter) {
+                m_drawSubmitter.emplace(std::thread::hardware_concurrency());
+            }
+
 #else
-            const winrt::com_ptr<ID3DBlob> vertexShaderBytes = sample::dx::CompileShader(CubeShader::ShaderHlsl, "MainVS", "vs_5_0");
+            // Buffers of the meshes drawn on a previous device are recreated on first use.
+            m_meshBuffers.clear();
+
+            m_vertexShaderBytes = sample::dx::CompileShader(CubeShader::ShaderHlsl, "MainVS", "vs_5_0");
             CHECK_HRCMD(m_device->CreateVertexShader(
-                vertexShaderBytes->GetBufferPointer(), vertexShaderBytes->GetBufferSize(), nullptr, m_vertexShader.put()));
+                m_vertexShaderBytes->GetBufferPointer(), m_vertexShaderBytes->GetBufferSize(), nullptr, m_vertexShader.put()));
+
+            const winrt::com_ptr<ID3DBlob> batchedVertexShaderBytes =
+                sample::dx::CompileShader(CubeShader::ShaderHlsl, "MainVSBatched", "vs_5_0");
+            CHECK_HRCMD(m_device->CreateVertexShader(batchedVertexShaderBytes->GetBufferPointer(),
+                                                     batchedVertexShaderBytes->GetBufferSize(),
+                                                     nullptr,
+                                                     m_batchedVertexShader.put()));
 
             const winrt::com_ptr<ID3DBlob> pixelShaderBytes = sample::dx::CompileShader(CubeShader::ShaderHlsl, "MainPS", "ps_5_0");
             CHECK_HRCMD(m_device->CreatePixelShader(
                 pixelShaderBytes->GetBufferPointer(), pixelShaderBytes->GetBufferSize(), nullptr, m_pixelShader.put()));
 
-            const D3D11_INPUT_ELEMENT_DESC vertexDesc[] = {
-                {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-                {"COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-            };
-
-            CHECK_HRCMD(m_device->CreateInputLayout(vertexDesc,
-                                                    (UINT)std::size(vertexDesc),
-                                                    vertexShaderBytes->GetBufferPointer(),
-                                                    vertexShaderBytes->GetBufferSize(),
-                                                    m_inputLayout.put()));
-
             const CD3D11_BUFFER_DESC modelConstantBufferDesc(sizeof(CubeShader::ModelConstantBuffer), D3D11_BIND_CONSTANT_BUFFER);
             CHECK_HRCMD(m_device->CreateBuffer(&modelConstantBufferDesc, nullptr, m_modelCBuffer.put()));
 
@@ -240,14 +310,6 @@ namespace {
                                                                       D3D11_BIND_CONSTANT_BUFFER);
             CHECK_HRCMD(m_device->CreateBuffer(&viewProjectionConstantBufferDesc, nullptr, m_viewProjectionCBuffer.put()));
 
-            const D3D11_SUBRESOURCE_DATA vertexBufferData{CubeShader::c_cubeVertices};
-            const CD3D11_BUFFER_DESC vertexBufferDesc(sizeof(CubeShader::c_cubeVertices), D3D11_BIND_VERTEX_BUFFER);
-            CHECK_HRCMD(m_device->CreateBuffer(&vertexBufferDesc, &vertexBufferData, m_cubeVertexBuffer.put()));
-
-            const D3D11_SUBRESOURCE_DATA indexBufferData{CubeShader::c_cubeIndices};
-            const CD3D11_BUFFER_DESC indexBufferDesc(sizeof(CubeShader::c_cubeIndices), D3D11_BIND_INDEX_BUFFER);
-            CHECK_HRCMD(m_device->CreateBuffer(&indexBufferDesc, &indexBufferData, m_cubeIndexBuffer.put()));
-
             D3D11_FEATURE_DATA_D3D11_OPTIONS3 options;
             m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS3, &options, sizeof(options));
             CHECK_MSG(options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizer,
@@ -258,11 +320,42 @@ namespace {
             depthStencilDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
             depthStencilDesc.DepthFunc = D3D11_COMPARISON_GREATER;
             CHECK_HRCMD(m_device->CreateDepthStencilState(&depthStencilDesc, m_reversedZDepthNoStencilTest.put()));
+
+            // Depth only pre-pass of the visibility mask, whose triangles are drawn whatever their winding.
+            const winrt::com_ptr<ID3DBlob> visibilityMaskShaderBytes =
+                sample::dx::CompileShader(CubeShader::ShaderHlsl, "MainVSVisibilityMask", "vs_5_0");
+            CHECK_HRCMD(m_device->CreateVertexShader(visibilityMaskShaderBytes->GetBufferPointer(),
+                                                     visibilityMaskShaderBytes->GetBufferSize(),
+                                                     nullptr,
+                                                     m_visibilityMaskVertexShader.put()));
+            const D3D11_INPUT_ELEMENT_DESC visibilityMaskElements[] = {
+                {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+            };
+            CHECK_HRCMD(m_device->CreateInputLayout(visibilityMaskElements,
+                                                    (UINT)std::size(visibilityMaskElements),
+                                                    visibilityMaskShaderBytes->GetBufferPointer(),
+                                                    visibilityMaskShaderBytes->GetBufferSize(),
+                                                    m_visibilityMaskInputLayout.put()));
+
+            const CD3D11_BUFFER_DESC visibilityMaskConstantBufferDesc(sizeof(CubeShader::VisibilityMaskConstantBuffer), D3D11_BIND_CONSTANT_BUFFER);
+            CHECK_HRCMD(m_device->CreateBuffer(&visibilityMaskConstantBufferDesc, nullptr, m_visibilityMaskCBuffer.put()));
+
+            CD3D11_DEPTH_STENCIL_DESC visibilityMaskDepthDesc(CD3D11_DEFAULT{});
+            visibilityMaskDepthDesc.DepthFunc = D3D11_COMPARISON_ALWAYS;
+            CHECK_HRCMD(m_device->CreateDepthStencilState(&visibilityMaskDepthDesc, m_visibilityMaskDepthState.put()));
+
+            CD3D11_RASTERIZER_DESC noCullDesc(CD3D11_DEFAULT{});
+            noCullDesc.CullMode = D3D11_CULL_NONE;
+            CHECK_HRCMD(m_device->CreateRasterizerState(&noCullDesc, m_noCullRasterizerState.put()));
+
+            // The mask buffers of a previous device are recreated on first use.
+            m_visibilityMaskVertices = nullptr;
+            m_visibilityMaskIndices = nullptr;
 #endif
         }
 
-        const std::vector<DXGI_FORMAT>& SupportedColorFormats() const override {
-            const static std::vector<DXGI_FORMAT> SupportedColorFormats = {
+        const std::vector<int64_t>& SupportedColorFormats() const override {
+            const static std::vector<int64_t> SupportedColorFormats = {
                 DXGI_FORMAT_R8G8B8A8_UNORM,
                 DXGI_FORMAT_B8G8R8A8_UNORM,
                 DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
@@ -271,57 +364,57 @@ namespace {
             return SupportedColorFormats;
         }
 
-        const std::vector<DXGI_FORMAT>& SupportedDepthFormats() const override {
-            const static std::vector<DXGI_FORMAT> SupportedDepthFormats = {
+        const std::vector<int64_t>& SupportedDepthFormats() const override {
+            const static std::vector<int64_t> SupportedDepthFormats = {
                 DXGI_FORMAT_D32_FLOAT,
                 DXGI_FORMAT_D16_UNORM,
                 DXGI_FORMAT_D24_UNORM_S8_UINT,
+#ifndef USE_BGFX
+                // bgfx has no texture format matching it.
                 DXGI_FORMAT_D32_FLOAT_S8X24_UINT,
+#endif
             };
             return SupportedDepthFormats;
         }
 
+        std::vector<sample::SwapchainImage> EnumerateSwapchainImages(XrSwapchain swapchain) const override {
+            xr::SmallVector<XrSwapchainImageD3D11KHR, 4> images;
+            xr::EnumerateSwapchainImages(swapchain, {XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR}, images);
+
+            std::vector<sample::SwapchainImage> textures;
+            for (const XrSwapchainImageD3D11KHR& image : images) {
+                textures.push_back(image.texture);
+            }
+            return textures;
+        }
+
         void RenderView(const XrRect2Di& imageRect,
                         const float renderTargetClearColor[4],
-                        const std::vector<xr::math::ViewProjection>& viewProjections,
-                        DXGI_FORMAT colorSwapchainFormat,
-                        ID3D11Texture2D* colorTexture,
-                        DXGI_FORMAT depthSwapchainFormat,
-                        ID3D11Texture2D* depthTexture,
-                        const std::vector<const sample::Cube*>& cubes) override {
+                        const std::pmr::vector<xr::math::ViewProjection>& viewProjections,
+                        uint32_t colorImageIndex,
+                        uint32_t depthImageIndex,
+                        const sample::DrawList& cubes,
+                        const sample::MeshRegistry& meshes,
+                        const sample::VisibilityMask& visibilityMask) override {
 #ifdef USE_BGFX
             // Can't use debug function cause it should use an instance and multiview version of the program
             //bool blink = false;
             //bgfx::dbgTextPrintf(0, 0, blink ? 0x4f : 0x04, " Test. ");
             
             const uint32_t viewInstanceCount = (uint32_t)viewProjections.size();
-            DirectX::XMFLOAT4X4 ViewProjection[2];
+            xr::math::Float4x4 ViewProjection[2];
             for (uint32_t k = 0; k < viewInstanceCount; k++) {
-                const DirectX::XMMATRIX spaceToView = xr::math::LoadInvertedXrPose(viewProjections[k].Pose);
-                const DirectX::XMMATRIX projectionMatrix = ComposeProjectionMatrix(viewProjections[k].Fov, viewProjections[k].NearFar);
+                const xr::math::Matrix spaceToView = xr::math::LoadInvertedXrPose(viewProjections[k].Pose);
+                const xr::math::Matrix projectionMatrix = ComposeProjectionMatrix(viewProjections[k].Fov, viewProjections[k].NearFar);
 
                 // Set view projection matrix for each view, transpose for shader usage.
-                DirectX::XMStoreFloat4x4(&ViewProjection[k], /*DirectX::XMMatrixTranspose*/(spaceToView * projectionMatrix));
+                xr::math::StoreFloat4x4(&ViewProjection[k], /*xr::math::MatrixTranspose*/(spaceToView * projectionMatrix));
             }
 
-            // Create RenderTargetView with the original swapchain format (swapchain image is typeless).
-            winrt::com_ptr<ID3D11RenderTargetView> renderTargetView;
-            const CD3D11_RENDER_TARGET_VIEW_DESC renderTargetViewDesc(D3D11_RTV_DIMENSION_TEXTURE2DARRAY, colorSwapchainFormat);
-            CHECK_HRCMD(m_device->CreateRenderTargetView(colorTexture, &renderTargetViewDesc, renderTargetView.put()));
-
-            // Create a DepthStencilView with the original swapchain format (swapchain image is typeless)
-            winrt::com_ptr<ID3D11DepthStencilView> depthStencilView;
-            CD3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc(D3D11_DSV_DIMENSION_TEXTURE2DARRAY, depthSwapchainFormat);
-            CHECK_HRCMD(m_device->CreateDepthStencilView(depthTexture, &depthStencilViewDesc, depthStencilView.put()));
-
-            bgfx::PlatformData pdata;
-            pdata.context = m_device.get();
-            pdata.backBuffer = renderTargetView.get();
-            pdata.backBufferDS = depthStencilView.get();
-            bgfx::setPlatformData(pdata);
-
+            // Render into the frame buffer of the acquired images, instead of changing the back buffer with setPlatformData, which
+            // resets the bgfx renderer.
             bgfx::setViewRect(0, imageRect.offset.x, imageRect.offset.y, imageRect.extent.width, imageRect.extent.height);
-            bgfx::setViewFrameBuffer(0, BGFX_INVALID_HANDLE);
+            bgfx::setViewFrameBuffer(0, GetFrameBuffer(colorImageIndex, depthImageIndex));
                        
             const bool reversedZ = viewProjections[0].NearFar.Near > viewProjections[0].NearFar.Far;
             const float depthClearValue = reversedZ ? 0.f : 1.f;
@@ -336,23 +429,46 @@ namespace {
 
             bgfx::touch(0);
 
-            // Draw the cube
-            // Render each cube            
-            for (const sample::Cube* cube : cubes) {
-                // Compute and update the model transform for each cube, transpose for shader usage.
-                DirectX::XMFLOAT4X4 Model;
-                const DirectX::XMMATRIX scaleMatrix = DirectX::XMMatrixScaling(cube->Scale.x, cube->Scale.y, cube->Scale.z);
-                DirectX::XMStoreFloat4x4(&Model, /*DirectX::XMMatrixTranspose*/(scaleMatrix * xr::math::LoadXrPose(cube->PoseInScene)));                
-
-                bgfx::setTransform(&Model(0,0), 1);
-                bgfx::setUniform(m_viewProjectionCBuffer, &ViewProjection[0](0, 0), 2);
-                bgfx::setVertexBuffer(0, m_cubeVertexBuffer);
-                bgfx::setIndexBuffer(m_cubeIndexBuffer);
-                bgfx::setInstanceCount(2);
-                bgfx::setState(reversedZ ? m_reversedZDepthNoStencilTest : BGFX_STATE_DEFAULT);
-                bgfx::submit(0, m_program);
+            const uint64_t state = reversedZ ? m_reversedZDepthNoStencilTest : BGFX_STATE_DEFAULT;
+
+            // Fill the pixels hidden by the lenses with the depth of the near plane, so the depth test rejects the scene there.
+            // The queue draws are submitted from depth 1, this one comes first.
+            if (!visibilityMask.Empty() && bgfx::isValid(m_visibilityMaskProgram)) {
+                UpdateVisibilityMaskBuffers(visibilityMask);
+                const float nearDepth = reversedZ ? 1.0f : (bgfx::getCaps()->homogeneousDepth ? -1.0f : 0.0f);
+                const float maskDepth[4] = {nearDepth, 0, 0, 0};
+                bgfx::setUniform(m_visibilityMaskDepthUniform, maskDepth);
+                bgfx::setVertexBuffer(0, m_visibilityMaskVertices);
+                bgfx::setIndexBuffer(m_visibilityMaskIndices);
+                bgfx::setInstanceCount(viewInstanceCount);
+                bgfx::setState(BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_ALWAYS | BGFX_STATE_MSAA);
+                bgfx::submit(0, m_visibilityMaskProgram, 0);
             }
-            
+
+            // Queue the draws by program and mesh, and front to back within a mesh so that the reversed-Z depth test rejects
+            // hidden fragments early.
+            const bool batchedDraw = m_batchedDraw && bgfx::isValid(m_batchedProgram) && viewInstanceCount == CubeShader::MaxViewInstance;
+            const bgfx::ProgramHandle program = batchedDraw ? m_batchedProgram : m_program;
+            m_queue.Clear();
+            m_queue.Push(cubes, 0, program.idx, sample::CenterOfViews(viewProjections));
+            m_queue.Sort();
+            m_queue.Gather(cubes);
+
+            // Buffers are created on this thread, the submitting threads only read them.
+            m_batchBuffers.clear();
+            for (const sample::RenderQueue::Batch& batch : m_queue.Batches()) {
+                m_batchBuffers.push_back(&GetMeshBuffers(meshes, batch.Mesh));
+            }
+
+            sample::BgfxDrawParameters parameters;
+            parameters.View = 0;
+            parameters.Program = program;
+            parameters.State = state;
+            parameters.ViewCount = viewInstanceCount;
+            parameters.ViewProjectionUniform = m_viewProjectionCBuffer;
+            parameters.ViewProjections = &ViewProjection[0].m[0][0];
+            parameters.Instanced = batchedDraw;
+            m_drawSubmitter->Submit(m_queue, m_batchBuffers.data(), parameters);
 
             bgfx::frame();
 #else
@@ -364,26 +480,45 @@ namespace {
                 (float)imageRect.offset.x, (float)imageRect.offset.y, (float)imageRect.extent.width, (float)imageRect.extent.height);
             m_deviceContext->RSSetViewports(1, &viewport);
 
-            // Create RenderTargetView with the original swapchain format (swapchain image is typeless).
-            winrt::com_ptr<ID3D11RenderTargetView> renderTargetView;
-            const CD3D11_RENDER_TARGET_VIEW_DESC renderTargetViewDesc(D3D11_RTV_DIMENSION_TEXTURE2DARRAY, colorSwapchainFormat);
-            CHECK_HRCMD(m_device->CreateRenderTargetView(colorTexture, &renderTargetViewDesc, renderTargetView.put()));
-
-            // Create a DepthStencilView with the original swapchain format (swapchain image is typeless)
-            winrt::com_ptr<ID3D11DepthStencilView> depthStencilView;
-            CD3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc(D3D11_DSV_DIMENSION_TEXTURE2DARRAY, depthSwapchainFormat);
-            CHECK_HRCMD(m_device->CreateDepthStencilView(depthTexture, &depthStencilViewDesc, depthStencilView.put()));
+            CHECK(colorImageIndex < m_renderTargetViews.size() && depthImageIndex < m_depthStencilViews.size());
+            ID3D11RenderTargetView* renderTargetView = m_renderTargetViews[colorImageIndex].get();
+            ID3D11DepthStencilView* depthStencilView = m_depthStencilViews[depthImageIndex].get();
 
             const bool reversedZ = viewProjections[0].NearFar.Near > viewProjections[0].NearFar.Far;
             const float depthClearValue = reversedZ ? 0.f : 1.f;
 
             // Clear swapchain and depth buffer. NOTE: This will clear the entire render target view, not just the specified view.
-            m_deviceContext->ClearRenderTargetView(renderTargetView.get(), renderTargetClearColor);
-            m_deviceContext->ClearDepthStencilView(depthStencilView.get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, depthClearValue, 0);
+            m_deviceContext->ClearRenderTargetView(renderTargetView, renderTargetClearColor);
+            m_deviceContext->ClearDepthStencilView(depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, depthClearValue, 0);
             m_deviceContext->OMSetDepthStencilState(reversedZ ? m_reversedZDepthNoStencilTest.get() : nullptr, 0);
 
-            ID3D11RenderTargetView* renderTargets[] = {renderTargetView.get()};
-            m_deviceContext->OMSetRenderTargets((UINT)std::size(renderTargets), renderTargets, depthStencilView.get());
+            ID3D11RenderTargetView* renderTargets[] = {renderTargetView};
+            m_deviceContext->OMSetRenderTargets((UINT)std::size(renderTargets), renderTargets, depthStencilView);
+            m_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+            // Fill the pixels hidden by the lenses with the depth of the near plane, so the depth test rejects the scene there.
+            if (!visibilityMask.Empty()) {
+                UpdateVisibilityMaskBuffers(visibilityMask);
+                const CubeShader::VisibilityMaskConstantBuffer maskDepth{{reversedZ ? 1.0f : 0.0f, 0, 0, 0}};
+                m_deviceContext->UpdateSubresource(m_visibilityMaskCBuffer.get(), 0, nullptr, &maskDepth, 0, 0);
+
+                const UINT strides[] = {sizeof(XrVector3f)};
+                const UINT offsets[] = {0};
+                ID3D11Buffer* vertexBuffers[] = {m_visibilityMaskVertices.get()};
+                m_deviceContext->IASetVertexBuffers(0, (UINT)std::size(vertexBuffers), vertexBuffers, strides, offsets);
+                m_deviceContext->IASetIndexBuffer(m_visibilityMaskIndices.get(), DXGI_FORMAT_R32_UINT, 0);
+                m_deviceContext->IASetInputLayout(m_visibilityMaskInputLayout.get());
+                ID3D11Buffer* const maskConstantBuffers[] = {m_visibilityMaskCBuffer.get()};
+                m_deviceContext->VSSetConstantBuffers(2, (UINT)std::size(maskConstantBuffers), maskConstantBuffers);
+                m_deviceContext->VSSetShader(m_visibilityMaskVertexShader.get(), nullptr, 0);
+                m_deviceContext->PSSetShader(nullptr, nullptr, 0);
+                m_deviceContext->OMSetDepthStencilState(m_visibilityMaskDepthState.get(), 0);
+                m_deviceContext->RSSetState(m_noCullRasterizerState.get());
+                m_deviceContext->DrawIndexedInstanced((UINT)visibilityMask.Indices().size(), viewInstanceCount, 0, 0, 0);
+
+                m_deviceContext->RSSetState(nullptr);
+                m_deviceContext->OMSetDepthStencilState(reversedZ ? m_reversedZDepthNoStencilTest.get() : nullptr, 0);
+            }
 
             ID3D11Buffer* const constantBuffers[] = {m_modelCBuffer.get(), m_viewProjectionCBuffer.get()};
             m_deviceContext->VSSetConstantBuffers(0, (UINT)std::size(constantBuffers), constantBuffers);
@@ -393,66 +528,472 @@ namespace {
             CubeShader::ViewProjectionConstantBuffer viewProjectionCBufferData;
 
             for (uint32_t k = 0; k < viewInstanceCount; k++) {
-                const DirectX::XMMATRIX spaceToView = xr::math::LoadInvertedXrPose(viewProjections[k].Pose);
-                const DirectX::XMMATRIX projectionMatrix = ComposeProjectionMatrix(viewProjections[k].Fov, viewProjections[k].NearFar);
+                const xr::math::Matrix spaceToView = xr::math::LoadInvertedXrPose(viewProjections[k].Pose);
+                const xr::math::Matrix projectionMatrix = ComposeProjectionMatrix(viewProjections[k].Fov, viewProjections[k].NearFar);
 
                 // Set view projection matrix for each view, transpose for shader usage.
-                DirectX::XMStoreFloat4x4(&viewProjectionCBufferData.ViewProjection[k],
-                                         DirectX::XMMatrixTranspose(spaceToView * projectionMatrix));
+                xr::math::StoreFloat4x4(&viewProjectionCBufferData.ViewProjection[k],
+                                        xr::math::MatrixTranspose(spaceToView * projectionMatrix));
             }
             m_deviceContext->UpdateSubresource(m_viewProjectionCBuffer.get(), 0, nullptr, &viewProjectionCBufferData, 0, 0);
 
-            // Set cube primitive data.
-            const UINT strides[] = {sizeof(CubeShader::Vertex)};
-            const UINT offsets[] = {0};
-            ID3D11Buffer* vertexBuffers[] = {m_cubeVertexBuffer.get()};
-            m_deviceContext->IASetVertexBuffers(0, (UINT)std::size(vertexBuffers), vertexBuffers, strides, offsets);
-            m_deviceContext->IASetIndexBuffer(m_cubeIndexBuffer.get(), DXGI_FORMAT_R16_UINT, 0);
-            m_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-            m_deviceContext->IASetInputLayout(m_inputLayout.get());
+            // Queue the draws by shaders and mesh to bind each buffer once, and front to back within a mesh so that the reversed-Z
+            // depth test rejects hidden fragments early.
+            const bool batchedDraw = m_batchedDraw && viewInstanceCount == CubeShader::MaxViewInstance;
+            m_queue.Clear();
+            m_queue.Push(cubes, 0, batchedDraw ? 1 : 0, sample::CenterOfViews(viewProjections));
+            m_queue.Sort();
+            m_queue.Gather(cubes);
+            const xr::math::TransformArrays& transforms = m_queue.Transforms();
+
+            if (batchedDraw && cubes.Size() > 0) {
+                ReserveModelsBuffer((uint32_t)cubes.Size());
+                ID3D11ShaderResourceView* const shaderResources[] = {m_modelsBufferView.get()};
+                m_deviceContext->VSSetShaderResources(0, (UINT)std::size(shaderResources), shaderResources);
+                m_deviceContext->VSSetShader(m_batchedVertexShader.get(), nullptr, 0);
+            }
+
+            for (const sample::RenderQueue::Batch& batch : m_queue.Batches()) {
+                // Set the mesh primitive data once for all its cubes.
+                const MeshBuffers& buffers = GetMeshBuffers(meshes, batch.Mesh);
+                const UINT strides[] = {buffers.Stride};
+                const UINT offsets[] = {0};
+                ID3D11Buffer* vertexBuffers[] = {buffers.Vertices.get()};
+                m_deviceContext->IASetVertexBuffers(0, (UINT)std::size(vertexBuffers), vertexBuffers, strides, offsets);
+                m_deviceContext->IASetIndexBuffer(buffers.Indices.get(), buffers.IndexFormat, 0);
+                m_deviceContext->IASetInputLayout(buffers.InputLayout.get());
+
+                if (batchedDraw) {
+                    // Upload the model transforms of the mesh, transpose for shader usage. The shader indexes them from the first
+                    // instance, as SV_InstanceID does not include the start instance location.
+                    D3D11_MAPPED_SUBRESOURCE mapped;
+                    CHECK_HRCMD(m_deviceContext->Map(m_modelsBuffer.get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped));
+                    xr::math::Float4x4* models = reinterpret_cast<xr::math::Float4x4*>(mapped.pData);
+                    xr::math::PosesToTransposedMatrices(transforms, batch.First, batch.Count, models);
+                    m_deviceContext->Unmap(m_modelsBuffer.get(), 0);
+
+                    // Draw all cubes of the mesh for all views with one call.
+                    m_deviceContext->DrawIndexedInstanced(buffers.IndexCount, batch.Count * viewInstanceCount, 0, 0, 0);
+                    continue;
+                }
+
+                // Render each cube
+                for (uint32_t i = batch.First; i < batch.First + batch.Count; i++) {
+                    // Compute and update the model transform for each cube, transpose for shader usage.
+                    CubeShader::ModelConstantBuffer model;
+                    xr::math::PosesToTransposedMatrices(transforms, i, 1, &model.Model);
+                    m_deviceContext->UpdateSubresource(m_modelCBuffer.get(), 0, nullptr, &model, 0, 0);
+
+                    // Draw the cube.
+                    m_deviceContext->DrawIndexedInstanced(buffers.IndexCount, viewInstanceCount, 0, 0, 0);
+                }
+            }
+#endif
+        }
+
+        void CacheSwapchainImageViews(int64_t colorSwapchainFormat,
+                                      const std::vector<sample::SwapchainImage>& colorTextures,
+                                      int64_t depthSwapchainFormat,
+                                      const std::vector<sample::SwapchainImage>& depthTextures) override {
+#ifdef USE_BGFX
+            for (sample::SwapchainImage colorTexture : colorTextures) {
+                m_colorTextures.push_back(CreateSwapchainTexture(colorSwapchainFormat, static_cast<ID3D11Texture2D*>(colorTexture)));
+            }
+            for (sample::SwapchainImage depthTexture : depthTextures) {
+                m_depthTextures.push_back(CreateSwapchainTexture(depthSwapchainFormat, static_cast<ID3D11Texture2D*>(depthTexture)));
+            }
 
-            // Render each cube
-            for (const sample::Cube* cube : cubes) {
-                // Compute and update the model transform for each cube, transpose for shader usage.
-                CubeShader::ModelConstantBuffer model;
-                const DirectX::XMMATRIX scaleMatrix = DirectX::XMMatrixScaling(cube->Scale.x, cube->Scale.y, cube->Scale.z);
-                DirectX::XMStoreFloat4x4(&model.Model, DirectX::XMMatrixTranspose(scaleMatrix * xr::math::LoadXrPose(cube->PoseInScene)));
-                m_deviceContext->UpdateSubresource(m_modelCBuffer.get(), 0, nullptr, &model, 0, 0);
+            // The internal texture of a bgfx texture exists once a frame has processed its creation.
+            bgfx::frame();
+            for (size_t i = 0; i < colorTextures.size(); i++) {
+                bgfx::overrideInternal(m_colorTextures[i], reinterpret_cast<uintptr_t>(colorTextures[i]));
+            }
+            for (size_t i = 0; i < depthTextures.size(); i++) {
+                bgfx::overrideInternal(m_depthTextures[i], reinterpret_cast<uintptr_t>(depthTextures[i]));
+            }
+
+            // The runtime hands out the images of both swapchains in the same order, so the pairs of the same index are the ones used.
+            m_frameBuffers.assign(m_colorTextures.size() * m_depthTextures.size(), BGFX_INVALID_HANDLE);
+            for (uint32_t i = 0; i < (uint32_t)std::min(m_colorTextures.size(), m_depthTextures.size()); i++) {
+                GetFrameBuffer(i, i);
+            }
+#else
+            for (sample::SwapchainImage colorTexture : colorTextures) {
+                // Create RenderTargetView with the original swapchain format (swapchain image is typeless).
+                const CD3D11_RENDER_TARGET_VIEW_DESC renderTargetViewDesc(D3D11_RTV_DIMENSION_TEXTURE2DARRAY, (DXGI_FORMAT)colorSwapchainFormat);
+                CHECK_HRCMD(m_device->CreateRenderTargetView(
+                    static_cast<ID3D11Texture2D*>(colorTexture), &renderTargetViewDesc, m_renderTargetViews.emplace_back().put()));
+                m_createdViewCount++;
+            }
+            for (sample::SwapchainImage depthTexture : depthTextures) {
+                // Create a DepthStencilView with the original swapchain format (swapchain image is typeless)
+                const CD3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc(D3D11_DSV_DIMENSION_TEXTURE2DARRAY, (DXGI_FORMAT)depthSwapchainFormat);
+                CHECK_HRCMD(m_device->CreateDepthStencilView(
+                    static_cast<ID3D11Texture2D*>(depthTexture), &depthStencilViewDesc, m_depthStencilViews.emplace_back().put()));
+                m_createdViewCount++;
+            }
+#endif
+        }
 
-                // Draw the cube.
-                m_deviceContext->DrawIndexedInstanced((UINT)std::size(CubeShader::c_cubeIndices), viewInstanceCount, 0, 0, 0);
+        void ClearSwapchainImageViews() override {
+#ifdef USE_BGFX
+            // The swapchain images stay owned by the runtime, bgfx does not release the textures it did not create.
+            for (bgfx::FrameBufferHandle frameBuffer : m_frameBuffers) {
+                if (bgfx::isValid(frameBuffer)) {
+                    bgfx::destroy(frameBuffer);
+                }
+            }
+            for (bgfx::TextureHandle texture : m_colorTextures) {
+                bgfx::destroy(texture);
             }
+            for (bgfx::TextureHandle texture : m_depthTextures) {
+                bgfx::destroy(texture);
+            }
+            m_frameBuffers.clear();
+            m_colorTextures.clear();
+            m_depthTextures.clear();
+#else
+            m_renderTargetViews.clear();
+            m_depthStencilViews.clear();
 #endif
         }
 
+        uint64_t CreatedViewCount() const override {
+            return m_createdViewCount;
+        }
+
     private:
+#ifdef USE_BGFX
+        using MeshBuffers = sample::BgfxMeshBuffers;
+
+        // Buffers are created when a mesh is first drawn. bgfx reads the data when the next frame creates them, after RenderView
+        // returned, so it reads a copy instead of memory owned by the program.
+        const MeshBuffers& GetMeshBuffers(const sample::MeshRegistry& meshes, sample::MeshId id) {
+            if (id >= m_meshBuffers.size()) {
+                m_meshBuffers.resize(meshes.Size());
+            }
+            MeshBuffers& buffers = m_meshBuffers[id];
+            if (bgfx::isValid(buffers.Vertices)) {
+                return buffers;
+            }
+
+            const sample::Mesh& mesh = meshes.Get(id);
+            buffers.Layout.begin();
+            for (const sample::VertexElement& element : mesh.Layout) {
+                buffers.Layout.add(ToBgfxAttrib(element.Attribute), element.Count, ToBgfxAttribType(element.Type), element.Normalized != 0);
+            }
+            buffers.Layout.end();
+            CHECK(buffers.Layout.getStride() == mesh.VertexStride);
+
+            const bool indices32 = mesh.IndexType == sample::IndexFormat::Uint32;
+            buffers.Vertices = bgfx::createVertexBuffer(bgfx::copy(mesh.Vertices, mesh.VertexStride * mesh.VertexCount), buffers.Layout);
+            buffers.Indices = bgfx::createIndexBuffer(bgfx::copy(mesh.Indices, mesh.IndexCount * (indices32 ? 4 : 2)),
+                                                      indices32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
+            return buffers;
+        }
+
+        // Shaders are cached by content, so a program is created once even if its shaders are requested again.
+        bgfx::ShaderHandle GetShader(const sample::AssetArchive& archive, const char* name) {
+            const sample::ArchiveEntry* const shader = archive.Find(name);
+            if (shader == nullptr || shader->Type != sample::ArchiveEntryType::Shader) {
+                DEBUG_PRINT("Shader %s not found", name);
+                return BGFX_INVALID_HANDLE;
+            }
+
+            const auto it = m_shaders.find(shader->ContentHash);
+            if (it != m_shaders.end()) {
+                return it->second;
+            }
+
+            // The archive stays mapped as long as the plugin, so bgfx can read the shader in place.
+            const bgfx::ShaderHandle handle = bgfx::createShader(bgfx::makeRef(archive.Data(*shader), (uint32_t)shader->Size));
+            bgfx::setName(handle, name);
+            m_shaders.emplace(shader->ContentHash, handle);
+            return handle;
+        }
+
+        bgfx::ProgramHandle GetProgram(const sample::AssetArchive& archive, const char* vertexShaderName, const char* fragmentShaderName) {
+            const bgfx::ShaderHandle vertexShader = GetShader(archive, vertexShaderName);
+            const bgfx::ShaderHandle fragmentShader = GetShader(archive, fragmentShaderName);
+            if (!bgfx::isValid(vertexShader) || !bgfx::isValid(fragmentShader)) {
+                return BGFX_INVALID_HANDLE;
+            }
+
+            const std::pair<uint16_t, uint16_t> key{vertexShader.idx, fragmentShader.idx};
+            const auto it = m_programs.find(key);
+            if (it != m_programs.end()) {
+                return it->second;
+            }
+
+            // The cached shaders outlive the program.
+            const bgfx::ProgramHandle program = bgfx::createProgram(vertexShader, fragmentShader, false);
+            m_programs.emplace(key, program);
+            return program;
+        }
+
+        // Destroy everything created on the device, before moving to another adapter.
+        void ShutdownBgfx() {
+            if (!m_device) {
+                return;
+            }
+
+            for (const auto& [key, program] : m_programs) {
+                bgfx::destroy(program);
+            }
+            m_programs.clear();
+            for (const auto& [hash, shader] : m_shaders) {
+                bgfx::destroy(shader);
+            }
+            m_shaders.clear();
+            m_program = m_batchedProgram = m_visibilityMaskProgram = BGFX_INVALID_HANDLE;
+
+            DestroyVisibilityMaskBuffers();
+            bgfx::destroy(m_visibilityMaskDepthUniform);
+            for (const MeshBuffers& buffers : m_meshBuffers) {
+                if (bgfx::isValid(buffers.Vertices)) {
+                    bgfx::destroy(buffers.Vertices);
+                    bgfx::destroy(buffers.Indices);
+                }
+            }
+            m_meshBuffers.clear();
+            bgfx::destroy(m_viewProjectionCBuffer);
+            bgfx::shutdown();
+
+            m_deviceContext = nullptr;
+            m_device = nullptr;
+        }
+
+        // The mask only changes when the runtime sends a new one, its buffers are recreated then.
+        void UpdateVisibilityMaskBuffers(const sample::VisibilityMask& visibilityMask) {
+            if (bgfx::isValid(m_visibilityMaskVertices) && visibilityMask.Version() == m_visibilityMaskVersion) {
+                return;
+            }
+
+            DestroyVisibilityMaskBuffers();
+            const std::vector<XrVector3f>& vertices = visibilityMask.Vertices();
+            const std::vector<uint32_t>& indices = visibilityMask.Indices();
+            m_visibilityMaskVertices =
+                bgfx::createVertexBuffer(bgfx::copy(vertices.data(), (uint32_t)(vertices.size() * sizeof(XrVector3f))), m_visibilityMaskLayout);
+            m_visibilityMaskIndices =
+                bgfx::createIndexBuffer(bgfx::copy(indices.data(), (uint32_t)(indices.size() * sizeof(uint32_t))), BGFX_BUFFER_INDEX32);
+            m_visibilityMaskVersion = visibilityMask.Version();
+        }
+
+        void DestroyVisibilityMaskBuffers() {
+            if (bgfx::isValid(m_visibilityMaskVertices)) {
+                bgfx::destroy(m_visibilityMaskVertices);
+                bgfx::destroy(m_visibilityMaskIndices);
+                m_visibilityMaskVertices = BGFX_INVALID_HANDLE;
+                m_visibilityMaskIndices = BGFX_INVALID_HANDLE;
+            }
+        }
+#else
+        struct MeshBuffers {
+            winrt::com_ptr<ID3D11Buffer> Vertices;
+            winrt::com_ptr<ID3D11Buffer> Indices;
+            winrt::com_ptr<ID3D11InputLayout> InputLayout;
+            UINT Stride{0};
+            UINT IndexCount{0};
+            DXGI_FORMAT IndexFormat{DXGI_FORMAT_R16_UINT};
+        };
+
+        // Buffers and input layout are created when a mesh is first drawn.
+        const MeshBuffers& GetMeshBuffers(const sample::MeshRegistry& meshes, sample::MeshId id) {
+            if (id >= m_meshBuffers.size()) {
+                m_meshBuffers.resize(meshes.Size());
+            }
+            MeshBuffers& buffers = m_meshBuffers[id];
+            if (buffers.Vertices) {
+                return buffers;
+            }
+
+            const sample::Mesh& mesh = meshes.Get(id);
+            std::vector<D3D11_INPUT_ELEMENT_DESC> vertexDesc;
+            for (const sample::VertexElement& element : mesh.Layout) {
+                vertexDesc.push_back({ToSemanticName(element.Attribute),
+                                      0,
+                                      ToDxgiFormat(element),
+                                      0,
+                                      D3D11_APPEND_ALIGNED_ELEMENT,
+                                      D3D11_INPUT_PER_VERTEX_DATA,
+                                      0});
+            }
+            CHECK_HRCMD(m_device->CreateInputLayout(vertexDesc.data(),
+                                                    (UINT)vertexDesc.size(),
+                                                    m_vertexShaderBytes->GetBufferPointer(),
+                                                    m_vertexShaderBytes->GetBufferSize(),
+                                                    buffers.InputLayout.put()));
+
+            const bool indices32 = mesh.IndexType == sample::IndexFormat::Uint32;
+            const D3D11_SUBRESOURCE_DATA vertexBufferData{mesh.Vertices};
+            const CD3D11_BUFFER_DESC vertexBufferDesc(mesh.VertexStride * mesh.VertexCount, D3D11_BIND_VERTEX_BUFFER);
+            CHECK_HRCMD(m_device->CreateBuffer(&vertexBufferDesc, &vertexBufferData, buffers.Vertices.put()));
+
+            const D3D11_SUBRESOURCE_DATA indexBufferData{mesh.Indices};
+            const CD3D11_BUFFER_DESC indexBufferDesc(mesh.IndexCount * (indices32 ? 4 : 2), D3D11_BIND_INDEX_BUFFER);
+            CHECK_HRCMD(m_device->CreateBuffer(&indexBufferDesc, &indexBufferData, buffers.Indices.put()));
+
+            buffers.Stride = mesh.VertexStride;
+            buffers.IndexCount = mesh.IndexCount;
+            buffers.IndexFormat = indices32 ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+            return buffers;
+        }
+
+        // Grow the structured buffer holding the model transforms of the batched draw.
+        void ReserveModelsBuffer(uint32_t cubeCount) {
+            if (cubeCount <= m_modelsBufferCapacity) {
+                return;
+            }
+
+            uint32_t capacity = std::max<uint32_t>(m_modelsBufferCapacity, 64);
+            while (capacity < cubeCount) {
+                capacity *= 2;
+            }
+
+            m_modelsBufferView = nullptr;
+            m_modelsBuffer = nullptr;
+
+            CD3D11_BUFFER_DESC modelsBufferDesc(capacity * sizeof(xr::math::Float4x4),
+                                                D3D11_BIND_SHADER_RESOURCE,
+                                                D3D11_USAGE_DYNAMIC,
+                                                D3D11_CPU_ACCESS_WRITE,
+                                                D3D11_RESOURCE_MISC_BUFFER_STRUCTURED,
+                                                sizeof(xr::math::Float4x4));
+            CHECK_HRCMD(m_device->CreateBuffer(&modelsBufferDesc, nullptr, m_modelsBuffer.put()));
+
+            const CD3D11_SHADER_RESOURCE_VIEW_DESC modelsViewDesc(
+                m_modelsBuffer.get(), DXGI_FORMAT_UNKNOWN, 0, capacity);
+            CHECK_HRCMD(m_device->CreateShaderResourceView(m_modelsBuffer.get(), &modelsViewDesc, m_modelsBufferView.put()));
+
+            m_modelsBufferCapacity = capacity;
+        }
+
+        // The mask only changes when the runtime sends a new one, its buffers are recreated then.
+        void UpdateVisibilityMaskBuffers(const sample::VisibilityMask& visibilityMask) {
+            if (m_visibilityMaskVertices && visibilityMask.Version() == m_visibilityMaskVersion) {
+                return;
+            }
+
+            const std::vector<XrVector3f>& vertices = visibilityMask.Vertices();
+            const std::vector<uint32_t>& indices = visibilityMask.Indices();
+            m_visibilityMaskVertices = nullptr;
+            m_visibilityMaskIndices = nullptr;
+
+            const D3D11_SUBRESOURCE_DATA vertexBufferData{vertices.data()};
+            const CD3D11_BUFFER_DESC vertexBufferDesc((UINT)(vertices.size() * sizeof(XrVector3f)), D3D11_BIND_VERTEX_BUFFER);
+            CHECK_HRCMD(m_device->CreateBuffer(&vertexBufferDesc, &vertexBufferData, m_visibilityMaskVertices.put()));
+
+            const D3D11_SUBRESOURCE_DATA indexBufferData{indices.data()};
+            const CD3D11_BUFFER_DESC indexBufferDesc((UINT)(indices.size() * sizeof(uint32_t)), D3D11_BIND_INDEX_BUFFER);
+            CHECK_HRCMD(m_device->CreateBuffer(&indexBufferDesc, &indexBufferData, m_visibilityMaskIndices.put()));
+
+            m_visibilityMaskVersion = visibilityMask.Version();
+        }
+#endif
+
+#ifdef USE_BGFX
+        // Wraps a swapchain image in a bgfx texture, whose internal texture is replaced by the image once bgfx created it.
+        bgfx::TextureHandle CreateSwapchainTexture(int64_t swapchainFormat, ID3D11Texture2D* texture) {
+            D3D11_TEXTURE2D_DESC desc;
+            texture->GetDesc(&desc);
+            m_swapchainArraySize = (uint16_t)desc.ArraySize;
+
+            const DXGI_FORMAT format = (DXGI_FORMAT)swapchainFormat;
+            const bool srgb = format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+            return bgfx::createTexture2D((uint16_t)desc.Width,
+                                         (uint16_t)desc.Height,
+                                         false,
+                                         (uint16_t)desc.ArraySize,
+                                         ToBgfxTextureFormat(swapchainFormat),
+                                         BGFX_TEXTURE_RT | (srgb ? BGFX_TEXTURE_SRGB : 0));
+        }
+
+        // Frame buffers are keyed by the pair of color and depth image indices. A lookup miss only happens if the runtime
+        // hands out the images of the two swapchains in different orders.
+        bgfx::FrameBufferHandle GetFrameBuffer(uint32_t colorImageIndex, uint32_t depthImageIndex) {
+            CHECK(colorImageIndex < m_colorTextures.size() && depthImageIndex < m_depthTextures.size());
+            bgfx::FrameBufferHandle& frameBuffer = m_frameBuffers[colorImageIndex * m_depthTextures.size() + depthImageIndex];
+            if (!bgfx::isValid(frameBuffer)) {
+                // Attach all the layers, the shaders select the layer of each view.
+                bgfx::Attachment attachments[2];
+                attachments[0].init(m_colorTextures[colorImageIndex], bgfx::Access::Write, 0, m_swapchainArraySize);
+                attachments[1].init(m_depthTextures[depthImageIndex], bgfx::Access::Write, 0, m_swapchainArraySize);
+                frameBuffer = bgfx::createFrameBuffer((uint8_t)std::size(attachments), attachments, false);
+                m_createdViewCount += std::size(attachments); // bgfx creates a view per attachment.
+            }
+            return frameBuffer;
+        }
+
+        std::vector<bgfx::TextureHandle> m_colorTextures;  // Indexed by swapchain image index.
+        std::vector<bgfx::TextureHandle> m_depthTextures;  // Indexed by swapchain image index.
+        std::vector<bgfx::FrameBufferHandle> m_frameBuffers;
+        uint16_t m_swapchainArraySize{1};
+#else
+        std::vector<winrt::com_ptr<ID3D11RenderTargetView>> m_renderTargetViews; // Indexed by swapchain image index.
+        std::vector<winrt::com_ptr<ID3D11DepthStencilView>> m_depthStencilViews; // Indexed by swapchain image index.
+#endif
+        uint64_t m_createdViewCount{0};
+
+        XrGraphicsBindingD3D11KHR m_graphicsBinding{XR_TYPE_GRAPHICS_BINDING_D3D11_KHR};
+        LUID m_adapterLuid{};
+
+        // Draw all cubes with one instanced draw call when the device supports it.
+        bool m_batchedDraw{true};
+
+        sample::RenderQueue m_queue;
+        std::vector<MeshBuffers> m_meshBuffers; // Indexed by MeshId.
+
 #ifdef USE_BGFX
         winrt::com_ptr<ID3D11Device> m_device;
         winrt::com_ptr<ID3D11DeviceContext> m_deviceContext;
 
-        bgfx::VertexLayout m_inputLayout;
-        bgfx::VertexBufferHandle m_cubeVertexBuffer;
-        bgfx::IndexBufferHandle m_cubeIndexBuffer;
-        bgfx::ProgramHandle m_program;
+        bgfx::ProgramHandle m_program = BGFX_INVALID_HANDLE;
+        bgfx::ProgramHandle m_batchedProgram = BGFX_INVALID_HANDLE;
+        std::unordered_map<uint64_t, bgfx::ShaderHandle> m_shaders;
+        std::map<std::pair<uint16_t, uint16_t>, bgfx::ProgramHandle> m_programs;
+
+        sample::AssetLoader m_assetLoader;
+        std::shared_future<sample::AssetPtr> m_archiveAsset;
+        std::optional<sample::AssetArchive> m_archive;
         uint64_t m_reversedZDepthNoStencilTest;
         bgfx::UniformHandle m_viewProjectionCBuffer;
+        std::optional<sample::BgfxDrawSubmitter> m_drawSubmitter;
+        std::vector<const MeshBuffers*> m_batchBuffers; // Indexed by render queue batch.
+
+        bgfx::ProgramHandle m_visibilityMaskProgram = BGFX_INVALID_HANDLE;
+        bgfx::UniformHandle m_visibilityMaskDepthUniform = BGFX_INVALID_HANDLE;
+        bgfx::VertexLayout m_visibilityMaskLayout;
+        bgfx::VertexBufferHandle m_visibilityMaskVertices = BGFX_INVALID_HANDLE;
+        bgfx::IndexBufferHandle m_visibilityMaskIndices = BGFX_INVALID_HANDLE;
+        uint64_t m_visibilityMaskVersion{0};
 #else
         winrt::com_ptr<ID3D11Device> m_device;
         winrt::com_ptr<ID3D11DeviceContext> m_deviceContext;
+        winrt::com_ptr<ID3DBlob> m_vertexShaderBytes; // Mesh input layouts are validated against its input signature.
         winrt::com_ptr<ID3D11VertexShader> m_vertexShader;
+        winrt::com_ptr<ID3D11VertexShader> m_batchedVertexShader;
         winrt::com_ptr<ID3D11PixelShader> m_pixelShader;
-        winrt::com_ptr<ID3D11InputLayout> m_inputLayout;
         winrt::com_ptr<ID3D11Buffer> m_modelCBuffer;
         winrt::com_ptr<ID3D11Buffer> m_viewProjectionCBuffer;
-        winrt::com_ptr<ID3D11Buffer> m_cubeVertexBuffer;
-        winrt::com_ptr<ID3D11Buffer> m_cubeIndexBuffer;
         winrt::com_ptr<ID3D11DepthStencilState> m_reversedZDepthNoStencilTest;
+        winrt::com_ptr<ID3D11Buffer> m_modelsBuffer;
+        winrt::com_ptr<ID3D11ShaderResourceView> m_modelsBufferView;
+        uint32_t m_modelsBufferCapacity{0};
+
+        winrt::com_ptr<ID3D11VertexShader> m_visibilityMaskVertexShader;
+        winrt::com_ptr<ID3D11InputLayout> m_visibilityMaskInputLayout;
+        winrt::com_ptr<ID3D11Buffer> m_visibilityMaskCBuffer;
+        winrt::com_ptr<ID3D11DepthStencilState> m_visibilityMaskDepthState;
+        winrt::com_ptr<ID3D11RasterizerState> m_noCullRasterizerState;
+        winrt::com_ptr<ID3D11Buffer> m_visibilityMaskVertices;
+        winrt::com_ptr<ID3D11Buffer> m_visibilityMaskIndices;
+        uint64_t m_visibilityMaskVersion{0};
 #endif
     };
 } // namespace
 
 namespace sample {
-    std::unique_ptr<sample::IGraphicsPluginD3D11> CreateCubeGraphics() {
+    std::unique_ptr<sample::IGraphicsPlugin> CreateCubeGraphics() {
         return std::make_unique<CubeGraphics>();
     }
 } // namespace sample
@@ -0,0 +1,69 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "DynamicResolution.h"
+
+namespace sample {
+    DynamicResolutionController::DynamicResolutionController(const DynamicResolutionSettings& settings)
+        : m_settings(settings)
+        , m_scale(settings.MaxScale) {
+        CHECK(settings.MinScale > 0 && settings.MinScale <= settings.MaxScale);
+        CHECK(settings.LowerBudget > 0 && settings.LowerBudget < settings.UpperBudget);
+        CHECK(settings.IncreaseStep > 0);
+    }
+
+    float DynamicResolutionController::Update(XrDuration renderDuration, XrDuration displayPeriod, uint32_t missedDisplayPeriods) {
+        if (displayPeriod <= 0) {
+            return m_scale;
+        }
+
+        // A missed display period means the frame took at least a full period, whatever the measured render time.
+        float load = (float)renderDuration / (float)displayPeriod;
+        if (missedDisplayPeriods > 0) {
+            load = std::max(load, 1.0f + missedDisplayPeriods);
+        }
+
+        if (load > m_settings.UpperBudget) {
+            // Drop at once to the scale whose cost is in the middle of the budget band.
+            const float targetLoad = (m_settings.LowerBudget + m_settings.UpperBudget) / 2;
+            m_scale = std::max(m_settings.MinScale, m_scale * std::sqrt(targetLoad / load));
+            m_framesUnderBudget = 0;
+        } else if (load < m_settings.LowerBudget) {
+            if (++m_framesUnderBudget >= m_settings.IncreaseDelayFrames) {
+                // Only grow if the cost at the larger scale stays under the upper budget, otherwise the next frame would drop back.
+                const float scale = std::min(m_settings.MaxScale, m_scale + m_settings.IncreaseStep);
+                const float ratio = scale / m_scale;
+                if (load * ratio * ratio <= m_settings.UpperBudget) {
+                    m_scale = scale;
+                }
+                m_framesUnderBudget = 0;
+            }
+        } else {
+            m_framesUnderBudget = 0;
+        }
+        return m_scale;
+    }
+
+    void DynamicResolutionController::Reset() {
+        m_scale = m_settings.MaxScale;
+        m_framesUnderBudget = 0;
+    }
+
+    XrExtent2Di ScaleExtent(const XrExtent2Di& extent, float scale, const XrExtent2Di& maxExtent) {
+        return {std::clamp((int32_t)std::lround(extent.width * scale), 1, std::max(maxExtent.width, 1)),
+                std::clamp((int32_t)std::lround(extent.height * scale), 1, std::max(maxExtent.height, 1))};
+    }
+} // namespace sample
@@ -0,0 +1,64 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+namespace sample {
+    struct DynamicResolutionSettings {
+        // Bounds of the scale applied to the recommended image size. The swapchains are created for MaxScale.
+        float MinScale{0.5f};
+        float MaxScale{1.0f};
+
+        // Render time thresholds, in fractions of the display period. Above UpperBudget the scale drops right away, it only grows
+        // back after IncreaseDelayFrames frames in a row under LowerBudget. Between the two the scale is kept.
+        float LowerBudget{0.7f};
+        float UpperBudget{0.9f};
+        uint32_t IncreaseDelayFrames{60};
+
+        // Increment of the scale when it grows, so that it recovers over several steps.
+        float IncreaseStep{0.05f};
+    };
+
+    // Picks the resolution scale of the next frames from the render time of the previous ones.
+    // The render cost is assumed proportional to the number of pixels, so to the square of the scale. The controller does not
+    // read any clock, so it can be fed with synthetic timings.
+    class DynamicResolutionController {
+    public:
+        explicit DynamicResolutionController(const DynamicResolutionSettings& settings = {});
+
+        // Feeds the render time of a frame, with its display period and the number of display periods missed before it.
+        // Returns the scale to render the next frame with.
+        float Update(XrDuration renderDuration, XrDuration displayPeriod, uint32_t missedDisplayPeriods);
+
+        float Scale() const {
+            return m_scale;
+        }
+
+        const DynamicResolutionSettings& Settings() const {
+            return m_settings;
+        }
+
+        // Back to the maximum scale, e.g. when the swapchains are recreated.
+        void Reset();
+
+    private:
+        const DynamicResolutionSettings m_settings;
+        float m_scale;
+        uint32_t m_framesUnderBudget{0};
+    };
+
+    // Rounded extent scaled by scale, between one pixel and maxExtent in each dimension.
+    XrExtent2Di ScaleExtent(const XrExtent2Di& extent, float scale, const XrExtent2Di& maxExtent);
+} // namespace sample
@@ -0,0 +1,83 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "FrameArena.h"
+
+namespace {
+    constexpr size_t BufferAlignment = alignof(std::max_align_t);
+} // namespace
+
+namespace sample {
+    FrameArena::FrameArena(size_t capacity, std::pmr::memory_resource* upstream)
+        : m_upstream(upstream) {
+        CHECK(m_upstream != nullptr);
+        if (capacity > 0) {
+            m_buffer = static_cast<std::byte*>(m_upstream->allocate(capacity, BufferAlignment));
+            m_capacity = capacity;
+        }
+    }
+
+    FrameArena::~FrameArena() {
+        ReleaseOverflow();
+        if (m_buffer != nullptr) {
+            m_upstream->deallocate(m_buffer, m_capacity, BufferAlignment);
+        }
+    }
+
+    void FrameArena::Reset() {
+        if (m_overflowBytes > 0) {
+            // Grow to the high water mark of the frame, with room for alignment padding of the overflowed allocations.
+            const size_t capacity = m_capacity + m_overflowBytes + m_overflowBlocks.size() * BufferAlignment;
+            ReleaseOverflow();
+
+            if (m_buffer != nullptr) {
+                m_upstream->deallocate(m_buffer, m_capacity, BufferAlignment);
+            }
+            m_buffer = static_cast<std::byte*>(m_upstream->allocate(capacity, BufferAlignment));
+            m_capacity = capacity;
+        }
+        m_offset = 0;
+    }
+
+    void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+        const size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+        if (alignment <= BufferAlignment && offset + bytes <= m_capacity) {
+            m_offset = offset + bytes;
+            return m_buffer + offset;
+        }
+
+        void* const pointer = m_upstream->allocate(bytes, alignment);
+        m_overflowBlocks.push_back({pointer, bytes, alignment});
+        m_overflowBytes += bytes;
+        return pointer;
+    }
+
+    void FrameArena::do_deallocate(void*, size_t, size_t) {
+        // Memory is reclaimed by Reset().
+    }
+
+    bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    void FrameArena::ReleaseOverflow() {
+        for (const OverflowBlock& block : m_overflowBlocks) {
+            m_upstream->deallocate(block.Pointer, block.Bytes, block.Alignment);
+        }
+        m_overflowBlocks.clear();
+        m_overflowBytes = 0;
+    }
+} // namespace sample
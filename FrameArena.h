@@ -0,0 +1,63 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+namespace sample {
+    // Linear allocator for the transient containers of a frame, used through std::pmr containers.
+    // Allocations bump an offset in a single buffer and deallocations do nothing, Reset() frees everything at once.
+    // When a frame needs more than the capacity, the excess comes from the upstream resource until the next Reset(),
+    // which grows the buffer to the high water mark so that the following frames do not allocate again.
+    class FrameArena : public std::pmr::memory_resource {
+    public:
+        explicit FrameArena(size_t capacity = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+        ~FrameArena() override;
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // All memory allocated since the last reset must no longer be in use.
+        void Reset();
+
+        size_t Capacity() const {
+            return m_capacity;
+        }
+
+        // Bytes allocated since the last reset, including the ones that did not fit in the buffer.
+        size_t Used() const {
+            return m_offset + m_overflowBytes;
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+        struct OverflowBlock {
+            void* Pointer;
+            size_t Bytes;
+            size_t Alignment;
+        };
+
+        void ReleaseOverflow();
+
+        std::pmr::memory_resource* const m_upstream;
+        std::byte* m_buffer{nullptr};
+        size_t m_capacity{0};
+        size_t m_offset{0};
+        size_t m_overflowBytes{0};
+        std::vector<OverflowBlock> m_overflowBlocks;
+    };
+} // namespace sample
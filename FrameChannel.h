@@ -0,0 +1,75 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace sample {
+    // Bounded blocking queue handing values from one stage of the frame pipeline to the next.
+    // Once closed, Push() fails and Pop() fails after the remaining values are drained. Values are stored in a ring allocated once.
+    template <typename T>
+    class FrameChannel {
+    public:
+        explicit FrameChannel(size_t capacity)
+            : m_values(capacity) {
+        }
+
+        // Blocks while the channel is full.
+        bool Push(T value) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notFull.wait(lock, [&] { return m_closed || m_size < m_values.size(); });
+            if (m_closed) {
+                return false;
+            }
+            m_values[(m_front + m_size) % m_values.size()] = std::move(value);
+            m_size++;
+            m_notEmpty.notify_one();
+            return true;
+        }
+
+        // Blocks while the channel is empty.
+        bool Pop(T& value) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_notEmpty.wait(lock, [&] { return m_closed || m_size > 0; });
+            if (m_size == 0) {
+                return false;
+            }
+            value = std::move(m_values[m_front]);
+            m_front = (m_front + 1) % m_values.size();
+            m_size--;
+            m_notFull.notify_one();
+            return true;
+        }
+
+        void Close() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            m_notFull.notify_all();
+            m_notEmpty.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_notFull;
+        std::condition_variable m_notEmpty;
+        std::vector<T> m_values;
+        size_t m_front{0};
+        size_t m_size{0};
+        bool m_closed{false};
+    };
+} // namespace sample
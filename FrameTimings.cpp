@@ -0,0 +1,222 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "FrameTimings.h"
+
+#include <iomanip>
+#include <ostream>
+
+namespace {
+    double ToMicroseconds(int64_t nanoseconds) {
+        return nanoseconds / 1000.0;
+    }
+
+    double StageDurationUs(const sample::FrameTiming& timing, sample::FrameStage stage) {
+        return ToMicroseconds(timing[stage].End - timing[stage].Start);
+    }
+
+    // From the start of the first stage to the end of the last one that ran.
+    sample::FrameTiming::Interval FrameInterval(const sample::FrameTiming& timing) {
+        sample::FrameTiming::Interval frame{};
+        for (const sample::FrameTiming::Interval& interval : timing.Stages) {
+            if (interval.End == 0) {
+                continue;
+            }
+            frame.Start = frame.Start == 0 ? interval.Start : std::min(frame.Start, interval.Start);
+            frame.End = std::max(frame.End, interval.End);
+        }
+        return frame;
+    }
+} // namespace
+
+namespace sample {
+    const char* ToCString(FrameStage stage) {
+        switch (stage) {
+        case FrameStage::WaitFrame:
+            return "xrWaitFrame";
+        case FrameStage::BeginFrame:
+            return "xrBeginFrame";
+        case FrameStage::LocateViews:
+            return "xrLocateViews";
+        case FrameStage::UpdateScene:
+            return "UpdateScene";
+        case FrameStage::AcquireSwapchainImages:
+            return "AcquireSwapchainImages";
+        case FrameStage::RenderView:
+            return "RenderView";
+        case FrameStage::ReleaseSwapchainImages:
+            return "ReleaseSwapchainImages";
+        case FrameStage::EndFrame:
+            return "xrEndFrame";
+        default:
+            return "Unknown";
+        }
+    }
+
+    int64_t FrameClockNow() {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    FrameTimingRecorder::FrameTimingRecorder(uint32_t capacity) {
+        uint64_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_slots = std::make_unique<Slot[]>(size);
+        m_mask = size - 1;
+    }
+
+    void FrameTimingRecorder::Record(const FrameTiming& timing) {
+        const uint64_t index = m_head.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[index & m_mask];
+
+        slot.Sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::array<uint64_t, TimingWordCount> words{};
+        std::memcpy(words.data(), &timing, sizeof(timing));
+        for (size_t i = 0; i < TimingWordCount; i++) {
+            slot.Words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.Sequence.store(2 * index + 2, std::memory_order_release);
+
+        m_head.store(index + 1, std::memory_order_release);
+    }
+
+    std::vector<FrameTiming> FrameTimingRecorder::Snapshot() const {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t capacity = m_mask + 1;
+        const uint64_t first = head > capacity ? head - capacity : 0;
+
+        std::vector<FrameTiming> timings;
+        timings.reserve(head - first);
+        for (uint64_t index = first; index < head; index++) {
+            const Slot& slot = m_slots[index & m_mask];
+            const uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2) {
+                continue; // Already overwritten by a newer record.
+            }
+
+            std::array<uint64_t, TimingWordCount> words;
+            for (size_t i = 0; i < TimingWordCount; i++) {
+                words[i] = slot.Words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.Sequence.load(std::memory_order_relaxed) == sequence) {
+                FrameTiming& timing = timings.emplace_back();
+                std::memcpy(&timing, words.data(), sizeof(timing));
+            }
+        }
+        return timings;
+    }
+
+    uint32_t MissedDisplayPeriods(const FrameTiming& previous, const FrameTiming& current) {
+        const XrDuration period = current.PredictedDisplayPeriod;
+        const XrDuration elapsed = current.PredictedDisplayTime - previous.PredictedDisplayTime;
+        if (period <= 0 || elapsed <= period) {
+            return 0;
+        }
+        return (uint32_t)((elapsed + period / 2) / period - 1);
+    }
+
+    void WriteFrameTimingsCsv(const std::vector<FrameTiming>& timings, std::ostream& out) {
+        out << "FrameIndex,PredictedDisplayTime,PredictedDisplayPeriod,MissedDisplayPeriods,ShouldRender,HeapAllocations,ResolutionScale,FrameStart,FrameUs";
+        for (uint32_t i = 0; i < FrameStageCount; i++) {
+            out << ',' << ToCString(static_cast<FrameStage>(i)) << "Us";
+        }
+        out << '\n';
+
+        out << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < timings.size(); i++) {
+            const FrameTiming& timing = timings[i];
+            const FrameTiming::Interval frame = FrameInterval(timing);
+            const uint32_t missed = i > 0 ? MissedDisplayPeriods(timings[i - 1], timing) : 0;
+
+            out << timing.FrameIndex << ',' << timing.PredictedDisplayTime << ',' << timing.PredictedDisplayPeriod << ',' << missed
+                << ',' << (timing.ShouldRender ? 1 : 0) << ',' << timing.HeapAllocations << ',' << timing.ResolutionScale << ',' << frame.Start << ',' << ToMicroseconds(frame.End - frame.Start);
+            for (uint32_t stage = 0; stage < FrameStageCount; stage++) {
+                out << ',' << StageDurationUs(timing, static_cast<FrameStage>(stage));
+            }
+            out << '\n';
+        }
+    }
+
+    void WriteFrameTimingsChromeTrace(const std::vector<FrameTiming>& timings, std::ostream& out) {
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool firstEvent = true;
+        auto beginEvent = [&](const char* name, const char* phase, uint32_t lane, int64_t timestamp) {
+            out << (firstEvent ? "\n" : ",\n");
+            firstEvent = false;
+            out << "{\"name\":\"" << name << "\",\"cat\":\"frame\",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << lane
+                << ",\"ts\":" << ToMicroseconds(timestamp);
+        };
+
+        // Stages go to the lane of the thread running them in the pipelined frame loop, frames overlap as async spans.
+        const char* const laneNames[] = {"Frames", "Wait", "Update", "Render"};
+        for (uint32_t lane = 0; lane < std::size(laneNames); lane++) {
+            beginEvent("thread_name", "M", lane, 0);
+            out << ",\"args\":{\"name\":\"" << laneNames[lane] << "\"}}";
+        }
+        auto stageLane = [](FrameStage stage) -> uint32_t {
+            switch (stage) {
+            case FrameStage::WaitFrame:
+                return 1;
+            case FrameStage::LocateViews:
+            case FrameStage::UpdateScene:
+                return 2;
+            default:
+                return 3;
+            }
+        };
+
+        for (size_t i = 0; i < timings.size(); i++) {
+            const FrameTiming& timing = timings[i];
+            const FrameTiming::Interval frame = FrameInterval(timing);
+            if (frame.End == 0) {
+                continue;
+            }
+
+            beginEvent("Frame", "b", 0, frame.Start);
+            out << ",\"id\":" << timing.FrameIndex << ",\"args\":{\"frameIndex\":" << timing.FrameIndex
+                << ",\"predictedDisplayTime\":" << timing.PredictedDisplayTime
+                << ",\"predictedDisplayPeriod\":" << timing.PredictedDisplayPeriod
+                << ",\"shouldRender\":" << (timing.ShouldRender ? "true" : "false") << ",\"heapAllocations\":" << timing.HeapAllocations
+                << "}}";
+            beginEvent("Frame", "e", 0, frame.End);
+            out << ",\"id\":" << timing.FrameIndex << "}";
+
+            for (uint32_t stage = 0; stage < FrameStageCount; stage++) {
+                const FrameTiming::Interval& interval = timing.Stages[stage];
+                if (interval.End == 0) {
+                    continue;
+                }
+                const FrameStage frameStage = static_cast<FrameStage>(stage);
+                beginEvent(ToCString(frameStage), "X", stageLane(frameStage), interval.Start);
+                out << ",\"dur\":" << ToMicroseconds(interval.End - interval.Start) << "}";
+            }
+
+            const uint32_t missed = i > 0 ? MissedDisplayPeriods(timings[i - 1], timing) : 0;
+            if (missed > 0) {
+                beginEvent("MissedFrame", "i", 0, frame.Start);
+                out << ",\"s\":\"g\",\"args\":{\"missedDisplayPeriods\":" << missed << "}}";
+            }
+        }
+
+        out << "\n]}\n";
+    }
+} // namespace sample
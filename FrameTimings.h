@@ -0,0 +1,122 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <iosfwd>
+#include <type_traits>
+
+namespace sample {
+    // Stages of a frame, in the order RenderFrame goes through them.
+    enum class FrameStage : uint32_t {
+        WaitFrame,
+        BeginFrame,
+        LocateViews,
+        UpdateScene,
+        AcquireSwapchainImages,
+        RenderView,
+        ReleaseSwapchainImages,
+        EndFrame,
+        Count
+    };
+
+    constexpr uint32_t FrameStageCount = static_cast<uint32_t>(FrameStage::Count);
+    const char* ToCString(FrameStage stage);
+
+    // Nanoseconds of a monotonic clock, the time base of all frame timestamps.
+    int64_t FrameClockNow();
+
+    struct FrameTiming {
+        // Start and end timestamps of a stage, both zero when the stage did not run this frame.
+        struct Interval {
+            int64_t Start{0};
+            int64_t End{0};
+        };
+
+        uint64_t FrameIndex{0};
+        XrTime PredictedDisplayTime{0};
+        XrDuration PredictedDisplayPeriod{0};
+        bool ShouldRender{false};
+        uint64_t HeapAllocations{0}; // From xrWaitFrame to xrEndFrame, when the program counts them.
+        float ResolutionScale{1.0f}; // Of the rendered image size, relative to the recommended size.
+        uint32_t CreatedViews{0};    // Render target and depth stencil views created by RenderView, zero once they are cached.
+        std::array<Interval, FrameStageCount> Stages{};
+
+        Interval& operator[](FrameStage stage) {
+            return Stages[static_cast<uint32_t>(stage)];
+        }
+        const Interval& operator[](FrameStage stage) const {
+            return Stages[static_cast<uint32_t>(stage)];
+        }
+    };
+
+    // Records the duration of a stage for the lifetime of the scope.
+    class ScopedFrameStage {
+    public:
+        ScopedFrameStage(FrameTiming& timing, FrameStage stage)
+            : m_interval(timing[stage]) {
+            m_interval.Start = FrameClockNow();
+        }
+        ~ScopedFrameStage() {
+            m_interval.End = FrameClockNow();
+        }
+
+        ScopedFrameStage(const ScopedFrameStage&) = delete;
+        ScopedFrameStage& operator=(const ScopedFrameStage&) = delete;
+
+    private:
+        FrameTiming::Interval& m_interval;
+    };
+
+    // Ring buffer of the most recent frame timings. One thread records, any thread can take a snapshot without blocking it.
+    // Each slot is guarded by a sequence number, so a reader drops the records overwritten while it copies them. The record
+    // itself is copied through relaxed atomic words, so that a torn copy is discarded rather than being a data race.
+    class FrameTimingRecorder {
+    public:
+        // Capacity is rounded up to a power of two.
+        explicit FrameTimingRecorder(uint32_t capacity = 1024);
+
+        void Record(const FrameTiming& timing);
+
+        // Records still in the buffer, oldest first.
+        std::vector<FrameTiming> Snapshot() const;
+
+        uint64_t RecordedCount() const {
+            return m_head.load(std::memory_order_acquire);
+        }
+
+    private:
+        static_assert(std::is_trivially_copyable_v<FrameTiming>);
+        constexpr static size_t TimingWordCount = (sizeof(FrameTiming) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        struct Slot {
+            std::atomic<uint64_t> Sequence{0}; // Odd while written, 2 * (record number + 1) once complete.
+            std::array<std::atomic<uint64_t>, TimingWordCount> Words{};
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        uint64_t m_mask;
+        std::atomic<uint64_t> m_head{0};
+    };
+
+    // Number of display periods skipped between two consecutive records, 0 when the runtime did not drop a frame.
+    uint32_t MissedDisplayPeriods(const FrameTiming& previous, const FrameTiming& current);
+
+    // One line per frame with stage durations in microseconds.
+    void WriteFrameTimingsCsv(const std::vector<FrameTiming>& timings, std::ostream& out);
+
+    // Trace Event Format JSON, to be opened with chrome://tracing or Perfetto.
+    void WriteFrameTimingsChromeTrace(const std::vector<FrameTiming>& timings, std::ostream& out);
+} // namespace sample
@@ -1,11 +1,19 @@
 #!/bin/sh
 mkdir build
+mkdir build/host
+cd build/host
+cmake ../../AssetPacker
+cmake --build . --config Release
+ASSET_PACKER=$(pwd)/Release/AssetPacker.exe
+
+cd ../..
+
 mkdir build/x64_uwp
 cd build/x64_uwp
-cmake ../.. -DCMAKE_SYSTEM_NAME=WindowsStore -DCMAKE_SYSTEM_VERSION=10.0
+cmake ../.. -DCMAKE_SYSTEM_NAME=WindowsStore -DCMAKE_SYSTEM_VERSION=10.0 -DASSET_PACKER=$ASSET_PACKER
 
 cd ../..
 
 mkdir build/arm64_uwp
 cd build/arm64_uwp
-cmake ../.. -DCMAKE_SYSTEM_NAME=WindowsStore -DCMAKE_SYSTEM_VERSION=10.0 -A arm64
\ No newline at end of file
+cmake ../.. -DCMAKE_SYSTEM_NAME=WindowsStore -DCMAKE_SYSTEM_VERSION=10.0 -A arm64 -DASSET_PACKER=$ASSET_PACKER
\ No newline at end of file
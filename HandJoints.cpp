@@ -0,0 +1,145 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "HandJoints.h"
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace sample {
+    HandTracker::HandTracker(XrSession session, const xr::ExtensionDispatchTable& extensions)
+        : m_extensions(extensions) {
+        CHECK(extensions.xrCreateHandTrackerMSFT != nullptr && extensions.xrCreateHandJointSpaceMSFT != nullptr);
+        for (uint32_t hand = 0; hand < HandJoints::HandCount; hand++) {
+            XrHandTrackerCreateInfoMSFT createInfo{XR_TYPE_HAND_TRACKER_CREATE_INFO_MSFT};
+            createInfo.hand = hand == 0 ? XR_HAND_LEFT_MSFT : XR_HAND_RIGHT_MSFT;
+            CHECK_XRCMD(extensions.xrCreateHandTrackerMSFT(session, &createInfo, m_trackers[hand].Put(extensions.xrDestroyHandTrackerMSFT)));
+
+            for (XrHandJointMSFT joint : xr::HandJoints) {
+                XrHandJointSpaceCreateInfoMSFT spaceInfo{XR_TYPE_HAND_JOINT_SPACE_CREATE_INFO_MSFT};
+                spaceInfo.handTracker = m_trackers[hand].Get();
+                spaceInfo.joint = joint;
+                spaceInfo.poseInJointSpace = xr::math::Pose::Identity();
+                const uint32_t index = hand * (uint32_t)xr::HandJointCount + xr::JointToIndex(joint);
+                CHECK_XRCMD(extensions.xrCreateHandJointSpaceMSFT(session, &spaceInfo, m_jointSpaces[index].Put()));
+            }
+        }
+    }
+
+    void HandTracker::Locate(XrSpace baseSpace, XrTime time, HandJoints& joints) {
+        joints.Clear();
+        for (uint32_t hand = 0; hand < HandJoints::HandCount; hand++) {
+            XrHandTrackerStateMSFT state{XR_TYPE_HAND_TRACKER_STATE_MSFT};
+            CHECK_XRCMD(m_extensions.xrGetHandTrackerStateMSFT(m_trackers[hand].Get(), time, &state));
+            if (!state.isActive) {
+                continue; // The joints of a hand out of view are not located.
+            }
+            joints.Tracked[hand] = 1;
+
+            const uint32_t first = hand * (uint32_t)xr::HandJointCount;
+            for (uint32_t i = first; i < first + xr::HandJointCount; i++) {
+                XrHandJointRadiusMSFT radius{XR_TYPE_HAND_JOINT_RADIUS_MSFT};
+                XrSpaceLocation location{XR_TYPE_SPACE_LOCATION, &radius};
+                CHECK_XRCMD(xrLocateSpace(m_jointSpaces[i].Get(), baseSpace, time, &location));
+                const bool valid = xr::math::Pose::IsPoseValid(location);
+                joints.Valid[i] = valid ? 1 : 0;
+                joints.Positions[i] = location.pose.position;
+                joints.Orientations[i] = location.pose.orientation;
+                joints.Radii[i] = radius.radius;
+            }
+        }
+    }
+
+    void WriteHandJointRecording(const HandJointRecording& recording, std::ostream& out) {
+        out << "Time,Hand,Joint,X,Y,Z,QX,QY,QZ,QW,Radius\n";
+        for (const HandJointSample& sample : recording) {
+            const HandJoints& joints = sample.Joints;
+            for (uint32_t i = 0; i < HandJoints::JointCount; i++) {
+                if (!joints.Valid[i]) {
+                    continue;
+                }
+                const XrVector3f& p = joints.Positions[i];
+                const XrQuaternionf& q = joints.Orientations[i];
+                out << sample.Time << ',' << i / xr::HandJointCount << ',' << i % xr::HandJointCount << ',' << p.x << ',' << p.y << ','
+                    << p.z << ',' << q.x << ',' << q.y << ',' << q.z << ',' << q.w << ',' << joints.Radii[i] << '\n';
+            }
+        }
+    }
+
+    HandJointRecording ReadHandJointRecording(std::istream& in) {
+        HandJointRecording recording;
+        std::string line;
+        std::getline(in, line); // Header
+        while (std::getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            for (char& c : line) {
+                c = c == ',' ? ' ' : c;
+            }
+            std::istringstream row(line);
+            XrTime time;
+            uint32_t hand, joint;
+            XrVector3f p;
+            XrQuaternionf q;
+            float radius;
+            row >> time >> hand >> joint >> p.x >> p.y >> p.z >> q.x >> q.y >> q.z >> q.w >> radius;
+            CHECK_MSG(!row.fail() && hand < HandJoints::HandCount && joint < xr::HandJointCount, "Invalid hand joint recording row");
+
+            if (recording.empty() || recording.back().Time != time) {
+                CHECK_MSG(recording.empty() || recording.back().Time < time, "Hand joint recording is not sorted by time");
+                recording.emplace_back().Time = time;
+            }
+            HandJoints& joints = recording.back().Joints;
+            const uint32_t i = hand * (uint32_t)xr::HandJointCount + joint;
+            joints.Positions[i] = p;
+            joints.Orientations[i] = q;
+            joints.Radii[i] = radius;
+            joints.Valid[i] = 1;
+            joints.Tracked[hand] = 1;
+        }
+        return recording;
+    }
+
+    HandJointPlayback::HandJointPlayback(std::shared_ptr<const HandJointRecording> recording)
+        : m_recording(std::move(recording)) {
+        CHECK_MSG(m_recording && !m_recording->empty(), "Empty hand joint recording");
+    }
+
+    void HandJointPlayback::Locate(XrSpace /*baseSpace*/, XrTime time, HandJoints& joints) {
+        const HandJointRecording& recording = *m_recording;
+        if (!m_started || time < m_startTime) {
+            m_startTime = time;
+            m_started = true;
+            m_nextSample = 0;
+        }
+
+        // The recording loops once its last sample is reached, the last sample then lasts as long as the first interval.
+        const XrTime firstTime = recording.front().Time;
+        const XrDuration firstInterval = recording.size() > 1 ? recording[1].Time - firstTime : 1;
+        const XrDuration duration = recording.back().Time - firstTime + firstInterval;
+        const XrTime recordingTime = firstTime + (time - m_startTime) % duration;
+
+        if (m_nextSample > 0 && recording[m_nextSample - 1].Time > recordingTime) {
+            m_nextSample = 0; // Looped
+        }
+        while (m_nextSample < recording.size() && recording[m_nextSample].Time <= recordingTime) {
+            m_nextSample++;
+        }
+        joints = recording[m_nextSample > 0 ? m_nextSample - 1 : 0].Joints;
+    }
+} // namespace sample
@@ -0,0 +1,88 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <iosfwd>
+
+#include "XrUtility/XrHand.h"
+
+namespace sample {
+    // Joint poses and radii of both hands as parallel arrays, indexed by hand * xr::HandJointCount + xr::JointToIndex(joint).
+    // Fixed size, so locating the joints of a frame does not allocate.
+    struct HandJoints {
+        constexpr static uint32_t HandCount = 2; // Left then right, the order of XrHandMSFT.
+        constexpr static uint32_t JointCount = HandCount * (uint32_t)xr::HandJointCount;
+
+        std::array<XrVector3f, JointCount> Positions{};
+        std::array<XrQuaternionf, JointCount> Orientations{};
+        std::array<float, JointCount> Radii{};
+        std::array<uint8_t, JointCount> Valid{}; // 1 when the joint has a valid position and orientation.
+        std::array<uint8_t, HandCount> Tracked{};
+
+        void Clear() {
+            Valid.fill(0);
+            Tracked.fill(0);
+        }
+    };
+
+    // Where the hand joints of a frame come from, the runtime or a recording.
+    struct IHandJointSource {
+        virtual ~IHandJointSource() = default;
+
+        // Locates the joints in baseSpace at the given time. The joints of an untracked hand are not valid.
+        virtual void Locate(XrSpace baseSpace, XrTime time, HandJoints& joints) = 0;
+    };
+
+    // Joints located by the runtime with XR_MSFT_hand_tracking_preview, one joint space per joint.
+    class HandTracker : public IHandJointSource {
+    public:
+        HandTracker(XrSession session, const xr::ExtensionDispatchTable& extensions);
+
+        void Locate(XrSpace baseSpace, XrTime time, HandJoints& joints) override;
+
+    private:
+        const xr::ExtensionDispatchTable& m_extensions;
+        std::array<xr::HandTrackerHandle, HandJoints::HandCount> m_trackers;
+        std::array<xr::SpaceHandle, HandJoints::JointCount> m_jointSpaces;
+    };
+
+    struct HandJointSample {
+        XrTime Time{0};
+        HandJoints Joints;
+    };
+
+    // Joints of both hands over time, in the space they were located in, sorted by time.
+    using HandJointRecording = std::vector<HandJointSample>;
+
+    // CSV with one row per valid joint: Time,Hand,Joint,X,Y,Z,QX,QY,QZ,QW,Radius. Rows of a sample share its time.
+    void WriteHandJointRecording(const HandJointRecording& recording, std::ostream& out);
+    HandJointRecording ReadHandJointRecording(std::istream& in);
+
+    // Replays a recording in a loop, from the time of the first Locate() call. Each frame gets the latest sample at its time.
+    // The joints stay in the space they were recorded in, the base space is ignored.
+    class HandJointPlayback : public IHandJointSource {
+    public:
+        explicit HandJointPlayback(std::shared_ptr<const HandJointRecording> recording);
+
+        void Locate(XrSpace baseSpace, XrTime time, HandJoints& joints) override;
+
+    private:
+        std::shared_ptr<const HandJointRecording> m_recording;
+        XrTime m_startTime{0};
+        bool m_started{false};
+        size_t m_nextSample{0};
+    };
+} // namespace sample
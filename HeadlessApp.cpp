@@ -0,0 +1,356 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Runs the sample against the headless runtime with the null graphics plugin, and reports the CPU cost of the program.
+// Usage: OpenXR-bgfx-headless [--frames N] [--realtime] [--pipelined] [--idle] [--asset file]... [--archive file] [--sync-assets]
+//                             [--dynamic-resolution] [--event-flood N] [--hands] [--hand-recording file]
+//                             [--save-hand-recording file] [--csv file] [--trace file] [--reserve-holograms N]
+//                             [--check-no-alloc] [--check-frames] [--check-views] [--check-batches]
+//                             [--visibility-mask-changes N] [--check-visibility-mask] [--reference-space-changes N]
+//                             [--check-layers]
+// --idle removes the input events of the script, so that no hologram is placed and the frames reach a steady state.
+// --asset makes the null plugin load a file as the cube plugin loads its shaders, --sync-assets reads them when the device
+// is initialized instead of in the background, to compare the time to the first frame. --archive does the same with an asset
+// archive written by AssetPacker. --dynamic-resolution enables the resolution controller with its default settings.
+// --event-flood makes the runtime queue N events per frame, which the program drains a bounded number at a time.
+// --hands replays a synthetic recording of both hands, --hand-recording a recording read from a file, and their joints are
+// drawn as octahedrons. --save-hand-recording writes the replayed recording, e.g. to start a recording file from the synthetic one.
+// --reserve-holograms sets the number of holograms the scene reserves room for, 64 by default.
+// --check-no-alloc fails when the program allocates in a steady state frame. The allocations of the runtime are counted apart,
+// as a real runtime does not allocate from the heap of the application. --check-frames fails when more than one frame is ended
+// without being rendered, e.g. when the pipeline keeps running frames while the session stops. --check-views fails when a
+// steady state frame creates a render target or depth stencil view, instead of reusing the views cached per swapchain image.
+// --check-batches fails when a frame issues more than one draw per mesh, the stereo views being drawn together.
+// --visibility-mask-changes makes the runtime change the visibility masks every N frames. --check-visibility-mask fails unless
+// the masks are fetched and uploaded once at start and once per change, so the last change must come a frame before the exit.
+// --reference-space-changes makes the runtime announce a change of the origin of the reference spaces every N frames.
+// --check-layers fails when a frame the runtime asked to render is ended without a layer.
+
+#include "pch.h"
+#include "OpenXrProgram.h"
+#include "HeadlessRuntime/HeadlessRuntime.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+constexpr const char* ProgramName = "BasicXrApp_headless";
+
+// Frames left out of the steady state, while the swapchains, arenas and hologram store reach their capacity.
+constexpr size_t WarmUpFrameCount = 60;
+
+namespace {
+    std::atomic<uint64_t> g_heapAllocationCount{0};
+    std::atomic<uint64_t> g_runtimeHeapAllocationCount{0};
+
+    uint64_t HeapAllocationCount() {
+        return g_heapAllocationCount.load(std::memory_order_relaxed);
+    }
+
+    // The allocations made inside runtime calls belong to the runtime, a real one has its own allocator.
+    void CountHeapAllocation() {
+        (headless::IsInRuntimeCall() ? g_runtimeHeapAllocationCount : g_heapAllocationCount).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Both hands open in front of the user, circling once per second.
+    sample::HandJointRecording MakeSyntheticHandRecording() {
+        constexpr uint32_t SampleCount = 60;
+        constexpr XrDuration SamplePeriod = 16'666'667;
+        constexpr float Pi = 3.14159265f;
+
+        sample::HandJointRecording recording(SampleCount);
+        for (uint32_t s = 0; s < SampleCount; s++) {
+            recording[s].Time = s * SamplePeriod;
+            sample::HandJoints& joints = recording[s].Joints;
+            const float angle = 2 * Pi * s / SampleCount;
+            for (uint32_t hand = 0; hand < sample::HandJoints::HandCount; hand++) {
+                const float side = hand == 0 ? -1.0f : 1.0f;
+                const XrVector3f palm{side * 0.15f + 0.05f * std::cos(angle), -0.2f + 0.05f * std::sin(angle), -0.4f};
+                auto setJoint = [&](XrHandJointMSFT joint, float x, float y, float radius) {
+                    const uint32_t i = hand * (uint32_t)xr::HandJointCount + xr::JointToIndex(joint);
+                    joints.Positions[i] = {palm.x + side * x, palm.y + y, palm.z};
+                    joints.Orientations[i] = xr::math::Quaternion::Identity();
+                    joints.Radii[i] = radius;
+                    joints.Valid[i] = 1;
+                };
+
+                setJoint(XR_HAND_JOINT_PALM_MSFT, 0, 0, 0.02f);
+                setJoint(XR_HAND_JOINT_WRIST_MSFT, 0, -0.06f, 0.02f);
+                // Thumb first, its metacarpal follows the wrist, then the four fingers of five joints each.
+                uint32_t joint = XR_HAND_JOINT_THUMB_METACARPAL_MSFT;
+                for (uint32_t finger = 0; finger < 5; finger++) {
+                    const uint32_t fingerJointCount = finger == 0 ? 4 : 5;
+                    for (uint32_t k = 0; k < fingerJointCount; k++, joint++) {
+                        const float x = finger == 0 ? -0.04f - 0.02f * k : 0.03f * (finger - 2.5f);
+                        const float y = finger == 0 ? -0.03f + 0.015f * k : -0.03f + 0.025f * k;
+                        setJoint(static_cast<XrHandJointMSFT>(joint), x, y, k + 1 == fingerJointCount ? 0.006f : 0.009f);
+                    }
+                }
+                joints.Tracked[hand] = 1;
+            }
+        }
+        return recording;
+    }
+} // namespace
+
+// Count every heap allocation of the process, the ones of the runtime apart.
+void* operator new(size_t size) {
+    CountHeapAllocation();
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    CountHeapAllocation();
+    const size_t align = static_cast<size_t>(alignment);
+    if (void* pointer = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+int main(int argc, char** argv) {
+    try {
+        headless::RuntimeOptions options;
+        options.ExitAfterFrames = 600;
+        sample::ProgramOptions programOptions;
+        programOptions.HeapAllocationCount = &HeapAllocationCount;
+        const char* csvPath = nullptr;
+        const char* tracePath = nullptr;
+        const char* savedHandRecordingPath = nullptr;
+        bool checkNoAllocation = false;
+        bool checkFrames = false;
+        bool checkViews = false;
+        bool checkBatches = false;
+        bool checkVisibilityMask = false;
+        bool checkLayers = false;
+        sample::NullGraphicsAssets assets;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                options.ExitAfterFrames = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--realtime") == 0) {
+                options.PaceToRealTime = true;
+            } else if (std::strcmp(argv[i], "--idle") == 0) {
+                options.Script.Inputs.clear();
+            } else if (std::strcmp(argv[i], "--pipelined") == 0) {
+                programOptions.PipelinedFrameLoop = true;
+            } else if (std::strcmp(argv[i], "--asset") == 0 && i + 1 < argc) {
+                assets.Paths.push_back(argv[++i]);
+            } else if (std::strcmp(argv[i], "--archive") == 0 && i + 1 < argc) {
+                assets.ArchivePath = argv[++i];
+            } else if (std::strcmp(argv[i], "--sync-assets") == 0) {
+                assets.LoadOnDeviceInitialization = true;
+            } else if (std::strcmp(argv[i], "--dynamic-resolution") == 0) {
+                programOptions.DynamicResolution.emplace();
+            } else if (std::strcmp(argv[i], "--event-flood") == 0 && i + 1 < argc) {
+                options.EventsPerFrame = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--hands") == 0) {
+                programOptions.RecordedHandJoints = std::make_shared<const sample::HandJointRecording>(MakeSyntheticHandRecording());
+            } else if (std::strcmp(argv[i], "--hand-recording") == 0 && i + 1 < argc) {
+                std::ifstream recording(argv[++i]);
+                CHECK_MSG(recording.good(), "Cannot open the hand joint recording");
+                programOptions.RecordedHandJoints = std::make_shared<const sample::HandJointRecording>(sample::ReadHandJointRecording(recording));
+            } else if (std::strcmp(argv[i], "--save-hand-recording") == 0 && i + 1 < argc) {
+                savedHandRecordingPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+                csvPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+                tracePath = argv[++i];
+            } else if (std::strcmp(argv[i], "--reserve-holograms") == 0 && i + 1 < argc) {
+                programOptions.ReservedHologramCount = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--check-no-alloc") == 0) {
+                checkNoAllocation = true;
+            } else if (std::strcmp(argv[i], "--check-frames") == 0) {
+                checkFrames = true;
+            } else if (std::strcmp(argv[i], "--check-views") == 0) {
+                checkViews = true;
+            } else if (std::strcmp(argv[i], "--check-batches") == 0) {
+                checkBatches = true;
+            } else if (std::strcmp(argv[i], "--visibility-mask-changes") == 0 && i + 1 < argc) {
+                options.VisibilityMaskChangePeriod = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--check-visibility-mask") == 0) {
+                checkVisibilityMask = true;
+            } else if (std::strcmp(argv[i], "--reference-space-changes") == 0 && i + 1 < argc) {
+                options.ReferenceSpaceChangePeriod = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--check-layers") == 0) {
+                checkLayers = true;
+            } else {
+                std::fprintf(stderr,
+                             "Usage: %s [--frames N] [--realtime] [--pipelined] [--idle] [--asset file]... [--archive file] [--sync-assets] "
+                             "[--dynamic-resolution] [--event-flood N] [--hands] [--hand-recording file] [--save-hand-recording file] "
+                             "[--csv file] [--trace file] [--reserve-holograms N] [--check-no-alloc] [--check-frames] [--check-views] "
+                             "[--check-batches] [--visibility-mask-changes N] [--check-visibility-mask] "
+                             "[--reference-space-changes N] [--check-layers]\n",
+                             argv[0]);
+                return 1;
+            }
+        }
+        headless::SetOptions(options);
+
+        if (savedHandRecordingPath != nullptr) {
+            CHECK_MSG(programOptions.RecordedHandJoints, "--save-hand-recording needs --hands or --hand-recording");
+            std::ofstream recording(savedHandRecordingPath);
+            CHECK_MSG(recording.good(), "Cannot open the hand joint recording file");
+            sample::WriteHandJointRecording(*programOptions.RecordedHandJoints, recording);
+        }
+
+        const int64_t startTime = sample::FrameClockNow();
+        sample::NullGraphicsStats stats;
+        auto graphics = sample::CreateNullGraphics(&stats, assets);
+        auto program = sample::CreateOpenXrProgram(ProgramName, std::move(graphics), programOptions);
+
+        const auto start = std::chrono::steady_clock::now();
+        program->Run();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        const headless::RuntimeStats runtimeStats = headless::GetStats();
+        const double frameCount = (double)std::max<uint64_t>(runtimeStats.FramesEnded, 1);
+        std::printf("Frames: %llu ended, %llu rendered\n",
+                    (unsigned long long)runtimeStats.FramesEnded,
+                    (unsigned long long)stats.FrameCount);
+        std::printf("CPU time: %.3f ms total, %.4f ms/frame\n", elapsed.count(), elapsed.count() / frameCount);
+        if (stats.FrameCount > 0) {
+            std::printf("Time to first frame: %.3f ms, %llu asset bytes loaded, %u archive entries\n",
+                        (stats.FirstRenderTime - startTime) / 1e6,
+                        (unsigned long long)stats.AssetBytes,
+                        stats.ArchiveEntryCount);
+        }
+        std::printf("Cubes: %.1f avg, %u max, %.1f draw batches avg, %llu bytes submitted\n",
+                    stats.CubeCount / (double)std::max<uint64_t>(stats.FrameCount, 1),
+                    stats.MaxCubeCount,
+                    stats.BatchCount / (double)std::max<uint64_t>(stats.FrameCount, 1),
+                    (unsigned long long)stats.SubmittedBytes);
+        if (stats.LastFrame.VisibilityMaskTriangleCount > 0) {
+            std::printf("Visibility mask: %u triangles, %llu uploads for %llu changes\n",
+                        stats.LastFrame.VisibilityMaskTriangleCount,
+                        (unsigned long long)stats.VisibilityMaskUploadCount,
+                        (unsigned long long)runtimeStats.VisibilityMaskChanges);
+        }
+        std::printf("Runtime calls:\n");
+        for (uint32_t i = 0; i < headless::EntryPointCount; i++) {
+            const auto entryPoint = static_cast<headless::EntryPoint>(i);
+            if (runtimeStats.CallCount(entryPoint) > 0) {
+                std::printf("  %-40s %10llu\n", headless::ToCString(entryPoint), (unsigned long long)runtimeStats.CallCount(entryPoint));
+            }
+        }
+
+        const std::vector<sample::FrameTiming> timings = program->FrameTimings().Snapshot();
+        // The frame reaching ExitAfterFrames makes the runtime queue the exit events, it ends the steady state.
+        uint64_t steadyStateAllocations = 0;
+        size_t steadyStateFrameCount = 0;
+        size_t allocatingFrameCount = 0;
+        uint64_t steadyStateCreatedViews = 0;
+        double resolutionScaleSum = 0;
+        float minResolutionScale = 1.0f;
+        for (const sample::FrameTiming& timing : timings) {
+            if (timing.FrameIndex < WarmUpFrameCount || (options.ExitAfterFrames > 0 && timing.FrameIndex + 1 >= options.ExitAfterFrames)) {
+                continue;
+            }
+            steadyStateAllocations += timing.HeapAllocations;
+            steadyStateFrameCount++;
+            allocatingFrameCount += timing.HeapAllocations > 0 ? 1 : 0;
+            steadyStateCreatedViews += timing.CreatedViews;
+            resolutionScaleSum += timing.ResolutionScale;
+            minResolutionScale = std::min(minResolutionScale, timing.ResolutionScale);
+        }
+        std::printf("Heap allocations: %llu in %zu steady state frames, %zu frames allocated, %llu by the runtime in total\n",
+                    (unsigned long long)steadyStateAllocations,
+                    steadyStateFrameCount,
+                    allocatingFrameCount,
+                    (unsigned long long)g_runtimeHeapAllocationCount.load(std::memory_order_relaxed));
+        if (programOptions.DynamicResolution && steadyStateFrameCount > 0) {
+            std::printf("Resolution scale: %.2f avg, %.2f min\n", resolutionScaleSum / steadyStateFrameCount, minResolutionScale);
+        }
+        if (csvPath != nullptr) {
+            std::ofstream csv(csvPath);
+            CHECK_MSG(csv.good(), "Cannot open the CSV file");
+            sample::WriteFrameTimingsCsv(timings, csv);
+        }
+        if (tracePath != nullptr) {
+            std::ofstream trace(tracePath);
+            CHECK_MSG(trace.good(), "Cannot open the trace file");
+            sample::WriteFrameTimingsChromeTrace(timings, trace);
+        }
+
+        if (checkNoAllocation && (steadyStateFrameCount == 0 || steadyStateAllocations > 0)) {
+            std::fprintf(stderr, "Check failed: %llu heap allocations in %zu steady state frames\n",
+                         (unsigned long long)steadyStateAllocations,
+                         steadyStateFrameCount);
+            return 1;
+        }
+        // The views of the swapchain images are created before the first frame, none when the plugin does not count them.
+        if (checkViews && (stats.CreatedViewCount == 0 || steadyStateCreatedViews > 0)) {
+            std::fprintf(stderr, "Check failed: %llu views created in steady state frames, %llu in total\n",
+                         (unsigned long long)steadyStateCreatedViews,
+                         (unsigned long long)stats.CreatedViewCount);
+            return 1;
+        }
+        if (checkBatches && (stats.BatchCount == 0 || stats.BatchCount != stats.MeshCount)) {
+            std::fprintf(stderr, "Check failed: %llu draw batches for %llu meshes\n",
+                         (unsigned long long)stats.BatchCount,
+                         (unsigned long long)stats.MeshCount);
+            return 1;
+        }
+        // Each fetch reads the size then the triangles of every view.
+        const uint64_t maskFetchCount =
+            runtimeStats.CallCount(headless::EntryPoint::xrGetVisibilityMaskKHR) / (2 * std::max<uint64_t>(stats.LastFrame.ViewCount, 1));
+        if (checkVisibilityMask && (stats.VisibilityMaskUploadCount != runtimeStats.VisibilityMaskChanges + 1 ||
+                                    maskFetchCount != stats.VisibilityMaskUploadCount)) {
+            std::fprintf(stderr, "Check failed: %llu visibility mask fetches and %llu uploads for %llu changes\n",
+                         (unsigned long long)maskFetchCount,
+                         (unsigned long long)stats.VisibilityMaskUploadCount,
+                         (unsigned long long)runtimeStats.VisibilityMaskChanges);
+            return 1;
+        }
+        if (checkFrames && runtimeStats.FramesEnded > stats.FrameCount + 1) {
+            std::fprintf(stderr, "Check failed: %llu frames ended, %llu rendered\n",
+                         (unsigned long long)runtimeStats.FramesEnded,
+                         (unsigned long long)stats.FrameCount);
+            return 1;
+        }
+        if (checkLayers && runtimeStats.RenderedFramesWithoutLayers > 0) {
+            std::fprintf(stderr, "Check failed: %llu frames to render ended without a layer\n",
+                         (unsigned long long)runtimeStats.RenderedFramesWithoutLayers);
+            return 1;
+        }
+    } catch (const std::exception& ex) {
+        DEBUG_PRINT("Unhandled Exception: %s\n", ex.what());
+        return 1;
+    } catch (...) {
+        DEBUG_PRINT("Unhandled Exception\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,1944 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "HeadlessRuntime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <XrUtility/XrMath.h>
+#include <XrUtility/XrExtensions.h>
+
+#if XR_PTR_SIZE != 8
+#error The headless runtime hands out 64-bit object ids as handles.
+#endif
+
+using namespace headless;
+
+namespace {
+    constexpr XrTime StartTime = 1'000'000'000;
+    constexpr XrSystemId HmdSystemId = 1;
+    constexpr uint32_t MaxLayerCount = 16;
+    constexpr size_t MaxFloodedEventQueueSize = 64; // Flooded events are dropped past that size, as the queue of a runtime is bounded.
+    constexpr XrViewConfigurationType ViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+    constexpr uint32_t ViewCount = 2;
+
+    bool IsSupportedSwapchainFormat(int64_t format) {
+        return std::find(std::begin(ColorSwapchainFormats), std::end(ColorSwapchainFormats), format) != std::end(ColorSwapchainFormats) ||
+               std::find(std::begin(DepthSwapchainFormats), std::end(DepthSwapchainFormats), format) != std::end(DepthSwapchainFormats);
+    }
+
+    // The floor of the STAGE reference space, relative to the LOCAL reference space where the head starts.
+    constexpr XrPosef StageInLocal = xr::math::Pose::Translation({0, -1.6f, 0});
+
+    enum class ObjectType { Instance, Session, Space, Swapchain, ActionSet, Action, SpatialAnchor };
+
+    struct Object {
+        virtual ~Object() = default;
+
+        ObjectType Type{};
+        uint64_t Parent{0};
+        std::unordered_set<uint64_t> Children;
+    };
+
+    struct InstanceObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::Instance;
+
+        std::vector<std::string> EnabledExtensions;
+        std::vector<std::string> Paths{std::string()}; // Indexed by XrPath, XR_NULL_PATH maps to an empty string.
+        std::unordered_map<std::string, XrPath> PathIds;
+        std::unordered_map<XrPath, std::vector<XrActionSuggestedBinding>> SuggestedBindings;
+        std::deque<XrEventDataBuffer> Events; // Allocates as the events are queued, within runtime calls (see IsInRuntimeCall()).
+        uint64_t Session{0};
+
+        bool IsExtensionEnabled(const char* name) const {
+            return std::find(EnabledExtensions.begin(), EnabledExtensions.end(), name) != EnabledExtensions.end();
+        }
+    };
+
+    // Action states are tracked for any subaction path, the left hand and the right hand.
+    constexpr size_t SubactionCount = 1 + static_cast<size_t>(Hand::Count);
+
+    struct ActionState {
+        bool Active{false};
+        bool Current{false};
+        bool Changed{false};
+        XrTime LastChangeTime{0};
+    };
+
+    struct ActionObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::Action;
+
+        XrActionType ActionType{};
+        std::vector<XrPath> SubactionPaths;
+        std::vector<std::string> Bindings; // Resolved from the suggested bindings when the action set is attached.
+        std::array<ActionState, SubactionCount> States;
+    };
+
+    struct ActionSetObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::ActionSet;
+
+        bool Attached{false};
+        std::vector<uint64_t> Actions;
+    };
+
+    struct SessionObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::Session;
+
+        XrSessionState State{XR_SESSION_STATE_UNKNOWN};
+        bool Running{false};
+        bool ExitRequested{false};
+        bool ActionSetsAttached{false};
+
+        uint64_t FramesWaited{0};
+        uint64_t FramesBegun{0};
+        uint64_t FramesEnded{0};
+        bool FrameInProgress{false};
+        uint64_t VisibilityMaskGeneration{0};
+        XrTime DisplayTime{StartTime}; // Predicted display time of the last waited frame.
+        std::deque<XrTime> RenderedDisplayTimes; // Of the waited frames that should be rendered and are not ended yet.
+        std::chrono::steady_clock::time_point PacingStart;
+
+        size_t NextInput{0};
+        std::unordered_map<std::string, bool> InputValues;
+    };
+
+    enum class SpaceKind { Reference, Action, Anchor };
+
+    struct SpaceObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::Space;
+
+        SpaceKind Kind{};
+        XrReferenceSpaceType ReferenceSpaceType{};
+        uint64_t Action{0};
+        size_t Subaction{0};
+        uint64_t Anchor{0};
+        XrPosef Offset{xr::math::Pose::Identity()};
+    };
+
+    struct SwapchainObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::Swapchain;
+
+        uint32_t ImageCount{0};
+        uint64_t FirstImage{0};
+        uint32_t NextImage{0};
+        uint32_t AcquiredImageCount{0}; // Images are acquired in order, so the acquired ones are the ones before NextImage.
+        bool FrontImageWaited{false};
+    };
+
+    struct SpatialAnchorObject : Object {
+        static constexpr ObjectType StaticType = ObjectType::SpatialAnchor;
+
+        XrPosef PoseInLocal{xr::math::Pose::Identity()};
+    };
+
+    struct Runtime {
+        std::mutex Mutex;
+        std::condition_variable FrameBegun; // Notified when a frame is begun or a session stops running.
+        RuntimeOptions PendingOptions;
+        RuntimeOptions Options;
+
+        std::unordered_map<uint64_t, std::unique_ptr<Object>> Objects;
+        uint64_t NextHandle{1};
+        uint64_t NextImage{1};
+        uint64_t Instance{0};
+
+        std::array<std::atomic<uint64_t>, EntryPointCount> Calls{};
+        std::atomic<uint64_t> FramesBegun{0};
+        std::atomic<uint64_t> FramesEnded{0};
+        std::atomic<uint64_t> FramesDiscarded{0};
+        std::atomic<uint64_t> RenderedFramesWithoutLayers{0};
+        std::atomic<uint64_t> LayersSubmitted{0};
+        std::atomic<uint64_t> ViewsSubmitted{0};
+        std::atomic<uint64_t> SpacesLocated{0};
+        std::atomic<uint64_t> VisibilityMaskChanges{0};
+        std::atomic<XrTime> LastPredictedDisplayTime{0};
+    };
+
+    Runtime& GetRuntime() {
+        static Runtime runtime;
+        return runtime;
+    }
+
+    thread_local uint32_t t_runtimeCallDepth = 0;
+
+    // Every entry point counts its call and runs under the runtime lock, exceptions are turned into XrResult.
+    template <typename TFunc>
+    XrResult Invoke(EntryPoint entryPoint, TFunc&& func) {
+        Runtime& runtime = GetRuntime();
+        runtime.Calls[static_cast<uint32_t>(entryPoint)].fetch_add(1, std::memory_order_relaxed);
+        struct CallScope {
+            CallScope() {
+                t_runtimeCallDepth++;
+            }
+            ~CallScope() {
+                t_runtimeCallDepth--;
+            }
+        } callScope;
+        try {
+            std::lock_guard<std::mutex> lock(runtime.Mutex);
+            return func(runtime);
+        } catch (const std::bad_alloc&) {
+            return XR_ERROR_OUT_OF_MEMORY;
+        } catch (...) {
+            return XR_ERROR_RUNTIME_FAILURE;
+        }
+    }
+
+    template <typename T, typename THandle>
+    T* Get(Runtime& runtime, THandle handle) {
+        const auto it = runtime.Objects.find(reinterpret_cast<uint64_t>(handle));
+        if (it == runtime.Objects.end() || it->second->Type != T::StaticType) {
+            return nullptr;
+        }
+        return static_cast<T*>(it->second.get());
+    }
+
+    template <typename T, typename THandle>
+    T* Create(Runtime& runtime, uint64_t parent, THandle* handle) {
+        auto object = std::make_unique<T>();
+        object->Type = T::StaticType;
+        object->Parent = parent;
+
+        const uint64_t id = runtime.NextHandle++;
+        if (parent != 0) {
+            runtime.Objects.at(parent)->Children.insert(id);
+        }
+
+        T* const result = object.get();
+        runtime.Objects.emplace(id, std::move(object));
+        *handle = reinterpret_cast<THandle>(id);
+        return result;
+    }
+
+    // Destroying a handle destroys all of its children, as a runtime is expected to do.
+    void Destroy(Runtime& runtime, uint64_t id) {
+        const auto it = runtime.Objects.find(id);
+        if (it == runtime.Objects.end()) {
+            return;
+        }
+
+        const std::unordered_set<uint64_t> children = std::move(it->second->Children);
+        for (uint64_t child : children) {
+            Destroy(runtime, child);
+        }
+
+        const uint64_t parent = it->second->Parent;
+        if (const auto parentIt = runtime.Objects.find(parent); parentIt != runtime.Objects.end()) {
+            parentIt->second->Children.erase(id);
+        }
+        runtime.Objects.erase(id);
+    }
+
+    template <typename T, typename THandle>
+    XrResult DestroyHandle(Runtime& runtime, THandle handle) {
+        if (!Get<T>(runtime, handle)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        Destroy(runtime, reinterpret_cast<uint64_t>(handle));
+        return XR_SUCCESS;
+    }
+
+    // The two-call idiom: report the count, and fill the output array only when it is large enough.
+    template <typename TFill>
+    XrResult FillArray(uint32_t capacityInput, uint32_t* countOutput, uint32_t count, TFill&& fill) {
+        if (countOutput == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        *countOutput = count;
+        if (capacityInput == 0) {
+            return XR_SUCCESS;
+        }
+        if (capacityInput < count) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            fill(i);
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult FillString(uint32_t capacityInput, uint32_t* countOutput, char* buffer, const std::string& str) {
+        const uint32_t count = static_cast<uint32_t>(str.size() + 1);
+        return FillArray(capacityInput, countOutput, count, [&](uint32_t i) { buffer[i] = i < str.size() ? str[i] : '\0'; });
+    }
+
+    void CopyString(char* dest, size_t destSize, const char* source) {
+        std::strncpy(dest, source, destSize - 1);
+        dest[destSize - 1] = '\0';
+    }
+
+    std::vector<XrExtensionProperties> SupportedExtensions(const RuntimeOptions& options) {
+        std::vector<XrExtensionProperties> extensions;
+        auto add = [&](const char* name, uint32_t version) {
+            XrExtensionProperties& properties = extensions.emplace_back(XrExtensionProperties{XR_TYPE_EXTENSION_PROPERTIES, nullptr, {}, version});
+            CopyString(properties.extensionName, sizeof(properties.extensionName), name);
+        };
+
+        add(XR_HEADLESS_GRAPHICS_EXTENSION_NAME, XR_HEADLESS_graphics_SPEC_VERSION);
+        if (options.SupportsDepthComposition) {
+            add(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME, XR_KHR_composition_layer_depth_SPEC_VERSION);
+        }
+        if (options.SupportsUnboundedSpace) {
+            add(XR_MSFT_UNBOUNDED_REFERENCE_SPACE_EXTENSION_NAME, XR_MSFT_unbounded_reference_space_SPEC_VERSION);
+        }
+        if (options.SupportsSpatialAnchor) {
+            add(XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME, XR_MSFT_spatial_anchor_SPEC_VERSION);
+        }
+        if (options.SupportsLocateSpaces) {
+            add(XR_KHR_LOCATE_SPACES_EXTENSION_NAME, XR_KHR_locate_spaces_SPEC_VERSION);
+        }
+        if (options.SupportsVisibilityMask) {
+            add(XR_KHR_VISIBILITY_MASK_EXTENSION_NAME, XR_KHR_visibility_mask_SPEC_VERSION);
+        }
+        return extensions;
+    }
+
+    void QueueEvent(InstanceObject& instance, const void* event, size_t size) {
+        XrEventDataBuffer& buffer = instance.Events.emplace_back();
+        std::memcpy(&buffer, event, size);
+    }
+
+    void QueueSessionState(Runtime& runtime, uint64_t sessionId, SessionObject& session, XrSessionState state) {
+        session.State = state;
+
+        const XrEventDataSessionStateChanged event{
+            XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED, nullptr, reinterpret_cast<XrSession>(sessionId), state, session.DisplayTime};
+        QueueEvent(*Get<InstanceObject>(runtime, session.Parent), &event, sizeof(event));
+    }
+
+    // Walks the session down to STOPPING, the application then ends the session and the runtime follows with EXITING.
+    void RequestExit(Runtime& runtime, uint64_t sessionId, SessionObject& session) {
+        session.ExitRequested = true;
+        if (session.State == XR_SESSION_STATE_FOCUSED) {
+            QueueSessionState(runtime, sessionId, session, XR_SESSION_STATE_VISIBLE);
+        }
+        if (session.State == XR_SESSION_STATE_VISIBLE) {
+            QueueSessionState(runtime, sessionId, session, XR_SESSION_STATE_SYNCHRONIZED);
+        }
+        if (session.State == XR_SESSION_STATE_SYNCHRONIZED || session.State == XR_SESSION_STATE_READY) {
+            QueueSessionState(runtime, sessionId, session, XR_SESSION_STATE_STOPPING);
+        }
+    }
+
+    XrPosef Invert(const XrPosef& pose) {
+        XrPosef result;
+        xr::math::StoreXrPose(&result, xr::math::LoadInvertedXrPose(pose));
+        return result;
+    }
+
+    size_t SubactionIndex(const std::string& path) {
+        constexpr char left[] = "/user/hand/left";
+        constexpr char right[] = "/user/hand/right";
+        auto startsWith = [&](const char* prefix, size_t length) {
+            return path.compare(0, length, prefix) == 0 && (path.size() == length || path[length] == '/');
+        };
+
+        if (startsWith(left, sizeof(left) - 1)) {
+            return 1 + static_cast<size_t>(Hand::Left);
+        } else if (startsWith(right, sizeof(right) - 1)) {
+            return 1 + static_cast<size_t>(Hand::Right);
+        }
+        return 0;
+    }
+
+    const std::string* PathString(const InstanceObject& instance, XrPath path) {
+        return path < instance.Paths.size() ? &instance.Paths[static_cast<size_t>(path)] : nullptr;
+    }
+
+    // Locates the space in the LOCAL reference space, returns false when the space is not tracked.
+    bool LocateInLocal(Runtime& runtime, const SpaceObject& space, XrTime time, XrPosef* pose) {
+        const headless::Script& script = runtime.Options.Script;
+        const XrDuration scriptTime = time - StartTime;
+        using xr::math::operator*;
+
+        switch (space.Kind) {
+        case SpaceKind::Reference:
+            switch (space.ReferenceSpaceType) {
+            case XR_REFERENCE_SPACE_TYPE_VIEW:
+                *pose = space.Offset * script.Head.Sample(scriptTime);
+                return true;
+            case XR_REFERENCE_SPACE_TYPE_STAGE:
+                *pose = space.Offset * StageInLocal;
+                return true;
+            default:
+                *pose = space.Offset;
+                return true;
+            }
+        case SpaceKind::Action: {
+            const ActionObject* action = Get<ActionObject>(runtime, space.Action);
+            if (!action || !action->States[space.Subaction].Active) {
+                return false;
+            }
+
+            // An action space without subaction path follows the hand of its first binding.
+            size_t subaction = space.Subaction;
+            if (subaction == 0 && !action->Bindings.empty()) {
+                subaction = SubactionIndex(action->Bindings.front());
+            }
+            if (subaction == 0) {
+                return false;
+            }
+            *pose = space.Offset * script.Hands[subaction - 1].Sample(scriptTime);
+            return true;
+        }
+        case SpaceKind::Anchor: {
+            const SpatialAnchorObject* anchor = Get<SpatialAnchorObject>(runtime, space.Anchor);
+            if (!anchor) {
+                return false;
+            }
+            *pose = space.Offset * anchor->PoseInLocal;
+            return true;
+        }
+        }
+        return false;
+    }
+
+    XrSpaceLocationFlags Locate(Runtime& runtime, const SpaceObject& space, const SpaceObject& baseSpace, XrTime time, XrPosef* pose) {
+        XrPosef spaceInLocal, baseInLocal;
+        if (!LocateInLocal(runtime, space, time, &spaceInLocal) || !LocateInLocal(runtime, baseSpace, time, &baseInLocal)) {
+            *pose = xr::math::Pose::Identity();
+            return 0;
+        }
+
+        using xr::math::operator*;
+        *pose = spaceInLocal * Invert(baseInLocal);
+        return XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT |
+               XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+    }
+
+    // Applies the scripted input events up to the given time, events are sorted when the instance is created.
+    void AdvanceInputs(const Runtime& runtime, SessionObject& session, XrTime time) {
+        const std::vector<InputEvent>& inputs = runtime.Options.Script.Inputs;
+        for (; session.NextInput < inputs.size() && inputs[session.NextInput].Time <= time - StartTime; session.NextInput++) {
+            session.InputValues[inputs[session.NextInput].BindingPath] = inputs[session.NextInput].Value;
+        }
+    }
+
+    void SyncAction(const SessionObject& session, ActionObject& action, XrTime time) {
+        for (size_t subaction = 0; subaction < SubactionCount; subaction++) {
+            bool active = false;
+            bool value = false;
+            for (const std::string& binding : action.Bindings) {
+                if (subaction == 0 || SubactionIndex(binding) == subaction) {
+                    active = true;
+                    const auto it = session.InputValues.find(binding);
+                    value |= it != session.InputValues.end() && it->second;
+                }
+            }
+
+            ActionState& state = action.States[subaction];
+            state.Changed = state.Active && active && state.Current != value;
+            if (state.Changed) {
+                state.LastChangeTime = time;
+            }
+            state.Active = active;
+            state.Current = value;
+        }
+    }
+
+    void DeactivateAction(ActionObject& action) {
+        for (ActionState& state : action.States) {
+            state = ActionState{};
+        }
+    }
+
+    // Returns the state of the action for the subaction path, or an error if the query is not valid.
+    XrResult GetActionState(Runtime& runtime,
+                            XrSession sessionHandle,
+                            const XrActionStateGetInfo* getInfo,
+                            XrActionType expectedType,
+                            const ActionState** state) {
+        SessionObject* session = Get<SessionObject>(runtime, sessionHandle);
+        if (!session) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (getInfo == nullptr || getInfo->type != XR_TYPE_ACTION_STATE_GET_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        ActionObject* action = Get<ActionObject>(runtime, getInfo->action);
+        if (!action) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (action->ActionType != expectedType) {
+            return XR_ERROR_ACTION_TYPE_MISMATCH;
+        }
+        if (!Get<ActionSetObject>(runtime, action->Parent)->Attached) {
+            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+        }
+
+        size_t subaction = 0;
+        if (getInfo->subactionPath != XR_NULL_PATH) {
+            const auto& paths = action->SubactionPaths;
+            if (std::find(paths.begin(), paths.end(), getInfo->subactionPath) == paths.end()) {
+                return XR_ERROR_PATH_UNSUPPORTED;
+            }
+            subaction = SubactionIndex(*PathString(*Get<InstanceObject>(runtime, session->Parent), getInfo->subactionPath));
+        }
+
+        *state = &action->States[subaction];
+        return XR_SUCCESS;
+    }
+
+    XrResult CreateSpace(Runtime& runtime, XrSession sessionHandle, const SpaceObject& desc, XrSpace* space) {
+        if (!Get<SessionObject>(runtime, sessionHandle)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (space == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        SpaceObject* spaceObject = Create<SpaceObject>(runtime, reinterpret_cast<uint64_t>(sessionHandle), space);
+        spaceObject->Kind = desc.Kind;
+        spaceObject->ReferenceSpaceType = desc.ReferenceSpaceType;
+        spaceObject->Action = desc.Action;
+        spaceObject->Subaction = desc.Subaction;
+        spaceObject->Anchor = desc.Anchor;
+        spaceObject->Offset = desc.Offset;
+        return XR_SUCCESS;
+    }
+
+    XrPosef MakePose(const XrVector3f& position, float yaw, float pitch) {
+        XrPosef pose;
+        pose.orientation = xr::math::Quaternion::RotationRollPitchYaw({pitch, yaw, 0});
+        pose.position = position;
+        return pose;
+    }
+} // namespace
+
+namespace headless {
+    const char* ToCString(EntryPoint entryPoint) {
+#define HEADLESS_ENTRY_NAME(name) #name,
+        static constexpr const char* names[] = {HEADLESS_FOR_EACH_ENTRY_POINT(HEADLESS_ENTRY_NAME)};
+#undef HEADLESS_ENTRY_NAME
+        const uint32_t index = static_cast<uint32_t>(entryPoint);
+        return index < EntryPointCount ? names[index] : "Unknown";
+    }
+
+    XrPosef PoseTrack::Sample(XrDuration time) const {
+        if (Keyframes.empty()) {
+            return xr::math::Pose::Identity();
+        }
+
+        const XrDuration first = Keyframes.front().Time;
+        const XrDuration duration = Keyframes.back().Time - first;
+        if (Loop && duration > 0) {
+            time = first + ((time - first) % duration + duration) % duration;
+        }
+
+        const auto next = std::upper_bound(
+            Keyframes.begin(), Keyframes.end(), time, [](XrDuration t, const Keyframe& keyframe) { return t < keyframe.Time; });
+        if (next == Keyframes.begin()) {
+            return Keyframes.front().Pose;
+        } else if (next == Keyframes.end()) {
+            return Keyframes.back().Pose;
+        }
+
+        const Keyframe& previous = *(next - 1);
+        const float alpha = static_cast<float>(time - previous.Time) / static_cast<float>(next->Time - previous.Time);
+        return xr::math::Pose::Slerp(previous.Pose, next->Pose, alpha);
+    }
+
+    Script DefaultScript() {
+        constexpr XrDuration second = 1'000'000'000;
+        constexpr uint32_t stepsPerLoop = 16;
+        constexpr XrDuration loopDuration = 4 * second;
+        constexpr XrDuration inputDuration = 60 * second;
+
+        Script script;
+        for (uint32_t i = 0; i <= stepsPerLoop; i++) {
+            const XrDuration time = loopDuration * i / stepsPerLoop;
+            const float angle = 2 * xr::math::Pi * i / stepsPerLoop;
+
+            script.Head.Keyframes.push_back({time, MakePose({0.05f * std::sin(angle), 0, 0}, 0.15f * std::sin(angle), 0.05f * std::cos(angle))});
+
+            const XrVector2f circle{0.1f * std::cos(angle), 0.1f * std::sin(angle)};
+            script.Hands[static_cast<size_t>(Hand::Left)].Keyframes.push_back(
+                {time, MakePose({-0.2f + circle.x, -0.3f + circle.y, -0.4f}, 0.3f, -0.5f)});
+            script.Hands[static_cast<size_t>(Hand::Right)].Keyframes.push_back(
+                {time, MakePose({0.2f - circle.x, -0.3f - circle.y, -0.4f}, -0.3f, -0.5f)});
+        }
+
+        for (XrDuration time = second; time < inputDuration; time += second) {
+            script.Inputs.push_back({time, "/user/hand/right/input/select/click", true});
+            script.Inputs.push_back({time + second / 10, "/user/hand/right/input/select/click", false});
+        }
+        return script;
+    }
+
+    void SetOptions(RuntimeOptions options) {
+        Runtime& runtime = GetRuntime();
+        std::lock_guard<std::mutex> lock(runtime.Mutex);
+        runtime.PendingOptions = std::move(options);
+    }
+
+    RuntimeStats GetStats() {
+        const Runtime& runtime = GetRuntime();
+        RuntimeStats stats;
+        for (uint32_t i = 0; i < EntryPointCount; i++) {
+            stats.Calls[i] = runtime.Calls[i].load(std::memory_order_relaxed);
+        }
+        stats.FramesBegun = runtime.FramesBegun.load(std::memory_order_relaxed);
+        stats.FramesEnded = runtime.FramesEnded.load(std::memory_order_relaxed);
+        stats.FramesDiscarded = runtime.FramesDiscarded.load(std::memory_order_relaxed);
+        stats.RenderedFramesWithoutLayers = runtime.RenderedFramesWithoutLayers.load(std::memory_order_relaxed);
+        stats.LayersSubmitted = runtime.LayersSubmitted.load(std::memory_order_relaxed);
+        stats.ViewsSubmitted = runtime.ViewsSubmitted.load(std::memory_order_relaxed);
+        stats.SpacesLocated = runtime.SpacesLocated.load(std::memory_order_relaxed);
+        stats.VisibilityMaskChanges = runtime.VisibilityMaskChanges.load(std::memory_order_relaxed);
+        stats.LastPredictedDisplayTime = runtime.LastPredictedDisplayTime.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void ResetStats() {
+        Runtime& runtime = GetRuntime();
+        for (auto& calls : runtime.Calls) {
+            calls.store(0, std::memory_order_relaxed);
+        }
+        runtime.FramesBegun.store(0, std::memory_order_relaxed);
+        runtime.FramesEnded.store(0, std::memory_order_relaxed);
+        runtime.FramesDiscarded.store(0, std::memory_order_relaxed);
+        runtime.RenderedFramesWithoutLayers.store(0, std::memory_order_relaxed);
+        runtime.LayersSubmitted.store(0, std::memory_order_relaxed);
+        runtime.ViewsSubmitted.store(0, std::memory_order_relaxed);
+        runtime.SpacesLocated.store(0, std::memory_order_relaxed);
+        runtime.VisibilityMaskChanges.store(0, std::memory_order_relaxed);
+    }
+
+    bool IsInRuntimeCall() {
+        return t_runtimeCallDepth > 0;
+    }
+} // namespace headless
+
+#pragma region Instance
+XrResult XRAPI_CALL xrEnumerateInstanceExtensionProperties(const char* layerName,
+                                                           uint32_t propertyCapacityInput,
+                                                           uint32_t* propertyCountOutput,
+                                                           XrExtensionProperties* properties) {
+    return Invoke(EntryPoint::xrEnumerateInstanceExtensionProperties, [&](Runtime& runtime) {
+        if (layerName != nullptr) {
+            return XR_ERROR_API_LAYER_NOT_PRESENT;
+        }
+
+        const std::vector<XrExtensionProperties> extensions = SupportedExtensions(runtime.PendingOptions);
+        return FillArray(propertyCapacityInput, propertyCountOutput, static_cast<uint32_t>(extensions.size()), [&](uint32_t i) {
+            std::memcpy(properties[i].extensionName, extensions[i].extensionName, sizeof(properties[i].extensionName));
+            properties[i].extensionVersion = extensions[i].extensionVersion;
+        });
+    });
+}
+
+XrResult XRAPI_CALL xrCreateInstance(const XrInstanceCreateInfo* createInfo, XrInstance* instance) {
+    return Invoke(EntryPoint::xrCreateInstance, [&](Runtime& runtime) {
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_INSTANCE_CREATE_INFO || instance == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->enabledApiLayerCount > 0) {
+            return XR_ERROR_API_LAYER_NOT_PRESENT;
+        }
+        if (runtime.Instance != 0) {
+            return XR_ERROR_LIMIT_REACHED;
+        }
+
+        const std::vector<XrExtensionProperties> supported = SupportedExtensions(runtime.PendingOptions);
+        for (uint32_t i = 0; i < createInfo->enabledExtensionCount; i++) {
+            const char* name = createInfo->enabledExtensionNames[i];
+            if (std::none_of(supported.begin(), supported.end(), [&](const auto& p) { return std::strcmp(p.extensionName, name) == 0; })) {
+                return XR_ERROR_EXTENSION_NOT_PRESENT;
+            }
+        }
+
+        runtime.Options = runtime.PendingOptions;
+        std::stable_sort(runtime.Options.Script.Inputs.begin(),
+                         runtime.Options.Script.Inputs.end(),
+                         [](const InputEvent& a, const InputEvent& b) { return a.Time < b.Time; });
+
+        InstanceObject* instanceObject = Create<InstanceObject>(runtime, 0, instance);
+        instanceObject->EnabledExtensions.assign(createInfo->enabledExtensionNames,
+                                                 createInfo->enabledExtensionNames + createInfo->enabledExtensionCount);
+        runtime.Instance = reinterpret_cast<uint64_t>(*instance);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrDestroyInstance(XrInstance instance) {
+    return Invoke(EntryPoint::xrDestroyInstance, [&](Runtime& runtime) {
+        const XrResult result = DestroyHandle<InstanceObject>(runtime, instance);
+        if (XR_SUCCEEDED(result)) {
+            runtime.Instance = 0;
+        }
+        return result;
+    });
+}
+
+XrResult XRAPI_CALL xrGetInstanceProperties(XrInstance instance, XrInstanceProperties* instanceProperties) {
+    return Invoke(EntryPoint::xrGetInstanceProperties, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (instanceProperties == nullptr || instanceProperties->type != XR_TYPE_INSTANCE_PROPERTIES) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        instanceProperties->runtimeVersion = XR_MAKE_VERSION(0, 1, 0);
+        CopyString(instanceProperties->runtimeName, sizeof(instanceProperties->runtimeName), "Headless Runtime");
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrPollEvent(XrInstance instance, XrEventDataBuffer* eventData) {
+    return Invoke(EntryPoint::xrPollEvent, [&](Runtime& runtime) {
+        InstanceObject* instanceObject = Get<InstanceObject>(runtime, instance);
+        if (!instanceObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (eventData == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (instanceObject->Events.empty()) {
+            return XR_EVENT_UNAVAILABLE;
+        }
+
+        *eventData = instanceObject->Events.front();
+        instanceObject->Events.pop_front();
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrStringToPath(XrInstance instance, const char* pathString, XrPath* path) {
+    return Invoke(EntryPoint::xrStringToPath, [&](Runtime& runtime) {
+        InstanceObject* instanceObject = Get<InstanceObject>(runtime, instance);
+        if (!instanceObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (pathString == nullptr || pathString[0] != '/' || path == nullptr) {
+            return XR_ERROR_PATH_FORMAT_INVALID;
+        }
+
+        const auto [it, inserted] = instanceObject->PathIds.emplace(pathString, static_cast<XrPath>(instanceObject->Paths.size()));
+        if (inserted) {
+            instanceObject->Paths.push_back(it->first);
+        }
+        *path = it->second;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL
+xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
+    return Invoke(EntryPoint::xrPathToString, [&](Runtime& runtime) {
+        const InstanceObject* instanceObject = Get<InstanceObject>(runtime, instance);
+        if (!instanceObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        const std::string* str = PathString(*instanceObject, path);
+        if (str == nullptr || path == XR_NULL_PATH) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        return FillString(bufferCapacityInput, bufferCountOutput, buffer, *str);
+    });
+}
+#pragma endregion
+
+#pragma region System
+XrResult XRAPI_CALL xrGetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId) {
+    return Invoke(EntryPoint::xrGetSystem, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (getInfo == nullptr || getInfo->type != XR_TYPE_SYSTEM_GET_INFO || systemId == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (getInfo->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY) {
+            return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+        }
+
+        *systemId = HmdSystemId;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrGetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties* properties) {
+    return Invoke(EntryPoint::xrGetSystemProperties, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (systemId != HmdSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        if (properties == nullptr || properties->type != XR_TYPE_SYSTEM_PROPERTIES) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        properties->systemId = systemId;
+        properties->vendorId = 0;
+        CopyString(properties->systemName, sizeof(properties->systemName), "Headless HMD");
+        properties->graphicsProperties.maxSwapchainImageWidth = runtime.Options.ViewWidth * 2;
+        properties->graphicsProperties.maxSwapchainImageHeight = runtime.Options.ViewHeight * 2;
+        properties->graphicsProperties.maxLayerCount = MaxLayerCount;
+        properties->trackingProperties.orientationTracking = XR_TRUE;
+        properties->trackingProperties.positionTracking = XR_TRUE;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrEnumerateEnvironmentBlendModes(XrInstance instance,
+                                                     XrSystemId systemId,
+                                                     XrViewConfigurationType viewConfigurationType,
+                                                     uint32_t environmentBlendModeCapacityInput,
+                                                     uint32_t* environmentBlendModeCountOutput,
+                                                     XrEnvironmentBlendMode* environmentBlendModes) {
+    return Invoke(EntryPoint::xrEnumerateEnvironmentBlendModes, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (systemId != HmdSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        if (viewConfigurationType != ViewConfigurationType) {
+            return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+        }
+        return FillArray(environmentBlendModeCapacityInput, environmentBlendModeCountOutput, 1, [&](uint32_t i) {
+            environmentBlendModes[i] = runtime.Options.BlendMode;
+        });
+    });
+}
+
+XrResult XRAPI_CALL xrEnumerateViewConfigurations(XrInstance instance,
+                                                  XrSystemId systemId,
+                                                  uint32_t viewConfigurationTypeCapacityInput,
+                                                  uint32_t* viewConfigurationTypeCountOutput,
+                                                  XrViewConfigurationType* viewConfigurationTypes) {
+    return Invoke(EntryPoint::xrEnumerateViewConfigurations, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (systemId != HmdSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        return FillArray(viewConfigurationTypeCapacityInput, viewConfigurationTypeCountOutput, 1, [&](uint32_t i) {
+            viewConfigurationTypes[i] = ViewConfigurationType;
+        });
+    });
+}
+
+XrResult XRAPI_CALL xrGetViewConfigurationProperties(XrInstance instance,
+                                                     XrSystemId systemId,
+                                                     XrViewConfigurationType viewConfigurationType,
+                                                     XrViewConfigurationProperties* configurationProperties) {
+    return Invoke(EntryPoint::xrGetViewConfigurationProperties, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (systemId != HmdSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        if (viewConfigurationType != ViewConfigurationType) {
+            return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+        }
+        if (configurationProperties == nullptr || configurationProperties->type != XR_TYPE_VIEW_CONFIGURATION_PROPERTIES) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        configurationProperties->viewConfigurationType = viewConfigurationType;
+        configurationProperties->fovMutable = XR_FALSE;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrEnumerateViewConfigurationViews(XrInstance instance,
+                                                      XrSystemId systemId,
+                                                      XrViewConfigurationType viewConfigurationType,
+                                                      uint32_t viewCapacityInput,
+                                                      uint32_t* viewCountOutput,
+                                                      XrViewConfigurationView* views) {
+    return Invoke(EntryPoint::xrEnumerateViewConfigurationViews, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (systemId != HmdSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        if (viewConfigurationType != ViewConfigurationType) {
+            return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+        }
+
+        const RuntimeOptions& options = runtime.Options;
+        return FillArray(viewCapacityInput, viewCountOutput, ViewCount, [&](uint32_t i) {
+            views[i].recommendedImageRectWidth = options.ViewWidth;
+            views[i].maxImageRectWidth = options.ViewWidth * 2;
+            views[i].recommendedImageRectHeight = options.ViewHeight;
+            views[i].maxImageRectHeight = options.ViewHeight * 2;
+            views[i].recommendedSwapchainSampleCount = 1;
+            views[i].maxSwapchainSampleCount = 1;
+        });
+    });
+}
+#pragma endregion
+
+#pragma region Session
+XrResult XRAPI_CALL xrCreateSession(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session) {
+    return Invoke(EntryPoint::xrCreateSession, [&](Runtime& runtime) {
+        InstanceObject* instanceObject = Get<InstanceObject>(runtime, instance);
+        if (!instanceObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_SESSION_CREATE_INFO || session == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->systemId != HmdSystemId) {
+            return XR_ERROR_SYSTEM_INVALID;
+        }
+        if (instanceObject->Session != 0) {
+            return XR_ERROR_LIMIT_REACHED;
+        }
+
+        // Only the headless graphics binding is accepted, its absence means a session without graphics.
+        const auto* binding = reinterpret_cast<const XrBaseInStructure*>(createInfo->next);
+        if (binding != nullptr && binding->type != XR_TYPE_GRAPHICS_BINDING_HEADLESS) {
+            return XR_ERROR_GRAPHICS_DEVICE_INVALID;
+        }
+
+        SessionObject* sessionObject = Create<SessionObject>(runtime, reinterpret_cast<uint64_t>(instance), session);
+        instanceObject->Session = reinterpret_cast<uint64_t>(*session);
+        QueueSessionState(runtime, instanceObject->Session, *sessionObject, XR_SESSION_STATE_IDLE);
+        QueueSessionState(runtime, instanceObject->Session, *sessionObject, XR_SESSION_STATE_READY);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrDestroySession(XrSession session) {
+    return Invoke(EntryPoint::xrDestroySession, [&](Runtime& runtime) {
+        const SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        Get<InstanceObject>(runtime, sessionObject->Parent)->Session = 0;
+        Destroy(runtime, reinterpret_cast<uint64_t>(session));
+        runtime.FrameBegun.notify_all();
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrBeginSession(XrSession session, const XrSessionBeginInfo* beginInfo) {
+    return Invoke(EntryPoint::xrBeginSession, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (beginInfo == nullptr || beginInfo->type != XR_TYPE_SESSION_BEGIN_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (beginInfo->primaryViewConfigurationType != ViewConfigurationType) {
+            return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+        }
+        if (sessionObject->Running) {
+            return XR_ERROR_SESSION_RUNNING;
+        }
+        if (sessionObject->State != XR_SESSION_STATE_READY) {
+            return XR_ERROR_SESSION_NOT_READY;
+        }
+
+        sessionObject->Running = true;
+        sessionObject->PacingStart = std::chrono::steady_clock::now();
+
+        const uint64_t sessionId = reinterpret_cast<uint64_t>(session);
+        QueueSessionState(runtime, sessionId, *sessionObject, XR_SESSION_STATE_SYNCHRONIZED);
+        QueueSessionState(runtime, sessionId, *sessionObject, XR_SESSION_STATE_VISIBLE);
+        QueueSessionState(runtime, sessionId, *sessionObject, XR_SESSION_STATE_FOCUSED);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrEndSession(XrSession session) {
+    return Invoke(EntryPoint::xrEndSession, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (!sessionObject->Running) {
+            return XR_ERROR_SESSION_NOT_RUNNING;
+        }
+        if (sessionObject->State != XR_SESSION_STATE_STOPPING) {
+            return XR_ERROR_SESSION_NOT_STOPPING;
+        }
+
+        sessionObject->Running = false;
+        sessionObject->FrameInProgress = false;
+        sessionObject->FramesBegun = sessionObject->FramesWaited; // Frames waited but never begun are dropped.
+        runtime.FrameBegun.notify_all();
+
+        const uint64_t sessionId = reinterpret_cast<uint64_t>(session);
+        QueueSessionState(runtime, sessionId, *sessionObject, XR_SESSION_STATE_IDLE);
+        if (sessionObject->ExitRequested) {
+            QueueSessionState(runtime, sessionId, *sessionObject, XR_SESSION_STATE_EXITING);
+        }
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrRequestExitSession(XrSession session) {
+    return Invoke(EntryPoint::xrRequestExitSession, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (!sessionObject->Running) {
+            return XR_ERROR_SESSION_NOT_RUNNING;
+        }
+
+        RequestExit(runtime, reinterpret_cast<uint64_t>(session), *sessionObject);
+        return XR_SUCCESS;
+    });
+}
+#pragma endregion
+
+#pragma region Spaces
+XrResult XRAPI_CALL xrEnumerateReferenceSpaces(XrSession session,
+                                               uint32_t spaceCapacityInput,
+                                               uint32_t* spaceCountOutput,
+                                               XrReferenceSpaceType* spaces) {
+    return Invoke(EntryPoint::xrEnumerateReferenceSpaces, [&](Runtime& runtime) {
+        const SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        std::vector<XrReferenceSpaceType> types{XR_REFERENCE_SPACE_TYPE_VIEW, XR_REFERENCE_SPACE_TYPE_LOCAL, XR_REFERENCE_SPACE_TYPE_STAGE};
+        if (Get<InstanceObject>(runtime, sessionObject->Parent)->IsExtensionEnabled(XR_MSFT_UNBOUNDED_REFERENCE_SPACE_EXTENSION_NAME)) {
+            types.push_back(XR_REFERENCE_SPACE_TYPE_UNBOUNDED_MSFT);
+        }
+        return FillArray(spaceCapacityInput, spaceCountOutput, static_cast<uint32_t>(types.size()), [&](uint32_t i) {
+            spaces[i] = types[i];
+        });
+    });
+}
+
+XrResult XRAPI_CALL xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space) {
+    return Invoke(EntryPoint::xrCreateReferenceSpace, [&](Runtime& runtime) {
+        const SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_REFERENCE_SPACE_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        switch (createInfo->referenceSpaceType) {
+        case XR_REFERENCE_SPACE_TYPE_VIEW:
+        case XR_REFERENCE_SPACE_TYPE_LOCAL:
+        case XR_REFERENCE_SPACE_TYPE_STAGE:
+            break;
+        case XR_REFERENCE_SPACE_TYPE_UNBOUNDED_MSFT:
+            if (!Get<InstanceObject>(runtime, sessionObject->Parent)->IsExtensionEnabled(XR_MSFT_UNBOUNDED_REFERENCE_SPACE_EXTENSION_NAME)) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+            break;
+        default:
+            return XR_ERROR_REFERENCE_SPACE_UNSUPPORTED;
+        }
+
+        SpaceObject desc;
+        desc.Kind = SpaceKind::Reference;
+        desc.ReferenceSpaceType = createInfo->referenceSpaceType;
+        desc.Offset = createInfo->poseInReferenceSpace;
+        return CreateSpace(runtime, session, desc, space);
+    });
+}
+
+XrResult XRAPI_CALL xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo* createInfo, XrSpace* space) {
+    return Invoke(EntryPoint::xrCreateActionSpace, [&](Runtime& runtime) {
+        const SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_ACTION_SPACE_CREATE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const ActionObject* action = Get<ActionObject>(runtime, createInfo->action);
+        if (!action) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (action->ActionType != XR_ACTION_TYPE_POSE_INPUT) {
+            return XR_ERROR_ACTION_TYPE_MISMATCH;
+        }
+
+        SpaceObject desc;
+        desc.Kind = SpaceKind::Action;
+        desc.Action = reinterpret_cast<uint64_t>(createInfo->action);
+        desc.Offset = createInfo->poseInActionSpace;
+        if (createInfo->subactionPath != XR_NULL_PATH) {
+            const auto& paths = action->SubactionPaths;
+            if (std::find(paths.begin(), paths.end(), createInfo->subactionPath) == paths.end()) {
+                return XR_ERROR_PATH_UNSUPPORTED;
+            }
+            desc.Subaction = SubactionIndex(*PathString(*Get<InstanceObject>(runtime, sessionObject->Parent), createInfo->subactionPath));
+        }
+        return CreateSpace(runtime, session, desc, space);
+    });
+}
+
+XrResult XRAPI_CALL xrDestroySpace(XrSpace space) {
+    return Invoke(EntryPoint::xrDestroySpace, [&](Runtime& runtime) { return DestroyHandle<SpaceObject>(runtime, space); });
+}
+
+XrResult XRAPI_CALL xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location) {
+    return Invoke(EntryPoint::xrLocateSpace, [&](Runtime& runtime) {
+        const SpaceObject* spaceObject = Get<SpaceObject>(runtime, space);
+        const SpaceObject* baseSpaceObject = Get<SpaceObject>(runtime, baseSpace);
+        if (!spaceObject || !baseSpaceObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (location == nullptr || location->type != XR_TYPE_SPACE_LOCATION) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (time <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        location->locationFlags = Locate(runtime, *spaceObject, *baseSpaceObject, time, &location->pose);
+        runtime.SpacesLocated.fetch_add(1, std::memory_order_relaxed);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrLocateViews(XrSession session,
+                                  const XrViewLocateInfo* viewLocateInfo,
+                                  XrViewState* viewState,
+                                  uint32_t viewCapacityInput,
+                                  uint32_t* viewCountOutput,
+                                  XrView* views) {
+    return Invoke(EntryPoint::xrLocateViews, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (viewLocateInfo == nullptr || viewLocateInfo->type != XR_TYPE_VIEW_LOCATE_INFO || viewState == nullptr ||
+            viewState->type != XR_TYPE_VIEW_STATE) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (viewLocateInfo->viewConfigurationType != ViewConfigurationType) {
+            return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+        }
+        if (viewLocateInfo->displayTime <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        const SpaceObject* baseSpace = Get<SpaceObject>(runtime, viewLocateInfo->space);
+        if (!baseSpace) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        SpaceObject head;
+        head.Kind = SpaceKind::Reference;
+        head.ReferenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+
+        XrPosef headPose;
+        viewState->viewStateFlags = Locate(runtime, head, *baseSpace, viewLocateInfo->displayTime, &headPose);
+
+        const RuntimeOptions& options = runtime.Options;
+        return FillArray(viewCapacityInput, viewCountOutput, ViewCount, [&](uint32_t i) {
+            const float eyeOffset = (i == 0 ? -0.5f : 0.5f) * options.InterpupillaryDistance;
+            using xr::math::operator*;
+            views[i].pose = xr::math::Pose::Translation({eyeOffset, 0, 0}) * headPose;
+            views[i].fov = options.Fov;
+        });
+    });
+}
+#pragma endregion
+
+#pragma region Swapchains
+XrResult XRAPI_CALL xrEnumerateSwapchainFormats(XrSession session,
+                                                uint32_t formatCapacityInput,
+                                                uint32_t* formatCountOutput,
+                                                int64_t* formats) {
+    return Invoke(EntryPoint::xrEnumerateSwapchainFormats, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        constexpr uint32_t colorFormatCount = static_cast<uint32_t>(std::size(ColorSwapchainFormats));
+        constexpr uint32_t formatCount = colorFormatCount + static_cast<uint32_t>(std::size(DepthSwapchainFormats));
+        return FillArray(formatCapacityInput, formatCountOutput, formatCount, [&](uint32_t i) {
+            formats[i] = i < colorFormatCount ? ColorSwapchainFormats[i] : DepthSwapchainFormats[i - colorFormatCount];
+        });
+    });
+}
+
+XrResult XRAPI_CALL xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain) {
+    return Invoke(EntryPoint::xrCreateSwapchain, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_SWAPCHAIN_CREATE_INFO || swapchain == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!IsSupportedSwapchainFormat(createInfo->format)) {
+            return XR_ERROR_SWAPCHAIN_FORMAT_UNSUPPORTED;
+        }
+        if (createInfo->width == 0 || createInfo->height == 0 || createInfo->arraySize == 0 || createInfo->mipCount == 0 ||
+            createInfo->faceCount == 0 || createInfo->sampleCount != 1) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        SwapchainObject* swapchainObject = Create<SwapchainObject>(runtime, reinterpret_cast<uint64_t>(session), swapchain);
+        swapchainObject->ImageCount = runtime.Options.SwapchainImageCount;
+        swapchainObject->FirstImage = runtime.NextImage;
+        runtime.NextImage += swapchainObject->ImageCount;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrDestroySwapchain(XrSwapchain swapchain) {
+    return Invoke(EntryPoint::xrDestroySwapchain, [&](Runtime& runtime) { return DestroyHandle<SwapchainObject>(runtime, swapchain); });
+}
+
+XrResult XRAPI_CALL xrEnumerateSwapchainImages(XrSwapchain swapchain,
+                                               uint32_t imageCapacityInput,
+                                               uint32_t* imageCountOutput,
+                                               XrSwapchainImageBaseHeader* images) {
+    return Invoke(EntryPoint::xrEnumerateSwapchainImages, [&](Runtime& runtime) {
+        const SwapchainObject* swapchainObject = Get<SwapchainObject>(runtime, swapchain);
+        if (!swapchainObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (imageCapacityInput > 0 && (images == nullptr || images->type != XR_TYPE_SWAPCHAIN_IMAGE_HEADLESS)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        auto* headlessImages = reinterpret_cast<XrSwapchainImageHeadless*>(images);
+        return FillArray(imageCapacityInput, imageCountOutput, swapchainObject->ImageCount, [&](uint32_t i) {
+            headlessImages[i].image = swapchainObject->FirstImage + i;
+        });
+    });
+}
+
+XrResult XRAPI_CALL xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo* acquireInfo, uint32_t* index) {
+    return Invoke(EntryPoint::xrAcquireSwapchainImage, [&](Runtime& runtime) {
+        SwapchainObject* swapchainObject = Get<SwapchainObject>(runtime, swapchain);
+        if (!swapchainObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if ((acquireInfo != nullptr && acquireInfo->type != XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO) || index == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (swapchainObject->AcquiredImageCount == swapchainObject->ImageCount) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+
+        *index = swapchainObject->NextImage;
+        swapchainObject->AcquiredImageCount++;
+        swapchainObject->NextImage = (swapchainObject->NextImage + 1) % swapchainObject->ImageCount;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo* waitInfo) {
+    return Invoke(EntryPoint::xrWaitSwapchainImage, [&](Runtime& runtime) {
+        SwapchainObject* swapchainObject = Get<SwapchainObject>(runtime, swapchain);
+        if (!swapchainObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (waitInfo == nullptr || waitInfo->type != XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (swapchainObject->AcquiredImageCount == 0 || swapchainObject->FrontImageWaited) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+
+        swapchainObject->FrontImageWaited = true;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo) {
+    return Invoke(EntryPoint::xrReleaseSwapchainImage, [&](Runtime& runtime) {
+        SwapchainObject* swapchainObject = Get<SwapchainObject>(runtime, swapchain);
+        if (!swapchainObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (releaseInfo != nullptr && releaseInfo->type != XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!swapchainObject->FrontImageWaited) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+
+        swapchainObject->AcquiredImageCount--;
+        swapchainObject->FrontImageWaited = false;
+        return XR_SUCCESS;
+    });
+}
+#pragma endregion
+
+#pragma region Frame
+XrResult XRAPI_CALL xrWaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState) {
+    // As a real runtime does, block until the previously waited frame is begun, which lets another thread call xrBeginFrame.
+    {
+        Runtime& runtime = GetRuntime();
+        std::unique_lock<std::mutex> lock(runtime.Mutex);
+        runtime.FrameBegun.wait(lock, [&] {
+            const SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+            return !sessionObject || !sessionObject->Running || sessionObject->FramesBegun >= sessionObject->FramesWaited;
+        });
+    }
+
+    std::chrono::steady_clock::time_point deadline{};
+    const XrResult result = Invoke(EntryPoint::xrWaitFrame, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if ((frameWaitInfo != nullptr && frameWaitInfo->type != XR_TYPE_FRAME_WAIT_INFO) || frameState == nullptr ||
+            frameState->type != XR_TYPE_FRAME_STATE) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!sessionObject->Running) {
+            return XR_ERROR_SESSION_NOT_RUNNING;
+        }
+
+        // The simulated display clock advances by exactly one frame period per xrWaitFrame.
+        const RuntimeOptions& options = runtime.Options;
+        const uint64_t frameIndex = ++sessionObject->FramesWaited;
+        sessionObject->DisplayTime = StartTime + static_cast<XrTime>(frameIndex) * options.FramePeriod;
+        if (options.PaceToRealTime) {
+            deadline = sessionObject->PacingStart + std::chrono::nanoseconds(static_cast<XrDuration>(frameIndex - 1) * options.FramePeriod);
+        }
+
+        frameState->predictedDisplayTime = sessionObject->DisplayTime;
+        frameState->predictedDisplayPeriod = options.FramePeriod;
+        frameState->shouldRender = sessionObject->State == XR_SESSION_STATE_VISIBLE || sessionObject->State == XR_SESSION_STATE_FOCUSED;
+        if (frameState->shouldRender) {
+            sessionObject->RenderedDisplayTimes.push_back(sessionObject->DisplayTime);
+        }
+        runtime.LastPredictedDisplayTime.store(sessionObject->DisplayTime, std::memory_order_relaxed);
+        return XR_SUCCESS;
+    });
+
+    // Block outside of the runtime lock, so that other threads can keep calling into the runtime.
+    if (XR_SUCCEEDED(result) && deadline != std::chrono::steady_clock::time_point{}) {
+        std::this_thread::sleep_until(deadline);
+    }
+    return result;
+}
+
+XrResult XRAPI_CALL xrBeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo) {
+    return Invoke(EntryPoint::xrBeginFrame, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (frameBeginInfo != nullptr && frameBeginInfo->type != XR_TYPE_FRAME_BEGIN_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!sessionObject->Running) {
+            return XR_ERROR_SESSION_NOT_RUNNING;
+        }
+        if (sessionObject->FramesBegun >= sessionObject->FramesWaited) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+
+        sessionObject->FramesBegun++;
+        runtime.FramesBegun.fetch_add(1, std::memory_order_relaxed);
+        runtime.FrameBegun.notify_all();
+
+        // Beginning a frame while the previous one was not ended discards the previous frame.
+        if (sessionObject->FrameInProgress) {
+            runtime.FramesDiscarded.fetch_add(1, std::memory_order_relaxed);
+            return XR_FRAME_DISCARDED;
+        }
+        sessionObject->FrameInProgress = true;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
+    return Invoke(EntryPoint::xrEndFrame, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (frameEndInfo == nullptr || frameEndInfo->type != XR_TYPE_FRAME_END_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!sessionObject->Running) {
+            return XR_ERROR_SESSION_NOT_RUNNING;
+        }
+        if (!sessionObject->FrameInProgress) {
+            return XR_ERROR_CALL_ORDER_INVALID;
+        }
+        if (frameEndInfo->displayTime <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+        if (frameEndInfo->environmentBlendMode != runtime.Options.BlendMode) {
+            return XR_ERROR_ENVIRONMENT_BLEND_MODE_UNSUPPORTED;
+        }
+        if (frameEndInfo->layerCount > MaxLayerCount) {
+            return XR_ERROR_LAYER_LIMIT_EXCEEDED;
+        }
+
+        uint64_t viewCount = 0;
+        for (uint32_t i = 0; i < frameEndInfo->layerCount; i++) {
+            const XrCompositionLayerBaseHeader* layer = frameEndInfo->layers[i];
+            if (layer == nullptr) {
+                return XR_ERROR_LAYER_INVALID;
+            }
+            if (layer->type == XR_TYPE_COMPOSITION_LAYER_PROJECTION) {
+                const auto* projectionLayer = reinterpret_cast<const XrCompositionLayerProjection*>(layer);
+                if (projectionLayer->viewCount != ViewCount) {
+                    return XR_ERROR_VALIDATION_FAILURE;
+                }
+                viewCount += projectionLayer->viewCount;
+            }
+        }
+
+        sessionObject->FrameInProgress = false;
+        sessionObject->FramesEnded++;
+        runtime.FramesEnded.fetch_add(1, std::memory_order_relaxed);
+        runtime.LayersSubmitted.fetch_add(frameEndInfo->layerCount, std::memory_order_relaxed);
+        runtime.ViewsSubmitted.fetch_add(viewCount, std::memory_order_relaxed);
+
+        std::deque<XrTime>& renderedDisplayTimes = sessionObject->RenderedDisplayTimes;
+        while (!renderedDisplayTimes.empty() && renderedDisplayTimes.front() < frameEndInfo->displayTime) {
+            renderedDisplayTimes.pop_front(); // Discarded by a later xrBeginFrame.
+        }
+        if (!renderedDisplayTimes.empty() && renderedDisplayTimes.front() == frameEndInfo->displayTime) {
+            renderedDisplayTimes.pop_front();
+            if (frameEndInfo->layerCount == 0) {
+                runtime.RenderedFramesWithoutLayers.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (runtime.Options.EventsPerFrame > 0) {
+            const XrEventDataReferenceSpaceChangePending event{XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING,
+                                                               nullptr,
+                                                               session,
+                                                               XR_REFERENCE_SPACE_TYPE_STAGE,
+                                                               frameEndInfo->displayTime,
+                                                               XR_TRUE,
+                                                               xr::math::Pose::Identity()};
+            InstanceObject& instanceObject = *Get<InstanceObject>(runtime, sessionObject->Parent);
+            for (uint32_t i = 0; i < runtime.Options.EventsPerFrame && instanceObject.Events.size() < MaxFloodedEventQueueSize; i++) {
+                QueueEvent(instanceObject, &event, sizeof(event));
+            }
+        }
+
+        const uint32_t spaceChangePeriod = runtime.Options.ReferenceSpaceChangePeriod;
+        if (spaceChangePeriod > 0 && sessionObject->FramesEnded % spaceChangePeriod == 0 && !sessionObject->ExitRequested) {
+            InstanceObject& instanceObject = *Get<InstanceObject>(runtime, sessionObject->Parent);
+            for (XrReferenceSpaceType type :
+                 {XR_REFERENCE_SPACE_TYPE_LOCAL, XR_REFERENCE_SPACE_TYPE_STAGE, XR_REFERENCE_SPACE_TYPE_UNBOUNDED_MSFT}) {
+                if (type == XR_REFERENCE_SPACE_TYPE_UNBOUNDED_MSFT &&
+                    !instanceObject.IsExtensionEnabled(XR_MSFT_UNBOUNDED_REFERENCE_SPACE_EXTENSION_NAME)) {
+                    continue;
+                }
+                const XrEventDataReferenceSpaceChangePending event{XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING,
+                                                                   nullptr,
+                                                                   session,
+                                                                   type,
+                                                                   frameEndInfo->displayTime + runtime.Options.FramePeriod,
+                                                                   XR_TRUE,
+                                                                   xr::math::Pose::Identity()};
+                QueueEvent(instanceObject, &event, sizeof(event));
+            }
+        }
+
+        const uint64_t exitAfterFrames = runtime.Options.ExitAfterFrames;
+        if (exitAfterFrames > 0 && sessionObject->FramesEnded >= exitAfterFrames && !sessionObject->ExitRequested) {
+            RequestExit(runtime, reinterpret_cast<uint64_t>(session), *sessionObject);
+        }
+
+        // The masks of an exiting session are not read again, so they stop changing.
+        const uint32_t maskChangePeriod = runtime.Options.VisibilityMaskChangePeriod;
+        if (maskChangePeriod > 0 && sessionObject->FramesEnded % maskChangePeriod == 0 && !sessionObject->ExitRequested) {
+            sessionObject->VisibilityMaskGeneration++;
+            runtime.VisibilityMaskChanges.fetch_add(1, std::memory_order_relaxed);
+
+            XrEventDataVisibilityMaskChangedKHR event{XR_TYPE_EVENT_DATA_VISIBILITY_MASK_CHANGED_KHR, nullptr, session, ViewConfigurationType, 0};
+            InstanceObject& instanceObject = *Get<InstanceObject>(runtime, sessionObject->Parent);
+            for (event.viewIndex = 0; event.viewIndex < ViewCount; event.viewIndex++) {
+                QueueEvent(instanceObject, &event, sizeof(event));
+            }
+        }
+        return XR_SUCCESS;
+    });
+}
+#pragma endregion
+
+#pragma region Actions
+XrResult XRAPI_CALL xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo* createInfo, XrActionSet* actionSet) {
+    return Invoke(EntryPoint::xrCreateActionSet, [&](Runtime& runtime) {
+        if (!Get<InstanceObject>(runtime, instance)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_ACTION_SET_CREATE_INFO || actionSet == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->actionSetName[0] == '\0') {
+            return XR_ERROR_NAME_INVALID;
+        }
+        if (createInfo->localizedActionSetName[0] == '\0') {
+            return XR_ERROR_LOCALIZED_NAME_INVALID;
+        }
+
+        Create<ActionSetObject>(runtime, reinterpret_cast<uint64_t>(instance), actionSet);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrDestroyActionSet(XrActionSet actionSet) {
+    return Invoke(EntryPoint::xrDestroyActionSet, [&](Runtime& runtime) { return DestroyHandle<ActionSetObject>(runtime, actionSet); });
+}
+
+XrResult XRAPI_CALL xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo* createInfo, XrAction* action) {
+    return Invoke(EntryPoint::xrCreateAction, [&](Runtime& runtime) {
+        ActionSetObject* actionSetObject = Get<ActionSetObject>(runtime, actionSet);
+        if (!actionSetObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_ACTION_CREATE_INFO || action == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (createInfo->actionName[0] == '\0') {
+            return XR_ERROR_NAME_INVALID;
+        }
+        if (createInfo->localizedActionName[0] == '\0') {
+            return XR_ERROR_LOCALIZED_NAME_INVALID;
+        }
+        if (actionSetObject->Attached) {
+            return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+        }
+
+        ActionObject* actionObject = Create<ActionObject>(runtime, reinterpret_cast<uint64_t>(actionSet), action);
+        actionObject->ActionType = createInfo->actionType;
+        actionObject->SubactionPaths.assign(createInfo->subactionPaths, createInfo->subactionPaths + createInfo->countSubactionPaths);
+        actionSetObject->Actions.push_back(reinterpret_cast<uint64_t>(*action));
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrDestroyAction(XrAction action) {
+    return Invoke(EntryPoint::xrDestroyAction, [&](Runtime& runtime) {
+        const ActionObject* actionObject = Get<ActionObject>(runtime, action);
+        if (!actionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        std::vector<uint64_t>& actions = Get<ActionSetObject>(runtime, actionObject->Parent)->Actions;
+        actions.erase(std::remove(actions.begin(), actions.end(), reinterpret_cast<uint64_t>(action)), actions.end());
+        Destroy(runtime, reinterpret_cast<uint64_t>(action));
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrSuggestInteractionProfileBindings(XrInstance instance, const XrInteractionProfileSuggestedBinding* suggestedBindings) {
+    return Invoke(EntryPoint::xrSuggestInteractionProfileBindings, [&](Runtime& runtime) {
+        InstanceObject* instanceObject = Get<InstanceObject>(runtime, instance);
+        if (!instanceObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (suggestedBindings == nullptr || suggestedBindings->type != XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (instanceObject->Session != 0 && Get<SessionObject>(runtime, instanceObject->Session)->ActionSetsAttached) {
+            return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+        }
+        if (PathString(*instanceObject, suggestedBindings->interactionProfile) == nullptr) {
+            return XR_ERROR_PATH_INVALID;
+        }
+
+        for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
+            const XrActionSuggestedBinding& binding = suggestedBindings->suggestedBindings[i];
+            if (!Get<ActionObject>(runtime, binding.action)) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (PathString(*instanceObject, binding.binding) == nullptr) {
+                return XR_ERROR_PATH_INVALID;
+            }
+        }
+
+        // Later suggestions for the same interaction profile replace the earlier ones.
+        instanceObject->SuggestedBindings[suggestedBindings->interactionProfile].assign(
+            suggestedBindings->suggestedBindings, suggestedBindings->suggestedBindings + suggestedBindings->countSuggestedBindings);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attachInfo) {
+    return Invoke(EntryPoint::xrAttachSessionActionSets, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (attachInfo == nullptr || attachInfo->type != XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (sessionObject->ActionSetsAttached) {
+            return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
+        }
+        for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
+            if (!Get<ActionSetObject>(runtime, attachInfo->actionSets[i])) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+        }
+
+        // The simulated device uses the simple controller profile when it was suggested, otherwise the first suggested profile.
+        const InstanceObject& instance = *Get<InstanceObject>(runtime, sessionObject->Parent);
+        const std::vector<XrActionSuggestedBinding>* bindings = nullptr;
+        for (const auto& [profile, profileBindings] : instance.SuggestedBindings) {
+            if (bindings == nullptr || *PathString(instance, profile) == "/interaction_profiles/khr/simple_controller") {
+                bindings = &profileBindings;
+            }
+        }
+
+        sessionObject->ActionSetsAttached = true;
+        for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
+            Get<ActionSetObject>(runtime, attachInfo->actionSets[i])->Attached = true;
+        }
+        if (bindings != nullptr) {
+            for (const XrActionSuggestedBinding& binding : *bindings) {
+                ActionObject* action = Get<ActionObject>(runtime, binding.action);
+                if (action && Get<ActionSetObject>(runtime, action->Parent)->Attached) {
+                    action->Bindings.push_back(*PathString(instance, binding.binding));
+                }
+            }
+        }
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
+    return Invoke(EntryPoint::xrSyncActions, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (syncInfo == nullptr || syncInfo->type != XR_TYPE_ACTIONS_SYNC_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
+            const ActionSetObject* actionSet = Get<ActionSetObject>(runtime, syncInfo->activeActionSets[i].actionSet);
+            if (!actionSet) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+            if (!actionSet->Attached) {
+                return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+            }
+        }
+
+        // Inputs are sampled at the predicted display time of the last waited frame.
+        const bool focused = sessionObject->State == XR_SESSION_STATE_FOCUSED;
+        AdvanceInputs(runtime, *sessionObject, sessionObject->DisplayTime);
+        for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
+            for (uint64_t action : Get<ActionSetObject>(runtime, syncInfo->activeActionSets[i].actionSet)->Actions) {
+                ActionObject& actionObject = *Get<ActionObject>(runtime, action);
+                if (focused) {
+                    SyncAction(*sessionObject, actionObject, sessionObject->DisplayTime);
+                } else {
+                    DeactivateAction(actionObject);
+                }
+            }
+        }
+        return focused ? XR_SUCCESS : XR_SESSION_NOT_FOCUSED;
+    });
+}
+
+XrResult XRAPI_CALL xrGetActionStateBoolean(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateBoolean* state) {
+    return Invoke(EntryPoint::xrGetActionStateBoolean, [&](Runtime& runtime) {
+        if (state == nullptr || state->type != XR_TYPE_ACTION_STATE_BOOLEAN) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const ActionState* actionState;
+        const XrResult result = GetActionState(runtime, session, getInfo, XR_ACTION_TYPE_BOOLEAN_INPUT, &actionState);
+        if (XR_SUCCEEDED(result)) {
+            state->currentState = actionState->Current;
+            state->changedSinceLastSync = actionState->Changed;
+            state->lastChangeTime = actionState->LastChangeTime;
+            state->isActive = actionState->Active;
+        }
+        return result;
+    });
+}
+
+// Inputs of the script are binary, a float action reads them as 0 or 1.
+XrResult XRAPI_CALL xrGetActionStateFloat(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateFloat* state) {
+    return Invoke(EntryPoint::xrGetActionStateFloat, [&](Runtime& runtime) {
+        if (state == nullptr || state->type != XR_TYPE_ACTION_STATE_FLOAT) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const ActionState* actionState;
+        const XrResult result = GetActionState(runtime, session, getInfo, XR_ACTION_TYPE_FLOAT_INPUT, &actionState);
+        if (XR_SUCCEEDED(result)) {
+            state->currentState = actionState->Current ? 1.0f : 0.0f;
+            state->changedSinceLastSync = actionState->Changed;
+            state->lastChangeTime = actionState->LastChangeTime;
+            state->isActive = actionState->Active;
+        }
+        return result;
+    });
+}
+
+XrResult XRAPI_CALL xrGetActionStatePose(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStatePose* state) {
+    return Invoke(EntryPoint::xrGetActionStatePose, [&](Runtime& runtime) {
+        if (state == nullptr || state->type != XR_TYPE_ACTION_STATE_POSE) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const ActionState* actionState;
+        const XrResult result = GetActionState(runtime, session, getInfo, XR_ACTION_TYPE_POSE_INPUT, &actionState);
+        if (XR_SUCCEEDED(result)) {
+            state->isActive = actionState->Active;
+        }
+        return result;
+    });
+}
+
+XrResult XRAPI_CALL xrApplyHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo, const XrHapticBaseHeader* hapticFeedback) {
+    return Invoke(EntryPoint::xrApplyHapticFeedback, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (hapticActionInfo == nullptr || hapticActionInfo->type != XR_TYPE_HAPTIC_ACTION_INFO || hapticFeedback == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const ActionObject* action = Get<ActionObject>(runtime, hapticActionInfo->action);
+        if (!action) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        return action->ActionType == XR_ACTION_TYPE_VIBRATION_OUTPUT ? XR_SUCCESS : XR_ERROR_ACTION_TYPE_MISMATCH;
+    });
+}
+
+XrResult XRAPI_CALL xrStopHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo) {
+    return Invoke(EntryPoint::xrStopHapticFeedback, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (hapticActionInfo == nullptr || hapticActionInfo->type != XR_TYPE_HAPTIC_ACTION_INFO) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const ActionObject* action = Get<ActionObject>(runtime, hapticActionInfo->action);
+        if (!action) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        return action->ActionType == XR_ACTION_TYPE_VIBRATION_OUTPUT ? XR_SUCCESS : XR_ERROR_ACTION_TYPE_MISMATCH;
+    });
+}
+#pragma endregion
+
+#pragma region Extensions
+XrResult XRAPI_CALL xrCreateSpatialAnchorMSFT(XrSession session,
+                                              const XrSpatialAnchorCreateInfoMSFT* createInfo,
+                                              XrSpatialAnchorMSFT* anchor) {
+    return Invoke(EntryPoint::xrCreateSpatialAnchorMSFT, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_SPATIAL_ANCHOR_CREATE_INFO_MSFT || anchor == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        const SpaceObject* space = Get<SpaceObject>(runtime, createInfo->space);
+        if (!space) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        XrPosef spaceInLocal;
+        if (!LocateInLocal(runtime, *space, createInfo->time, &spaceInLocal)) {
+            return XR_ERROR_CREATE_SPATIAL_ANCHOR_FAILED_MSFT;
+        }
+
+        using xr::math::operator*;
+        SpatialAnchorObject* anchorObject = Create<SpatialAnchorObject>(runtime, reinterpret_cast<uint64_t>(session), anchor);
+        anchorObject->PoseInLocal = createInfo->pose * spaceInLocal;
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrCreateSpatialAnchorSpaceMSFT(XrSession session,
+                                                   const XrSpatialAnchorSpaceCreateInfoMSFT* createInfo,
+                                                   XrSpace* space) {
+    return Invoke(EntryPoint::xrCreateSpatialAnchorSpaceMSFT, [&](Runtime& runtime) {
+        if (createInfo == nullptr || createInfo->type != XR_TYPE_SPATIAL_ANCHOR_SPACE_CREATE_INFO_MSFT) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (!Get<SpatialAnchorObject>(runtime, createInfo->anchor)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        SpaceObject desc;
+        desc.Kind = SpaceKind::Anchor;
+        desc.Anchor = reinterpret_cast<uint64_t>(createInfo->anchor);
+        desc.Offset = createInfo->poseInAnchorSpace;
+        return CreateSpace(runtime, session, desc, space);
+    });
+}
+
+XrResult XRAPI_CALL xrDestroySpatialAnchorMSFT(XrSpatialAnchorMSFT anchor) {
+    return Invoke(EntryPoint::xrDestroySpatialAnchorMSFT,
+                  [&](Runtime& runtime) { return DestroyHandle<SpatialAnchorObject>(runtime, anchor); });
+}
+
+XrResult XRAPI_CALL xrLocateSpacesKHR(XrSession session, const XrSpacesLocateInfoKHR* locateInfo, XrSpaceLocationsKHR* spaceLocations) {
+    return Invoke(EntryPoint::xrLocateSpacesKHR, [&](Runtime& runtime) {
+        if (!Get<SessionObject>(runtime, session)) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (locateInfo == nullptr || locateInfo->type != XR_TYPE_SPACES_LOCATE_INFO_KHR || spaceLocations == nullptr ||
+            spaceLocations->type != XR_TYPE_SPACE_LOCATIONS_KHR || spaceLocations->locationCount != locateInfo->spaceCount) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        if (locateInfo->time <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        const SpaceObject* baseSpace = Get<SpaceObject>(runtime, locateInfo->baseSpace);
+        if (!baseSpace) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        for (uint32_t i = 0; i < locateInfo->spaceCount; i++) {
+            if (!Get<SpaceObject>(runtime, locateInfo->spaces[i])) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+        }
+
+        for (uint32_t i = 0; i < locateInfo->spaceCount; i++) {
+            XrSpaceLocationDataKHR& location = spaceLocations->locations[i];
+            location.locationFlags = Locate(runtime, *Get<SpaceObject>(runtime, locateInfo->spaces[i]), *baseSpace, locateInfo->time, &location.pose);
+        }
+        runtime.SpacesLocated.fetch_add(locateInfo->spaceCount, std::memory_order_relaxed);
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrGetVisibilityMaskKHR(XrSession session,
+                                           XrViewConfigurationType viewConfigurationType,
+                                           uint32_t viewIndex,
+                                           XrVisibilityMaskTypeKHR visibilityMaskType,
+                                           XrVisibilityMaskKHR* visibilityMask) {
+    return Invoke(EntryPoint::xrGetVisibilityMaskKHR, [&](Runtime& runtime) {
+        SessionObject* sessionObject = Get<SessionObject>(runtime, session);
+        if (!sessionObject) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+        if (viewConfigurationType != ViewConfigurationType) {
+            return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+        }
+        if (viewIndex >= ViewCount || visibilityMask == nullptr || visibilityMask->type != XR_TYPE_VISIBILITY_MASK_KHR) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        // A triangle cutting each corner of the view on the z = -1 plane, the other mask types are left empty. The triangles
+        // shrink and grow back each time the mask changes.
+        const bool hiddenMesh = visibilityMaskType == XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR;
+        const uint32_t vertexCount = hiddenMesh ? 12 : 0;
+        const uint32_t indexCount = hiddenMesh ? 12 : 0;
+        visibilityMask->vertexCountOutput = vertexCount;
+        visibilityMask->indexCountOutput = indexCount;
+        if (visibilityMask->vertexCapacityInput == 0 || visibilityMask->indexCapacityInput == 0) {
+            return XR_SUCCESS;
+        }
+        if (visibilityMask->vertexCapacityInput < vertexCount || visibilityMask->indexCapacityInput < indexCount) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+
+        const XrFovf& fov = runtime.Options.Fov;
+        const float left = std::tan(fov.angleLeft);
+        const float right = std::tan(fov.angleRight);
+        const float up = std::tan(fov.angleUp);
+        const float down = std::tan(fov.angleDown);
+        const float cut = sessionObject->VisibilityMaskGeneration % 2 == 0 ? 0.2f : 0.15f;
+        const float cutX = (right - left) * cut;
+        const float cutY = (up - down) * cut;
+        const XrVector2f corners[] = {{left, up}, {right, up}, {right, down}, {left, down}};
+        for (uint32_t corner = 0; corner < vertexCount / 3; corner++) {
+            const XrVector2f& c = corners[corner];
+            const float towardsCenterX = c.x == left ? cutX : -cutX;
+            const float towardsCenterY = c.y == down ? cutY : -cutY;
+            visibilityMask->vertices[corner * 3 + 0] = c;
+            visibilityMask->vertices[corner * 3 + 1] = {c.x + towardsCenterX, c.y};
+            visibilityMask->vertices[corner * 3 + 2] = {c.x, c.y + towardsCenterY};
+        }
+        for (uint32_t i = 0; i < indexCount; i++) {
+            visibilityMask->indices[i] = i;
+        }
+        return XR_SUCCESS;
+    });
+}
+
+XrResult XRAPI_CALL xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
+    return Invoke(EntryPoint::xrGetInstanceProcAddr, [&](Runtime& runtime) {
+        if (name == nullptr || function == nullptr) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+        *function = nullptr;
+
+        struct Entry {
+            const char* Name;
+            PFN_xrVoidFunction Function;
+        };
+#define HEADLESS_PROC_ENTRY(name) {#name, reinterpret_cast<PFN_xrVoidFunction>(&name)},
+        static const Entry entries[] = {HEADLESS_FOR_EACH_ENTRY_POINT(HEADLESS_PROC_ENTRY)};
+#undef HEADLESS_PROC_ENTRY
+
+        // Extension functions are only available when their extension is enabled.
+        static const std::pair<const char*, const char*> extensionFunctions[] = {
+            {"xrCreateSpatialAnchorMSFT", XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME},
+            {"xrCreateSpatialAnchorSpaceMSFT", XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME},
+            {"xrDestroySpatialAnchorMSFT", XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME},
+            {"xrLocateSpacesKHR", XR_KHR_LOCATE_SPACES_EXTENSION_NAME},
+            {"xrGetVisibilityMaskKHR", XR_KHR_VISIBILITY_MASK_EXTENSION_NAME},
+        };
+
+        const InstanceObject* instanceObject = Get<InstanceObject>(runtime, instance);
+        if (!instanceObject) {
+            const bool allowedWithoutInstance =
+                std::strcmp(name, "xrEnumerateInstanceExtensionProperties") == 0 || std::strcmp(name, "xrCreateInstance") == 0;
+            if (instance != XR_NULL_HANDLE || !allowedWithoutInstance) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+        }
+
+        const auto it = std::find_if(std::begin(entries), std::end(entries), [&](const Entry& entry) { return std::strcmp(entry.Name, name) == 0; });
+        if (it == std::end(entries)) {
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
+        }
+
+        for (const auto& [functionName, extension] : extensionFunctions) {
+            if (std::strcmp(functionName, name) == 0 && (!instanceObject || !instanceObject->IsExtensionEnabled(extension))) {
+                return XR_ERROR_FUNCTION_UNSUPPORTED;
+            }
+        }
+
+        *function = it->Function;
+        return XR_SUCCESS;
+    });
+}
+#pragma endregion
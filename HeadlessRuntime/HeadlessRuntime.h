@@ -0,0 +1,208 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+// An in-process stand-in for an OpenXR runtime, linked in place of the OpenXR loader.
+// It implements the entry points used by the sample with a scripted head and hand trajectory
+// and a simulated display clock, so that the frame loop can run deterministically without an HMD or GPU.
+
+#include <openxr/openxr.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Graphics "API" of the headless runtime: swapchain images are opaque 64-bit handles owned by the runtime.
+#define XR_HEADLESS_graphics 1
+#define XR_HEADLESS_graphics_SPEC_VERSION 1
+#define XR_HEADLESS_GRAPHICS_EXTENSION_NAME "XR_HEADLESS_graphics"
+
+// Structure types taken from a range that is not registered with Khronos.
+constexpr XrStructureType XR_TYPE_GRAPHICS_BINDING_HEADLESS = static_cast<XrStructureType>(1999000000);
+constexpr XrStructureType XR_TYPE_SWAPCHAIN_IMAGE_HEADLESS = static_cast<XrStructureType>(1999000001);
+
+struct XrGraphicsBindingHeadless {
+    XrStructureType type;
+    const void* XR_MAY_ALIAS next;
+};
+
+struct XrSwapchainImageHeadless {
+    XrStructureType type;
+    void* XR_MAY_ALIAS next;
+    uint64_t image;
+};
+
+#define HEADLESS_FOR_EACH_ENTRY_POINT(_)      \
+    _(xrGetInstanceProcAddr)                  \
+    _(xrEnumerateInstanceExtensionProperties) \
+    _(xrCreateInstance)                       \
+    _(xrDestroyInstance)                      \
+    _(xrGetInstanceProperties)                \
+    _(xrPollEvent)                            \
+    _(xrStringToPath)                         \
+    _(xrPathToString)                         \
+    _(xrGetSystem)                            \
+    _(xrGetSystemProperties)                  \
+    _(xrEnumerateEnvironmentBlendModes)       \
+    _(xrEnumerateViewConfigurations)          \
+    _(xrGetViewConfigurationProperties)       \
+    _(xrEnumerateViewConfigurationViews)      \
+    _(xrCreateSession)                        \
+    _(xrDestroySession)                       \
+    _(xrBeginSession)                         \
+    _(xrEndSession)                           \
+    _(xrRequestExitSession)                   \
+    _(xrEnumerateReferenceSpaces)             \
+    _(xrCreateReferenceSpace)                 \
+    _(xrCreateActionSpace)                    \
+    _(xrDestroySpace)                         \
+    _(xrLocateSpace)                          \
+    _(xrEnumerateSwapchainFormats)            \
+    _(xrCreateSwapchain)                      \
+    _(xrDestroySwapchain)                     \
+    _(xrEnumerateSwapchainImages)             \
+    _(xrAcquireSwapchainImage)                \
+    _(xrWaitSwapchainImage)                   \
+    _(xrReleaseSwapchainImage)                \
+    _(xrWaitFrame)                            \
+    _(xrBeginFrame)                           \
+    _(xrEndFrame)                             \
+    _(xrLocateViews)                          \
+    _(xrCreateActionSet)                      \
+    _(xrDestroyActionSet)                     \
+    _(xrCreateAction)                         \
+    _(xrDestroyAction)                        \
+    _(xrSuggestInteractionProfileBindings)    \
+    _(xrAttachSessionActionSets)              \
+    _(xrSyncActions)                          \
+    _(xrGetActionStateBoolean)                \
+    _(xrGetActionStateFloat)                  \
+    _(xrGetActionStatePose)                   \
+    _(xrApplyHapticFeedback)                  \
+    _(xrStopHapticFeedback)                   \
+    _(xrCreateSpatialAnchorMSFT)              \
+    _(xrCreateSpatialAnchorSpaceMSFT)         \
+    _(xrDestroySpatialAnchorMSFT)             \
+    _(xrLocateSpacesKHR)                      \
+    _(xrGetVisibilityMaskKHR)
+
+namespace headless {
+#define HEADLESS_ENUM_ENTRY(name) name,
+    enum class EntryPoint : uint32_t { HEADLESS_FOR_EACH_ENTRY_POINT(HEADLESS_ENUM_ENTRY) Count };
+#undef HEADLESS_ENUM_ENTRY
+
+    constexpr uint32_t EntryPointCount = static_cast<uint32_t>(EntryPoint::Count);
+    const char* ToCString(EntryPoint entryPoint);
+
+    // Swapchain formats of the runtime, as DXGI_FORMAT values so that the format preferences of D3D11 renderers keep working.
+    constexpr int64_t ColorSwapchainFormats[] = {
+        29, // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+        91, // DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
+        28, // DXGI_FORMAT_R8G8B8A8_UNORM
+        87, // DXGI_FORMAT_B8G8R8A8_UNORM
+    };
+    constexpr int64_t DepthSwapchainFormats[] = {
+        40, // DXGI_FORMAT_D32_FLOAT
+        55, // DXGI_FORMAT_D16_UNORM
+        45, // DXGI_FORMAT_D24_UNORM_S8_UINT
+    };
+
+    enum class Hand : uint32_t { Left, Right, Count };
+
+    // A pose at a time relative to the start of the simulated clock.
+    struct Keyframe {
+        XrDuration Time;
+        XrPosef Pose;
+    };
+
+    // Keyframes are sorted by time and interpolated linearly, the track repeats itself when Loop is set.
+    struct PoseTrack {
+        std::vector<Keyframe> Keyframes;
+        bool Loop{true};
+
+        XrPosef Sample(XrDuration time) const;
+    };
+
+    // Sets the boolean input at the given binding path (e.g. "/user/hand/right/input/select/click") from Time onwards.
+    struct InputEvent {
+        XrDuration Time;
+        std::string BindingPath;
+        bool Value;
+    };
+
+    // Poses are expressed in the LOCAL reference space, head tracks the VIEW reference space.
+    struct Script {
+        PoseTrack Head;
+        std::array<PoseTrack, static_cast<size_t>(Hand::Count)> Hands;
+        std::vector<InputEvent> Inputs;
+    };
+
+    // A gentle head sway, both hands circling in front of the user and a right hand select click every second.
+    Script DefaultScript();
+
+    struct RuntimeOptions {
+        headless::Script Script{DefaultScript()};
+
+        XrDuration FramePeriod{16'666'667};
+        bool PaceToRealTime{false};  // Otherwise xrWaitFrame returns immediately and only the simulated clock advances.
+        uint64_t ExitAfterFrames{0}; // The runtime asks the application to exit after that many frames, 0 never does.
+        uint32_t EventsPerFrame{0};  // Reference space change events of the stage space queued at every xrEndFrame, to flood the event queue.
+        uint32_t VisibilityMaskChangePeriod{0}; // The visibility masks change every that many frames, with an event per view.
+        // A change of the origin of the LOCAL, STAGE and UNBOUNDED spaces is announced every that many frames, for the display time
+        // of the next frame. The new origins are given at the previous ones, so spaces are located as before.
+        uint32_t ReferenceSpaceChangePeriod{0};
+
+        XrEnvironmentBlendMode BlendMode{XR_ENVIRONMENT_BLEND_MODE_ADDITIVE};
+        uint32_t ViewWidth{1440};
+        uint32_t ViewHeight{936};
+        uint32_t SwapchainImageCount{3};
+        float InterpupillaryDistance{0.064f};
+        XrFovf Fov{-0.7f, 0.7f, 0.6f, -0.6f};
+
+        bool SupportsDepthComposition{true};
+        bool SupportsUnboundedSpace{true};
+        bool SupportsSpatialAnchor{true};
+        bool SupportsLocateSpaces{true};
+        bool SupportsVisibilityMask{true}; // The hidden area of each view is a triangle in every corner.
+    };
+
+    // Takes effect at the next xrCreateInstance.
+    void SetOptions(RuntimeOptions options);
+
+    struct RuntimeStats {
+        std::array<uint64_t, EntryPointCount> Calls{};
+        uint64_t FramesBegun{0};
+        uint64_t FramesEnded{0};
+        uint64_t FramesDiscarded{0};
+        uint64_t RenderedFramesWithoutLayers{0}; // Ended without any layer, although xrWaitFrame returned shouldRender.
+        uint64_t LayersSubmitted{0};
+        uint64_t ViewsSubmitted{0};
+        uint64_t SpacesLocated{0};
+        uint64_t VisibilityMaskChanges{0};
+        XrTime LastPredictedDisplayTime{0};
+
+        uint64_t CallCount(EntryPoint entryPoint) const {
+            return Calls[static_cast<uint32_t>(entryPoint)];
+        }
+    };
+
+    RuntimeStats GetStats();
+    void ResetStats();
+
+    // Whether the calling thread is running an entry point of the runtime, e.g. to tell the heap allocations of the runtime from
+    // the ones of the application.
+    bool IsInRuntimeCall();
+} // namespace headless
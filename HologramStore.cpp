@@ -0,0 +1,166 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "HologramStore.h"
+
+namespace sample {
+    HologramId HologramStore::Add(xr::SpaceHandle space, xr::SpatialAnchorHandle anchor, const XrVector3f& scale, MeshId mesh) {
+        CHECK(space.Get() != XR_NULL_HANDLE);
+
+        uint32_t slot;
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slot = (uint32_t)m_indexOfSlot.size();
+            CHECK_MSG(slot <= SlotMask, "Too many holograms");
+            m_indexOfSlot.push_back(InvalidIndex);
+            m_generationOfSlot.push_back(0);
+        }
+        const HologramId id = (m_generationOfSlot[slot] << SlotBits) | slot;
+        m_indexOfSlot[slot] = Size();
+        m_idOfIndex.push_back(id);
+
+        m_spaces.push_back(space.Get());
+        m_posesInSpace.push_back(xr::math::Pose::Identity());
+        m_scales.push_back(scale);
+        m_meshes.push_back(mesh);
+        m_posesInScene.push_back(xr::math::Pose::Identity());
+        m_visible.push_back(0);
+        m_spaceHandles.push_back(std::move(space));
+        m_anchorHandles.push_back(std::move(anchor));
+        return id;
+    }
+
+    void HologramStore::Remove(HologramId id) {
+        uint32_t index = IndexOf(id);
+        const uint32_t last = Size() - 1;
+
+        // A removed hologram with a pose in space is replaced by the last of those, whose place is then filled like any other.
+        if (index < m_posedCount) {
+            m_posedCount--;
+            if (index != m_posedCount) {
+                MoveHologram(m_posedCount, index);
+            }
+            index = m_posedCount;
+        }
+
+        // Move the last hologram into the removed slot to keep the arrays packed.
+        if (index != last) {
+            MoveHologram(last, index);
+        }
+
+        m_spaces.pop_back();
+        m_posesInSpace.pop_back();
+        m_scales.pop_back();
+        m_meshes.pop_back();
+        m_posesInScene.pop_back();
+        m_visible.pop_back();
+        m_spaceHandles.pop_back();
+        m_anchorHandles.pop_back();
+        m_idOfIndex.pop_back();
+
+        FreeSlot(id & SlotMask);
+    }
+
+    void HologramStore::Clear() {
+        for (HologramId id : m_idOfIndex) {
+            FreeSlot(id & SlotMask);
+        }
+
+        m_spaces.clear();
+        m_posesInSpace.clear();
+        m_scales.clear();
+        m_meshes.clear();
+        m_posesInScene.clear();
+        m_visible.clear();
+        m_spaceHandles.clear();
+        m_anchorHandles.clear();
+        m_idOfIndex.clear();
+        m_posedCount = 0;
+    }
+
+    void HologramStore::SetPoseInSpace(HologramId id, const XrPosef& pose) {
+        uint32_t index = IndexOf(id);
+        if (index >= m_posedCount) {
+            if (index != m_posedCount) {
+                SwapHolograms(index, m_posedCount);
+            }
+            index = m_posedCount++;
+        }
+        m_posesInSpace[index] = pose;
+    }
+
+    void HologramStore::Reserve(uint32_t capacity) {
+        m_spaces.reserve(capacity);
+        m_posesInSpace.reserve(capacity);
+        m_scales.reserve(capacity);
+        m_meshes.reserve(capacity);
+        m_posesInScene.reserve(capacity);
+        m_visible.reserve(capacity);
+        m_spaceHandles.reserve(capacity);
+        m_anchorHandles.reserve(capacity);
+        m_idOfIndex.reserve(capacity);
+        m_indexOfSlot.reserve(capacity);
+        m_generationOfSlot.reserve(capacity);
+        m_freeSlots.reserve(capacity);
+    }
+
+    void HologramStore::MoveHologram(uint32_t from, uint32_t to) {
+        m_spaces[to] = m_spaces[from];
+        m_posesInSpace[to] = m_posesInSpace[from];
+        m_scales[to] = m_scales[from];
+        m_meshes[to] = m_meshes[from];
+        m_posesInScene[to] = m_posesInScene[from];
+        m_visible[to] = m_visible[from];
+        m_spaceHandles[to] = std::move(m_spaceHandles[from]);
+        m_anchorHandles[to] = std::move(m_anchorHandles[from]);
+
+        m_idOfIndex[to] = m_idOfIndex[from];
+        m_indexOfSlot[m_idOfIndex[to] & SlotMask] = to;
+    }
+
+    void HologramStore::SwapHolograms(uint32_t a, uint32_t b) {
+        std::swap(m_spaces[a], m_spaces[b]);
+        std::swap(m_posesInSpace[a], m_posesInSpace[b]);
+        std::swap(m_scales[a], m_scales[b]);
+        std::swap(m_meshes[a], m_meshes[b]);
+        std::swap(m_posesInScene[a], m_posesInScene[b]);
+        std::swap(m_visible[a], m_visible[b]);
+        std::swap(m_spaceHandles[a], m_spaceHandles[b]);
+        std::swap(m_anchorHandles[a], m_anchorHandles[b]);
+
+        std::swap(m_idOfIndex[a], m_idOfIndex[b]);
+        m_indexOfSlot[m_idOfIndex[a] & SlotMask] = a;
+        m_indexOfSlot[m_idOfIndex[b] & SlotMask] = b;
+    }
+
+    void HologramStore::FreeSlot(uint32_t slot) {
+        m_indexOfSlot[slot] = InvalidIndex;
+        m_generationOfSlot[slot] = (m_generationOfSlot[slot] + 1) & (std::numeric_limits<uint32_t>::max() >> SlotBits);
+        m_freeSlots.push_back(slot);
+    }
+
+    bool HologramStore::Contains(HologramId id) const {
+        const uint32_t slot = id & SlotMask;
+        return slot < m_indexOfSlot.size() && m_indexOfSlot[slot] != InvalidIndex && m_generationOfSlot[slot] == id >> SlotBits;
+    }
+
+    uint32_t HologramStore::IndexOf(HologramId id) const {
+        CHECK(Contains(id));
+        return m_indexOfSlot[id & SlotMask];
+    }
+} // namespace sample
@@ -0,0 +1,120 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include "MeshRegistry.h"
+
+namespace sample {
+    // Identifies a hologram for its whole lifetime, unlike its index in the store which changes when holograms are removed.
+    // The id of a removed hologram is reused with another generation, so a stale id is never Contains().
+    using HologramId = uint32_t;
+
+    // Holograms stored as parallel arrays, so per-frame passes over them are linear loops over packed data.
+    // All arrays have Size() elements and are indexed by IndexOf(id). Array pointers are invalidated by Add(), Remove(), Clear() and
+    // SetPoseInSpace(), and Clear() also invalidates all ids.
+    class HologramStore {
+    public:
+        HologramId Add(xr::SpaceHandle space, xr::SpatialAnchorHandle anchor, const XrVector3f& scale, MeshId mesh);
+        void Remove(HologramId id);
+        void Clear();
+
+        // Add() does not allocate while the store holds at most capacity holograms.
+        void Reserve(uint32_t capacity);
+
+        bool Contains(HologramId id) const;
+        uint32_t IndexOf(HologramId id) const;
+
+        uint32_t Size() const {
+            return (uint32_t)m_spaces.size();
+        }
+
+        // Holograms given a pose in their space come first, the PosedCount() ones. The others are at the origin of their space,
+        // so their pose in the scene is the located pose of their space and per-frame passes skip the pose multiplication for them.
+        uint32_t PosedCount() const {
+            return m_posedCount;
+        }
+
+        // Moves the hologram among the first PosedCount() ones if it is not yet, which changes the index of another hologram.
+        void SetPoseInSpace(HologramId id, const XrPosef& pose);
+
+        // Space each hologram is placed in.
+        const XrSpace* Spaces() const {
+            return m_spaces.data();
+        }
+
+        // Hologram pose in its space. Default to identity.
+        const XrPosef* PosesInSpace() const {
+            return m_posesInSpace.data();
+        }
+
+        XrVector3f* Scales() {
+            return m_scales.data();
+        }
+        const XrVector3f* Scales() const {
+            return m_scales.data();
+        }
+
+        // Mesh drawn for each hologram.
+        const MeshId* Meshes() const {
+            return m_meshes.data();
+        }
+
+        // Hologram pose in the scene, updated every frame.
+        XrPosef* PosesInScene() {
+            return m_posesInScene.data();
+        }
+        const XrPosef* PosesInScene() const {
+            return m_posesInScene.data();
+        }
+
+        // Non-zero when the hologram was located this frame.
+        uint8_t* Visible() {
+            return m_visible.data();
+        }
+        const uint8_t* Visible() const {
+            return m_visible.data();
+        }
+
+    private:
+        constexpr static uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        // An id is the slot of the hologram in m_indexOfSlot, with the generation of the slot in the high bits.
+        constexpr static uint32_t SlotBits = 24;
+        constexpr static uint32_t SlotMask = (1u << SlotBits) - 1;
+
+        void FreeSlot(uint32_t slot);
+        void MoveHologram(uint32_t from, uint32_t to);
+        void SwapHolograms(uint32_t a, uint32_t b);
+
+        std::vector<XrSpace> m_spaces;
+        std::vector<XrPosef> m_posesInSpace;
+        std::vector<XrVector3f> m_scales;
+        std::vector<MeshId> m_meshes;
+        std::vector<XrPosef> m_posesInScene;
+        std::vector<uint8_t> m_visible;
+
+        // Owning handles, kept apart so that the hot arrays stay packed.
+        std::vector<xr::SpaceHandle> m_spaceHandles;
+        std::vector<xr::SpatialAnchorHandle> m_anchorHandles;
+
+        std::vector<HologramId> m_idOfIndex;
+        std::vector<uint32_t> m_indexOfSlot;      // As many slots as holograms were ever stored at once.
+        std::vector<uint32_t> m_generationOfSlot; // Incremented when the hologram of the slot is removed.
+        std::vector<uint32_t> m_freeSlots;
+
+        uint32_t m_posedCount{0};
+    };
+} // namespace sample
@@ -0,0 +1,57 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include "CubeMesh.h"
+
+// Geometry of the octahedron drawn for each hand joint, with the vertex layout of the cube.
+namespace sample {
+    namespace JointMesh {
+        using Vertex = CubeMesh::Vertex;
+
+        constexpr XrVector3f Light{0.8f, 0.8f, 0.8f};
+        constexpr XrVector3f Dark{0.4f, 0.4f, 0.4f};
+
+        // Vertices of an octahedron inscribed in a sphere of 0.5 meter radius, on the axes. (Positive/Negative X, Y, Z)
+        constexpr XrVector3f PX{0.5f, 0, 0};
+        constexpr XrVector3f NX{-0.5f, 0, 0};
+        constexpr XrVector3f PY{0, 0.5f, 0};
+        constexpr XrVector3f NY{0, -0.5f, 0};
+        constexpr XrVector3f PZ{0, 0, 0.5f};
+        constexpr XrVector3f NZ{0, 0, -0.5f};
+
+#define JOINT_FACE(V1, V2, V3, COLOR) {V1, COLOR}, {V2, COLOR}, {V3, COLOR},
+
+        constexpr Vertex c_jointVertices[] = {
+            JOINT_FACE(PX, PZ, PY, Light) // +X+Y+Z
+            JOINT_FACE(NX, PY, PZ, Dark)  // -X+Y+Z
+            JOINT_FACE(PX, NY, PZ, Dark)  // +X-Y+Z
+            JOINT_FACE(NX, PZ, NY, Light) // -X-Y+Z
+            JOINT_FACE(PX, PY, NZ, Dark)  // +X+Y-Z
+            JOINT_FACE(NX, NZ, PY, Light) // -X+Y-Z
+            JOINT_FACE(PX, NZ, NY, Light) // +X-Y-Z
+            JOINT_FACE(NX, NY, NZ, Dark)  // -X-Y-Z
+        };
+
+        // Winding order is clockwise as for the cube. Neighbouring faces use different colors.
+        constexpr unsigned short c_jointIndices[] = {
+            0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11,
+            12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+        };
+
+#undef JOINT_FACE
+    } // namespace JointMesh
+} // namespace sample
@@ -0,0 +1,68 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "MeshRegistry.h"
+
+namespace {
+    uint32_t AttributeTypeSize(sample::VertexAttributeType type) {
+        switch (type) {
+        case sample::VertexAttributeType::Uint8: return 1;
+        case sample::VertexAttributeType::Int16: return 2;
+        case sample::VertexAttributeType::Float: return 4;
+        }
+        THROW("Unknown vertex attribute type");
+    }
+} // namespace
+
+namespace sample {
+    MeshId MeshRegistry::Add(Mesh mesh) {
+        CHECK(mesh.Vertices != nullptr && mesh.VertexCount > 0);
+        CHECK(mesh.Indices != nullptr && mesh.IndexCount > 0);
+
+        // Attributes are packed in layout order, locate the position within a vertex.
+        std::optional<uint32_t> positionOffset;
+        uint32_t offset = 0;
+        for (const VertexElement& element : mesh.Layout) {
+            if (element.Attribute == VertexAttribute::Position) {
+                CHECK_MSG(element.Type == VertexAttributeType::Float && element.Count == 3, "Mesh positions must be 3 floats");
+                positionOffset = offset;
+            }
+            offset += element.Count * AttributeTypeSize(element.Type);
+        }
+        CHECK_MSG(positionOffset.has_value(), "Mesh has no position attribute");
+        CHECK_MSG(offset == mesh.VertexStride, "Mesh vertex stride does not match its layout");
+
+        const uint8_t* const vertices = static_cast<const uint8_t*>(mesh.Vertices);
+        XrVector3f min, max;
+        for (uint32_t i = 0; i < mesh.VertexCount; i++) {
+            XrVector3f position;
+            std::memcpy(&position, vertices + i * mesh.VertexStride + *positionOffset, sizeof(position));
+            if (i == 0) {
+                min = max = position;
+            } else {
+                min = {std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z)};
+                max = {std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z)};
+            }
+        }
+        using namespace xr::math;
+        mesh.Bounds = {(min + max) * 0.5f, (max - min) * 0.5f};
+
+        const MeshId id = (MeshId)m_meshes.size();
+        m_bounds.push_back(mesh.Bounds);
+        m_meshes.push_back(std::move(mesh));
+        return id;
+    }
+} // namespace sample
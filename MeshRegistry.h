@@ -0,0 +1,66 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include "AssetArchiveFormat.h"
+#include "XrUtility/XrFrustum.h"
+
+namespace sample {
+    // Index of a mesh in its MeshRegistry, valid for the lifetime of the registry.
+    using MeshId = uint32_t;
+
+    enum class IndexFormat : uint8_t { Uint16, Uint32 };
+
+    // Geometry drawn for a renderable. Vertex and index data are referenced, not copied, and must outlive the registry,
+    // e.g. constant arrays or the streams of a mapped asset archive.
+    struct Mesh {
+        std::vector<VertexElement> Layout;
+        uint32_t VertexStride{0};
+        const void* Vertices{nullptr};
+        uint32_t VertexCount{0};
+        const void* Indices{nullptr};
+        uint32_t IndexCount{0};
+        IndexFormat IndexType{IndexFormat::Uint16};
+
+        // Bounds of the vertex positions in the mesh space, computed when the mesh is added.
+        xr::math::Box Bounds{};
+    };
+
+    // Meshes referenced by the renderables of the scene. Meshes are added up front and never removed, so the registry can be read
+    // from the render thread while the scene is updated.
+    class MeshRegistry {
+    public:
+        // The layout must have a Position attribute of 3 floats.
+        MeshId Add(Mesh mesh);
+
+        const Mesh& Get(MeshId id) const {
+            return m_meshes[id];
+        }
+
+        uint32_t Size() const {
+            return (uint32_t)m_meshes.size();
+        }
+
+        // Bounds of each mesh, indexed by MeshId, as expected by xr::math::CullBoxes().
+        const xr::math::Box* Bounds() const {
+            return m_bounds.data();
+        }
+
+    private:
+        std::vector<Mesh> m_meshes;
+        std::vector<xr::math::Box> m_bounds;
+    };
+} // namespace sample
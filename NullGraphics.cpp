@@ -0,0 +1,203 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+#include "pch.h"
+#include "OpenXrProgram.h"
+#include "AssetArchive.h"
+#include "RenderQueue.h"
+#include "HeadlessRuntime/HeadlessRuntime.h"
+
+namespace {
+    struct NullGraphics : sample::IGraphicsPlugin {
+        NullGraphics(sample::NullGraphicsStats* stats, const sample::NullGraphicsAssets& assets)
+            : m_stats(stats)
+            , m_assetPaths(assets.Paths)
+            , m_archivePath(assets.ArchivePath)
+            , m_loadAssetsOnDeviceInitialization(assets.LoadOnDeviceInitialization) {
+            if (!m_loadAssetsOnDeviceInitialization) {
+                StartLoadingAssets();
+            }
+        }
+
+        const char* GraphicsExtensionName() const override {
+            return XR_HEADLESS_GRAPHICS_EXTENSION_NAME;
+        }
+
+        const XrBaseInStructure* InitializeDevice(XrInstance, XrSystemId, const xr::ExtensionDispatchTable&) override {
+            if (m_loadAssetsOnDeviceInitialization) {
+                StartLoadingAssets();
+            }
+            for (const std::shared_future<sample::AssetPtr>& asset : m_assets) {
+                const sample::AssetPtr& content = asset.get();
+                if (m_stats != nullptr) {
+                    m_stats->AssetBytes += content->Size();
+                }
+            }
+            m_assets.clear();
+
+            if (m_archiveAsset.valid()) {
+                const sample::AssetArchive archive(m_archiveAsset.get());
+                if (m_stats != nullptr) {
+                    for (uint32_t i = 0; i < archive.EntryCount(); i++) {
+                        m_stats->AssetBytes += archive.Entries()[i].Size;
+                    }
+                    m_stats->ArchiveEntryCount += archive.EntryCount();
+                }
+                m_archiveAsset = {};
+            }
+
+            return reinterpret_cast<const XrBaseInStructure*>(&m_graphicsBinding);
+        }
+
+        const std::vector<int64_t>& SupportedColorFormats() const override {
+            return m_colorFormats;
+        }
+
+        const std::vector<int64_t>& SupportedDepthFormats() const override {
+            return m_depthFormats;
+        }
+
+        std::vector<sample::SwapchainImage> EnumerateSwapchainImages(XrSwapchain swapchain) const override {
+            xr::SmallVector<XrSwapchainImageHeadless, 4> images;
+            xr::EnumerateSwapchainImages(swapchain, {XR_TYPE_SWAPCHAIN_IMAGE_HEADLESS}, images);
+
+            std::vector<sample::SwapchainImage> textures;
+            for (const XrSwapchainImageHeadless& image : images) {
+                textures.push_back(reinterpret_cast<sample::SwapchainImage>(static_cast<uintptr_t>(image.image)));
+            }
+            return textures;
+        }
+
+        void RenderView(const XrRect2Di&,
+                        const float[4],
+                        const std::pmr::vector<xr::math::ViewProjection>& viewProjections,
+                        uint32_t colorImageIndex,
+                        uint32_t depthImageIndex,
+                        const sample::DrawList& cubes,
+                        const sample::MeshRegistry& meshes,
+                        const sample::VisibilityMask& visibilityMask) override {
+            // A renderer looks the views of the images up by index, they are created by CacheSwapchainImageViews.
+            CHECK(colorImageIndex < m_colorImageCount && depthImageIndex < m_depthImageCount);
+
+            if (m_stats == nullptr) {
+                return;
+            }
+
+            // Sort the draws and compute their model matrices as a renderer would, to account for their cost.
+            m_queue.Clear();
+            m_queue.Push(cubes, 0, 0, sample::CenterOfViews(viewProjections));
+            m_queue.Sort();
+            m_queue.Gather(cubes);
+            m_models.reserve(cubes.Poses.capacity());
+            m_models.resize(m_queue.Size());
+            xr::math::PosesToMatrices(m_queue.Transforms(), 0, m_queue.Size(), m_models.data());
+
+            sample::NullGraphicsStats::Frame frame;
+            frame.CubeCount = (uint32_t)cubes.Size();
+            frame.ViewCount = (uint32_t)viewProjections.size();
+            frame.BatchCount = (uint32_t)m_queue.Batches().size();
+            frame.MeshCount = CountDistinctMeshes(cubes, meshes);
+            frame.SubmittedBytes = sizeof(xr::math::ViewProjection) * frame.ViewCount + sizeof(float[16]) * frame.CubeCount;
+            frame.VisibilityMaskTriangleCount = (uint32_t)visibilityMask.Indices().size() / 3;
+            if (visibilityMask.Version() != m_visibilityMaskVersion) {
+                // A renderer uploads the mask again only when it changes.
+                frame.SubmittedBytes += visibilityMask.Vertices().size() * sizeof(XrVector3f) + visibilityMask.Indices().size() * sizeof(uint32_t);
+                m_visibilityMaskVersion = visibilityMask.Version();
+                m_stats->VisibilityMaskUploadCount++;
+            }
+
+            if (m_stats->FrameCount == 0) {
+                m_stats->FirstRenderTime = sample::FrameClockNow();
+            }
+            m_stats->LastFrame = frame;
+            m_stats->FrameCount++;
+            m_stats->CubeCount += frame.CubeCount;
+            m_stats->ViewCount += frame.ViewCount;
+            m_stats->BatchCount += frame.BatchCount;
+            m_stats->MeshCount += frame.MeshCount;
+            m_stats->SubmittedBytes += frame.SubmittedBytes;
+            m_stats->MaxCubeCount = std::max(m_stats->MaxCubeCount, frame.CubeCount);
+        }
+
+        // There is no view to create, but the views a renderer would create are counted, one per image.
+        void CacheSwapchainImageViews(int64_t,
+                                      const std::vector<sample::SwapchainImage>& colorTextures,
+                                      int64_t,
+                                      const std::vector<sample::SwapchainImage>& depthTextures) override {
+            m_colorImageCount = (uint32_t)colorTextures.size();
+            m_depthImageCount = (uint32_t)depthTextures.size();
+            m_createdViewCount += m_colorImageCount + m_depthImageCount;
+            if (m_stats != nullptr) {
+                m_stats->CreatedViewCount = m_createdViewCount;
+            }
+        }
+
+        void ClearSwapchainImageViews() override {
+            m_colorImageCount = 0;
+            m_depthImageCount = 0;
+        }
+
+        uint64_t CreatedViewCount() const override {
+            return m_createdViewCount;
+        }
+
+    private:
+        // Counted apart from the render queue, to check its batches.
+        uint32_t CountDistinctMeshes(const sample::DrawList& draws, const sample::MeshRegistry& meshes) {
+            m_meshDrawn.assign(meshes.Size(), 0);
+            uint32_t meshCount = 0;
+            for (sample::MeshId mesh : draws.Meshes) {
+                meshCount += m_meshDrawn[mesh] == 0 ? 1 : 0;
+                m_meshDrawn[mesh] = 1;
+            }
+            return meshCount;
+        }
+
+        void StartLoadingAssets() {
+            for (const std::string& path : m_assetPaths) {
+                m_assets.push_back(m_assetLoader.LoadAsync(path));
+            }
+            if (!m_archivePath.empty()) {
+                m_archiveAsset = m_assetLoader.LoadAsync(m_archivePath);
+            }
+        }
+
+        sample::NullGraphicsStats* const m_stats;
+        const std::vector<std::string> m_assetPaths;
+        const std::string m_archivePath;
+        const bool m_loadAssetsOnDeviceInitialization;
+        sample::AssetLoader m_assetLoader;
+        std::vector<std::shared_future<sample::AssetPtr>> m_assets;
+        std::shared_future<sample::AssetPtr> m_archiveAsset;
+        sample::RenderQueue m_queue;
+        std::vector<xr::math::Float4x4> m_models; // Indexed by sorted draw.
+        uint64_t m_visibilityMaskVersion{0};
+        std::vector<uint8_t> m_meshDrawn; // Indexed by MeshId.
+        uint32_t m_colorImageCount{0};
+        uint32_t m_depthImageCount{0};
+        uint64_t m_createdViewCount{0};
+        XrGraphicsBindingHeadless m_graphicsBinding{XR_TYPE_GRAPHICS_BINDING_HEADLESS};
+
+        const std::vector<int64_t> m_colorFormats{std::begin(headless::ColorSwapchainFormats), std::end(headless::ColorSwapchainFormats)};
+        const std::vector<int64_t> m_depthFormats{std::begin(headless::DepthSwapchainFormats), std::end(headless::DepthSwapchainFormats)};
+    };
+} // namespace
+
+namespace sample {
+    std::unique_ptr<sample::IGraphicsPlugin> CreateNullGraphics(NullGraphicsStats* stats, const NullGraphicsAssets& assets) {
+        return std::make_unique<NullGraphics>(stats, assets);
+    }
+} // namespace sample
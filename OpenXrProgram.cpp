@@ -16,13 +16,110 @@
 
 #include "pch.h"
 #include "OpenXrProgram.h"
-#include "DxUtility.h"
+#include "CubeMesh.h"
+#include "JointMesh.h"
+#include "FrameArena.h"
+#include "FrameChannel.h"
+#include "HologramStore.h"
+#include "XrUtility/XrActionManifest.h"
+#include "XrUtility/XrActionStateCache.h"
+#include "XrUtility/XrEventDispatcher.h"
+#include "XrUtility/XrFrustum.h"
+#include "XrUtility/XrMathBatch.h"
+#include "XrUtility/XrSpaceLocator.h"
 
 namespace {
+    // The cube drawn for the holograms and the hands, referencing the constant geometry of CubeMesh.h.
+    sample::Mesh MakeCubeMesh() {
+        using namespace sample::CubeMesh;
+        sample::Mesh mesh;
+        mesh.Layout.assign(std::begin(c_cubeLayout), std::end(c_cubeLayout));
+        mesh.VertexStride = sizeof(Vertex);
+        mesh.Vertices = c_cubeVertices;
+        mesh.VertexCount = (uint32_t)std::size(c_cubeVertices);
+        mesh.Indices = c_cubeIndices;
+        mesh.IndexCount = (uint32_t)std::size(c_cubeIndices);
+        mesh.IndexType = sample::IndexFormat::Uint16;
+        return mesh;
+    }
+
+    // The octahedron drawn for the hand joints, referencing the constant geometry of JointMesh.h.
+    sample::Mesh MakeJointMesh() {
+        using namespace sample::JointMesh;
+        sample::Mesh mesh;
+        mesh.Layout.assign(std::begin(sample::CubeMesh::c_cubeLayout), std::end(sample::CubeMesh::c_cubeLayout));
+        mesh.VertexStride = sizeof(Vertex);
+        mesh.Vertices = c_jointVertices;
+        mesh.VertexCount = (uint32_t)std::size(c_jointVertices);
+        mesh.Indices = c_jointIndices;
+        mesh.IndexCount = (uint32_t)std::size(c_jointIndices);
+        mesh.IndexType = sample::IndexFormat::Uint16;
+        return mesh;
+    }
+
+    // Size of the cubes following the hands.
+    constexpr XrVector3f HandCubeScale{0.1f, 0.1f, 0.1f};
+
+    constexpr std::string_view LeftHandPath = "/user/hand/left";
+    constexpr std::string_view RightHandPath = "/user/hand/right";
+    constexpr std::string_view SimpleController = "/interaction_profiles/khr/simple_controller";
+
+    // Indices of the actions in ActionDeclarations.
+    constexpr uint32_t PlaceAction = 0;
+    constexpr uint32_t PoseAction = 1;
+    constexpr uint32_t VibrateAction = 2;
+    constexpr uint32_t ExitAction = 3;
+
+    constexpr std::array<xr::ActionDeclaration, 4> ActionDeclarations{{
+        {"place_hologram", "Place Hologram", XR_ACTION_TYPE_BOOLEAN_INPUT, {LeftHandPath, RightHandPath}},
+        {"hand_pose", "Hand Pose", XR_ACTION_TYPE_POSE_INPUT, {LeftHandPath, RightHandPath}},
+        {"vibrate", "Vibrate", XR_ACTION_TYPE_VIBRATION_OUTPUT, {LeftHandPath, RightHandPath}},
+        {"exit_session", "Exit session", XR_ACTION_TYPE_BOOLEAN_INPUT, {LeftHandPath, RightHandPath}},
+    }};
+
+    constexpr std::array<xr::BindingDeclaration, 8> BindingDeclarations{{
+        {SimpleController, "place_hologram", "/user/hand/right/input/select/click"},
+        {SimpleController, "place_hologram", "/user/hand/left/input/select/click"},
+        {SimpleController, "hand_pose", "/user/hand/right/input/grip/pose"},
+        {SimpleController, "hand_pose", "/user/hand/left/input/grip/pose"},
+        {SimpleController, "vibrate", "/user/hand/right/output/haptic"},
+        {SimpleController, "vibrate", "/user/hand/left/output/haptic"},
+        {SimpleController, "exit_session", "/user/hand/right/input/menu/click"},
+        {SimpleController, "exit_session", "/user/hand/left/input/menu/click"},
+    }};
+
+    constexpr xr::ActionManifest ActionManifest =
+        xr::MakeActionManifest("place_hologram_action_set", "Placement", ActionDeclarations, BindingDeclarations);
+    static_assert(ActionManifest.IsValid(), "Each binding must reference a declared action");
+    static_assert(ActionManifest.FindAction("place_hologram") == PlaceAction && ActionManifest.FindAction("hand_pose") == PoseAction &&
+                  ActionManifest.FindAction("vibrate") == VibrateAction && ActionManifest.FindAction("exit_session") == ExitAction);
+
     struct ImplementOpenXrProgram : sample::IOpenXrProgram {
-        ImplementOpenXrProgram(std::string applicationName, std::unique_ptr<sample::IGraphicsPluginD3D11> graphicsPlugin)
+        ImplementOpenXrProgram(std::string applicationName,
+                               std::unique_ptr<sample::IGraphicsPlugin> graphicsPlugin,
+                               const sample::ProgramOptions& options)
             : m_applicationName(std::move(applicationName))
-            , m_graphicsPlugin(std::move(graphicsPlugin)) {
+            , m_graphicsPlugin(std::move(graphicsPlugin))
+            , m_options(options) {
+            if (options.DynamicResolution) {
+                m_dynamicResolution.emplace(*options.DynamicResolution);
+            }
+
+            m_cubeMeshId = m_meshes.Add(MakeCubeMesh());
+            m_jointMeshId = m_meshes.Add(MakeJointMesh());
+            m_holograms.Reserve(options.ReservedHologramCount);
+            m_locatedSpaces.reserve(m_handSpaces.size() + options.ReservedHologramCount);
+
+            SubscribeToEvents();
+        }
+
+        ~ImplementOpenXrProgram() override {
+            // The pipeline threads use the program, stop them before it is destroyed.
+            try {
+                StopFramePipeline();
+            } catch (...) {
+            }
+            xr::PathCache::Global().Forget(m_instance.Get());
         }
 
         void Run() override {
@@ -41,16 +138,29 @@ namespace {
                         break;
                     }
 
-                    if (m_sessionRunning) {
+                    if (m_sessionRunning && m_options.PipelinedFrameLoop) {
+                        // The pipeline threads run the frames, this thread only processes events.
+                        if (!m_framePipeline) {
+                            StartFramePipeline();
+                        }
+                        m_framePipeline->EventsDrained();
+                        CheckFramePipeline();
+
+                        if (!m_moreEventsPending && m_framePipeline) {
+                            using namespace std::chrono_literals;
+                            m_framePipeline->WaitForDrainRequest(5ms);
+                        }
+                    } else if (m_sessionRunning) {
                         PollActions();
                         RenderFrame();
-                    } else {
+                    } else if (!m_moreEventsPending) {
                         // Throttle loop since xrWaitFrame won't be called.
                         using namespace std::chrono_literals;
                         std::this_thread::sleep_for(250ms);
                     }
                 }
 
+                StopFramePipeline();
                 if (requestRestart) {
                     PrepareSessionRestart();
                 }
@@ -74,21 +184,22 @@ namespace {
             CHECK_XRCMD(xrCreateInstance(&createInfo, m_instance.Put()));
 
             m_extensions.PopulateDispatchTable(m_instance.Get());
+
+            // The entry point of an extension that was not enabled must not be called, even if the runtime exports it.
+            m_spaceLocator = xr::SpaceLocator(m_optionalExtensions.LocateSpacesSupported ? m_extensions.xrLocateSpacesKHR : nullptr);
         }
 
         std::vector<const char*> SelectExtensions() {
             // Fetch the list of extensions supported by the runtime.
-            uint32_t extensionCount;
-            CHECK_XRCMD(xrEnumerateInstanceExtensionProperties(nullptr, 0, &extensionCount, nullptr));
-            std::vector<XrExtensionProperties> extensionProperties(extensionCount, {XR_TYPE_EXTENSION_PROPERTIES});
-            CHECK_XRCMD(xrEnumerateInstanceExtensionProperties(nullptr, extensionCount, &extensionCount, extensionProperties.data()));
+            xr::SmallVector<XrExtensionProperties, 32> extensionProperties;
+            xr::EnumerateInstanceExtensionProperties(extensionProperties);
 
             std::vector<const char*> enabledExtensions;
 
             // Add a specific extension to the list of extensions to be enabled, if it is supported.
             auto EnableExtentionIfSupported = [&](const char* extensionName) {
-                for (uint32_t i = 0; i < extensionCount; i++) {
-                    if (strcmp(extensionProperties[i].extensionName, extensionName) == 0) {
+                for (const XrExtensionProperties& extensionProperty : extensionProperties) {
+                    if (strcmp(extensionProperty.extensionName, extensionName) == 0) {
                         enabledExtensions.push_back(extensionName);
                         return true;
                     }
@@ -96,13 +207,16 @@ namespace {
                 return false;
             };
 
-            // D3D11 extension is required for this sample, so check if it's supported.
-            CHECK(EnableExtentionIfSupported(XR_KHR_D3D11_ENABLE_EXTENSION_NAME));
+            // The graphics API extension of the plugin is required for this sample, so check if it's supported.
+            CHECK(EnableExtentionIfSupported(m_graphicsPlugin->GraphicsExtensionName()));
 
             // Additional optional extensions for enhanced functionality. Track whether enabled in m_optionalExtensions.
             m_optionalExtensions.DepthExtensionSupported = EnableExtentionIfSupported(XR_KHR_COMPOSITION_LAYER_DEPTH_EXTENSION_NAME);
             m_optionalExtensions.UnboundedRefSpaceSupported = EnableExtentionIfSupported(XR_MSFT_UNBOUNDED_REFERENCE_SPACE_EXTENSION_NAME);
             m_optionalExtensions.SpatialAnchorSupported = EnableExtentionIfSupported(XR_MSFT_SPATIAL_ANCHOR_EXTENSION_NAME);
+            m_optionalExtensions.LocateSpacesSupported = EnableExtentionIfSupported(XR_KHR_LOCATE_SPACES_EXTENSION_NAME);
+            m_optionalExtensions.VisibilityMaskSupported = EnableExtentionIfSupported(XR_KHR_VISIBILITY_MASK_EXTENSION_NAME);
+            m_optionalExtensions.HandTrackingSupported = EnableExtentionIfSupported(XR_MSFT_HAND_TRACKING_PREVIEW_EXTENSION_NAME);
 
             return enabledExtensions;
         }
@@ -110,82 +224,37 @@ namespace {
         void CreateActions() {
             CHECK(m_instance.Get() != XR_NULL_HANDLE);
 
-            // Create an action set.
-            {
-                XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
-                strcpy_s(actionSetInfo.actionSetName, "place_hologram_action_set");
-                strcpy_s(actionSetInfo.localizedActionSetName, "Placement");
-                CHECK_XRCMD(xrCreateActionSet(m_instance.Get(), &actionSetInfo, m_actionSet.Put()));
-            }
-
-            // Create actions.
-            {
-                // Enable subaction path filtering for left or right hand.
-                m_subactionPaths[LeftSide] = GetXrPath("/user/hand/left");
-                m_subactionPaths[RightSide] = GetXrPath("/user/hand/right");
-
-                // Create an input action to place a hologram.
-                {
-                    XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
-                    actionInfo.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
-                    strcpy_s(actionInfo.actionName, "place_hologram");
-                    strcpy_s(actionInfo.localizedActionName, "Place Hologram");
-                    actionInfo.countSubactionPaths = (uint32_t)m_subactionPaths.size();
-                    actionInfo.subactionPaths = m_subactionPaths.data();
-                    CHECK_XRCMD(xrCreateAction(m_actionSet.Get(), &actionInfo, m_placeAction.Put()));
-                }
-
-                // Create an input action getting the left and right hand poses.
-                {
-                    XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
-                    actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
-                    strcpy_s(actionInfo.actionName, "hand_pose");
-                    strcpy_s(actionInfo.localizedActionName, "Hand Pose");
-                    actionInfo.countSubactionPaths = (uint32_t)m_subactionPaths.size();
-                    actionInfo.subactionPaths = m_subactionPaths.data();
-                    CHECK_XRCMD(xrCreateAction(m_actionSet.Get(), &actionInfo, m_poseAction.Put()));
-                }
+            m_actionContext.emplace(m_instance.Get());
+            const std::vector<XrAction> actions = xr::ExpandActionManifest(*m_actionContext, ActionManifest);
+            m_placeAction = actions[PlaceAction];
+            m_poseAction = actions[PoseAction];
+            m_vibrateAction = actions[VibrateAction];
+            m_exitAction = actions[ExitAction];
 
-                // Create an output action for vibrating the left and right controller.
-                {
-                    XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
-                    actionInfo.actionType = XR_ACTION_TYPE_VIBRATION_OUTPUT;
-                    strcpy_s(actionInfo.actionName, "vibrate");
-                    strcpy_s(actionInfo.localizedActionName, "Vibrate");
-                    actionInfo.countSubactionPaths = (uint32_t)m_subactionPaths.size();
-                    actionInfo.subactionPaths = m_subactionPaths.data();
-                    CHECK_XRCMD(xrCreateAction(m_actionSet.Get(), &actionInfo, m_vibrateAction.Put()));
-                }
+            // Enable subaction path filtering for left or right hand.
+            m_subactionPaths[LeftSide] = GetXrPath(xr::PathString(LeftHandPath));
+            m_subactionPaths[RightSide] = GetXrPath(xr::PathString(RightHandPath));
 
-                // Create an input action to exit session
-                {
-                    XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
-                    actionInfo.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
-                    strcpy_s(actionInfo.actionName, "exit_session");
-                    strcpy_s(actionInfo.localizedActionName, "Exit session");
-                    actionInfo.countSubactionPaths = (uint32_t)m_subactionPaths.size();
-                    actionInfo.subactionPaths = m_subactionPaths.data();
-                    CHECK_XRCMD(xrCreateAction(m_actionSet.Get(), &actionInfo, m_exitAction.Put()));
-                }
-            }
+            // Cache the state of the input actions of each hand, and react to their changes instead of polling them.
+            for (uint32_t side : {LeftSide, RightSide}) {
+                const XrPath subactionPath = m_subactionPaths[side];
 
-            // Setup suggest bindings for simple controller.
-            {
-                std::vector<XrActionSuggestedBinding> bindings;
-                bindings.push_back({m_placeAction.Get(), GetXrPath("/user/hand/right/input/select/click")});
-                bindings.push_back({m_placeAction.Get(), GetXrPath("/user/hand/left/input/select/click")});
-                bindings.push_back({m_poseAction.Get(), GetXrPath("/user/hand/right/input/grip/pose")});
-                bindings.push_back({m_poseAction.Get(), GetXrPath("/user/hand/left/input/grip/pose")});
-                bindings.push_back({m_vibrateAction.Get(), GetXrPath("/user/hand/right/output/haptic")});
-                bindings.push_back({m_vibrateAction.Get(), GetXrPath("/user/hand/left/output/haptic")});
-                bindings.push_back({m_exitAction.Get(), GetXrPath("/user/hand/right/input/menu/click")});
-                bindings.push_back({m_exitAction.Get(), GetXrPath("/user/hand/left/input/menu/click")});
+                // When select button is pressed, place the cube at the location of corresponding hand.
+                const uint32_t place = m_actionStates.Declare(m_placeAction, XR_ACTION_TYPE_BOOLEAN_INPUT, subactionPath);
+                m_actionStates.Subscribe(place, xr::ActionEdge::Pressed, [this, side](const xr::ActionStateChange& change) {
+                    // Use the poses at the time when action happened to do the placement
+                    PlaceHologramInHand(side, change.LastChangeTime);
+                    ApplyVibration(m_subactionPaths[side]);
+                });
 
-                XrInteractionProfileSuggestedBinding suggestedBindings{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
-                suggestedBindings.interactionProfile = GetXrPath("/interaction_profiles/khr/simple_controller");
-                suggestedBindings.suggestedBindings = bindings.data();
-                suggestedBindings.countSuggestedBindings = (uint32_t)bindings.size();
-                CHECK_XRCMD(xrSuggestInteractionProfileBindings(m_instance.Get(), &suggestedBindings));
+                // This sample, when menu button is released, requests to quit the session, and therefore quit the application.
+                const uint32_t exit = m_actionStates.Declare(m_exitAction, XR_ACTION_TYPE_BOOLEAN_INPUT, subactionPath);
+                m_actionStates.Subscribe(exit, xr::ActionEdge::Released, [this, side](const xr::ActionStateChange& change) {
+                    if (m_actionStates.IsActive(change.Entry)) { // Not released by the loss of the input focus.
+                        CHECK_XRCMD(xrRequestExitSession(m_session.Get()));
+                        ApplyVibration(m_subactionPaths[side]);
+                    }
+                });
             }
         }
 
@@ -197,7 +266,7 @@ namespace {
             systemInfo.formFactor = m_formFactor;
             while (true) {
                 XrResult result = xrGetSystem(m_instance.Get(), &systemInfo, &m_systemId);
-                if (SUCCEEDED(result)) {
+                if (XR_SUCCEEDED(result)) {
                     break;
                 } else if (result == XR_ERROR_FORM_FACTOR_UNAVAILABLE) {
                     DEBUG_PRINT("No headset detected.  Trying again in one second...");
@@ -211,13 +280,9 @@ namespace {
             // Choose an environment blend mode.
             {
                 // Query the list of supported environment blend modes for the current system
-                uint32_t count;
-                CHECK_XRCMD(xrEnumerateEnvironmentBlendModes(m_instance.Get(), m_systemId, m_primaryViewConfigType, 0, &count, nullptr));
-                CHECK(count > 0); // A system must support at least one environment blend mode.
-
-                std::vector<XrEnvironmentBlendMode> environmentBlendModes(count);
-                CHECK_XRCMD(xrEnumerateEnvironmentBlendModes(
-                    m_instance.Get(), m_systemId, m_primaryViewConfigType, count, &count, environmentBlendModes.data()));
+                xr::SmallVector<XrEnvironmentBlendMode, 4> environmentBlendModes;
+                xr::EnumerateEnvironmentBlendModes(m_instance.Get(), m_systemId, m_primaryViewConfigType, environmentBlendModes);
+                CHECK(!environmentBlendModes.empty()); // A system must support at least one environment blend mode.
 
                 // This sample supports all modes, pick the system's preferred one.
                 m_environmentBlendMode = environmentBlendModes[0];
@@ -233,41 +298,33 @@ namespace {
             CHECK(m_systemId != XR_NULL_SYSTEM_ID);
             CHECK(m_session.Get() == XR_NULL_HANDLE);
 
-            // Create the D3D11 device for the adapter associated with the system.
-            XrGraphicsRequirementsD3D11KHR graphicsRequirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D11_KHR};
-            CHECK_XRCMD(m_extensions.xrGetD3D11GraphicsRequirementsKHR(m_instance.Get(), m_systemId, &graphicsRequirements));
-
-            // Create a list of feature levels which are both supported by the OpenXR runtime and this application.
-            std::vector<D3D_FEATURE_LEVEL> featureLevels = {D3D_FEATURE_LEVEL_12_1,
-                                                            D3D_FEATURE_LEVEL_12_0,
-                                                            D3D_FEATURE_LEVEL_11_1,
-                                                            D3D_FEATURE_LEVEL_11_0,
-                                                            D3D_FEATURE_LEVEL_10_1,
-                                                            D3D_FEATURE_LEVEL_10_0};
-            featureLevels.erase(std::remove_if(featureLevels.begin(),
-                                               featureLevels.end(),
-                                               [&](D3D_FEATURE_LEVEL fl) { return fl < graphicsRequirements.minFeatureLevel; }),
-                                featureLevels.end());
-            CHECK_MSG(featureLevels.size() != 0, "Unsupported minimum feature level!");
-
-            ID3D11Device* device = m_graphicsPlugin->InitializeDevice(graphicsRequirements.adapterLuid, featureLevels);
-
-            XrGraphicsBindingD3D11KHR graphicsBinding{XR_TYPE_GRAPHICS_BINDING_D3D11_KHR};
-            graphicsBinding.device = device;
+            // Create the graphics device for the system, and bind it to the session.
+            const XrBaseInStructure* graphicsBinding = m_graphicsPlugin->InitializeDevice(m_instance.Get(), m_systemId, m_extensions);
 
             XrSessionCreateInfo createInfo{XR_TYPE_SESSION_CREATE_INFO};
-            createInfo.next = &graphicsBinding;
+            createInfo.next = graphicsBinding;
             createInfo.systemId = m_systemId;
             CHECK_XRCMD(xrCreateSession(m_instance.Get(), &createInfo, m_session.Put()));
 
-            XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
-            std::vector<XrActionSet> actionSets = {m_actionSet.Get()};
-            attachInfo.countActionSets = (uint32_t)actionSets.size();
-            attachInfo.actionSets = actionSets.data();
-            CHECK_XRCMD(xrAttachSessionActionSets(m_session.Get(), &attachInfo));
+            m_actionContext->AttachActionsToSession(m_session.Get());
 
             CreateSpaces();
             CreateSwapchains();
+            CreateHandJointSource();
+        }
+
+        // Joints come from the recording of the options if any, otherwise from the runtime when the system tracks hands.
+        void CreateHandJointSource() {
+            if (m_options.RecordedHandJoints) {
+                m_handJointSource = std::make_unique<sample::HandJointPlayback>(m_options.RecordedHandJoints);
+            } else if (m_optionalExtensions.HandTrackingSupported) {
+                XrSystemHandTrackingPropertiesMSFT handTrackingProperties{XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_MSFT};
+                XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES, &handTrackingProperties};
+                CHECK_XRCMD(xrGetSystemProperties(m_instance.Get(), m_systemId, &systemProperties));
+                if (handTrackingProperties.supportsHandTracking) {
+                    m_handJointSource = std::make_unique<sample::HandTracker>(m_session.Get(), m_extensions);
+                }
+            }
         }
 
         void CreateSpaces() {
@@ -292,27 +349,23 @@ namespace {
             // Create a space for each hand pointer pose.
             for (uint32_t side : {LeftSide, RightSide}) {
                 XrActionSpaceCreateInfo createInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
-                createInfo.action = m_poseAction.Get();
+                createInfo.action = m_poseAction;
                 createInfo.poseInActionSpace = xr::math::Pose::Identity();
                 createInfo.subactionPath = m_subactionPaths[side];
-                CHECK_XRCMD(xrCreateActionSpace(m_session.Get(), &createInfo, m_cubesInHand[side].Space.Put()));
+                CHECK_XRCMD(xrCreateActionSpace(m_session.Get(), &createInfo, m_handSpaces[side].Put()));
             }
         }
 
-        std::tuple<DXGI_FORMAT, DXGI_FORMAT> SelectSwapchainPixelFormats() {
+        std::tuple<int64_t, int64_t> SelectSwapchainPixelFormats() {
             CHECK(m_session.Get() != XR_NULL_HANDLE);
 
             // Query runtime preferred swapchain formats.
-            uint32_t swapchainFormatCount;
-            CHECK_XRCMD(xrEnumerateSwapchainFormats(m_session.Get(), 0, &swapchainFormatCount, nullptr));
-
-            std::vector<int64_t> swapchainFormats(swapchainFormatCount);
-            CHECK_XRCMD(xrEnumerateSwapchainFormats(
-                m_session.Get(), (uint32_t)swapchainFormats.size(), &swapchainFormatCount, swapchainFormats.data()));
+            xr::SmallVector<int64_t, 32> swapchainFormats;
+            xr::EnumerateSwapchainFormats(m_session.Get(), swapchainFormats);
 
             // Choose the first runtime preferred format that this app supports.
-            auto SelectPixelFormat = [](const std::vector<int64_t>& runtimePreferredFormats,
-                                        const std::vector<DXGI_FORMAT>& applicationSupportedFormats) {
+            auto SelectPixelFormat = [](const auto& runtimePreferredFormats,
+                                        const std::vector<int64_t>& applicationSupportedFormats) {
                 auto found = std::find_first_of(std::begin(runtimePreferredFormats),
                                                 std::end(runtimePreferredFormats),
                                                 std::begin(applicationSupportedFormats),
@@ -320,11 +373,11 @@ namespace {
                 if (found == std::end(runtimePreferredFormats)) {
                     THROW("No runtime swapchain format is supported.");
                 }
-                return (DXGI_FORMAT)*found;
+                return *found;
             };
 
-            DXGI_FORMAT colorSwapchainFormat = SelectPixelFormat(swapchainFormats, m_graphicsPlugin->SupportedColorFormats());
-            DXGI_FORMAT depthSwapchainFormat = SelectPixelFormat(swapchainFormats, m_graphicsPlugin->SupportedDepthFormats());
+            const int64_t colorSwapchainFormat = SelectPixelFormat(swapchainFormats, m_graphicsPlugin->SupportedColorFormats());
+            const int64_t depthSwapchainFormat = SelectPixelFormat(swapchainFormats, m_graphicsPlugin->SupportedDepthFormats());
 
             return {colorSwapchainFormat, depthSwapchainFormat};
         }
@@ -343,14 +396,10 @@ namespace {
             const auto [colorSwapchainFormat, depthSwapchainFormat] = SelectSwapchainPixelFormats();
 
             // Query and cache view configuration views.
-            uint32_t viewCount;
-            CHECK_XRCMD(xrEnumerateViewConfigurationViews(m_instance.Get(), m_systemId, m_primaryViewConfigType, 0, &viewCount, nullptr));
+            xr::EnumerateViewConfigurationViews(m_instance.Get(), m_systemId, m_primaryViewConfigType, m_renderResources->ConfigViews);
+            const uint32_t viewCount = m_renderResources->ConfigViews.size();
             CHECK(viewCount == m_stereoViewCount);
 
-            m_renderResources->ConfigViews.resize(viewCount, {XR_TYPE_VIEW_CONFIGURATION_VIEW});
-            CHECK_XRCMD(xrEnumerateViewConfigurationViews(
-                m_instance.Get(), m_systemId, m_primaryViewConfigType, viewCount, &viewCount, m_renderResources->ConfigViews.data()));
-
             // Using texture array for better performance, but requiring left/right views have identical sizes.
             const XrViewConfigurationView& view = m_renderResources->ConfigViews[0];
             CHECK(m_renderResources->ConfigViews[0].recommendedImageRectWidth ==
@@ -360,48 +409,70 @@ namespace {
             CHECK(m_renderResources->ConfigViews[0].recommendedSwapchainSampleCount ==
                   m_renderResources->ConfigViews[1].recommendedSwapchainSampleCount);
 
-            // Use recommended rendering parameters for a balance between quality and performance
-            const uint32_t imageRectWidth = view.recommendedImageRectWidth;
-            const uint32_t imageRectHeight = view.recommendedImageRectHeight;
+            // Use recommended rendering parameters for a balance between quality and performance.
+            // With dynamic resolution, the swapchains are created for the largest scale and each frame renders a part of them.
+            m_renderResources->RecommendedExtent = {(int32_t)view.recommendedImageRectWidth, (int32_t)view.recommendedImageRectHeight};
+            XrExtent2Di swapchainExtent = m_renderResources->RecommendedExtent;
+            if (m_dynamicResolution) {
+                m_dynamicResolution->Reset();
+                swapchainExtent = sample::ScaleExtent(m_renderResources->RecommendedExtent,
+                                                      m_dynamicResolution->Settings().MaxScale,
+                                                      {(int32_t)view.maxImageRectWidth, (int32_t)view.maxImageRectHeight});
+            }
+            const uint32_t imageRectWidth = swapchainExtent.width;
+            const uint32_t imageRectHeight = swapchainExtent.height;
             const uint32_t swapchainSampleCount = view.recommendedSwapchainSampleCount;
 
             // Create swapchains with texture array for color and depth images.
             // The texture array has the size of viewCount, and they are rendered in a single pass using VPRT.
             const uint32_t textureArraySize = viewCount;
             m_renderResources->ColorSwapchain =
-                CreateSwapchainD3D11(m_session.Get(),
-                                     colorSwapchainFormat,
-                                     imageRectWidth,
-                                     imageRectHeight,
-                                     textureArraySize,
-                                     swapchainSampleCount,
-                                     0 /*createFlags*/,
-                                     XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT);
+                CreateSwapchain(m_session.Get(),
+                                colorSwapchainFormat,
+                                imageRectWidth,
+                                imageRectHeight,
+                                textureArraySize,
+                                swapchainSampleCount,
+                                0 /*createFlags*/,
+                                XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT);
 
             m_renderResources->DepthSwapchain =
-                CreateSwapchainD3D11(m_session.Get(),
-                                     depthSwapchainFormat,
-                                     imageRectWidth,
-                                     imageRectHeight,
-                                     textureArraySize,
-                                     swapchainSampleCount,
-                                     0 /*createFlags*/,
-                                     XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+                CreateSwapchain(m_session.Get(),
+                                depthSwapchainFormat,
+                                imageRectWidth,
+                                imageRectHeight,
+                                textureArraySize,
+                                swapchainSampleCount,
+                                0 /*createFlags*/,
+                                XR_SWAPCHAIN_USAGE_SAMPLED_BIT | XR_SWAPCHAIN_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+
+            // Create the views of every swapchain image once, so the frame loop does not create them per frame.
+            m_graphicsPlugin->CacheSwapchainImageViews(colorSwapchainFormat,
+                                                       m_renderResources->ColorSwapchain.Images,
+                                                       depthSwapchainFormat,
+                                                       m_renderResources->DepthSwapchain.Images);
 
             // Preallocate view buffers for xrLocateViews later inside frame loop.
-            m_renderResources->Views.resize(viewCount, {XR_TYPE_VIEW});
-        }
-
-        struct SwapchainD3D11;
-        SwapchainD3D11 CreateSwapchainD3D11(XrSession session,
-                                            DXGI_FORMAT format,
-                                            uint32_t width,
-                                            uint32_t height,
-                                            uint32_t arraySize,
-                                            uint32_t sampleCount,
-                                            XrSwapchainCreateFlags createFlags,
-                                            XrSwapchainUsageFlags usageFlags) {
-            SwapchainD3D11 swapchain;
+            for (FrameSnapshot& frame : m_renderResources->FrameSnapshots) {
+                frame.Views.resize(viewCount, {XR_TYPE_VIEW});
+            }
+            m_renderResources->ProjectionLayerViews.resize(viewCount);
+            if (m_optionalExtensions.DepthExtensionSupported) {
+                m_renderResources->DepthInfoViews.resize(viewCount);
+            }
+            m_visibilityMaskChanged = true;
+        }
+
+        struct Swapchain;
+        Swapchain CreateSwapchain(XrSession session,
+                                  int64_t format,
+                                  uint32_t width,
+                                  uint32_t height,
+                                  uint32_t arraySize,
+                                  uint32_t sampleCount,
+                                  XrSwapchainCreateFlags createFlags,
+                                  XrSwapchainUsageFlags usageFlags) {
+            Swapchain swapchain;
             swapchain.Format = format;
             swapchain.Width = width;
             swapchain.Height = height;
@@ -420,81 +491,100 @@ namespace {
 
             CHECK_XRCMD(xrCreateSwapchain(session, &swapchainCreateInfo, swapchain.Handle.Put()));
 
-            uint32_t chainLength;
-            CHECK_XRCMD(xrEnumerateSwapchainImages(swapchain.Handle.Get(), 0, &chainLength, nullptr));
-
-            swapchain.Images.resize(chainLength, {XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR});
-            CHECK_XRCMD(xrEnumerateSwapchainImages(swapchain.Handle.Get(),
-                                                   (uint32_t)swapchain.Images.size(),
-                                                   &chainLength,
-                                                   reinterpret_cast<XrSwapchainImageBaseHeader*>(swapchain.Images.data())));
+            swapchain.Images = m_graphicsPlugin->EnumerateSwapchainImages(swapchain.Handle.Get());
 
             return swapchain;
         }
 
-        void ProcessEvents(bool* exitRenderLoop, bool* requestRestart) {
-            *exitRenderLoop = *requestRestart = false;
-
-            auto pollEvent = [&](XrEventDataBuffer& eventData) -> bool {
-                eventData.type = XR_TYPE_EVENT_DATA_BUFFER;
-                eventData.next = nullptr;
-                return CHECK_XRCMD(xrPollEvent(m_instance.Get(), &eventData)) == XR_SUCCESS;
-            };
-
-            XrEventDataBuffer eventData{};
-            while (pollEvent(eventData)) {
-                switch (eventData.type) {
-                case XR_TYPE_EVENT_DATA_INSTANCE_LOSS_PENDING: {
-                    *exitRenderLoop = true;
-                    *requestRestart = false;
-                    return;
+        void SubscribeToEvents() {
+            m_events.Subscribe<XrEventDataInstanceLossPending>([this](const XrEventDataInstanceLossPending&) {
+                m_exitRenderLoop = true;
+                m_instanceLost = true;
+            });
+            m_events.Subscribe<XrEventDataSessionStateChanged>([this](const XrEventDataSessionStateChanged& stateEvent) {
+                CHECK(m_session.Get() != XR_NULL_HANDLE && m_session.Get() == stateEvent.session);
+                m_sessionState = stateEvent.state;
+                switch (m_sessionState) {
+                case XR_SESSION_STATE_READY: {
+                    CHECK(m_session.Get() != XR_NULL_HANDLE);
+                    XrSessionBeginInfo sessionBeginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+                    sessionBeginInfo.primaryViewConfigurationType = m_primaryViewConfigType;
+                    CHECK_XRCMD(xrBeginSession(m_session.Get(), &sessionBeginInfo));
+                    m_sessionRunning = true;
+                    break;
                 }
-                case XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED: {
-                    const auto stateEvent = *reinterpret_cast<const XrEventDataSessionStateChanged*>(&eventData);
-                    CHECK(m_session.Get() != XR_NULL_HANDLE && m_session.Get() == stateEvent.session);
-                    m_sessionState = stateEvent.state;
-                    switch (m_sessionState) {
-                    case XR_SESSION_STATE_READY: {
-                        CHECK(m_session.Get() != XR_NULL_HANDLE);
-                        XrSessionBeginInfo sessionBeginInfo{XR_TYPE_SESSION_BEGIN_INFO};
-                        sessionBeginInfo.primaryViewConfigurationType = m_primaryViewConfigType;
-                        CHECK_XRCMD(xrBeginSession(m_session.Get(), &sessionBeginInfo));
-                        m_sessionRunning = true;
-                        break;
-                    }
-                    case XR_SESSION_STATE_STOPPING: {
-                        m_sessionRunning = false;
-                        CHECK_XRCMD(xrEndSession(m_session.Get()));
-                        break;
-                    }
-                    case XR_SESSION_STATE_EXITING: {
-                        // Do not attempt to restart because user closed this session.
-                        *exitRenderLoop = true;
-                        *requestRestart = false;
-                        break;
-                    }
-                    case XR_SESSION_STATE_LOSS_PENDING: {
-                        // Poll for a new systemId
-                        *exitRenderLoop = true;
-                        *requestRestart = true;
-                        break;
-                    }
-                    }
+                case XR_SESSION_STATE_STOPPING: {
+                    StopFramePipeline();
+                    m_sessionRunning = false;
+                    CHECK_XRCMD(xrEndSession(m_session.Get()));
                     break;
                 }
-                case XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING:
-                case XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED:
-                default: {
-                    DEBUG_PRINT("Ignoring event type %d", eventData.type);
+                case XR_SESSION_STATE_EXITING: {
+                    // Do not attempt to restart because user closed this session.
+                    m_exitRenderLoop = true;
+                    m_requestRestart = false;
                     break;
                 }
+                case XR_SESSION_STATE_LOSS_PENDING: {
+                    // Poll for a new systemId
+                    m_exitRenderLoop = true;
+                    m_requestRestart = true;
+                    break;
                 }
-            }
+                }
+            });
+            m_events.Subscribe<XrEventDataVisibilityMaskChangedKHR>([this](const XrEventDataVisibilityMaskChangedKHR& maskEvent) {
+                // The render thread fetches the masks again before its next frame.
+                if (maskEvent.viewConfigurationType == m_primaryViewConfigType) {
+                    m_visibilityMaskChanged = true;
+                }
+            });
+            m_events.Subscribe<XrEventDataReferenceSpaceChangePending>([this](const XrEventDataReferenceSpaceChangePending& spaceEvent) {
+                // UpdateScene() locates the views, holograms and hand joints in the scene space again for every frame, anchored
+                // holograms keep their place in the world and the others move with the origin. The frames already updated are
+                // in the previous origin, the ones displayed after the change are re-based into the new one (see EndFrame()).
+                if (spaceEvent.referenceSpaceType == m_sceneSpaceType) {
+                    DEBUG_PRINT("The origin of the scene space changes at time %lld", (long long)spaceEvent.changeTime);
+                    std::lock_guard<std::mutex> lock(m_sceneSpaceChangeMutex);
+                    SceneOrigin& origin = m_sceneOrigin;
+                    origin.ChangeCount++;
+                    if (spaceEvent.poseValid) {
+                        const XrPosef previousOriginInNewOrigin = xr::math::Pose::Invert(spaceEvent.poseInPreviousSpace);
+                        origin.FirstOriginInScene = xr::math::Pose::Multiply(origin.FirstOriginInScene, previousOriginInNewOrigin);
+                    } else {
+                        m_lastUnknownSceneSpaceChange = origin.ChangeCount;
+                    }
+                    m_sceneSpaceChanges[origin.ChangeCount % m_sceneSpaceChanges.size()] = {spaceEvent.changeTime, origin};
+                    m_sceneSpaceChangeCount.store(origin.ChangeCount, std::memory_order_release);
+                }
+            });
+            m_events.Subscribe<XrEventDataInteractionProfileChanged>([](const XrEventDataInteractionProfileChanged&) {
+                // Actions are bound to the new profile by the runtime, their state is read again at the next xrSyncActions.
+                DEBUG_PRINT("The interaction profile changed");
+            });
+            m_events.Subscribe<XrEventDataEventsLost>([](const XrEventDataEventsLost& lostEvent) {
+                DEBUG_PRINT("The runtime dropped %u events", lostEvent.lostEventCount);
+            });
+            m_events.SetDefaultHandler([](const XrEventDataBuffer& event) { DEBUG_PRINT("Ignoring event type %d", event.type); });
         }
 
-        struct Hologram;
-        Hologram CreateHologram(const XrPosef& poseInScene, XrTime placementTime) const {
-            Hologram hologram{};
+        // Handles at most MaxEventsPerDrain events per call, the others are left to the next call of the render loop.
+        void ProcessEvents(bool* exitRenderLoop, bool* requestRestart) {
+            m_exitRenderLoop = m_requestRestart = m_instanceLost = false;
+
+            m_moreEventsPending = m_events.Drain(m_instance.Get()) == MaxEventsPerDrain;
+            m_events.Dispatch();
+
+            *exitRenderLoop = m_exitRenderLoop;
+            *requestRestart = m_requestRestart && !m_instanceLost;
+        }
+
+        std::optional<sample::HologramId> CreateHologram(const XrPosef& poseInScene,
+                                                        XrTime placementTime,
+                                                        const XrVector3f& scale,
+                                                        sample::MeshId mesh) {
+            xr::SpaceHandle space;
+            xr::SpatialAnchorHandle anchor;
             if (m_optionalExtensions.SpatialAnchorSupported) {
                 // Anchors provide the best stability when moving beyond 5 meters, so if the extension is enabled,
                 // create an anchor at given location and place the hologram at the resulting anchor space.
@@ -504,14 +594,15 @@ namespace {
                 createInfo.time = placementTime;
 
                 XrResult result = m_extensions.xrCreateSpatialAnchorMSFT(
-                    m_session.Get(), &createInfo, hologram.Anchor.Put(m_extensions.xrDestroySpatialAnchorMSFT));
+                    m_session.Get(), &createInfo, anchor.Put(m_extensions.xrDestroySpatialAnchorMSFT));
                 if (XR_SUCCEEDED(result)) {
                     XrSpatialAnchorSpaceCreateInfoMSFT createSpaceInfo{XR_TYPE_SPATIAL_ANCHOR_SPACE_CREATE_INFO_MSFT};
-                    createSpaceInfo.anchor = hologram.Anchor.Get();
+                    createSpaceInfo.anchor = anchor.Get();
                     createSpaceInfo.poseInAnchorSpace = xr::math::Pose::Identity();
-                    CHECK_XRCMD(m_extensions.xrCreateSpatialAnchorSpaceMSFT(m_session.Get(), &createSpaceInfo, hologram.Cube.Space.Put()));
+                    CHECK_XRCMD(m_extensions.xrCreateSpatialAnchorSpaceMSFT(m_session.Get(), &createSpaceInfo, space.Put()));
                 } else if (result == XR_ERROR_CREATE_SPATIAL_ANCHOR_FAILED_MSFT) {
                     DEBUG_PRINT("Anchor cannot be created, likely due to lost positional tracking.");
+                    return std::nullopt;
                 } else {
                     CHECK_XRRESULT(result, "xrCreateSpatialAnchorMSFT");
                 }
@@ -521,92 +612,142 @@ namespace {
                 XrReferenceSpaceCreateInfo createInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
                 createInfo.referenceSpaceType = m_sceneSpaceType;
                 createInfo.poseInReferenceSpace = poseInScene;
-                CHECK_XRCMD(xrCreateReferenceSpace(m_session.Get(), &createInfo, hologram.Cube.Space.Put()));
+                CHECK_XRCMD(xrCreateReferenceSpace(m_session.Get(), &createInfo, space.Put()));
             }
-            return hologram;
+            return m_holograms.Add(std::move(space), std::move(anchor), scale, mesh);
         }
 
+        // Called by the thread updating the scene: the one calling Run() with the serial loop, the update thread of the pipeline.
+        // The action callbacks run on it, so they may use the hologram store, which only that thread touches while the session
+        // runs, and call the runtime, e.g. xrRequestExitSession. They must not touch the state of the event loop, e.g. m_sessionRunning.
         void PollActions() {
             // Get updated action states.
-            std::vector<XrActiveActionSet> activeActionSets = {{m_actionSet.Get(), XR_NULL_PATH}};
-            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
-            syncInfo.countActiveActionSets = (uint32_t)activeActionSets.size();
-            syncInfo.activeActionSets = activeActionSets.data();
-            CHECK_XRCMD(xrSyncActions(m_session.Get(), &syncInfo));
-
-            // Check the state of the actions for left and right hands separately.
-            for (uint32_t side : {LeftSide, RightSide}) {
-                const XrPath subactionPath = m_subactionPaths[side];
-
-                // Apply a tiny vibration to the corresponding hand to indicate that action is detected.
-                auto ApplyVibration = [this, subactionPath] {
-                    XrHapticActionInfo actionInfo{XR_TYPE_HAPTIC_ACTION_INFO};
-                    actionInfo.action = m_vibrateAction.Get();
-                    actionInfo.subactionPath = subactionPath;
-
-                    XrHapticVibration vibration{XR_TYPE_HAPTIC_VIBRATION};
-                    vibration.amplitude = 0.5f;
-                    vibration.duration = XR_MIN_HAPTIC_DURATION;
-                    vibration.frequency = XR_FREQUENCY_UNSPECIFIED;
-                    CHECK_XRCMD(xrApplyHapticFeedback(m_session.Get(), &actionInfo, (XrHapticBaseHeader*)&vibration));
-                };
+            m_actionContext->SyncActions(m_session.Get());
 
-                XrActionStateBoolean placeActionValue{XR_TYPE_ACTION_STATE_BOOLEAN};
-                {
-                    XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
-                    getInfo.action = m_placeAction.Get();
-                    getInfo.subactionPath = subactionPath;
-                    CHECK_XRCMD(xrGetActionStateBoolean(m_session.Get(), &getInfo, &placeActionValue));
-                }
+            // The callbacks subscribed in CreateActions() run for the actions that changed.
+            m_actionStates.Update(m_session.Get());
+        }
 
-                // When select button is pressed, place the cube at the location of corresponding hand.
-                if (placeActionValue.isActive && placeActionValue.changedSinceLastSync && placeActionValue.currentState) {
-                    // Use the poses at the time when action happened to do the placement
-                    const XrTime placementTime = placeActionValue.lastChangeTime;
+        void PlaceHologramInHand(uint32_t side, XrTime placementTime) {
+            // Locate the hand in the scene.
+            XrSpaceLocation handLocation{XR_TYPE_SPACE_LOCATION};
+            CHECK_XRCMD(xrLocateSpace(m_handSpaces[side].Get(), m_sceneSpace.Get(), placementTime, &handLocation));
 
-                    // Locate the hand in the scene.
-                    XrSpaceLocation handLocation{XR_TYPE_SPACE_LOCATION};
-                    CHECK_XRCMD(xrLocateSpace(m_cubesInHand[side].Space.Get(), m_sceneSpace.Get(), placementTime, &handLocation));
+            // Ensure we have tracking before placing a cube in the scene, so that it stays reliably at a physical location.
+            if (!xr::math::Pose::IsPoseValid(handLocation)) {
+                DEBUG_PRINT("Cube cannot be placed when positional tracking is lost.");
+            } else {
+                // Place a new cube at the given location and time, and remember output placement space and anchor.
+                CreateHologram(handLocation.pose, placementTime, {0.1f, 0.1f, 0.1f}, m_cubeMeshId);
+            }
+        }
 
-                    // Ensure we have tracking before placing a cube in the scene, so that it stays reliably at a physical location.
-                    if (!xr::math::Pose::IsPoseValid(handLocation)) {
-                        DEBUG_PRINT("Cube cannot be placed when positional tracking is lost.");
-                    } else {
-                        // Place a new cube at the given location and time, and remember output placement space and anchor.
-                        m_holograms.push_back(CreateHologram(handLocation.pose, placementTime));
-                    }
+        // Apply a tiny vibration to the corresponding hand to indicate that action is detected.
+        void ApplyVibration(XrPath subactionPath) {
+            XrHapticActionInfo actionInfo{XR_TYPE_HAPTIC_ACTION_INFO};
+            actionInfo.action = m_vibrateAction;
+            actionInfo.subactionPath = subactionPath;
+
+            XrHapticVibration vibration{XR_TYPE_HAPTIC_VIBRATION};
+            vibration.amplitude = 0.5f;
+            vibration.duration = XR_MIN_HAPTIC_DURATION;
+            vibration.frequency = XR_FREQUENCY_UNSPECIFIED;
+            CHECK_XRCMD(xrApplyHapticFeedback(m_session.Get(), &actionInfo, (XrHapticBaseHeader*)&vibration));
+        }
 
-                    ApplyVibration();
-                }
+        const sample::FrameTimingRecorder& FrameTimings() const override {
+            return m_frameTimings;
+        }
 
-                // This sample, when menu button is released, requests to quit the session, and therefore quit the application.
-                {
-                    XrActionStateBoolean exitActionValue{XR_TYPE_ACTION_STATE_BOOLEAN};
-                    XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
-                    getInfo.action = m_exitAction.Get();
-                    getInfo.subactionPath = subactionPath;
-                    CHECK_XRCMD(xrGetActionStateBoolean(m_session.Get(), &getInfo, &exitActionValue));
+        struct FrameSnapshot;
+        struct FramePipeline;
 
-                    if (exitActionValue.isActive && exitActionValue.changedSinceLastSync && !exitActionValue.currentState) {
-                        CHECK_XRCMD(xrRequestExitSession(m_session.Get()));
-                        ApplyVibration();
-                    }
-                }
-            }
+        // Serial frame loop, all stages of the frame run on the calling thread.
+        void RenderFrame() {
+            FrameSnapshot& frame = m_renderResources->FrameSnapshots[0];
+            WaitFrame(frame);
+            BeginFrame(frame);
+            UpdateFrame(frame);
+            EndFrame(frame);
         }
 
-        void RenderFrame() {
+        void WaitFrame(FrameSnapshot& frame) {
             CHECK(m_session.Get() != XR_NULL_HANDLE);
 
+            frame.Recycle();
+            frame.Timing = {};
+            frame.Timing.FrameIndex = m_frameIndex++;
+            if (m_options.HeapAllocationCount) {
+                frame.Timing.HeapAllocations = m_options.HeapAllocationCount();
+            }
+
             XrFrameWaitInfo frameWaitInfo{XR_TYPE_FRAME_WAIT_INFO};
-            XrFrameState frameState{XR_TYPE_FRAME_STATE};
-            CHECK_XRCMD(xrWaitFrame(m_session.Get(), &frameWaitInfo, &frameState));
+            frame.FrameState = {XR_TYPE_FRAME_STATE};
+            {
+                sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::WaitFrame);
+                CHECK_XRCMD(xrWaitFrame(m_session.Get(), &frameWaitInfo, &frame.FrameState));
+            }
+            frame.Timing.PredictedDisplayTime = frame.FrameState.predictedDisplayTime;
+            frame.Timing.PredictedDisplayPeriod = frame.FrameState.predictedDisplayPeriod;
+            frame.Timing.ShouldRender = frame.FrameState.shouldRender;
+        }
 
+        void BeginFrame(FrameSnapshot& frame) {
             XrFrameBeginInfo frameBeginInfo{XR_TYPE_FRAME_BEGIN_INFO};
+            sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::BeginFrame);
             CHECK_XRCMD(xrBeginFrame(m_session.Get(), &frameBeginInfo));
+        }
+
+        // Locate the views and update the scene for the predicted display time of the frame.
+        void UpdateFrame(FrameSnapshot& frame) {
+            frame.HasProjectionLayer = false;
+
+            // Only render when session is visible. otherwise submit zero layers
+            if (!frame.FrameState.shouldRender) {
+                return;
+            }
+
+            // The views and the scene are located in the origin of the scene space known before they are.
+            {
+                std::lock_guard<std::mutex> lock(m_sceneSpaceChangeMutex);
+                frame.UpdatedSceneOrigin = m_sceneOrigin;
+            }
+
+            // First update the viewState and views using latest predicted display time.
+            {
+                sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::LocateViews);
+
+                XrViewLocateInfo viewLocateInfo{XR_TYPE_VIEW_LOCATE_INFO};
+                viewLocateInfo.viewConfigurationType = m_primaryViewConfigType;
+                viewLocateInfo.displayTime = frame.FrameState.predictedDisplayTime;
+                viewLocateInfo.space = m_sceneSpace.Get();
+
+                // The output view count of xrLocateViews is always same as xrEnumerateViewConfigurationViews
+                // Therefore Views can be preallocated and avoid two call idiom here.
+                uint32_t viewCapacityInput = (uint32_t)frame.Views.size();
+                uint32_t viewCountOutput;
+                CHECK_XRCMD(xrLocateViews(
+                    m_session.Get(), &viewLocateInfo, &frame.ViewState, viewCapacityInput, &viewCountOutput, frame.Views.data()));
+
+                CHECK(viewCountOutput == viewCapacityInput);
+                CHECK(viewCountOutput == m_renderResources->ConfigViews.size());
+                CHECK(viewCountOutput == m_renderResources->ColorSwapchain.ArraySize);
+                CHECK(viewCountOutput == m_renderResources->DepthSwapchain.ArraySize);
+            }
+
+            if (!xr::math::Pose::IsPoseValid(frame.ViewState)) {
+                DEBUG_PRINT("xrLocateViews returned an invalid pose.");
+                return; // Skip rendering layers if view location is invalid
+            }
+
+            sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::UpdateScene);
+            UpdateScene(frame);
+            frame.HasProjectionLayer = true;
+        }
 
+        void EndFrame(FrameSnapshot& frame) {
             // EndFrame can submit mutiple layers
-            std::vector<XrCompositionLayerBaseHeader*> layers;
+            std::pmr::vector<XrCompositionLayerBaseHeader*> layers(&frame.Arena);
 
             // The projection layer consists of projection layer views.
             XrCompositionLayerProjection layer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
@@ -616,45 +757,97 @@ namespace {
             // But mixed reality capture has alpha blend mode display and use alpha channel to blend content to environment.
             layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
 
-            // Only render when session is visible. otherwise submit zero layers
-            if (frameState.shouldRender) {
-                // First update the viewState and views using latest predicted display time.
-                {
-                    XrViewLocateInfo viewLocateInfo{XR_TYPE_VIEW_LOCATE_INFO};
-                    viewLocateInfo.viewConfigurationType = m_primaryViewConfigType;
-                    viewLocateInfo.displayTime = frameState.predictedDisplayTime;
-                    viewLocateInfo.space = m_sceneSpace.Get();
-
-                    // The output view count of xrLocateViews is always same as xrEnumerateViewConfigurationViews
-                    // Therefore Views can be preallocated and avoid two call idiom here.
-                    uint32_t viewCapacityInput = (uint32_t)m_renderResources->Views.size();
-                    uint32_t viewCountOutput;
-                    CHECK_XRCMD(xrLocateViews(m_session.Get(),
-                                              &viewLocateInfo,
-                                              &m_renderResources->ViewState,
-                                              viewCapacityInput,
-                                              &viewCountOutput,
-                                              m_renderResources->Views.data()));
-
-                    CHECK(viewCountOutput == viewCapacityInput);
-                    CHECK(viewCountOutput == m_renderResources->ConfigViews.size());
-                    CHECK(viewCountOutput == m_renderResources->ColorSwapchain.ArraySize);
-                    CHECK(viewCountOutput == m_renderResources->DepthSwapchain.ArraySize);
-                }
+            // With the pipelined loop, the frames in flight when a change of the scene origin is dispatched were updated before it.
+            const uint32_t sceneSpaceChangeCount = m_sceneSpaceChangeCount.load(std::memory_order_acquire);
+            if (frame.HasProjectionLayer && frame.UpdatedSceneOrigin.ChangeCount != sceneSpaceChangeCount) {
+                frame.HasProjectionLayer = RebaseOnSceneSpaceChanges(frame);
+            }
 
-                // Then render projection layer into each view.
-                if (RenderLayer(frameState.predictedDisplayTime, layer)) {
-                    layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(&layer));
-                }
+            // Then render projection layer into each view.
+            if (frame.HasProjectionLayer) {
+                RenderLayer(frame, layer);
+                layers.push_back(reinterpret_cast<XrCompositionLayerBaseHeader*>(&layer));
             }
 
             // Submit the composition layers for the predicted display time.
             XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
-            frameEndInfo.displayTime = frameState.predictedDisplayTime;
+            frameEndInfo.displayTime = frame.FrameState.predictedDisplayTime;
             frameEndInfo.environmentBlendMode = m_environmentBlendMode;
             frameEndInfo.layerCount = (uint32_t)layers.size();
             frameEndInfo.layers = layers.data();
-            CHECK_XRCMD(xrEndFrame(m_session.Get(), &frameEndInfo));
+            {
+                sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::EndFrame);
+                CHECK_XRCMD(xrEndFrame(m_session.Get(), &frameEndInfo));
+            }
+
+            if (m_dynamicResolution && frame.HasProjectionLayer) {
+                // The render time spans from waiting for the swapchain images, which blocks while the GPU is behind, to their release.
+                const XrDuration renderDuration = frame.Timing[sample::FrameStage::ReleaseSwapchainImages].End -
+                                                  frame.Timing[sample::FrameStage::AcquireSwapchainImages].Start;
+                const uint32_t missedDisplayPeriods =
+                    m_previousRenderedTiming.ShouldRender ? sample::MissedDisplayPeriods(m_previousRenderedTiming, frame.Timing) : 0;
+                m_dynamicResolution->Update(renderDuration, frame.FrameState.predictedDisplayPeriod, missedDisplayPeriods);
+                m_previousRenderedTiming = frame.Timing;
+            }
+
+            if (m_options.HeapAllocationCount) {
+                frame.Timing.HeapAllocations = m_options.HeapAllocationCount() - frame.Timing.HeapAllocations;
+            }
+            m_frameTimings.Record(frame.Timing);
+        }
+
+        // The views and cubes of a frame updated before a change of the scene origin, and displayed after it, are in the previous
+        // origin. The views submitted with the projection layer are moved into the origin of the last change displayed by then, and
+        // the image rendered in the previous origin stays the same, as the cubes are drawn relative to the views. Returns false when
+        // the frame cannot be re-based: the runtime did not give the pose of one of the new origins, or more changes are announced
+        // past the display time of the frame than are kept.
+        bool RebaseOnSceneSpaceChanges(FrameSnapshot& frame) {
+            std::lock_guard<std::mutex> lock(m_sceneSpaceChangeMutex);
+            uint32_t changeCount = m_sceneOrigin.ChangeCount;
+            while (changeCount != frame.UpdatedSceneOrigin.ChangeCount &&
+                   frame.FrameState.predictedDisplayTime < m_sceneSpaceChanges[changeCount % m_sceneSpaceChanges.size()].ChangeTime) {
+                if (m_sceneOrigin.ChangeCount - changeCount + 1 >= m_sceneSpaceChanges.size()) {
+                    return false;
+                }
+                changeCount--;
+            }
+            if (changeCount == frame.UpdatedSceneOrigin.ChangeCount) {
+                return true; // Displayed before the changes, the origin of the frame is still the one of the scene.
+            }
+            if (m_lastUnknownSceneSpaceChange > frame.UpdatedSceneOrigin.ChangeCount && m_lastUnknownSceneSpaceChange <= changeCount) {
+                return false;
+            }
+
+            const SceneOrigin& origin = m_sceneSpaceChanges[changeCount % m_sceneSpaceChanges.size()].Origin;
+            const XrPosef frameOriginInScene =
+                xr::math::Pose::Multiply(xr::math::Pose::Invert(frame.UpdatedSceneOrigin.FirstOriginInScene), origin.FirstOriginInScene);
+            for (XrView& view : frame.Views) {
+                view.pose = xr::math::Pose::Multiply(view.pose, frameOriginInScene);
+            }
+            return true;
+        }
+
+        // Reads the hidden triangle mesh of each view from the runtime.
+        void FetchVisibilityMask(uint32_t viewCount) {
+            std::vector<XrVector2f> vertices;
+            std::vector<uint32_t> indices;
+            for (uint32_t i = 0; i < viewCount; i++) {
+                XrVisibilityMaskKHR mask{XR_TYPE_VISIBILITY_MASK_KHR};
+                CHECK_XRCMD(m_extensions.xrGetVisibilityMaskKHR(
+                    m_session.Get(), m_primaryViewConfigType, i, XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR, &mask));
+
+                vertices.resize(mask.vertexCountOutput);
+                indices.resize(mask.indexCountOutput);
+                mask.vertexCapacityInput = (uint32_t)vertices.size();
+                mask.vertices = vertices.data();
+                mask.indexCapacityInput = (uint32_t)indices.size();
+                mask.indices = indices.data();
+                if (mask.vertexCapacityInput > 0 && mask.indexCapacityInput > 0) {
+                    CHECK_XRCMD(m_extensions.xrGetVisibilityMaskKHR(
+                        m_session.Get(), m_primaryViewConfigType, i, XR_VISIBILITY_MASK_TYPE_HIDDEN_TRIANGLE_MESH_KHR, &mask));
+                }
+                m_visibilityMask.SetView(i, vertices.data(), mask.vertexCountOutput, indices.data(), mask.indexCountOutput);
+            }
         }
 
         uint32_t AquireAndWaitForSwapchainImage(XrSwapchain handle) {
@@ -670,26 +863,20 @@ namespace {
         }
 
         void UpdateSpinningCube(XrTime predictedDisplayTime) {
-            if (!m_mainCubeIndex) {
+            if (!m_mainCubeId) {
                 // Initialize a big cube 1 meter in front of user.
-                Hologram hologram = CreateHologram(xr::math::Pose::Translation({0, 0, -1}), predictedDisplayTime);
-                hologram.Cube.Scale = {0.25f, 0.25f, 0.25f};
-                m_holograms.push_back(std::move(hologram));
-                m_mainCubeIndex = (uint32_t)m_holograms.size() - 1;
+                m_mainCubeId = CreateHologram(xr::math::Pose::Translation({0, 0, -1}), predictedDisplayTime, {0.25f, 0.25f, 0.25f}, m_cubeMeshId);
             }
 
-            if (!m_spinningCubeIndex) {
+            if (!m_spinningCubeId) {
                 // Initialize a small cube and remember the time when animation is started.
-                Hologram hologram = CreateHologram(xr::math::Pose::Translation({0, 0, -1}), predictedDisplayTime);
-                hologram.Cube.Scale = {0.1f, 0.1f, 0.1f};
-                m_holograms.push_back(std::move(hologram));
-                m_spinningCubeIndex = (uint32_t)m_holograms.size() - 1;
-
+                m_spinningCubeId =
+                    CreateHologram(xr::math::Pose::Translation({0, 0, -1}), predictedDisplayTime, {0.1f, 0.1f, 0.1f}, m_cubeMeshId);
                 m_spinningCubeStartTime = predictedDisplayTime;
             }
 
             // Pause spinning cube animation when app lost 3D focus
-            if (IsSessionFocused()) {
+            if (IsSessionFocused() && m_spinningCubeId) {
                 auto convertToSeconds = [](XrDuration nanoSeconds) {
                     using namespace std::chrono;
                     return duration_cast<duration<float>>(duration<XrDuration, std::nano>(nanoSeconds)).count();
@@ -697,78 +884,143 @@ namespace {
 
                 const XrDuration duration = predictedDisplayTime - m_spinningCubeStartTime;
                 const float seconds = convertToSeconds(duration);
-                const float angle = DirectX::XM_PIDIV2 * seconds; // Rotate 90 degrees per second
-                const float radius = 0.5f;                        // Rotation radius in meters
+                const float angle = xr::math::PiDiv2 * seconds; // Rotate 90 degrees per second
+                const float radius = 0.5f;                    // Rotation radius in meters
 
                 // Let spinning cube rotate around the main cube at y axis.
                 XrPosef pose;
                 pose.position = {radius * std::sin(angle), 0, radius * std::cos(angle)};
                 pose.orientation = xr::math::Quaternion::RotationAxisAngle({0, 1, 0}, angle);
-                m_holograms[m_spinningCubeIndex.value()].Cube.PoseInSpace = pose;
+                m_holograms.SetPoseInSpace(m_spinningCubeId.value(), pose);
             }
         }
 
-        bool RenderLayer(XrTime predictedDisplayTime, XrCompositionLayerProjection& layer) {
-            const uint32_t viewCount = (uint32_t)m_renderResources->ConfigViews.size();
-
-            if (!xr::math::Pose::IsPoseValid(m_renderResources->ViewState)) {
-                DEBUG_PRINT("xrLocateViews returned an invalid pose.");
-                return false; // Skip rendering layers if view location is invalid
-            }
-
-            std::vector<const sample::Cube*> visibleCubes;
-
-            auto UpdateVisibleCube = [&](sample::Cube& cube) {
-                if (cube.Space.Get() != XR_NULL_HANDLE) {
-                    XrSpaceLocation cubeSpaceInScene{XR_TYPE_SPACE_LOCATION};
-                    CHECK_XRCMD(xrLocateSpace(cube.Space.Get(), m_sceneSpace.Get(), predictedDisplayTime, &cubeSpaceInScene));
-
-                    // Update cubes location with latest space relation
-                    if (xr::math::Pose::IsPoseValid(cubeSpaceInScene)) {
-                        if (cube.PoseInSpace.has_value()) {
-                            cube.PoseInScene = xr::math::Pose::Multiply(cube.PoseInSpace.value(), cubeSpaceInScene.pose);
-                        } else {
-                            cube.PoseInScene = cubeSpaceInScene.pose;
-                        }
-                        visibleCubes.push_back(&cube);
-                    }
-                }
-            };
+        // Update the holograms and gather the cubes visible in the views of the frame.
+        void UpdateScene(FrameSnapshot& frame) {
+            const uint32_t viewCount = (uint32_t)frame.Views.size();
+            const XrTime predictedDisplayTime = frame.FrameState.predictedDisplayTime;
+            sample::DrawList& visibleCubes = frame.Cubes;
 
             UpdateSpinningCube(predictedDisplayTime);
 
-            UpdateVisibleCube(m_cubesInHand[LeftSide]);
-            UpdateVisibleCube(m_cubesInHand[RightSide]);
+            // Gather the spaces of the hand cubes followed by all holograms, so they are located in the scene in one batch.
+            m_locatedSpaces.clear();
+            for (const xr::SpaceHandle& space : m_handSpaces) {
+                m_locatedSpaces.push_back(space.Get());
+            }
+            const uint32_t hologramCount = m_holograms.Size();
+            m_locatedSpaces.insert(m_locatedSpaces.end(), m_holograms.Spaces(), m_holograms.Spaces() + hologramCount);
+
+            m_spaceLocator.Locate(m_session.Get(), m_sceneSpace.Get(), predictedDisplayTime, m_locatedSpaces);
+            const XrPosef* locatedPoses = m_spaceLocator.Poses().data();
+            const uint8_t* locatedMask = m_spaceLocator.ValidMask().data();
+
+            // The hand cubes are drawn at the located poses of the hands.
+            const uint32_t handCount = (uint32_t)m_handSpaces.size();
+            const XrPosef* posesInSpace = m_holograms.PosesInSpace();
+            const XrVector3f* scales = m_holograms.Scales();
+            const sample::MeshId* meshes = m_holograms.Meshes();
+            XrPosef* posesInScene = m_holograms.PosesInScene();
+            uint8_t* visible = m_holograms.Visible();
+            // Only the holograms with a pose in their space need the multiplication, the others are where their space is located.
+            const uint32_t posedCount = m_holograms.PosedCount();
+            xr::math::MultiplyPoses(posesInSpace, locatedPoses + handCount, posesInScene, posedCount);
+            std::copy(locatedPoses + handCount + posedCount, locatedPoses + handCount + hologramCount, posesInScene + posedCount);
+            std::copy(locatedMask + handCount, locatedMask + handCount + hologramCount, visible);
+
+            uint32_t jointCount = 0;
+            if (m_handJointSource) {
+                m_handJointSource->Locate(m_sceneSpace.Get(), predictedDisplayTime, m_handJoints);
+                jointCount = sample::HandJoints::JointCount;
+            }
 
-            for (auto& hologram : m_holograms) {
-                UpdateVisibleCube(hologram.Cube);
+            // Keep the cubes with a valid pose for rendering. The list is reserved for the largest scene, as the render queues of the
+            // graphics plugin follow its capacity.
+            visibleCubes.Reserve(handCount + std::max(hologramCount, m_options.ReservedHologramCount) + sample::HandJoints::JointCount);
+            visibleCubes.Resize(handCount + hologramCount + jointCount);
+            size_t visibleCubeCount = 0;
+            for (uint32_t side = 0; side < handCount; side++) {
+                visibleCubes.Poses[visibleCubeCount] = locatedPoses[side];
+                visibleCubes.Scales[visibleCubeCount] = HandCubeScale;
+                visibleCubes.Meshes[visibleCubeCount] = m_cubeMeshId;
+                visibleCubeCount += locatedMask[side];
+            }
+            for (uint32_t i = 0; i < hologramCount; i++) {
+                visibleCubes.Poses[visibleCubeCount] = posesInScene[i];
+                visibleCubes.Scales[visibleCubeCount] = scales[i];
+                visibleCubes.Meshes[visibleCubeCount] = meshes[i];
+                visibleCubeCount += visible[i];
             }
+            for (uint32_t i = 0; i < jointCount; i++) {
+                // An octahedron with its vertices on the sphere of the joint.
+                const float size = m_handJoints.Radii[i] * 2;
+                visibleCubes.Poses[visibleCubeCount] = {m_handJoints.Orientations[i], m_handJoints.Positions[i]};
+                visibleCubes.Scales[visibleCubeCount] = {size, size, size};
+                visibleCubes.Meshes[visibleCubeCount] = m_jointMeshId;
+                visibleCubeCount += m_handJoints.Valid[i];
+            }
+            visibleCubes.Resize(visibleCubeCount);
 
-            m_renderResources->ProjectionLayerViews.resize(viewCount);
-            if (m_optionalExtensions.DepthExtensionSupported) {
-                m_renderResources->DepthInfoViews.resize(viewCount);
+            // Prepare rendering parameters of each view for swapchain texture arrays
+            std::pmr::vector<xr::math::ViewProjection>& viewProjections = frame.ViewProjections;
+            viewProjections.resize(viewCount);
+            m_viewFrustums.resize(viewCount);
+            for (uint32_t i = 0; i < viewCount; i++) {
+                viewProjections[i] = {frame.Views[i].pose, frame.Views[i].fov, m_nearFar};
+                m_viewFrustums[i] = xr::math::ComputeFrustum(viewProjections[i]);
             }
 
-            // Swapchain is acquired, rendered to, and released together for all views as texture array
-            const SwapchainD3D11& colorSwapchain = m_renderResources->ColorSwapchain;
-            const SwapchainD3D11& depthSwapchain = m_renderResources->DepthSwapchain;
+            // Drop the cubes whose mesh bounds are outside of every view, compacting the draw list in place.
+            m_inFrustumMask.reserve(visibleCubes.Poses.capacity());
+            m_inFrustumMask.resize(visibleCubeCount);
+            xr::math::CullBoxes(m_viewFrustums.data(),
+                                viewCount,
+                                visibleCubes.Poses.data(),
+                                visibleCubes.Scales.data(),
+                                m_meshes.Bounds(),
+                                visibleCubes.Meshes.data(),
+                                visibleCubeCount,
+                                m_inFrustumMask.data());
+            size_t inFrustumCount = 0;
+            for (size_t i = 0; i < visibleCubeCount; i++) {
+                visibleCubes.Poses[inFrustumCount] = visibleCubes.Poses[i];
+                visibleCubes.Scales[inFrustumCount] = visibleCubes.Scales[i];
+                visibleCubes.Meshes[inFrustumCount] = visibleCubes.Meshes[i];
+                inFrustumCount += m_inFrustumMask[i];
+            }
+            visibleCubes.Resize(inFrustumCount);
+        }
+
+        void RenderLayer(FrameSnapshot& frame, XrCompositionLayerProjection& layer) {
+            const uint32_t viewCount = (uint32_t)frame.Views.size();
+            CHECK(m_renderResources->ProjectionLayerViews.size() == viewCount);
 
-            // Use the full range of recommended image size to achieve optimum resolution
-            const XrRect2Di imageRect = {{0, 0}, {(int32_t)colorSwapchain.Width, (int32_t)colorSwapchain.Height}};
+            // Swapchain is acquired, rendered to, and released together for all views as texture array
+            const Swapchain& colorSwapchain = m_renderResources->ColorSwapchain;
+            const Swapchain& depthSwapchain = m_renderResources->DepthSwapchain;
+
+            // Use the full range of recommended image size to achieve optimum resolution, unless dynamic resolution scales it down.
+            const XrExtent2Di swapchainExtent = {(int32_t)colorSwapchain.Width, (int32_t)colorSwapchain.Height};
+            XrRect2Di imageRect = {{0, 0}, swapchainExtent};
+            if (m_dynamicResolution) {
+                frame.Timing.ResolutionScale = m_dynamicResolution->Scale();
+                imageRect.extent = sample::ScaleExtent(m_renderResources->RecommendedExtent, frame.Timing.ResolutionScale, swapchainExtent);
+            }
             CHECK(colorSwapchain.Width == depthSwapchain.Width);
             CHECK(colorSwapchain.Height == depthSwapchain.Height);
 
-            const uint32_t colorSwapchainImageIndex = AquireAndWaitForSwapchainImage(colorSwapchain.Handle.Get());
-            const uint32_t depthSwapchainImageIndex = AquireAndWaitForSwapchainImage(depthSwapchain.Handle.Get());
+            uint32_t colorSwapchainImageIndex;
+            uint32_t depthSwapchainImageIndex;
+            {
+                sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::AcquireSwapchainImages);
+                colorSwapchainImageIndex = AquireAndWaitForSwapchainImage(colorSwapchain.Handle.Get());
+                depthSwapchainImageIndex = AquireAndWaitForSwapchainImage(depthSwapchain.Handle.Get());
+            }
 
-            // Prepare rendering parameters of each view for swapchain texture arrays
-            std::vector<xr::math::ViewProjection> viewProjections(viewCount);
             for (uint32_t i = 0; i < viewCount; i++) {
-                viewProjections[i] = {m_renderResources->Views[i].pose, m_renderResources->Views[i].fov, m_nearFar};
-
                 m_renderResources->ProjectionLayerViews[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
-                m_renderResources->ProjectionLayerViews[i].pose = m_renderResources->Views[i].pose;
-                m_renderResources->ProjectionLayerViews[i].fov = m_renderResources->Views[i].fov;
+                m_renderResources->ProjectionLayerViews[i].pose = frame.Views[i].pose;
+                m_renderResources->ProjectionLayerViews[i].fov = frame.Views[i].fov;
                 m_renderResources->ProjectionLayerViews[i].subImage.swapchain = colorSwapchain.Handle.Get();
                 m_renderResources->ProjectionLayerViews[i].subImage.imageRect = imageRect;
                 m_renderResources->ProjectionLayerViews[i].subImage.imageArrayIndex = i;
@@ -789,46 +1041,175 @@ namespace {
             }
 
             // For Hololens additive display, best to clear render target with transparent black color (0,0,0,0)
-            constexpr DirectX::XMVECTORF32 opaqueColor = { 1.0f, 0.309803933f, 0.309803933f, 1.000000000f};
-            constexpr DirectX::XMVECTORF32 transparent = { 1.0f, 0.309803933f, 0.309803933f, 1.000000000f };
-
-            //constexpr DirectX::XMVECTORF32 opaqueColor = { 1.0, 0.309803933f, 0.309803933f, 1.000000000f };
-            //constexpr DirectX::XMVECTORF32 transparent = {0.000000000f, 0.000000000f, 0.000000000f, 0.000000000f};
-            const DirectX::XMVECTORF32 renderTargetClearColor =
-                (m_environmentBlendMode == XR_ENVIRONMENT_BLEND_MODE_OPAQUE) ? opaqueColor : transparent;
-
-            m_graphicsPlugin->RenderView(imageRect,
-                                         renderTargetClearColor,
-                                         viewProjections,
-                                         colorSwapchain.Format,
-                                         colorSwapchain.Images[colorSwapchainImageIndex].texture,
-                                         depthSwapchain.Format,
-                                         depthSwapchain.Images[depthSwapchainImageIndex].texture,
-                                         visibleCubes);
-
-            XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
-            CHECK_XRCMD(xrReleaseSwapchainImage(colorSwapchain.Handle.Get(), &releaseInfo));
-            CHECK_XRCMD(xrReleaseSwapchainImage(depthSwapchain.Handle.Get(), &releaseInfo));
+            constexpr float opaqueColor[4] = {1.0f, 0.309803933f, 0.309803933f, 1.000000000f};
+            constexpr float transparent[4] = {1.0f, 0.309803933f, 0.309803933f, 1.000000000f};
+
+            //constexpr float opaqueColor[4] = {1.0, 0.309803933f, 0.309803933f, 1.000000000f};
+            //constexpr float transparent[4] = {0.000000000f, 0.000000000f, 0.000000000f, 0.000000000f};
+            const float* renderTargetClearColor = (m_environmentBlendMode == XR_ENVIRONMENT_BLEND_MODE_OPAQUE) ? opaqueColor : transparent;
+
+            if (m_optionalExtensions.VisibilityMaskSupported) {
+                if (m_visibilityMaskChanged.exchange(false)) {
+                    FetchVisibilityMask(viewCount);
+                }
+                std::array<XrFovf, m_stereoViewCount> fovs;
+                for (uint32_t i = 0; i < viewCount; i++) {
+                    fovs[i] = frame.Views[i].fov;
+                }
+                m_visibilityMask.Update(fovs.data(), viewCount);
+            }
+
+            {
+                sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::RenderView);
+                const uint64_t createdViewCount = m_graphicsPlugin->CreatedViewCount();
+                m_graphicsPlugin->RenderView(imageRect,
+                                             renderTargetClearColor,
+                                             frame.ViewProjections,
+                                             colorSwapchainImageIndex,
+                                             depthSwapchainImageIndex,
+                                             frame.Cubes,
+                                             m_meshes,
+                                             m_visibilityMask);
+                frame.Timing.CreatedViews = (uint32_t)(m_graphicsPlugin->CreatedViewCount() - createdViewCount);
+            }
+
+            {
+                sample::ScopedFrameStage stage(frame.Timing, sample::FrameStage::ReleaseSwapchainImages);
+                XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
+                CHECK_XRCMD(xrReleaseSwapchainImage(colorSwapchain.Handle.Get(), &releaseInfo));
+                CHECK_XRCMD(xrReleaseSwapchainImage(depthSwapchain.Handle.Get(), &releaseInfo));
+            }
 
             layer.space = m_sceneSpace.Get();
             layer.viewCount = (uint32_t)m_renderResources->ProjectionLayerViews.size();
             layer.views = m_renderResources->ProjectionLayerViews.data();
-            return true;
+        }
+
+        // Pipelined frame loop: a wait thread calls xrWaitFrame, an update thread polls actions and updates the scene of
+        // frame N+1 while a render thread submits frame N. Each frame is a snapshot, handed from one thread to the next.
+        void StartFramePipeline() {
+            CHECK(m_framePipeline == nullptr);
+            m_framePipeline = std::make_unique<FramePipeline>();
+            FramePipeline& pipeline = *m_framePipeline;
+            for (uint32_t i = 0; i < FrameSnapshotCount; i++) {
+                pipeline.FreeFrames.Push(i);
+            }
+
+            pipeline.WaitThread = std::thread([this, &pipeline] { RunPipelineThread(pipeline, &ImplementOpenXrProgram::WaitFrames); });
+            pipeline.UpdateThread = std::thread([this, &pipeline] { RunPipelineThread(pipeline, &ImplementOpenXrProgram::UpdateFrames); });
+            pipeline.RenderThread = std::thread([this, &pipeline] { RunPipelineThread(pipeline, &ImplementOpenXrProgram::RenderFrames); });
+        }
+
+        // Lets the frames in flight go through the pipeline, then joins its threads and rethrows the first error of any of them.
+        void StopFramePipeline() {
+            if (!m_framePipeline) {
+                return;
+            }
+
+            m_framePipeline->RequestStop();
+            m_framePipeline->WaitThread.join();
+            m_framePipeline->UpdateThread.join();
+            m_framePipeline->RenderThread.join();
+
+            const std::exception_ptr error = m_framePipeline->Error;
+            m_framePipeline.reset();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        void CheckFramePipeline() {
+            if (m_framePipeline && m_framePipeline->Failed) {
+                StopFramePipeline();
+            }
+        }
+
+        void RunPipelineThread(FramePipeline& pipeline, void (ImplementOpenXrProgram::*loop)(FramePipeline&)) {
+            try {
+                (this->*loop)(pipeline);
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(pipeline.ErrorMutex);
+                    if (!pipeline.Error) {
+                        pipeline.Error = std::current_exception();
+                    }
+                }
+
+                // Unblock the other threads, the frames in flight are dropped.
+                pipeline.Failed = true;
+                pipeline.RequestStop();
+                pipeline.FreeFrames.Close();
+                pipeline.WaitedFrames.Close();
+                pipeline.UpdatedFrames.Close();
+                pipeline.BegunFrames.Close();
+            }
+        }
+
+        void WaitFrames(FramePipeline& pipeline) {
+            uint32_t index;
+            bool firstFrame = true;
+            while (!pipeline.StopRequested && pipeline.FreeFrames.Pop(index)) {
+                // Only wait for a frame once the previous one is begun. The runtime would block xrWaitFrame until then anyway,
+                // and this way the wait thread never blocks in the runtime on a frame the render thread will not begin.
+                uint32_t begunIndex;
+                if (!firstFrame && !pipeline.BegunFrames.Pop(begunIndex)) {
+                    break;
+                }
+                firstFrame = false;
+
+                FrameSnapshot& frame = m_renderResources->FrameSnapshots[index];
+                WaitFrame(frame);
+                if (!pipeline.WaitedFrames.Push(index)) {
+                    break;
+                }
+
+                // The session is not visible, e.g. it is stopping after an exit request. The event loop dispatches the state change
+                // before another frame is waited, rather than the pipeline running frames that are not rendered until its next drain.
+                if (!frame.FrameState.shouldRender) {
+                    pipeline.WaitForDrain();
+                }
+            }
+            pipeline.WaitedFrames.Close();
+        }
+
+        void UpdateFrames(FramePipeline& pipeline) {
+            uint32_t index;
+            while (!pipeline.Failed && pipeline.WaitedFrames.Pop(index)) {
+                PollActions();
+                UpdateFrame(m_renderResources->FrameSnapshots[index]);
+                if (!pipeline.UpdatedFrames.Push(index)) {
+                    break;
+                }
+            }
+            pipeline.UpdatedFrames.Close();
+        }
+
+        void RenderFrames(FramePipeline& pipeline) {
+            uint32_t index;
+            while (!pipeline.Failed && pipeline.UpdatedFrames.Pop(index)) {
+                FrameSnapshot& frame = m_renderResources->FrameSnapshots[index];
+                BeginFrame(frame);
+                pipeline.BegunFrames.Push(index);
+                EndFrame(frame);
+                pipeline.FreeFrames.Push(index);
+            }
         }
 
         void PrepareSessionRestart() {
-            m_mainCubeIndex = m_spinningCubeIndex = {};
-            m_holograms.clear();
+            m_mainCubeId = m_spinningCubeId = {};
+            m_holograms.Clear();
+            m_graphicsPlugin->ClearSwapchainImageViews();
             m_renderResources.reset();
+            m_handJointSource.reset();
             m_session.Reset();
             m_systemId = XR_NULL_SYSTEM_ID;
         }
 
-        constexpr bool IsSessionFocused() const {
+        bool IsSessionFocused() const {
             return m_sessionState == XR_SESSION_STATE_FOCUSED;
         }
 
-        XrPath GetXrPath(const char* string) const {
+        XrPath GetXrPath(const xr::PathString& string) const {
             return xr::StringToPath(m_instance.Get(), string);
         }
 
@@ -838,7 +1219,8 @@ namespace {
         constexpr static uint32_t m_stereoViewCount = 2; // PRIMARY_STEREO view configuration always has 2 views
 
         const std::string m_applicationName;
-        const std::unique_ptr<sample::IGraphicsPluginD3D11> m_graphicsPlugin;
+        const std::unique_ptr<sample::IGraphicsPlugin> m_graphicsPlugin;
+        const sample::ProgramOptions m_options;
 
         xr::InstanceHandle m_instance;
         xr::SessionHandle m_session;
@@ -849,64 +1231,192 @@ namespace {
             bool DepthExtensionSupported{false};
             bool UnboundedRefSpaceSupported{false};
             bool SpatialAnchorSupported{false};
+            bool LocateSpacesSupported{false};
+            bool VisibilityMaskSupported{false};
+            bool HandTrackingSupported{false};
         } m_optionalExtensions;
 
         xr::SpaceHandle m_sceneSpace;
         XrReferenceSpaceType m_sceneSpaceType{};
 
-        struct Hologram {
-            sample::Cube Cube;
-            xr::SpatialAnchorHandle Anchor;
-        };
-        std::vector<Hologram> m_holograms;
+        // Only added to when the program is created, so the render thread reads it without synchronization.
+        sample::MeshRegistry m_meshes;
+        sample::MeshId m_cubeMeshId{0};
+        sample::MeshId m_jointMeshId{0};
 
-        std::optional<uint32_t> m_mainCubeIndex;
-        std::optional<uint32_t> m_spinningCubeIndex;
+        // Holograms and hand joints are owned by the thread updating the scene while the session runs (see PollActions()).
+        sample::HologramStore m_holograms;
+
+        std::optional<sample::HologramId> m_mainCubeId;
+        std::optional<sample::HologramId> m_spinningCubeId;
         XrTime m_spinningCubeStartTime;
 
+        std::unique_ptr<sample::IHandJointSource> m_handJointSource; // Null when no hand is tracked.
+        sample::HandJoints m_handJoints;
+
+        xr::SpaceLocator m_spaceLocator;
+        std::vector<XrSpace> m_locatedSpaces;
+        std::vector<xr::math::Frustum> m_viewFrustums;
+        std::vector<uint8_t> m_inFrustumMask;
+
         constexpr static uint32_t LeftSide = 0;
         constexpr static uint32_t RightSide = 1;
         std::array<XrPath, 2> m_subactionPaths{};
-        std::array<sample::Cube, 2> m_cubesInHand{};
+        std::array<xr::SpaceHandle, 2> m_handSpaces{}; // Spaces of the hand poses, each drawn as a cube.
 
-        xr::ActionSetHandle m_actionSet;
-        xr::ActionHandle m_placeAction;
-        xr::ActionHandle m_exitAction;
-        xr::ActionHandle m_poseAction;
-        xr::ActionHandle m_vibrateAction;
+        std::optional<xr::ActionContext> m_actionContext; // Owns the action set and the actions of ActionManifest.
+        XrAction m_placeAction{XR_NULL_HANDLE};
+        XrAction m_exitAction{XR_NULL_HANDLE};
+        XrAction m_poseAction{XR_NULL_HANDLE};
+        XrAction m_vibrateAction{XR_NULL_HANDLE};
+        xr::ActionStateCache m_actionStates;
 
         XrEnvironmentBlendMode m_environmentBlendMode{};
         xr::math::NearFar m_nearFar{};
 
-        struct SwapchainD3D11 {
+        struct Swapchain {
             xr::SwapchainHandle Handle;
-            DXGI_FORMAT Format{DXGI_FORMAT_UNKNOWN};
+            int64_t Format{0};
             uint32_t Width{0};
             uint32_t Height{0};
             uint32_t ArraySize{0};
-            std::vector<XrSwapchainImageD3D11KHR> Images;
+            std::vector<sample::SwapchainImage> Images;
         };
 
-        struct RenderResources {
+        // The origin of the scene space after a number of changes dispatched by the event loop.
+        struct SceneOrigin {
+            uint32_t ChangeCount{0};
+            XrPosef FirstOriginInScene{xr::math::Pose::Identity()}; // The origin before the first change, in this one.
+        };
+
+        // State of a frame, from xrWaitFrame to xrEndFrame.
+        // Its transient containers live in the arena of the snapshot, recycled when the snapshot is reused for another frame.
+        struct FrameSnapshot {
+            sample::FrameArena Arena;
+
+            XrFrameState FrameState{XR_TYPE_FRAME_STATE};
             XrViewState ViewState{XR_TYPE_VIEW_STATE};
             std::vector<XrView> Views;
-            std::vector<XrViewConfigurationView> ConfigViews;
-            SwapchainD3D11 ColorSwapchain;
-            SwapchainD3D11 DepthSwapchain;
+            std::pmr::vector<xr::math::ViewProjection> ViewProjections{&Arena};
+            sample::DrawList Cubes{&Arena}; // Cubes visible in the views.
+            bool HasProjectionLayer{false};
+            SceneOrigin UpdatedSceneOrigin; // Origin of the scene space when the frame was updated.
+            sample::FrameTiming Timing;
+
+            void Recycle() {
+                // Drop the containers pointing into the arena before reusing its memory.
+                ViewProjections = std::pmr::vector<xr::math::ViewProjection>(&Arena);
+                Cubes = sample::DrawList(&Arena);
+                Arena.Reset();
+            }
+        };
+
+        // One frame being waited, one being updated and one being rendered.
+        constexpr static uint32_t FrameSnapshotCount = 3;
+
+        struct RenderResources {
+            std::array<FrameSnapshot, FrameSnapshotCount> FrameSnapshots;
+            xr::SmallVector<XrViewConfigurationView, m_stereoViewCount> ConfigViews;
+            XrExtent2Di RecommendedExtent{};
+            Swapchain ColorSwapchain;
+            Swapchain DepthSwapchain;
             std::vector<XrCompositionLayerProjectionView> ProjectionLayerViews;
             std::vector<XrCompositionLayerDepthInfoKHR> DepthInfoViews;
         };
 
         std::unique_ptr<RenderResources> m_renderResources{};
 
+        // Frame snapshots are passed between the threads by index.
+        struct FramePipeline {
+            sample::FrameChannel<uint32_t> FreeFrames{FrameSnapshotCount};
+            sample::FrameChannel<uint32_t> WaitedFrames{FrameSnapshotCount};
+            sample::FrameChannel<uint32_t> UpdatedFrames{FrameSnapshotCount};
+            sample::FrameChannel<uint32_t> BegunFrames{FrameSnapshotCount};
+
+            std::atomic<bool> StopRequested{false};
+            std::atomic<bool> Failed{false};
+            std::mutex ErrorMutex;
+            std::exception_ptr Error;
+
+            // The event loop sleeps between its drains, unless the wait thread asks for one.
+            std::mutex DrainMutex;
+            std::condition_variable DrainCondition;
+            uint64_t DrainCount{0};
+            bool DrainRequested{false};
+
+            void RequestStop() {
+                std::lock_guard<std::mutex> lock(DrainMutex);
+                StopRequested = true;
+                DrainCondition.notify_all();
+            }
+
+            // Called by the event loop after each drain.
+            void EventsDrained() {
+                std::lock_guard<std::mutex> lock(DrainMutex);
+                DrainCount++;
+                DrainRequested = false;
+                DrainCondition.notify_all();
+            }
+
+            void WaitForDrainRequest(std::chrono::milliseconds timeout) {
+                std::unique_lock<std::mutex> lock(DrainMutex);
+                DrainCondition.wait_for(lock, timeout, [&] { return DrainRequested || StopRequested; });
+            }
+
+            // Blocks until the event loop drained the events once more, or the pipeline stops.
+            void WaitForDrain() {
+                std::unique_lock<std::mutex> lock(DrainMutex);
+                const uint64_t drainCount = DrainCount + 1;
+                DrainRequested = true;
+                DrainCondition.notify_all();
+                DrainCondition.wait(lock, [&] { return DrainCount >= drainCount || StopRequested; });
+            }
+
+            std::thread WaitThread;
+            std::thread UpdateThread;
+            std::thread RenderThread;
+        };
+
+        std::unique_ptr<FramePipeline> m_framePipeline;
+
+        sample::FrameTimingRecorder m_frameTimings;
+        uint64_t m_frameIndex{0};
+
+        // Only used by the thread ending the frames.
+        std::optional<sample::DynamicResolutionController> m_dynamicResolution;
+        sample::VisibilityMask m_visibilityMask;
+        std::atomic<bool> m_visibilityMaskChanged{true}; // Set by the event loop, cleared by the thread fetching the masks.
+        // Changes of the scene origin, recorded by the event loop for the threads updating and ending the frames. The origin after
+        // change i is kept at i % size with the time of the change. The count is also read without the lock, to skip it when no
+        // change was dispatched since a frame was updated.
+        struct SceneSpaceChange {
+            XrTime ChangeTime{0};
+            SceneOrigin Origin;
+        };
+        std::mutex m_sceneSpaceChangeMutex;
+        SceneOrigin m_sceneOrigin;
+        std::array<SceneSpaceChange, 8> m_sceneSpaceChanges;
+        uint32_t m_lastUnknownSceneSpaceChange{0}; // Last change without the pose of the new origin, 0 for none.
+        std::atomic<uint32_t> m_sceneSpaceChangeCount{0};
+        sample::FrameTiming m_previousRenderedTiming;
+
+        // Events are drained and dispatched on the thread running the render loop.
+        constexpr static uint32_t MaxEventsPerDrain = 16;
+        xr::EventDispatcher<MaxEventsPerDrain> m_events;
+        bool m_exitRenderLoop{false}; // Results of the event handlers for the current ProcessEvents call.
+        bool m_requestRestart{false};
+        bool m_instanceLost{false};
+        bool m_moreEventsPending{false}; // The last drain was cut short, so the render loop does not wait before the next.
+
         bool m_sessionRunning{false};
-        XrSessionState m_sessionState{XR_SESSION_STATE_UNKNOWN};
+        std::atomic<XrSessionState> m_sessionState{XR_SESSION_STATE_UNKNOWN}; // Read by the update thread of the pipeline.
     };
 } // namespace
 
 namespace sample {
     std::unique_ptr<sample::IOpenXrProgram> CreateOpenXrProgram(std::string applicationName,
-                                                                std::unique_ptr<sample::IGraphicsPluginD3D11> graphicsPlugin) {
-        return std::make_unique<ImplementOpenXrProgram>(std::move(applicationName), std::move(graphicsPlugin));
+                                                                std::unique_ptr<sample::IGraphicsPlugin> graphicsPlugin,
+                                                                const ProgramOptions& options) {
+        return std::make_unique<ImplementOpenXrProgram>(std::move(applicationName), std::move(graphicsPlugin), options);
     }
 } // namespace sample
@@ -16,42 +16,168 @@
 
 #pragma once
 
+#include "DynamicResolution.h"
+#include "FrameTimings.h"
+#include "HandJoints.h"
+#include "MeshRegistry.h"
+#include "VisibilityMask.h"
+
 namespace sample {
-    struct Cube {
-        xr::SpaceHandle Space{};
-        std::optional<XrPosef> PoseInSpace{}; // Cube pose in above Space. Default to identity.
-        XrVector3f Scale{0.1f, 0.1f, 0.1f};
+    // Objects to draw in a frame, as parallel arrays.
+    struct DrawList {
+        explicit DrawList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : Poses(resource)
+            , Scales(resource)
+            , Meshes(resource) {
+        }
+
+        std::pmr::vector<XrPosef> Poses; // Object poses in the scene
+        std::pmr::vector<XrVector3f> Scales;
+        std::pmr::vector<MeshId> Meshes;
+
+        size_t Size() const {
+            return Poses.size();
+        }
+
+        void Clear() {
+            Poses.clear();
+            Scales.clear();
+            Meshes.clear();
+        }
 
-        XrPosef PoseInScene = xr::math::Pose::Identity(); // Cube pose in the scene.  Got updated every frame
+        void Reserve(size_t capacity) {
+            Poses.reserve(capacity);
+            Scales.reserve(capacity);
+            Meshes.reserve(capacity);
+        }
+
+        void Resize(size_t size) {
+            Poses.resize(size);
+            Scales.resize(size);
+            Meshes.resize(size);
+        }
     };
 
     struct IOpenXrProgram {
         virtual ~IOpenXrProgram() = default;
         virtual void Run() = 0;
+
+        // Timings of the most recent frames, safe to read from any thread while Run() is executing.
+        virtual const FrameTimingRecorder& FrameTimings() const = 0;
     };
 
-    struct IGraphicsPluginD3D11 {
-        virtual ~IGraphicsPluginD3D11() = default;
+    // Texture of a swapchain image as an opaque handle of the graphics API, e.g. ID3D11Texture2D*.
+    using SwapchainImage = void*;
+
+    // Swapchain formats are the values returned by xrEnumerateSwapchainFormats, e.g. DXGI_FORMAT for D3D11.
+    struct IGraphicsPlugin {
+        virtual ~IGraphicsPlugin() = default;
 
-        // Create an instance of this graphics api for the provided instance and systemId.
-        virtual ID3D11Device* InitializeDevice(LUID adapterLuid, const std::vector<D3D_FEATURE_LEVEL>& featureLevels) = 0;
+        // OpenXR extension enabling the graphics API of this plugin.
+        virtual const char* GraphicsExtensionName() const = 0;
+
+        // Create the graphics device for the provided instance and systemId.
+        // Returns the graphics binding to chain to XrSessionCreateInfo, which stays valid as long as the plugin.
+        virtual const XrBaseInStructure* InitializeDevice(XrInstance instance,
+                                                          XrSystemId systemId,
+                                                          const xr::ExtensionDispatchTable& extensions) = 0;
 
         // List of color pixel formats supported by this app.
-        virtual const std::vector<DXGI_FORMAT>& SupportedColorFormats() const = 0;
-        virtual const std::vector<DXGI_FORMAT>& SupportedDepthFormats() const = 0;
+        virtual const std::vector<int64_t>& SupportedColorFormats() const = 0;
+        virtual const std::vector<int64_t>& SupportedDepthFormats() const = 0;
+
+        // Query the images of a swapchain, using the swapchain image structure of the graphics API.
+        virtual std::vector<SwapchainImage> EnumerateSwapchainImages(XrSwapchain swapchain) const = 0;
 
-        // Render to swapchain images using stereo image array
+        // Render to swapchain images using stereo image array. The images are given by their index in the lists passed to
+        // CacheSwapchainImageViews, as returned by xrAcquireSwapchainImage. The draws reference meshes of the registry by id, and are
+        // submitted grouped by mesh to minimize state changes. The visibility mask, empty when the runtime has none, is drawn into
+        // depth first.
         virtual void RenderView(const XrRect2Di& imageRect,
                                 const float renderTargetClearColor[4],
-                                const std::vector<xr::math::ViewProjection>& viewProjections,
-                                DXGI_FORMAT colorSwapchainFormat,
-                                ID3D11Texture2D* colorTexture,
-                                DXGI_FORMAT depthSwapchainFormat,
-                                ID3D11Texture2D* depthTexture,
-                                const std::vector<const sample::Cube*>& cubes) = 0;
+                                const std::pmr::vector<xr::math::ViewProjection>& viewProjections,
+                                uint32_t colorImageIndex,
+                                uint32_t depthImageIndex,
+                                const sample::DrawList& cubes,
+                                const sample::MeshRegistry& meshes,
+                                const sample::VisibilityMask& visibilityMask) = 0;
+
+        // Create the render target and depth stencil views of all swapchain images up front, indexed like the images, so RenderView
+        // reuses them. Must be called before RenderView.
+        virtual void CacheSwapchainImageViews(int64_t colorSwapchainFormat,
+                                              const std::vector<SwapchainImage>& colorTextures,
+                                              int64_t depthSwapchainFormat,
+                                              const std::vector<SwapchainImage>& depthTextures) = 0;
+
+        // Release the cached views. Must be called before the swapchain images are destroyed.
+        virtual void ClearSwapchainImageViews() = 0;
+
+        // Total number of render target and depth stencil views created by this plugin.
+        virtual uint64_t CreatedViewCount() const = 0;
+    };
+
+    // Statistics recorded by the null graphics plugin.
+    struct NullGraphicsStats {
+        struct Frame {
+            uint32_t CubeCount{0};
+            uint32_t ViewCount{0};
+            uint32_t BatchCount{0};     // Draws a renderer would issue, one per view, program and mesh.
+            uint32_t MeshCount{0};      // Distinct meshes of the draws, the fewest batches for one view group and program.
+            uint32_t VisibilityMaskTriangleCount{0};
+            uint64_t SubmittedBytes{0}; // Bytes a renderer would upload: view projections and model transforms.
+        };
+
+        Frame LastFrame;
+        uint64_t FrameCount{0};
+        uint64_t CubeCount{0};
+        uint64_t ViewCount{0};
+        uint64_t BatchCount{0};
+        uint64_t MeshCount{0};
+        uint64_t SubmittedBytes{0};
+        uint32_t MaxCubeCount{0};
+        uint64_t AssetBytes{0};
+        uint32_t ArchiveEntryCount{0};
+        uint64_t CreatedViewCount{0}; // Render target and depth stencil views a renderer would create, one per swapchain image.
+        uint64_t VisibilityMaskUploadCount{0}; // Uploads of the visibility mask a renderer would make, one per change.
+        int64_t FirstRenderTime{0}; // FrameClockNow() at the first RenderView call.
+    };
+
+    // Files the null plugin loads as the cube plugin loads its shaders, to measure their cost on the time to the first frame.
+    struct NullGraphicsAssets {
+        std::vector<std::string> Paths;
+        std::string ArchivePath; // Asset archive written by AssetPacker, whose entries are looked up without copy.
+
+        // Read the files when the device is initialized instead of starting to load them when the plugin is created.
+        bool LoadOnDeviceInitialization{false};
+    };
+
+    std::unique_ptr<IGraphicsPlugin> CreateCubeGraphics();
+
+    // A plugin that renders nothing, for measuring the CPU cost of the program. Statistics are written to stats when not null.
+    std::unique_ptr<IGraphicsPlugin> CreateNullGraphics(NullGraphicsStats* stats, const NullGraphicsAssets& assets = {});
+
+    struct ProgramOptions {
+        // Run xrWaitFrame, the scene update and the frame submission on three threads, so that they overlap across frames.
+        // RenderView is then called from the render thread, which the graphics plugin must support.
+        bool PipelinedFrameLoop{false};
+
+        // Number of heap allocations made by the program so far. When set, the allocations of each frame are recorded in its timing.
+        uint64_t (*HeapAllocationCount)(){nullptr};
+
+        // When set, the image rectangle rendered each frame shrinks when the render time nears the display period, and grows
+        // back once there is headroom again. Otherwise the full recommended image size is always rendered.
+        std::optional<DynamicResolutionSettings> DynamicResolution;
+
+        // When set, the hand joints are replayed from the recording instead of being tracked by the runtime.
+        std::shared_ptr<const HandJointRecording> RecordedHandJoints;
+
+        // Holograms the scene reserves room for up front, the main and spinning cubes included. The scene keeps growing past it
+        // as cubes are placed, but each frame that does so allocates.
+        uint32_t ReservedHologramCount{64};
     };
 
-    std::unique_ptr<IGraphicsPluginD3D11> CreateCubeGraphics();
-    std::unique_ptr<IOpenXrProgram> CreateOpenXrProgram(std::string applicationName, std::unique_ptr<IGraphicsPluginD3D11> graphicsPlugin);
+    std::unique_ptr<IOpenXrProgram> CreateOpenXrProgram(std::string applicationName,
+                                                        std::unique_ptr<IGraphicsPlugin> graphicsPlugin,
+                                                        const ProgramOptions& options = {});
 
 } // namespace sample
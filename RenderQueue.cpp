@@ -0,0 +1,94 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "RenderQueue.h"
+
+namespace sample {
+    void RenderQueue::Push(const DrawList& draws, uint32_t view, uint32_t program, const XrVector3f& viewPosition) {
+        using namespace xr::math;
+        m_entries.reserve(m_entries.size() + draws.Poses.capacity());
+        for (size_t i = 0; i < draws.Size(); i++) {
+            const XrVector3f offset = draws.Poses[i].position - viewPosition;
+            Push(MakeKey(view, program, draws.Meshes[i], DepthBucket(Dot(offset, offset))), (uint32_t)i);
+        }
+    }
+
+    void RenderQueue::Sort() {
+        constexpr uint32_t PassCount = sizeof(uint64_t);
+        const uint32_t count = Size();
+
+        // The histograms of all passes are independent of the order of the keys, so they are counted in a single read.
+        std::array<std::array<uint32_t, 256>, PassCount> histograms{};
+        for (const Entry& entry : m_entries) {
+            for (uint32_t pass = 0; pass < PassCount; pass++) {
+                histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
+            }
+        }
+
+        m_sortScratch.reserve(m_entries.capacity());
+        m_sortScratch.resize(count);
+        for (uint32_t pass = 0; pass < PassCount && count > 0; pass++) {
+            std::array<uint32_t, 256>& offsets = histograms[pass];
+            if (offsets[(m_entries[0].Key >> (pass * 8)) & 0xFF] == count) {
+                continue; // Every key has the same byte, the order is unchanged.
+            }
+
+            uint32_t offset = 0;
+            for (uint32_t& bucket : offsets) {
+                const uint32_t bucketSize = bucket;
+                bucket = offset;
+                offset += bucketSize;
+            }
+            for (const Entry& entry : m_entries) {
+                m_sortScratch[offsets[(entry.Key >> (pass * 8)) & 0xFF]++] = entry;
+            }
+            m_entries.swap(m_sortScratch);
+        }
+
+        m_batches.clear();
+        m_batches.reserve(m_entries.capacity());
+        for (uint32_t i = 0; i < count; i++) {
+            const uint64_t stateKey = m_entries[i].Key >> DepthBits;
+            if (i > 0 && stateKey == (m_entries[i - 1].Key >> DepthBits)) {
+                m_batches.back().Count++;
+            } else {
+                m_batches.push_back({(uint32_t)(stateKey >> (ProgramBits + MeshBits)),
+                                     (uint32_t)(stateKey >> MeshBits) & ((1u << ProgramBits) - 1),
+                                     (MeshId)(stateKey & ((1u << MeshBits) - 1)),
+                                     i,
+                                     1});
+            }
+        }
+    }
+
+    void RenderQueue::Gather(const DrawList& draws) {
+        const uint32_t count = Size();
+        m_transforms.Reserve(m_entries.capacity());
+        m_transforms.Resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            m_transforms.Set(i, draws.Poses[m_entries[i].Draw], draws.Scales[m_entries[i].Draw]);
+        }
+    }
+
+    XrVector3f CenterOfViews(const std::pmr::vector<xr::math::ViewProjection>& viewProjections) {
+        using namespace xr::math;
+        XrVector3f center{0, 0, 0};
+        for (const ViewProjection& viewProjection : viewProjections) {
+            center = center + viewProjection.Pose.position;
+        }
+        return viewProjections.empty() ? center : center / (float)viewProjections.size();
+    }
+} // namespace sample
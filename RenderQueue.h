@@ -0,0 +1,109 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include "OpenXrProgram.h"
+#include "XrUtility/XrMathBatch.h"
+
+namespace sample {
+    // Draws of a frame ordered by a 64-bit sort key. From the most significant bits, a key holds
+    //     [view: 8][program: 12][mesh: 20][depth bucket: 24]
+    // so that sorted draws switch views least often, then programs, then meshes, and go front to back within a mesh.
+    // The storage is kept across frames and sized for the capacity of the pushed draw lists, so the queue stops allocating once
+    // the draw lists do, even while the number of draws still grows.
+    class RenderQueue {
+    public:
+        constexpr static uint32_t ViewBits = 8;
+        constexpr static uint32_t ProgramBits = 12;
+        constexpr static uint32_t MeshBits = 20;
+        constexpr static uint32_t DepthBits = 24;
+
+        static uint64_t MakeKey(uint32_t view, uint32_t program, MeshId mesh, uint32_t depthBucket) {
+            assert(view < (1u << ViewBits) && program < (1u << ProgramBits) && mesh < (1u << MeshBits) && depthBucket < (1u << DepthBits));
+            return ((uint64_t)view << (ProgramBits + MeshBits + DepthBits)) | ((uint64_t)program << (MeshBits + DepthBits)) |
+                   ((uint64_t)mesh << DepthBits) | depthBucket;
+        }
+
+        // Bucket of a non-negative depth. Non-negative floats order like their bit patterns, so dropping the low mantissa bits
+        // keeps the depth order down to a relative precision of 2^-16.
+        static uint32_t DepthBucket(float depth) {
+            uint32_t bits;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return depth > 0 ? bits >> (31 - DepthBits) : 0;
+        }
+
+        // Consecutive sorted draws sharing view, program and mesh, which are submitted without changing state.
+        struct Batch {
+            uint32_t View;
+            uint32_t Program;
+            MeshId Mesh;
+            uint32_t First; // Index of the first draw of the batch in sorted order.
+            uint32_t Count;
+        };
+
+        void Clear() {
+            m_entries.clear();
+            m_batches.clear();
+        }
+
+        // draw identifies the draw for the caller, e.g. its index in a DrawList.
+        void Push(uint64_t key, uint32_t draw) {
+            m_entries.push_back({key, draw});
+        }
+
+        // Queues every draw of the list for one view and program. The depth of a draw is its squared distance to viewPosition.
+        void Push(const DrawList& draws, uint32_t view, uint32_t program, const XrVector3f& viewPosition);
+
+        // Least significant digit radix sort of the keys, 8 bits per pass, then groups the sorted draws into batches.
+        // A pass over a byte equal in every key is skipped, which is most of them when the draws share their view and program.
+        void Sort();
+
+        uint32_t Size() const {
+            return (uint32_t)m_entries.size();
+        }
+
+        // The draw queued at position i in sorted order.
+        uint32_t Draw(uint32_t i) const {
+            return m_entries[i].Draw;
+        }
+
+        const std::vector<Batch>& Batches() const {
+            return m_batches;
+        }
+
+        // Copies the poses and scales of the draws in sorted order, so the transforms of a batch are contiguous. They are stored
+        // in structure of arrays form, which the matrix kernels load without transposing them.
+        void Gather(const DrawList& draws);
+
+        const xr::math::TransformArrays& Transforms() const {
+            return m_transforms;
+        }
+
+    private:
+        struct Entry {
+            uint64_t Key;
+            uint32_t Draw;
+        };
+
+        std::vector<Entry> m_entries;
+        std::vector<Entry> m_sortScratch;
+        std::vector<Batch> m_batches;
+        xr::math::TransformArrays m_transforms;
+    };
+
+    // Position the depth of the draws of all views is measured from, between the views.
+    XrVector3f CenterOfViews(const std::pmr::vector<xr::math::ViewProjection>& viewProjections);
+} // namespace sample
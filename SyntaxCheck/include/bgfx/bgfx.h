@@ -0,0 +1,151 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the bgfx API used by the application, with the signatures of bgfx.h.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#define BGFX_INVALID_HANDLE {UINT16_MAX}
+#define BGFX_STATE_WRITE_R UINT64_C(0x0000000000000001)
+#define BGFX_STATE_WRITE_G UINT64_C(0x0000000000000002)
+#define BGFX_STATE_WRITE_B UINT64_C(0x0000000000000004)
+#define BGFX_STATE_WRITE_A UINT64_C(0x0000000000000008)
+#define BGFX_STATE_WRITE_Z UINT64_C(0x0000004000000000)
+#define BGFX_STATE_WRITE_RGB (BGFX_STATE_WRITE_R | BGFX_STATE_WRITE_G | BGFX_STATE_WRITE_B)
+#define BGFX_STATE_DEPTH_TEST_LESS UINT64_C(0x0000000000000010)
+#define BGFX_STATE_DEPTH_TEST_GREATER UINT64_C(0x0000000000000050)
+#define BGFX_STATE_DEPTH_TEST_ALWAYS UINT64_C(0x0000000000000080)
+#define BGFX_STATE_CULL_CW UINT64_C(0x0000001000000000)
+#define BGFX_STATE_CULL_CCW UINT64_C(0x0000002000000000)
+#define BGFX_STATE_MSAA UINT64_C(0x0100000000000000)
+#define BGFX_STATE_DEFAULT (BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A | BGFX_STATE_WRITE_Z | BGFX_STATE_DEPTH_TEST_LESS | BGFX_STATE_CULL_CW | BGFX_STATE_MSAA)
+#define BGFX_DISCARD_ALL UINT8_C(0xff)
+#define BGFX_DISCARD_INSTANCE_DATA UINT8_C(0x02)
+#define BGFX_DISCARD_TRANSFORM UINT8_C(0x10)
+#define BGFX_CLEAR_COLOR UINT16_C(0x0001)
+#define BGFX_CLEAR_DEPTH UINT16_C(0x0002)
+#define BGFX_BUFFER_NONE UINT16_C(0x0000)
+#define BGFX_BUFFER_INDEX32 UINT16_C(0x1000)
+#define BGFX_TEXTURE_NONE UINT64_C(0x0000000000000000)
+#define BGFX_TEXTURE_RT UINT64_C(0x0000001000000000)
+#define BGFX_TEXTURE_SRGB UINT64_C(0x0000200000000000)
+#define BGFX_SAMPLER_NONE UINT64_C(0x0000000000000000)
+#define BGFX_CAPS_INSTANCING UINT64_C(0x0000000000000080)
+namespace bx { struct AllocatorI; }
+namespace bgfx {
+    using ViewId = uint16_t;
+    struct ProgramHandle { uint16_t idx; };
+    struct UniformHandle { uint16_t idx; };
+    struct ShaderHandle { uint16_t idx; };
+    struct TextureHandle { uint16_t idx; };
+    struct FrameBufferHandle { uint16_t idx; };
+    struct VertexBufferHandle { uint16_t idx; };
+    struct IndexBufferHandle { uint16_t idx; };
+    struct RendererType { enum Enum { Noop, Direct3D9, Direct3D11, Direct3D12, Count }; };
+    struct Access { enum Enum { Read, Write, ReadWrite, Count }; };
+    struct Attrib { enum Enum { Position, Normal, Tangent, Bitangent, Color0, Color1, Color2, Color3, Indices, Weight,
+                                TexCoord0, TexCoord1, TexCoord2, TexCoord3, TexCoord4, TexCoord5, TexCoord6, TexCoord7, Count }; };
+    struct AttribType { enum Enum { Uint8, Uint10, Int16, Half, Float, Count }; };
+    struct TextureFormat { enum Enum { Unknown, UnknownDepth = 80, BGRA8, RGBA8, D16, D24S8, D32F, Count }; };
+    struct UniformType { enum Enum { Sampler, End, Vec4, Mat3, Mat4, Count }; };
+    struct ViewMode { enum Enum { Default, Sequential, DepthAscending, DepthDescending, Count }; };
+    struct Memory { uint8_t* data; uint32_t size; };
+    struct PlatformData { void* ndt; void* nwh; void* context; void* backBuffer; void* backBufferDS; };
+    struct Resolution { uint32_t format; uint32_t width; uint32_t height; uint32_t reset; uint8_t numBackBuffers; uint8_t maxFrameLatency; };
+    struct CallbackI;
+    struct Init {
+        Init();
+        RendererType::Enum type;
+        uint16_t vendorId;
+        uint16_t deviceId;
+        uint64_t capabilities;
+        bool debug;
+        bool profile;
+        PlatformData platformData;
+        Resolution resolution;
+        struct Limits { uint16_t maxEncoders; uint32_t minResourceCbSize; uint32_t transientVbSize; uint32_t transientIbSize; } limits;
+        CallbackI* callback;
+        bx::AllocatorI* allocator;
+    };
+    struct Caps { RendererType::Enum rendererType; uint64_t supported; uint16_t vendorId; uint16_t deviceId; bool homogeneousDepth; bool originBottomLeft; uint8_t numGPUs; struct Limits { uint32_t maxDrawCalls; uint32_t maxEncoders; } limits; };
+    struct Attachment {
+        void init(TextureHandle _handle, Access::Enum _access = Access::Write, uint16_t _layer = 0, uint16_t _numLayers = 1,
+                  uint16_t _mip = 0, uint8_t _resolve = 0);
+        Access::Enum access; TextureHandle handle; uint16_t mip; uint16_t layer; uint16_t numLayers; uint8_t resolve;
+    };
+    struct VertexLayout {
+        VertexLayout();
+        VertexLayout& begin(RendererType::Enum _renderer = RendererType::Noop);
+        void end();
+        VertexLayout& add(Attrib::Enum _attrib, uint8_t _num, AttribType::Enum _type, bool _normalized = false, bool _asInt = false);
+        uint16_t getStride() const;
+    };
+    struct InstanceDataBuffer { uint8_t* data; uint32_t size; uint32_t offset; uint32_t num; uint16_t stride; VertexBufferHandle handle; };
+    struct Encoder {
+        void setUniform(UniformHandle, const void*, uint16_t = 1);
+        void setVertexBuffer(uint8_t, VertexBufferHandle);
+        void setIndexBuffer(IndexBufferHandle);
+        void setState(uint64_t, uint32_t = 0);
+        void setInstanceDataBuffer(const InstanceDataBuffer*);
+        void setInstanceCount(uint32_t);
+        uint32_t setTransform(const void*, uint16_t = 1);
+        void touch(ViewId);
+        void submit(ViewId, ProgramHandle, uint32_t = 0, uint8_t = BGFX_DISCARD_ALL);
+        void discard(uint8_t = BGFX_DISCARD_ALL);
+    };
+    bool init(const Init& _init = {});
+    void shutdown();
+    const Caps* getCaps();
+    Encoder* begin(bool _forThread = false);
+    void end(Encoder* _encoder);
+    uint32_t frame(bool _capture = false);
+    const Memory* copy(const void* _data, uint32_t _size);
+    const Memory* makeRef(const void* _data, uint32_t _size, void (*_releaseFn)(void*, void*) = nullptr, void* _userData = nullptr);
+    ShaderHandle createShader(const Memory* _mem);
+    void setName(ShaderHandle _handle, const char* _name, int32_t _len = INT32_MAX);
+    ProgramHandle createProgram(ShaderHandle _vsh, ShaderHandle _fsh, bool _destroyShaders = false);
+    UniformHandle createUniform(const char* _name, UniformType::Enum _type, uint16_t _num = 1);
+    VertexBufferHandle createVertexBuffer(const Memory* _mem, const VertexLayout& _layout, uint16_t _flags = BGFX_BUFFER_NONE);
+    IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags = BGFX_BUFFER_NONE);
+    TextureHandle createTexture2D(uint16_t _width, uint16_t _height, bool _hasMips, uint16_t _numLayers, TextureFormat::Enum _format,
+                                  uint64_t _flags = BGFX_TEXTURE_NONE | BGFX_SAMPLER_NONE, const Memory* _mem = nullptr);
+    uintptr_t overrideInternal(TextureHandle _handle, uintptr_t _ptr);
+    FrameBufferHandle createFrameBuffer(uint8_t _num, const Attachment* _attachment, bool _destroyTexture = false);
+    void destroy(ProgramHandle);
+    void destroy(ShaderHandle);
+    void destroy(UniformHandle);
+    void destroy(TextureHandle);
+    void destroy(FrameBufferHandle);
+    void destroy(VertexBufferHandle);
+    void destroy(IndexBufferHandle);
+    void setViewFrameBuffer(ViewId _id, FrameBufferHandle _handle);
+    void setViewRect(ViewId _id, uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height);
+    void setViewClear(ViewId _id, uint16_t _flags, uint32_t _rgba = 0x000000ff, float _depth = 1.0f, uint8_t _stencil = 0);
+    void setViewMode(ViewId _id, ViewMode::Enum _mode = ViewMode::Default);
+    void touch(ViewId _id);
+    void setUniform(UniformHandle _handle, const void* _value, uint16_t _num = 1);
+    void setVertexBuffer(uint8_t _stream, VertexBufferHandle _handle);
+    void setIndexBuffer(IndexBufferHandle _handle);
+    void setInstanceCount(uint32_t _numInstances);
+    void setInstanceDataBuffer(const InstanceDataBuffer* _idb);
+    uint32_t setTransform(const void* _mtx, uint16_t _num = 1);
+    void discard(uint8_t _flags = BGFX_DISCARD_ALL);
+    void setState(uint64_t _state, uint32_t _rgba = 0);
+    void submit(ViewId _id, ProgramHandle _program, uint32_t _depth = 0, uint8_t _flags = BGFX_DISCARD_ALL);
+    uint32_t getAvailInstanceDataBuffer(uint32_t _num, uint16_t _stride);
+    void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride);
+    template <typename Ty> bool isValid(Ty _handle) { return UINT16_MAX != _handle.idx; }
+}
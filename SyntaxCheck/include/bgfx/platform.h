@@ -0,0 +1,24 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the bgfx platform API used by the application.
+#pragma once
+#include <bgfx/bgfx.h>
+namespace bgfx {
+    struct RenderFrame { enum Enum { NoContext, Render, Timeout, Exiting, Count }; };
+    RenderFrame::Enum renderFrame(int32_t _msecs = -1);
+    void setPlatformData(const PlatformData& _data);
+}
@@ -0,0 +1,23 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the bx allocators used by the application.
+#pragma once
+#include <cstddef>
+namespace bx {
+    struct AllocatorI { virtual ~AllocatorI() = 0; virtual void* realloc(void*, size_t, size_t, const char*, uint32_t) = 0; };
+    struct DefaultAllocator : AllocatorI { DefaultAllocator(); void* realloc(void*, size_t, size_t, const char*, uint32_t) override; };
+}
@@ -0,0 +1,135 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the D3D11 API used by the application.
+#pragma once
+#include <windows.h>
+#include <d3dcommon.h>
+#include <dxgi.h>
+#define D3D11_SDK_VERSION 7
+#define D3D11_APPEND_ALIGNED_ELEMENT 0xffffffff
+enum D3D11_CREATE_DEVICE_FLAG { D3D11_CREATE_DEVICE_DEBUG = 0x2, D3D11_CREATE_DEVICE_BGRA_SUPPORT = 0x20 };
+enum D3D11_BIND_FLAG { D3D11_BIND_VERTEX_BUFFER = 0x1, D3D11_BIND_INDEX_BUFFER = 0x2, D3D11_BIND_CONSTANT_BUFFER = 0x4,
+                       D3D11_BIND_SHADER_RESOURCE = 0x8 };
+enum D3D11_USAGE { D3D11_USAGE_DEFAULT, D3D11_USAGE_IMMUTABLE, D3D11_USAGE_DYNAMIC, D3D11_USAGE_STAGING };
+enum D3D11_CPU_ACCESS_FLAG { D3D11_CPU_ACCESS_WRITE = 0x10000, D3D11_CPU_ACCESS_READ = 0x20000 };
+enum D3D11_RESOURCE_MISC_FLAG { D3D11_RESOURCE_MISC_BUFFER_STRUCTURED = 0x40 };
+enum D3D11_CLEAR_FLAG { D3D11_CLEAR_DEPTH = 0x1, D3D11_CLEAR_STENCIL = 0x2 };
+enum D3D11_COMPARISON_FUNC { D3D11_COMPARISON_NEVER = 1, D3D11_COMPARISON_LESS, D3D11_COMPARISON_EQUAL, D3D11_COMPARISON_LESS_EQUAL,
+                             D3D11_COMPARISON_GREATER, D3D11_COMPARISON_NOT_EQUAL, D3D11_COMPARISON_GREATER_EQUAL, D3D11_COMPARISON_ALWAYS };
+enum D3D11_DEPTH_WRITE_MASK { D3D11_DEPTH_WRITE_MASK_ZERO, D3D11_DEPTH_WRITE_MASK_ALL };
+enum D3D11_CULL_MODE { D3D11_CULL_NONE = 1, D3D11_CULL_FRONT, D3D11_CULL_BACK };
+enum D3D11_FILL_MODE { D3D11_FILL_WIREFRAME = 2, D3D11_FILL_SOLID };
+enum D3D11_INPUT_CLASSIFICATION { D3D11_INPUT_PER_VERTEX_DATA, D3D11_INPUT_PER_INSTANCE_DATA };
+enum D3D11_MAP { D3D11_MAP_READ = 1, D3D11_MAP_WRITE, D3D11_MAP_READ_WRITE, D3D11_MAP_WRITE_DISCARD, D3D11_MAP_WRITE_NO_OVERWRITE };
+enum D3D11_RTV_DIMENSION { D3D11_RTV_DIMENSION_TEXTURE2DARRAY = 5 };
+enum D3D11_DSV_DIMENSION { D3D11_DSV_DIMENSION_TEXTURE2DARRAY = 4 };
+enum D3D11_SRV_DIMENSION { D3D11_SRV_DIMENSION_BUFFER = 1 };
+enum D3D11_FEATURE { D3D11_FEATURE_D3D11_OPTIONS3 = 15 };
+struct D3D11_FEATURE_DATA_D3D11_OPTIONS3 { BOOL VPAndRTArrayIndexFromAnyShaderFeedingRasterizer; };
+struct D3D11_INPUT_ELEMENT_DESC { LPCSTR SemanticName; UINT SemanticIndex; DXGI_FORMAT Format; UINT InputSlot; UINT AlignedByteOffset;
+                                  D3D11_INPUT_CLASSIFICATION InputSlotClass; UINT InstanceDataStepRate; };
+struct D3D11_SUBRESOURCE_DATA { const void* pSysMem; UINT SysMemPitch; UINT SysMemSlicePitch; };
+struct D3D11_MAPPED_SUBRESOURCE { void* pData; UINT RowPitch; UINT DepthPitch; };
+struct D3D11_BOX;
+struct D3D11_VIEWPORT { FLOAT TopLeftX, TopLeftY, Width, Height, MinDepth, MaxDepth; };
+struct D3D11_BUFFER_DESC { UINT ByteWidth; D3D11_USAGE Usage; UINT BindFlags; UINT CPUAccessFlags; UINT MiscFlags; UINT StructureByteStride; };
+struct D3D11_TEXTURE2D_DESC { UINT Width; UINT Height; UINT MipLevels; UINT ArraySize; DXGI_FORMAT Format; DXGI_SAMPLE_DESC SampleDesc;
+                              D3D11_USAGE Usage; UINT BindFlags; UINT CPUAccessFlags; UINT MiscFlags; };
+struct D3D11_DEPTH_STENCILOP_DESC { int StencilFailOp, StencilDepthFailOp, StencilPassOp; D3D11_COMPARISON_FUNC StencilFunc; };
+struct D3D11_DEPTH_STENCIL_DESC { BOOL DepthEnable; D3D11_DEPTH_WRITE_MASK DepthWriteMask; D3D11_COMPARISON_FUNC DepthFunc; BOOL StencilEnable;
+                                  BYTE StencilReadMask; BYTE StencilWriteMask; D3D11_DEPTH_STENCILOP_DESC FrontFace; D3D11_DEPTH_STENCILOP_DESC BackFace; };
+struct D3D11_RASTERIZER_DESC { D3D11_FILL_MODE FillMode; D3D11_CULL_MODE CullMode; BOOL FrontCounterClockwise; INT DepthBias; FLOAT DepthBiasClamp;
+                               FLOAT SlopeScaledDepthBias; BOOL DepthClipEnable; BOOL ScissorEnable; BOOL MultisampleEnable; BOOL AntialiasedLineEnable; };
+struct D3D11_RENDER_TARGET_VIEW_DESC { DXGI_FORMAT Format; D3D11_RTV_DIMENSION ViewDimension; UINT Data[4]; };
+struct D3D11_DEPTH_STENCIL_VIEW_DESC { DXGI_FORMAT Format; D3D11_DSV_DIMENSION ViewDimension; UINT Flags; UINT Data[3]; };
+struct D3D11_SHADER_RESOURCE_VIEW_DESC { DXGI_FORMAT Format; D3D11_SRV_DIMENSION ViewDimension; UINT Data[4]; };
+
+struct CD3D11_DEFAULT {};
+struct CD3D11_BUFFER_DESC : D3D11_BUFFER_DESC {
+    explicit CD3D11_BUFFER_DESC(UINT byteWidth, UINT bindFlags, D3D11_USAGE usage = D3D11_USAGE_DEFAULT, UINT cpuaccessFlags = 0,
+                                UINT miscFlags = 0, UINT structureByteStride = 0);
+};
+struct CD3D11_DEPTH_STENCIL_DESC : D3D11_DEPTH_STENCIL_DESC { explicit CD3D11_DEPTH_STENCIL_DESC(CD3D11_DEFAULT); };
+struct CD3D11_RASTERIZER_DESC : D3D11_RASTERIZER_DESC { explicit CD3D11_RASTERIZER_DESC(CD3D11_DEFAULT); };
+struct CD3D11_VIEWPORT : D3D11_VIEWPORT {
+    explicit CD3D11_VIEWPORT(FLOAT topLeftX, FLOAT topLeftY, FLOAT width, FLOAT height, FLOAT minDepth = 0.0f, FLOAT maxDepth = 1.0f);
+};
+struct CD3D11_RENDER_TARGET_VIEW_DESC : D3D11_RENDER_TARGET_VIEW_DESC {
+    explicit CD3D11_RENDER_TARGET_VIEW_DESC(D3D11_RTV_DIMENSION viewDimension, DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN, UINT mipSlice = 0,
+                                            UINT firstArraySlice = 0, UINT arraySize = (UINT)-1);
+};
+struct CD3D11_DEPTH_STENCIL_VIEW_DESC : D3D11_DEPTH_STENCIL_VIEW_DESC {
+    explicit CD3D11_DEPTH_STENCIL_VIEW_DESC(D3D11_DSV_DIMENSION viewDimension, DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN, UINT mipSlice = 0,
+                                            UINT firstArraySlice = 0, UINT arraySize = (UINT)-1, UINT flags = 0);
+};
+struct ID3D11Buffer;
+struct CD3D11_SHADER_RESOURCE_VIEW_DESC : D3D11_SHADER_RESOURCE_VIEW_DESC {
+    explicit CD3D11_SHADER_RESOURCE_VIEW_DESC(ID3D11Buffer*, DXGI_FORMAT format, UINT firstElement, UINT numElements, UINT flags = 0);
+};
+
+struct ID3D11DeviceChild : IUnknown {};
+struct ID3D11Resource : ID3D11DeviceChild {};
+struct ID3D11Buffer : ID3D11Resource {};
+struct ID3D11Texture2D : ID3D11Resource { virtual void GetDesc(D3D11_TEXTURE2D_DESC* pDesc) = 0; };
+struct ID3D11View : ID3D11DeviceChild {};
+struct ID3D11RenderTargetView : ID3D11View {};
+struct ID3D11DepthStencilView : ID3D11View {};
+struct ID3D11ShaderResourceView : ID3D11View {};
+struct ID3D11VertexShader : ID3D11DeviceChild {};
+struct ID3D11PixelShader : ID3D11DeviceChild {};
+struct ID3D11InputLayout : ID3D11DeviceChild {};
+struct ID3D11DepthStencilState : ID3D11DeviceChild {};
+struct ID3D11RasterizerState : ID3D11DeviceChild {};
+struct ID3D11ClassLinkage;
+struct ID3D11ClassInstance;
+
+struct ID3D11Device : IUnknown {
+    virtual HRESULT CreateBuffer(const D3D11_BUFFER_DESC*, const D3D11_SUBRESOURCE_DATA*, ID3D11Buffer**) = 0;
+    virtual HRESULT CreateShaderResourceView(ID3D11Resource*, const D3D11_SHADER_RESOURCE_VIEW_DESC*, ID3D11ShaderResourceView**) = 0;
+    virtual HRESULT CreateRenderTargetView(ID3D11Resource*, const D3D11_RENDER_TARGET_VIEW_DESC*, ID3D11RenderTargetView**) = 0;
+    virtual HRESULT CreateDepthStencilView(ID3D11Resource*, const D3D11_DEPTH_STENCIL_VIEW_DESC*, ID3D11DepthStencilView**) = 0;
+    virtual HRESULT CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC*, UINT, const void*, SIZE_T, ID3D11InputLayout**) = 0;
+    virtual HRESULT CreateVertexShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11VertexShader**) = 0;
+    virtual HRESULT CreatePixelShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11PixelShader**) = 0;
+    virtual HRESULT CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC*, ID3D11DepthStencilState**) = 0;
+    virtual HRESULT CreateRasterizerState(const D3D11_RASTERIZER_DESC*, ID3D11RasterizerState**) = 0;
+    virtual HRESULT CheckFeatureSupport(D3D11_FEATURE, void*, UINT) = 0;
+};
+
+struct ID3D11DeviceContext : ID3D11DeviceChild {
+    virtual void VSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) = 0;
+    virtual void PSSetShader(ID3D11PixelShader*, ID3D11ClassInstance* const*, UINT) = 0;
+    virtual void VSSetShader(ID3D11VertexShader*, ID3D11ClassInstance* const*, UINT) = 0;
+    virtual void DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) = 0;
+    virtual HRESULT Map(ID3D11Resource*, UINT, D3D11_MAP, UINT, D3D11_MAPPED_SUBRESOURCE*) = 0;
+    virtual void Unmap(ID3D11Resource*, UINT) = 0;
+    virtual void IASetInputLayout(ID3D11InputLayout*) = 0;
+    virtual void IASetVertexBuffers(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) = 0;
+    virtual void IASetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT, UINT) = 0;
+    virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY) = 0;
+    virtual void VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) = 0;
+    virtual void OMSetRenderTargets(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*) = 0;
+    virtual void OMSetDepthStencilState(ID3D11DepthStencilState*, UINT) = 0;
+    virtual void RSSetState(ID3D11RasterizerState*) = 0;
+    virtual void RSSetViewports(UINT, const D3D11_VIEWPORT*) = 0;
+    virtual void UpdateSubresource(ID3D11Resource*, UINT, const D3D11_BOX*, const void*, UINT, UINT) = 0;
+    virtual void ClearRenderTargetView(ID3D11RenderTargetView*, const FLOAT[4]) = 0;
+    virtual void ClearDepthStencilView(ID3D11DepthStencilView*, UINT, FLOAT, BYTE) = 0;
+};
+
+HRESULT D3D11CreateDevice(IDXGIAdapter*, D3D_DRIVER_TYPE, HMODULE, UINT, const D3D_FEATURE_LEVEL*, UINT, UINT, ID3D11Device**,
+                          D3D_FEATURE_LEVEL*, ID3D11DeviceContext**);
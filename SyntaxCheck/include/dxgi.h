@@ -0,0 +1,37 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the DXGI API used by the application.
+#pragma once
+#include <windows.h>
+enum DXGI_FORMAT {
+    DXGI_FORMAT_UNKNOWN = 0, DXGI_FORMAT_R32G32B32A32_FLOAT = 2, DXGI_FORMAT_R32G32B32_FLOAT = 6, DXGI_FORMAT_R16G16B16A16_SNORM = 13,
+    DXGI_FORMAT_R16G16B16A16_SINT = 14, DXGI_FORMAT_R32G32_FLOAT = 16, DXGI_FORMAT_D32_FLOAT_S8X24_UINT = 20, DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+    DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29, DXGI_FORMAT_R8G8B8A8_UINT = 30, DXGI_FORMAT_R16G16_SNORM = 37, DXGI_FORMAT_R16G16_SINT = 38,
+    DXGI_FORMAT_D32_FLOAT = 40, DXGI_FORMAT_R32_FLOAT = 41, DXGI_FORMAT_R32_UINT = 42, DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+    DXGI_FORMAT_D16_UNORM = 55, DXGI_FORMAT_R16_UINT = 57, DXGI_FORMAT_B8G8R8A8_UNORM = 87, DXGI_FORMAT_B8G8R8A8_UNORM_SRGB = 91,
+};
+#define DXGI_ERROR_NOT_FOUND ((HRESULT)0x887A0002L)
+#define DXGI_ERROR_SDK_COMPONENT_MISSING ((HRESULT)0x887A002DL)
+struct DXGI_SAMPLE_DESC { UINT Count; UINT Quality; };
+struct DXGI_ADAPTER_DESC1 { WCHAR Description[128]; UINT VendorId; UINT DeviceId; UINT SubSysId; UINT Revision; SIZE_T DedicatedVideoMemory;
+                            SIZE_T DedicatedSystemMemory; SIZE_T SharedSystemMemory; LUID AdapterLuid; UINT Flags; };
+struct IDXGIObject : IUnknown {};
+struct IDXGIAdapter : IDXGIObject {};
+struct IDXGIAdapter1 : IDXGIAdapter { virtual HRESULT GetDesc1(DXGI_ADAPTER_DESC1* pDesc) = 0; };
+struct IDXGIFactory : IDXGIObject {};
+struct IDXGIFactory1 : IDXGIFactory { virtual HRESULT EnumAdapters1(UINT Adapter, IDXGIAdapter1** ppAdapter) = 0; };
+HRESULT CreateDXGIFactory1(REFIID riid, void** ppFactory);
@@ -0,0 +1,81 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the Win32 and CRT surface used by the application, see SyntaxCheck/CMakeLists.txt.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+typedef unsigned int UINT;
+typedef int INT;
+typedef int BOOL;
+typedef float FLOAT;
+typedef long HRESULT;
+typedef unsigned long DWORD;
+typedef unsigned long ULONG;
+typedef long LONG;
+typedef unsigned char BYTE;
+typedef size_t SIZE_T;
+typedef const char* LPCSTR;
+typedef const wchar_t* LPCWSTR;
+typedef wchar_t* LPWSTR;
+typedef wchar_t WCHAR;
+typedef void* HANDLE;
+typedef void* HMODULE;
+typedef void* HINSTANCE;
+typedef uint64_t UINT64;
+typedef int64_t LONGLONG;
+typedef uintptr_t UINT_PTR;
+struct LUID { DWORD LowPart; LONG HighPart; };
+union LARGE_INTEGER { struct { DWORD LowPart; LONG HighPart; }; LONGLONG QuadPart; };
+struct GUID { uint32_t Data1; uint16_t Data2; uint16_t Data3; uint8_t Data4[8]; };
+typedef GUID IID;
+#define REFIID const IID&
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define S_OK ((HRESULT)0L)
+#define CP_UTF8 65001
+#define GENERIC_READ 0x80000000L
+#define FILE_SHARE_READ 0x00000001
+#define OPEN_EXISTING 3
+#define PAGE_READONLY 0x02
+#define FILE_MAP_READ 0x0004
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+#define STDMETHODCALLTYPE
+#define WINAPI_PARTITION_DESKTOP 1
+#define WINAPI_FAMILY_PARTITION(partition) (partition)
+struct IUnknown {
+    virtual HRESULT QueryInterface(REFIID riid, void** ppvObject) = 0;
+    virtual ULONG AddRef() = 0;
+    virtual ULONG Release() = 0;
+};
+int MultiByteToWideChar(UINT, DWORD, LPCSTR, int, wchar_t*, int);
+int WideCharToMultiByte(UINT, DWORD, LPCWSTR, int, char*, int, LPCSTR, BOOL*);
+DWORD GetLastError();
+struct CREATEFILE2_EXTENDED_PARAMETERS;
+HANDLE CreateFile2(LPCWSTR, DWORD, DWORD, DWORD, CREATEFILE2_EXTENDED_PARAMETERS*);
+BOOL GetFileSizeEx(HANDLE, LARGE_INTEGER*);
+struct SECURITY_ATTRIBUTES;
+HANDLE CreateFileMappingFromApp(HANDLE, SECURITY_ATTRIBUTES*, ULONG, UINT64, LPCWSTR);
+void* MapViewOfFileFromApp(HANDLE, ULONG, UINT64, SIZE_T);
+BOOL UnmapViewOfFile(const void*);
+BOOL CloseHandle(HANDLE);
+void OutputDebugStringA(LPCSTR);
+
+// CRT secure string functions, declared by <string.h> on Windows.
+int strncpy_s(char*, size_t, const char*, size_t);
+template <size_t N>
+int strcpy_s(char (&)[N], const char*);
@@ -0,0 +1,47 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Declarations-only stand-in of the C++/WinRT base used by the application.
+#pragma once
+#include <windows.h>
+namespace winrt {
+    template <typename T> const GUID& guid_of();
+    template <typename T>
+    struct com_ptr {
+        com_ptr() = default;
+        com_ptr(std::nullptr_t) {}
+        com_ptr(const com_ptr&);
+        com_ptr(com_ptr&&);
+        com_ptr& operator=(const com_ptr&);
+        com_ptr& operator=(com_ptr&&);
+        com_ptr& operator=(std::nullptr_t);
+        ~com_ptr();
+        explicit operator bool() const;
+        T* operator->() const;
+        T* get() const;
+        T** put();
+        void** put_void();
+        T* m_ptr{nullptr};
+    };
+    struct handle {
+        explicit handle(HANDLE);
+        handle(handle&&);
+        ~handle();
+        HANDLE get() const;
+        explicit operator bool() const;
+    };
+    using file_handle = handle;
+}
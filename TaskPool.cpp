@@ -0,0 +1,83 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "TaskPool.h"
+
+namespace sample {
+    TaskPool::TaskPool(uint32_t workerCount) {
+        for (uint32_t i = 0; i < workerCount; i++) {
+            m_workers.emplace_back([this, thread = i + 1] {
+                uint64_t generation = 0;
+                for (;;) {
+                    {
+                        std::unique_lock lock(m_mutex);
+                        m_wake.wait(lock, [&] { return m_stopping || m_generation != generation; });
+                        if (m_stopping) {
+                            return;
+                        }
+                        generation = m_generation;
+                    }
+
+                    RunIterations(thread);
+
+                    std::lock_guard lock(m_mutex);
+                    if (--m_busyWorkerCount == 0) {
+                        m_done.notify_one();
+                    }
+                }
+            });
+        }
+    }
+
+    TaskPool::~TaskPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void TaskPool::Run(uint32_t count, Function function, void* context) {
+        std::lock_guard runLock(m_runMutex);
+        {
+            // The loop is published under the lock the workers wake up with.
+            std::lock_guard lock(m_mutex);
+            m_function = function;
+            m_context = context;
+            m_count = count;
+            m_nextIndex.store(0, std::memory_order_relaxed);
+            m_busyWorkerCount = (uint32_t)m_workers.size();
+            m_generation++;
+        }
+        m_wake.notify_all();
+
+        RunIterations(0);
+
+        // Every worker takes part in every loop, so none is still reading the loop when the next one is published.
+        std::unique_lock lock(m_mutex);
+        m_done.wait(lock, [&] { return m_busyWorkerCount == 0; });
+    }
+
+    void TaskPool::RunIterations(uint32_t thread) {
+        for (uint32_t index = m_nextIndex.fetch_add(1, std::memory_order_relaxed); index < m_count;
+             index = m_nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+            m_function(m_context, index, thread);
+        }
+    }
+} // namespace sample
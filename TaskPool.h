@@ -0,0 +1,72 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sample {
+    // Worker threads running the iterations of a loop in parallel, for splitting the work of a frame across cores.
+    // ParallelFor() returns once every iteration ran, the calling thread runs iterations too. Running a loop does not allocate.
+    // Thread 0 is always the calling thread and the workers are 1 to ThreadCount() - 1, so a task can use state bound to the
+    // calling thread, such as the bgfx encoder of the API thread, when its thread is 0.
+    class TaskPool {
+    public:
+        // workerCount threads are started besides the threads calling ParallelFor(), 0 runs every loop on the calling thread.
+        explicit TaskPool(uint32_t workerCount);
+        ~TaskPool();
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator=(const TaskPool&) = delete;
+
+        // Number of threads running a loop, the calling thread included.
+        uint32_t ThreadCount() const {
+            return (uint32_t)m_workers.size() + 1;
+        }
+
+        // Calls task(index, thread) for every index in [0, count). thread is in [0, ThreadCount()), 0 for the calling thread, and
+        // identifies the thread for per-thread state. Tasks must not throw. Loops of different threads run one after the other.
+        template <typename TTask>
+        void ParallelFor(uint32_t count, TTask&& task) {
+            using Task = std::remove_reference_t<TTask>;
+            Run(count, [](void* context, uint32_t index, uint32_t thread) { (*static_cast<Task*>(context))(index, thread); }, &task);
+        }
+
+    private:
+        using Function = void (*)(void* context, uint32_t index, uint32_t thread);
+
+        void Run(uint32_t count, Function function, void* context);
+        void RunIterations(uint32_t thread);
+
+        std::mutex m_runMutex; // Serializes the loops.
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        uint64_t m_generation{0};
+        uint32_t m_busyWorkerCount{0};
+        bool m_stopping{false};
+
+        Function m_function{nullptr};
+        void* m_context{nullptr};
+        uint32_t m_count{0};
+        std::atomic<uint32_t> m_nextIndex{0};
+
+        std::vector<std::thread> m_workers;
+    };
+} // namespace sample
@@ -0,0 +1,170 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "AssetArchive.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    struct Blob {
+        std::string Name;
+        sample::ArchiveEntryType Type;
+        std::string Content;
+    };
+
+    // Bytes of an archive holding the blobs, laid out as AssetPacker writes it.
+    std::vector<uint8_t> PackArchive(std::vector<Blob> blobs) {
+        std::sort(blobs.begin(), blobs.end(), [](const Blob& a, const Blob& b) {
+            return sample::ArchiveNameHash(a.Name) < sample::ArchiveNameHash(b.Name);
+        });
+
+        std::vector<sample::ArchiveEntry> entries(blobs.size());
+        uint64_t offset = sizeof(sample::ArchiveHeader) + entries.size() * sizeof(sample::ArchiveEntry);
+        for (size_t i = 0; i < blobs.size(); i++) {
+            offset = (offset + sample::ArchiveAlignment - 1) / sample::ArchiveAlignment * sample::ArchiveAlignment;
+            sample::ArchiveEntry& entry = entries[i];
+            std::memset(&entry, 0, sizeof(entry));
+            std::memcpy(entry.Name, blobs[i].Name.c_str(), blobs[i].Name.size() + 1);
+            entry.NameHash = sample::ArchiveNameHash(blobs[i].Name);
+            entry.ContentHash = sample::HashContent(reinterpret_cast<const uint8_t*>(blobs[i].Content.data()), blobs[i].Content.size());
+            entry.Offset = offset;
+            entry.Size = blobs[i].Content.size();
+            entry.Type = blobs[i].Type;
+            entry.Stride = 0;
+            offset += entry.Size;
+        }
+
+        std::vector<uint8_t> bytes(static_cast<size_t>(offset));
+        const sample::ArchiveHeader header{
+            sample::ArchiveMagic, sample::ArchiveVersion, static_cast<uint32_t>(entries.size()), 0, offset, 0};
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + sizeof(header), entries.data(), entries.size() * sizeof(sample::ArchiveEntry));
+        for (size_t i = 0; i < blobs.size(); i++) {
+            std::memcpy(bytes.data() + entries[i].Offset, blobs[i].Content.data(), blobs[i].Content.size());
+        }
+        return bytes;
+    }
+
+    sample::ArchiveEntry* EntryAt(std::vector<uint8_t>& bytes, size_t index) {
+        return reinterpret_cast<sample::ArchiveEntry*>(bytes.data() + sizeof(sample::ArchiveHeader)) + index;
+    }
+
+    // Writes the bytes to the temp directory and opens them as an archive.
+    sample::AssetArchive OpenArchive(sample::AssetLoader& loader, const std::vector<uint8_t>& bytes, const std::string& name) {
+        const std::string path = (std::filesystem::temp_directory_path() / ("AssetArchiveTest-" + name)).string();
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        sample::AssetPtr file = loader.Load(path);
+        std::filesystem::remove(path);
+        return sample::AssetArchive(std::move(file));
+    }
+
+    bool IsRejected(const std::vector<uint8_t>& bytes, const std::string& name) {
+        sample::AssetLoader loader;
+        try {
+            OpenArchive(loader, bytes, name);
+        } catch (const std::exception&) {
+            return true;
+        }
+        return false;
+    }
+
+    const std::vector<Blob> Blobs{
+        {"vs_instancing.bin", sample::ArchiveEntryType::Shader, "vertex shader"},
+        {"fs_instancing.bin", sample::ArchiveEntryType::Shader, "fragment shader"},
+        {"cube.vertices", sample::ArchiveEntryType::VertexStream, std::string(24 * 12, 'v')},
+        {"cube.indices", sample::ArchiveEntryType::IndexStream, std::string(36 * 2, 'i')},
+    };
+} // namespace
+
+TEST_CASE(EntriesAreFoundByName) {
+    sample::AssetLoader loader;
+    const sample::AssetArchive archive = OpenArchive(loader, PackArchive(Blobs), "valid");
+    CHECK(archive.EntryCount() == Blobs.size());
+
+    for (const Blob& blob : Blobs) {
+        const sample::ArchiveEntry* const entry = archive.Find(blob.Name);
+        CHECK(entry != nullptr);
+        CHECK(entry->Type == blob.Type);
+        CHECK(entry->Offset % sample::ArchiveAlignment == 0);
+        CHECK(std::string(reinterpret_cast<const char*>(archive.Data(*entry)), entry->Size) == blob.Content);
+        CHECK(entry->ContentHash == sample::HashContent(archive.Data(*entry), entry->Size));
+        CHECK(&archive.Get(blob.Name, blob.Type) == entry);
+    }
+    CHECK(archive.Find("missing.bin") == nullptr);
+}
+
+TEST_CASE(GetChecksTheType) {
+    sample::AssetLoader loader;
+    const sample::AssetArchive archive = OpenArchive(loader, PackArchive(Blobs), "types");
+
+    const auto throws = [&](std::string_view name, sample::ArchiveEntryType type) {
+        try {
+            archive.Get(name, type);
+        } catch (const std::exception&) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(!throws("cube.indices", sample::ArchiveEntryType::IndexStream));
+    CHECK(throws("cube.indices", sample::ArchiveEntryType::VertexStream));
+    CHECK(throws("missing.bin", sample::ArchiveEntryType::Shader));
+}
+
+TEST_CASE(EmptyArchive) {
+    sample::AssetLoader loader;
+    const sample::AssetArchive archive = OpenArchive(loader, PackArchive({}), "empty");
+    CHECK(archive.EntryCount() == 0);
+    CHECK(archive.Find("vs_instancing.bin") == nullptr);
+}
+
+TEST_CASE(InvalidArchivesAreRejected) {
+    const std::vector<uint8_t> valid = PackArchive(Blobs);
+    CHECK(!IsRejected(valid, "valid"));
+
+    CHECK(IsRejected(std::vector<uint8_t>(valid.begin(), valid.begin() + sizeof(sample::ArchiveHeader) / 2), "short"));
+    CHECK(IsRejected(std::vector<uint8_t>(valid.begin(), valid.end() - 1), "truncated"));
+
+    // A file larger than its header says is not the archive that was written either.
+    std::vector<uint8_t> extended = valid;
+    extended.resize(valid.size() + sample::ArchiveAlignment);
+    CHECK(IsRejected(extended, "extended"));
+
+    std::vector<uint8_t> magic = valid;
+    magic[0] ^= 0xFF;
+    CHECK(IsRejected(magic, "magic"));
+
+    // A header claiming more entries than the file holds.
+    std::vector<uint8_t> entryCount = valid;
+    reinterpret_cast<sample::ArchiveHeader*>(entryCount.data())->EntryCount = 1000;
+    CHECK(IsRejected(entryCount, "count"));
+
+    std::vector<uint8_t> outOfBounds = valid;
+    EntryAt(outOfBounds, 1)->Size = valid.size();
+    CHECK(IsRejected(outOfBounds, "bounds"));
+
+    std::vector<uint8_t> misaligned = valid;
+    EntryAt(misaligned, 1)->Offset += 1;
+    CHECK(IsRejected(misaligned, "misaligned"));
+
+    std::vector<uint8_t> unsorted = valid;
+    std::swap(*EntryAt(unsorted, 0), *EntryAt(unsorted, 1));
+    CHECK(IsRejected(unsorted, "unsorted"));
+
+    std::vector<uint8_t> unterminated = valid;
+    std::memset(EntryAt(unterminated, 0)->Name, 'x', sizeof(sample::ArchiveEntry::Name));
+    CHECK(IsRejected(unterminated, "name"));
+}
@@ -0,0 +1,108 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "AssetArchiveFormat.h"
+#include "AssetLoader.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    // File of the temp directory, removed when the test ends.
+    class TempFile {
+    public:
+        TempFile(const std::string& name, const std::string& content)
+            : m_path((std::filesystem::temp_directory_path() / ("AssetLoaderTest-" + name)).string()) {
+            std::ofstream(m_path, std::ios::binary) << content;
+        }
+        ~TempFile() {
+            std::error_code error;
+            std::filesystem::remove(m_path, error);
+        }
+
+        const std::string& Path() const {
+            return m_path;
+        }
+
+    private:
+        std::string m_path;
+    };
+
+    std::string Content(const sample::Asset& asset) {
+        return std::string(reinterpret_cast<const char*>(asset.Data()), asset.Size());
+    }
+} // namespace
+
+TEST_CASE(LoadMapsTheFileContent) {
+    const TempFile file("content", "vertex shader");
+    const TempFile empty("empty", "");
+
+    sample::AssetLoader loader;
+    const sample::AssetPtr asset = loader.Load(file.Path());
+    CHECK(Content(*asset) == "vertex shader");
+    CHECK(asset->ContentHash() == sample::HashContent(asset->Data(), asset->Size()));
+
+    const sample::AssetPtr emptyAsset = loader.Load(empty.Path());
+    CHECK(emptyAsset->Size() == 0);
+    CHECK(loader.FileReadCount() == 2);
+}
+
+TEST_CASE(APathIsReadOnce) {
+    const TempFile file("once", "pixel shader");
+
+    sample::AssetLoader loader(4);
+    std::vector<std::shared_future<sample::AssetPtr>> futures;
+    for (uint32_t i = 0; i < 32; i++) {
+        futures.push_back(loader.LoadAsync(file.Path()));
+    }
+    for (const std::shared_future<sample::AssetPtr>& future : futures) {
+        CHECK(future.get() == futures.front().get());
+    }
+    CHECK(loader.FileReadCount() == 1);
+}
+
+TEST_CASE(IdenticalFilesShareOneAsset) {
+    const TempFile first("first", "same bytes");
+    const TempFile second("second", "same bytes");
+    const TempFile other("other", "other bytes");
+
+    sample::AssetLoader loader;
+    const sample::AssetPtr firstAsset = loader.Load(first.Path());
+    const sample::AssetPtr secondAsset = loader.Load(second.Path());
+    const sample::AssetPtr otherAsset = loader.Load(other.Path());
+    CHECK(firstAsset == secondAsset);
+    CHECK(otherAsset != firstAsset);
+    CHECK(Content(*otherAsset) == "other bytes");
+    CHECK(loader.FileReadCount() == 3); // Both paths are read, only the content is shared.
+}
+
+TEST_CASE(AFailedLoadIsRetried) {
+    const std::string path = (std::filesystem::temp_directory_path() / "AssetLoaderTest-missing").string();
+    std::filesystem::remove(path);
+
+    sample::AssetLoader loader;
+    bool threw = false;
+    try {
+        loader.Load(path);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    const TempFile file("missing", "created later");
+    CHECK(Content(*loader.Load(path)) == "created later");
+    CHECK(loader.FileReadCount() == 1);
+}
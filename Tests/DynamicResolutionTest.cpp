@@ -0,0 +1,110 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "DynamicResolution.h"
+
+namespace {
+    constexpr XrDuration DisplayPeriod = 10'000'000;
+
+    // Render time of a frame whose cost at full scale is fullScaleLoad display periods, the cost being proportional to the pixels.
+    XrDuration RenderDuration(float fullScaleLoad, float scale) {
+        return (XrDuration)(fullScaleLoad * scale * scale * DisplayPeriod);
+    }
+
+    // Feeds frameCount frames of a scene costing fullScaleLoad display periods at full scale, and returns the last scale.
+    float Run(sample::DynamicResolutionController& controller, float fullScaleLoad, uint32_t frameCount) {
+        for (uint32_t i = 0; i < frameCount; i++) {
+            controller.Update(RenderDuration(fullScaleLoad, controller.Scale()), DisplayPeriod, 0);
+        }
+        return controller.Scale();
+    }
+} // namespace
+
+TEST_CASE(StepsDownOverBudget) {
+    sample::DynamicResolutionController controller;
+    CHECK(controller.Scale() == 1.0f);
+
+    // A single frame over the upper budget drops the scale to the middle of the budget band.
+    const float scale = controller.Update(RenderDuration(1.2f, 1.0f), DisplayPeriod, 0);
+    CHECK_NEAR(scale, std::sqrt(0.8 / 1.2), 1e-5);
+
+    // The scene then fits the band, so the scale holds.
+    CHECK(Run(controller, 1.2f, 300) == scale);
+}
+
+TEST_CASE(StepsBackUpUnderBudget) {
+    sample::DynamicResolutionController controller;
+    const sample::DynamicResolutionSettings& settings = controller.Settings();
+    Run(controller, 1.6f, 1);
+    const float droppedScale = controller.Scale();
+    CHECK(droppedScale < 0.75f);
+
+    // Once the load goes away, the scale grows by one step after IncreaseDelayFrames frames under the lower budget.
+    CHECK(Run(controller, 0.5f, settings.IncreaseDelayFrames - 1) == droppedScale);
+    CHECK_NEAR(Run(controller, 0.5f, 1), droppedScale + settings.IncreaseStep, 1e-5);
+
+    // And recovers the maximum scale step by step.
+    const uint32_t stepCount = (uint32_t)std::ceil((settings.MaxScale - droppedScale) / settings.IncreaseStep);
+    CHECK(Run(controller, 0.5f, stepCount * settings.IncreaseDelayFrames) == settings.MaxScale);
+    CHECK(Run(controller, 0.5f, 300) == settings.MaxScale);
+}
+
+TEST_CASE(DoesNotGrowBackOverBudget) {
+    // With large steps, growing from the minimum scale would more than double the cost.
+    sample::DynamicResolutionSettings settings;
+    settings.IncreaseStep = 0.25f;
+    sample::DynamicResolutionController controller(settings);
+    CHECK(Run(controller, 100.0f, 1) == settings.MinScale);
+
+    // Under the lower budget at this scale, but one step larger would go over the upper budget and drop again.
+    const float fullScaleLoad = 0.69f / (settings.MinScale * settings.MinScale);
+    CHECK(RenderDuration(fullScaleLoad, settings.MinScale + settings.IncreaseStep) > settings.UpperBudget * DisplayPeriod);
+    CHECK(Run(controller, fullScaleLoad, 600) == settings.MinScale);
+}
+
+TEST_CASE(MissedFramesStepDown) {
+    sample::DynamicResolutionController controller;
+
+    // The measured render time is small, but a missed display period means the frame took longer than the budget.
+    CHECK(controller.Update(RenderDuration(0.3f, 1.0f), DisplayPeriod, 1) < 1.0f);
+}
+
+TEST_CASE(ScaleStaysInBounds) {
+    sample::DynamicResolutionController controller;
+    const sample::DynamicResolutionSettings& settings = controller.Settings();
+    CHECK(Run(controller, 100.0f, 10) == settings.MinScale);
+    CHECK(Run(controller, 0.01f, 10'000) == settings.MaxScale);
+
+    // Invalid display periods leave the scale alone.
+    Run(controller, 10.0f, 1);
+    const float scale = controller.Scale();
+    CHECK(controller.Update(DisplayPeriod, 0, 0) == scale);
+
+    controller.Reset();
+    CHECK(controller.Scale() == settings.MaxScale);
+}
+
+TEST_CASE(ScaledExtentIsClamped) {
+    const XrExtent2Di extent{1440, 936};
+    const XrExtent2Di scaled = sample::ScaleExtent(extent, 0.5f, extent);
+    CHECK(scaled.width == 720 && scaled.height == 468);
+
+    const XrExtent2Di larger = sample::ScaleExtent(extent, 2.0f, extent);
+    CHECK(larger.width == extent.width && larger.height == extent.height);
+
+    const XrExtent2Di smallest = sample::ScaleExtent(extent, 0.0f, extent);
+    CHECK(smallest.width == 1 && smallest.height == 1);
+}
@@ -0,0 +1,130 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "FrameArena.h"
+
+namespace {
+    // Upstream resource counting the memory the arena takes from it.
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        uint32_t AllocationCount{0};
+        size_t OutstandingBytes{0};
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            AllocationCount++;
+            OutstandingBytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            OutstandingBytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    bool IsAligned(const void* pointer, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+    }
+} // namespace
+
+TEST_CASE(AllocatesFromTheBufferUntilFull) {
+    CountingResource upstream;
+    sample::FrameArena arena(1024, &upstream);
+    CHECK(upstream.AllocationCount == 1);
+
+    std::byte* const first = static_cast<std::byte*>(arena.allocate(3, 1));
+    void* const aligned = arena.allocate(16, 16);
+    CHECK(IsAligned(aligned, 16));
+    CHECK(static_cast<std::byte*>(aligned) - first == 16); // Padded after the first 3 bytes.
+    CHECK(arena.Used() == 32);
+    CHECK(upstream.AllocationCount == 1);
+
+    arena.deallocate(aligned, 16, 16); // Does not give the memory back before the reset.
+    CHECK(arena.Used() == 32);
+
+    arena.Reset();
+    CHECK(arena.Used() == 0);
+    CHECK(arena.allocate(3, 1) == first);
+    CHECK(upstream.AllocationCount == 1);
+}
+
+TEST_CASE(OverflowGrowsTheBufferAtReset) {
+    CountingResource upstream;
+    sample::FrameArena arena(256, &upstream);
+
+    const auto frame = [&] {
+        for (uint32_t i = 0; i < 4; i++) {
+            static_cast<void>(arena.allocate(96, 8));
+        }
+    };
+
+    frame();
+    CHECK(arena.Used() == 4 * 96);
+    CHECK(upstream.AllocationCount == 3); // The buffer, then the two allocations that do not fit.
+    CHECK(upstream.OutstandingBytes == 256 + 2 * 96);
+
+    arena.Reset();
+    CHECK(arena.Capacity() >= 4 * 96);
+    CHECK(upstream.OutstandingBytes == arena.Capacity()); // The overflow blocks and the old buffer are released.
+
+    const uint32_t allocationCount = upstream.AllocationCount;
+    for (uint32_t i = 0; i < 10; i++) {
+        frame();
+        arena.Reset();
+    }
+    CHECK(upstream.AllocationCount == allocationCount);
+}
+
+TEST_CASE(OverAlignedAllocationsGoUpstream) {
+    CountingResource upstream;
+    sample::FrameArena arena(1024, &upstream);
+    constexpr size_t alignment = alignof(std::max_align_t) * 4;
+    void* const pointer = arena.allocate(64, alignment);
+    CHECK(IsAligned(pointer, alignment));
+    CHECK(upstream.AllocationCount == 2);
+}
+
+TEST_CASE(PmrContainersStopAllocatingAfterTheFirstFrame) {
+    CountingResource upstream;
+    sample::FrameArena arena(0, &upstream);
+    uint32_t allocationCount = 0;
+    for (uint32_t frame = 0; frame < 5; frame++) {
+        std::pmr::vector<XrPosef> poses(&arena);
+        std::pmr::vector<uint32_t> meshes(&arena);
+        for (uint32_t i = 0; i < 100; i++) {
+            poses.push_back(xr::math::Pose::Identity());
+            meshes.push_back(i);
+        }
+        if (frame == 1) {
+            allocationCount = upstream.AllocationCount;
+        }
+        CHECK(frame < 2 || upstream.AllocationCount == allocationCount);
+        arena.Reset();
+    }
+}
+
+TEST_CASE(DestructorReleasesEverything) {
+    CountingResource upstream;
+    {
+        sample::FrameArena arena(64, &upstream);
+        static_cast<void>(arena.allocate(1000, 8));
+        static_cast<void>(arena.allocate(32, 8));
+    }
+    CHECK(upstream.OutstandingBytes == 0);
+}
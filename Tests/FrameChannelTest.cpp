@@ -0,0 +1,102 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "FrameChannel.h"
+
+TEST_CASE(ValuesComeOutInOrder) {
+    sample::FrameChannel<uint32_t> channel(3);
+    uint32_t value = 0;
+    for (uint32_t round = 0; round < 5; round++) { // The ring wraps around.
+        CHECK(channel.Push(2 * round));
+        CHECK(channel.Push(2 * round + 1));
+        CHECK(channel.Pop(value) && value == 2 * round);
+        CHECK(channel.Pop(value) && value == 2 * round + 1);
+    }
+}
+
+TEST_CASE(PushBlocksWhileFull) {
+    sample::FrameChannel<uint32_t> channel(2);
+    CHECK(channel.Push(0));
+    CHECK(channel.Push(1));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] { pushed = channel.Push(2); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(!pushed);
+
+    uint32_t value = 0;
+    CHECK(channel.Pop(value) && value == 0);
+    producer.join();
+    CHECK(pushed);
+    CHECK(channel.Pop(value) && value == 1);
+    CHECK(channel.Pop(value) && value == 2);
+}
+
+TEST_CASE(CloseDrainsThenFails) {
+    sample::FrameChannel<std::unique_ptr<uint32_t>> channel(4);
+    CHECK(channel.Push(std::make_unique<uint32_t>(7)));
+    channel.Close();
+    CHECK(!channel.Push(std::make_unique<uint32_t>(8)));
+
+    std::unique_ptr<uint32_t> value;
+    CHECK(channel.Pop(value) && *value == 7);
+    CHECK(!channel.Pop(value));
+    CHECK(value != nullptr && *value == 7); // A failed Pop leaves the value as it was.
+}
+
+TEST_CASE(CloseWakesBlockedThreads) {
+    sample::FrameChannel<uint32_t> empty(1);
+    sample::FrameChannel<uint32_t> full(1);
+    CHECK(full.Push(0));
+
+    std::atomic<bool> popFailed{false};
+    std::atomic<bool> pushFailed{false};
+    std::thread consumer([&] {
+        uint32_t value;
+        popFailed = !empty.Pop(value);
+    });
+    std::thread producer([&] { pushFailed = !full.Push(1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    empty.Close();
+    full.Close();
+    consumer.join();
+    producer.join();
+    CHECK(popFailed);
+    CHECK(pushFailed);
+}
+
+TEST_CASE(ThreadsExchangeEveryValue) {
+    constexpr uint32_t Count = 10000;
+    sample::FrameChannel<uint32_t> channel(2);
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < Count; i++) {
+            channel.Push(i);
+        }
+        channel.Close();
+    });
+
+    uint32_t expected = 0;
+    bool inOrder = true;
+    uint32_t value;
+    while (channel.Pop(value)) {
+        inOrder = inOrder && value == expected;
+        expected++;
+    }
+    producer.join();
+    CHECK(inOrder);
+    CHECK(expected == Count);
+}
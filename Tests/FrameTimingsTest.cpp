@@ -0,0 +1,132 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "FrameTimings.h"
+
+#include <sstream>
+
+namespace {
+    constexpr XrDuration Period = 11'111'111;
+
+    sample::FrameTiming MakeTiming(uint64_t frameIndex, XrTime displayTime) {
+        sample::FrameTiming timing;
+        timing.FrameIndex = frameIndex;
+        timing.PredictedDisplayTime = displayTime;
+        timing.PredictedDisplayPeriod = Period;
+        timing.ShouldRender = true;
+        timing[sample::FrameStage::WaitFrame] = {1000, 2000};
+        timing[sample::FrameStage::EndFrame] = {5000, 8000};
+        return timing;
+    }
+
+    size_t CountOf(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1)) {
+            count++;
+        }
+        return count;
+    }
+} // namespace
+
+TEST_CASE(SnapshotKeepsTheLatestRecordsInOrder) {
+    sample::FrameTimingRecorder recorder(5); // Rounded up to 8.
+    CHECK(recorder.Snapshot().empty());
+    for (uint64_t i = 0; i < 3; i++) {
+        recorder.Record(MakeTiming(i, i * Period));
+    }
+    std::vector<sample::FrameTiming> timings = recorder.Snapshot();
+    CHECK(timings.size() == 3);
+    CHECK(timings.front().FrameIndex == 0 && timings.back().FrameIndex == 2);
+
+    for (uint64_t i = 3; i < 20; i++) {
+        recorder.Record(MakeTiming(i, i * Period));
+    }
+    CHECK(recorder.RecordedCount() == 20);
+    timings = recorder.Snapshot();
+    CHECK(timings.size() == 8);
+    for (size_t i = 0; i < timings.size(); i++) {
+        CHECK(timings[i].FrameIndex == 12 + i);
+    }
+}
+
+TEST_CASE(ConcurrentSnapshotsOnlySeeCompleteRecords) {
+    sample::FrameTimingRecorder recorder(16);
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 0; i < 200000; i++) {
+            sample::FrameTiming timing = MakeTiming(i, (XrTime)i * 3);
+            timing.HeapAllocations = i * 7;
+            recorder.Record(timing);
+        }
+        done = true;
+    });
+
+    uint64_t snapshotCount = 0;
+    while (!done || snapshotCount == 0) {
+        const std::vector<sample::FrameTiming> timings = recorder.Snapshot();
+        for (size_t i = 0; i < timings.size(); i++) {
+            // A torn copy would mix fields of two records.
+            CHECK(timings[i].PredictedDisplayTime == (XrTime)timings[i].FrameIndex * 3);
+            CHECK(timings[i].HeapAllocations == timings[i].FrameIndex * 7);
+            CHECK(i == 0 || timings[i].FrameIndex > timings[i - 1].FrameIndex);
+        }
+        snapshotCount++;
+    }
+    writer.join();
+}
+
+TEST_CASE(MissedDisplayPeriodsCountsSkippedPeriods) {
+    const sample::FrameTiming first = MakeTiming(0, 100 * Period);
+    CHECK(sample::MissedDisplayPeriods(first, MakeTiming(1, 101 * Period)) == 0);
+    CHECK(sample::MissedDisplayPeriods(first, MakeTiming(1, 103 * Period)) == 2);
+    CHECK(sample::MissedDisplayPeriods(first, MakeTiming(1, 103 * Period + Period / 3)) == 2); // Jitter rounds to the nearest.
+    CHECK(sample::MissedDisplayPeriods(first, MakeTiming(1, 100 * Period)) == 0);
+
+    sample::FrameTiming noPeriod = MakeTiming(1, 105 * Period);
+    noPeriod.PredictedDisplayPeriod = 0;
+    CHECK(sample::MissedDisplayPeriods(first, noPeriod) == 0);
+}
+
+TEST_CASE(CsvHasOneLinePerFrame) {
+    const std::vector<sample::FrameTiming> timings = {MakeTiming(0, 0), MakeTiming(1, Period), MakeTiming(2, 4 * Period)};
+    std::ostringstream out;
+    sample::WriteFrameTimingsCsv(timings, out);
+    const std::string csv = out.str();
+
+    CHECK(CountOf(csv, "\n") == 1 + timings.size());
+    const size_t columns = CountOf(csv.substr(0, csv.find('\n')), ",") + 1;
+    CHECK(columns == 9 + sample::FrameStageCount);
+
+    // The last frame follows two missed periods and lasts from the start of xrWaitFrame to the end of xrEndFrame.
+    const std::string lastLine = csv.substr(csv.rfind('\n', csv.size() - 2) + 1);
+    CHECK_MSG(lastLine.rfind("2,44444444,11111111,2,1,0,1.000,1000,7.000,1.000,", 0) == 0, lastLine.c_str());
+}
+
+TEST_CASE(ChromeTraceHasAnEventPerStage) {
+    std::vector<sample::FrameTiming> timings = {MakeTiming(0, 0), MakeTiming(1, 3 * Period), MakeTiming(2, 4 * Period)};
+    timings[2].Stages = {}; // A frame with no stage is not traced.
+    std::ostringstream out;
+    sample::WriteFrameTimingsChromeTrace(timings, out);
+    const std::string trace = out.str();
+
+    CHECK(CountOf(trace, "\"ph\":\"M\"") == 4);
+    CHECK(CountOf(trace, "\"ph\":\"b\"") == 2);
+    CHECK(CountOf(trace, "\"ph\":\"e\"") == 2);
+    CHECK(CountOf(trace, "\"ph\":\"X\"") == 4);
+    CHECK(CountOf(trace, "\"name\":\"MissedFrame\"") == 1);
+    CHECK(CountOf(trace, "{") == CountOf(trace, "}"));
+    CHECK(CountOf(trace, "[") == CountOf(trace, "]"));
+}
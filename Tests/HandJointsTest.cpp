@@ -0,0 +1,108 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "HandJoints.h"
+
+#include <sstream>
+
+namespace {
+    // Samples 10ns apart, the palm of the left hand at x = sample index, the other joints not tracked.
+    std::shared_ptr<const sample::HandJointRecording> MakeRecording(uint32_t sampleCount) {
+        auto recording = std::make_shared<sample::HandJointRecording>(sampleCount);
+        const uint32_t palm = xr::JointToIndex(XR_HAND_JOINT_PALM_MSFT);
+        for (uint32_t s = 0; s < sampleCount; s++) {
+            sample::HandJointSample& joints = (*recording)[s];
+            joints.Time = s * 10;
+            joints.Joints.Positions[palm] = {(float)s, 0, 0};
+            joints.Joints.Orientations[palm] = xr::math::Quaternion::Identity();
+            joints.Joints.Radii[palm] = 0.01f;
+            joints.Joints.Valid[palm] = 1;
+            joints.Joints.Tracked[0] = 1;
+        }
+        return recording;
+    }
+
+    // Index of the sample the playback returned, from the palm position.
+    float PlayedSample(sample::HandJointPlayback& playback, XrTime time) {
+        sample::HandJoints joints;
+        playback.Locate(XR_NULL_HANDLE, time, joints);
+        return joints.Positions[xr::JointToIndex(XR_HAND_JOINT_PALM_MSFT)].x;
+    }
+} // namespace
+
+TEST_CASE(PlaysLatestSample) {
+    sample::HandJointPlayback playback(MakeRecording(3));
+
+    // The recording starts at the time of the first call, each frame gets the latest sample at its time.
+    CHECK(PlayedSample(playback, 1000) == 0);
+    CHECK(PlayedSample(playback, 1009) == 0);
+    CHECK(PlayedSample(playback, 1010) == 1);
+    CHECK(PlayedSample(playback, 1025) == 2);
+}
+
+TEST_CASE(PlaybackLoops) {
+    sample::HandJointPlayback playback(MakeRecording(3));
+    CHECK(PlayedSample(playback, 0) == 0);
+    CHECK(PlayedSample(playback, 29) == 2);
+
+    // The last sample lasts as long as the first interval, then the recording starts over.
+    CHECK(PlayedSample(playback, 30) == 0);
+    CHECK(PlayedSample(playback, 45) == 1);
+
+    // Frames may skip over a whole loop.
+    CHECK(PlayedSample(playback, 30 * 10 + 20) == 2);
+}
+
+TEST_CASE(PlaybackRestartsWhenTimeGoesBack) {
+    sample::HandJointPlayback playback(MakeRecording(3));
+    CHECK(PlayedSample(playback, 100) == 0);
+    CHECK(PlayedSample(playback, 120) == 2);
+    CHECK(PlayedSample(playback, 50) == 0);
+    CHECK(PlayedSample(playback, 60) == 1);
+}
+
+TEST_CASE(RecordingRoundTrips) {
+    const std::shared_ptr<const sample::HandJointRecording> recording = MakeRecording(4);
+    std::stringstream csv;
+    sample::WriteHandJointRecording(*recording, csv);
+    const sample::HandJointRecording read = sample::ReadHandJointRecording(csv);
+
+    // Only the valid joints are written, so the others read back as not tracked.
+    CHECK(read.size() == recording->size());
+    const uint32_t palm = xr::JointToIndex(XR_HAND_JOINT_PALM_MSFT);
+    for (size_t s = 0; s < read.size(); s++) {
+        CHECK(read[s].Time == (*recording)[s].Time);
+        CHECK(read[s].Joints.Tracked[0] == 1 && read[s].Joints.Tracked[1] == 0);
+        CHECK(read[s].Joints.Positions[palm].x == (float)s);
+        CHECK(read[s].Joints.Radii[palm] == 0.01f);
+        for (uint32_t i = 0; i < sample::HandJoints::JointCount; i++) {
+            CHECK(read[s].Joints.Valid[i] == (i == palm ? 1 : 0));
+        }
+    }
+}
+
+TEST_CASE(UnsortedRecordingIsRejected) {
+    std::stringstream csv("Time,Hand,Joint,X,Y,Z,QX,QY,QZ,QW,Radius\n"
+                          "10,0,0,0,0,0,0,0,0,1,0.01\n"
+                          "0,0,0,0,0,0,0,0,0,1,0.01\n");
+    bool threw = false;
+    try {
+        sample::ReadHandJointRecording(csv);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
@@ -0,0 +1,125 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "HologramStore.h"
+
+namespace {
+    // The store only reads the handles, fake ones are unknown to the headless runtime which fails to destroy them.
+    xr::SpaceHandle FakeSpace(uint32_t i) {
+        xr::SpaceHandle space;
+        *space.Put() = reinterpret_cast<XrSpace>(uint64_t{0x100000000} + i);
+        return space;
+    }
+
+    sample::HologramId Add(sample::HologramStore& store, uint32_t i) {
+        return store.Add(FakeSpace(i), {}, {1, 1, 1}, i);
+    }
+} // namespace
+
+TEST_CASE(RemoveKeepsOtherIds) {
+    sample::HologramStore store;
+    const sample::HologramId a = Add(store, 0);
+    const sample::HologramId b = Add(store, 1);
+    const sample::HologramId c = Add(store, 2);
+
+    // The last hologram moves into the slot of the removed one.
+    store.Remove(a);
+    CHECK(store.Size() == 2);
+    CHECK(!store.Contains(a));
+    CHECK(store.Meshes()[store.IndexOf(b)] == 1);
+    CHECK(store.Meshes()[store.IndexOf(c)] == 2);
+    CHECK(store.Spaces()[store.IndexOf(c)] == FakeSpace(2).Get());
+}
+
+TEST_CASE(RemovedIdIsNotReused) {
+    sample::HologramStore store;
+    const sample::HologramId a = Add(store, 0);
+    store.Remove(a);
+
+    // The slot of a is reused with another generation, so a stays removed.
+    const sample::HologramId b = Add(store, 1);
+    CHECK(b != a);
+    CHECK(!store.Contains(a));
+    CHECK(store.Contains(b));
+    CHECK(store.Meshes()[store.IndexOf(b)] == 1);
+
+    store.Clear();
+    CHECK(!store.Contains(b));
+    const sample::HologramId c = Add(store, 2);
+    CHECK(c != a && c != b);
+    CHECK(store.Contains(c));
+}
+
+TEST_CASE(SlotsAreBounded) {
+    // Placing and removing one hologram at a time never grows the store past the largest number of holograms stored at once.
+    sample::HologramStore store;
+    store.Reserve(2);
+    const sample::HologramId first = Add(store, 0);
+    const XrSpace* spaces = store.Spaces();
+    sample::HologramId previous = Add(store, 1);
+    for (uint32_t i = 2; i < 10000; i++) {
+        store.Remove(previous);
+        previous = Add(store, i);
+    }
+    CHECK(store.Size() == 2);
+    CHECK(store.Contains(first));
+    CHECK(store.Spaces() == spaces);
+}
+
+TEST_CASE(PosedHologramsComeFirst) {
+    sample::HologramStore store;
+    const sample::HologramId a = Add(store, 0);
+    const sample::HologramId b = Add(store, 1);
+    const sample::HologramId c = Add(store, 2);
+    const sample::HologramId d = Add(store, 3);
+    CHECK(store.PosedCount() == 0);
+
+    const XrPosef poseOfC{xr::math::Quaternion::Identity(), {0, 0, 1}};
+    const XrPosef poseOfD{xr::math::Quaternion::Identity(), {0, 0, 2}};
+    store.SetPoseInSpace(c, poseOfC);
+    store.SetPoseInSpace(d, poseOfD);
+    CHECK(store.PosedCount() == 2);
+    CHECK(store.IndexOf(c) < 2 && store.IndexOf(d) < 2);
+    CHECK(store.IndexOf(a) >= 2 && store.IndexOf(b) >= 2);
+    CHECK(store.Meshes()[store.IndexOf(a)] == 0);
+    CHECK(store.Spaces()[store.IndexOf(c)] == FakeSpace(2).Get());
+
+    // Setting the pose again keeps the hologram in place.
+    const uint32_t indexOfD = store.IndexOf(d);
+    store.SetPoseInSpace(d, poseOfC);
+    CHECK(store.IndexOf(d) == indexOfD);
+    CHECK(store.PosedCount() == 2);
+
+    // Removing a posed hologram keeps the posed ones first and the others at the identity pose.
+    store.Remove(c);
+    CHECK(store.Size() == 3);
+    CHECK(store.PosedCount() == 1);
+    CHECK(store.IndexOf(d) == 0);
+    CHECK(store.PosesInSpace()[0].position.z == poseOfC.position.z);
+    for (const sample::HologramId id : {a, b}) {
+        const uint32_t index = store.IndexOf(id);
+        CHECK(index >= 1);
+        CHECK(store.PosesInSpace()[index].position.z == 0);
+        CHECK(store.Meshes()[index] == (id == a ? 0u : 1u));
+    }
+
+    store.Remove(a);
+    CHECK(store.PosedCount() == 1);
+    CHECK(store.IndexOf(b) == 1);
+
+    store.Clear();
+    CHECK(store.PosedCount() == 0);
+}
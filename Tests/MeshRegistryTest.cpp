@@ -0,0 +1,124 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "MeshRegistry.h"
+
+namespace {
+    // Interleaved vertex of a color then a position, so the position is not at the start of the vertex.
+    struct ColoredVertex {
+        uint8_t Color[4];
+        XrVector3f Position;
+    };
+
+    const std::vector<sample::VertexElement> ColoredLayout{
+        {sample::VertexAttribute::Color0, 4, sample::VertexAttributeType::Uint8, 1},
+        {sample::VertexAttribute::Position, 3, sample::VertexAttributeType::Float, 0},
+    };
+
+    const ColoredVertex Vertices[] = {
+        {{255, 0, 0, 255}, {-1.0f, 2.0f, 0.5f}},
+        {{0, 255, 0, 255}, {3.0f, -2.0f, 0.5f}},
+        {{0, 0, 255, 255}, {1.0f, 4.0f, -1.5f}},
+    };
+    const uint16_t Indices[] = {0, 1, 2};
+
+    sample::Mesh ColoredMesh() {
+        sample::Mesh mesh;
+        mesh.Layout = ColoredLayout;
+        mesh.VertexStride = sizeof(ColoredVertex);
+        mesh.Vertices = Vertices;
+        mesh.VertexCount = 3;
+        mesh.Indices = Indices;
+        mesh.IndexCount = 3;
+        return mesh;
+    }
+
+    bool IsRejected(const sample::Mesh& mesh) {
+        sample::MeshRegistry registry;
+        try {
+            registry.Add(mesh);
+        } catch (const std::exception&) {
+            return registry.Size() == 0;
+        }
+        return false;
+    }
+
+    void CheckVector(const XrVector3f& actual, const XrVector3f& expected) {
+        CHECK_NEAR(actual.x, expected.x, 1e-6f);
+        CHECK_NEAR(actual.y, expected.y, 1e-6f);
+        CHECK_NEAR(actual.z, expected.z, 1e-6f);
+    }
+} // namespace
+
+TEST_CASE(BoundsEncloseThePositions) {
+    sample::MeshRegistry registry;
+    const sample::MeshId id = registry.Add(ColoredMesh());
+    CHECK(id == 0);
+    CHECK(registry.Size() == 1);
+
+    const xr::math::Box& bounds = registry.Get(id).Bounds;
+    CheckVector(bounds.Center, {1.0f, 1.0f, -0.5f});
+    CheckVector(bounds.HalfExtents, {2.0f, 3.0f, 1.0f});
+    CHECK(registry.Get(id).Vertices == Vertices); // Referenced, not copied.
+}
+
+TEST_CASE(IdsIndexTheBounds) {
+    sample::MeshRegistry registry;
+    const sample::MeshId colored = registry.Add(ColoredMesh());
+
+    // A single vertex mesh has empty bounds at the vertex.
+    const XrVector3f point{5.0f, 6.0f, 7.0f};
+    sample::Mesh pointMesh;
+    pointMesh.Layout = {{sample::VertexAttribute::Position, 3, sample::VertexAttributeType::Float, 0}};
+    pointMesh.VertexStride = sizeof(point);
+    pointMesh.Vertices = &point;
+    pointMesh.VertexCount = 1;
+    pointMesh.Indices = Indices;
+    pointMesh.IndexCount = 1;
+    const sample::MeshId single = registry.Add(pointMesh);
+
+    CHECK(single == colored + 1);
+    CHECK(registry.Size() == 2);
+    CheckVector(registry.Bounds()[colored].Center, {1.0f, 1.0f, -0.5f});
+    CheckVector(registry.Bounds()[single].Center, point);
+    CheckVector(registry.Bounds()[single].HalfExtents, {0.0f, 0.0f, 0.0f});
+}
+
+TEST_CASE(InvalidMeshesAreRejected) {
+    CHECK(!IsRejected(ColoredMesh()));
+
+    sample::Mesh noVertices = ColoredMesh();
+    noVertices.VertexCount = 0;
+    CHECK(IsRejected(noVertices));
+
+    sample::Mesh noIndices = ColoredMesh();
+    noIndices.Indices = nullptr;
+    CHECK(IsRejected(noIndices));
+
+    sample::Mesh noPosition = ColoredMesh();
+    noPosition.Layout.pop_back();
+    noPosition.VertexStride = 4;
+    CHECK(IsRejected(noPosition));
+
+    sample::Mesh halfPositions = ColoredMesh();
+    halfPositions.Layout[1].Type = sample::VertexAttributeType::Int16;
+    halfPositions.VertexStride = 4 + 3 * 2;
+    CHECK(IsRejected(halfPositions));
+
+    sample::Mesh wrongStride = ColoredMesh();
+    wrongStride.VertexStride = sizeof(XrVector3f);
+    CHECK(IsRejected(wrongStride));
+}
@@ -0,0 +1,134 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "RenderQueue.h"
+
+#include <random>
+
+namespace {
+    using Entry = std::pair<uint64_t, uint32_t>;
+
+    // Queues random keys, with few distinct views, programs and meshes so that keys repeat and sorting has to be stable.
+    std::vector<Entry> PushRandomKeys(sample::RenderQueue& queue, uint32_t count, uint32_t seed) {
+        std::mt19937 random(seed);
+        std::vector<Entry> entries;
+        for (uint32_t i = 0; i < count; i++) {
+            const uint64_t key = sample::RenderQueue::MakeKey(
+                random() % 2, random() % 3, random() % 5, random() % 8 == 0 ? 0 : random() % (1u << sample::RenderQueue::DepthBits));
+            queue.Push(key, i);
+            entries.emplace_back(key, i);
+        }
+        return entries;
+    }
+
+    sample::DrawList MakeDraws(uint32_t count, uint32_t seed) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+        sample::DrawList draws;
+        for (uint32_t i = 0; i < count; i++) {
+            draws.Poses.push_back({{0, 0, 0, 1}, {coordinate(random), coordinate(random), coordinate(random)}});
+            draws.Scales.push_back({1.0f + i, 1.0f, 1.0f});
+            draws.Meshes.push_back(random() % 3);
+        }
+        return draws;
+    }
+} // namespace
+
+TEST_CASE(SortMatchesStableSort) {
+    sample::RenderQueue queue;
+    for (uint32_t count : {0u, 1u, 2u, 1000u, 5000u}) {
+        queue.Clear();
+        std::vector<Entry> expected = PushRandomKeys(queue, count, count);
+        std::stable_sort(expected.begin(), expected.end(), [](const Entry& a, const Entry& b) { return a.first < b.first; });
+
+        queue.Sort();
+        CHECK(queue.Size() == count);
+        for (uint32_t i = 0; i < count; i++) {
+            CHECK(queue.Draw(i) == expected[i].second);
+        }
+    }
+}
+
+TEST_CASE(BatchesGroupTheDrawsOfOneState) {
+    sample::RenderQueue queue;
+    const std::vector<Entry> entries = PushRandomKeys(queue, 1000, 7);
+    queue.Sort();
+
+    const std::vector<sample::RenderQueue::Batch>& batches = queue.Batches();
+    CHECK(!batches.empty());
+    uint32_t next = 0;
+    for (size_t b = 0; b < batches.size(); b++) {
+        const sample::RenderQueue::Batch& batch = batches[b];
+        CHECK(batch.First == next && batch.Count > 0);
+        const uint64_t stateKey = sample::RenderQueue::MakeKey(batch.View, batch.Program, batch.Mesh, 0);
+        for (uint32_t i = batch.First; i < batch.First + batch.Count; i++) {
+            const uint64_t key = entries[queue.Draw(i)].first;
+            CHECK((key >> sample::RenderQueue::DepthBits) == (stateKey >> sample::RenderQueue::DepthBits));
+        }
+        if (b > 0) {
+            const sample::RenderQueue::Batch& previous = batches[b - 1];
+            CHECK(previous.View != batch.View || previous.Program != batch.Program || previous.Mesh != batch.Mesh);
+        }
+        next += batch.Count;
+    }
+    CHECK(next == queue.Size());
+    CHECK(batches.size() <= 2 * 3 * 5);
+}
+
+TEST_CASE(DepthBucketsKeepTheDepthOrder) {
+    CHECK(sample::RenderQueue::DepthBucket(0.0f) == 0);
+    CHECK(sample::RenderQueue::DepthBucket(-1.0f) == 0);
+
+    uint32_t previous = 0;
+    for (float depth = 1e-3f; depth < 1e4f; depth *= 1.01f) {
+        const uint32_t bucket = sample::RenderQueue::DepthBucket(depth);
+        CHECK(bucket < (1u << sample::RenderQueue::DepthBits));
+        CHECK(bucket > previous); // Steps of 1% are above the precision of the buckets.
+        previous = bucket;
+    }
+}
+
+TEST_CASE(DrawsOfAMeshGoFrontToBack) {
+    const sample::DrawList draws = MakeDraws(500, 3);
+    const XrVector3f viewPosition{1.0f, 0.5f, -2.0f};
+
+    sample::RenderQueue queue;
+    queue.Push(draws, 1, 2, viewPosition);
+    queue.Sort();
+    queue.Gather(draws);
+    CHECK(queue.Size() == draws.Size());
+
+    const auto distance = [&](uint32_t draw) {
+        using namespace xr::math;
+        const XrVector3f offset = draws.Poses[draw].position - viewPosition;
+        return Dot(offset, offset);
+    };
+    for (const sample::RenderQueue::Batch& batch : queue.Batches()) {
+        CHECK(batch.View == 1 && batch.Program == 2);
+        for (uint32_t i = batch.First; i < batch.First + batch.Count; i++) {
+            CHECK(draws.Meshes[queue.Draw(i)] == batch.Mesh);
+            CHECK(i == batch.First || distance(queue.Draw(i - 1)) <= distance(queue.Draw(i)));
+        }
+    }
+    CHECK(queue.Batches().size() == 3);
+
+    // The transforms are gathered in sorted order.
+    for (uint32_t i = 0; i < queue.Size(); i++) {
+        const uint32_t draw = queue.Draw(i);
+        CHECK(queue.Transforms().Pose(i).position.x == draws.Poses[draw].position.x);
+        CHECK(queue.Transforms().Scale(i).x == draws.Scales[draw].x);
+    }
+}
@@ -0,0 +1,59 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "TaskPool.h"
+
+TEST_CASE(EveryIndexRunsOnce) {
+    sample::TaskPool pool(3);
+    CHECK(pool.ThreadCount() == 4);
+    for (uint32_t count : {0u, 1u, 5u, 1000u}) {
+        std::vector<std::atomic<uint32_t>> runs(count);
+        pool.ParallelFor(count, [&](uint32_t index, uint32_t) { runs[index]++; });
+        for (const std::atomic<uint32_t>& run : runs) {
+            CHECK(run == 1);
+        }
+    }
+}
+
+TEST_CASE(ThreadZeroIsTheCaller) {
+    sample::TaskPool pool(3);
+    const std::thread::id caller = std::this_thread::get_id();
+    for (uint32_t loop = 0; loop < 100; loop++) {
+        std::atomic<bool> callerIsThreadZero{true};
+        std::atomic<bool> threadInRange{true};
+        pool.ParallelFor(64, [&](uint32_t, uint32_t thread) {
+            if ((thread == 0) != (std::this_thread::get_id() == caller)) {
+                callerIsThreadZero = false;
+            }
+            if (thread >= pool.ThreadCount()) {
+                threadInRange = false;
+            }
+        });
+        CHECK(callerIsThreadZero);
+        CHECK(threadInRange);
+    }
+}
+
+TEST_CASE(NoWorkerRunsOnTheCaller) {
+    sample::TaskPool pool(0);
+    CHECK(pool.ThreadCount() == 1);
+    const std::thread::id caller = std::this_thread::get_id();
+    uint32_t callerRuns = 0;
+    pool.ParallelFor(10, [&](uint32_t, uint32_t thread) {
+        callerRuns += (thread == 0 && std::this_thread::get_id() == caller) ? 1 : 0;
+    });
+    CHECK(callerRuns == 10);
+}
@@ -0,0 +1,57 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+// Minimal harness of the unit tests: each TEST_CASE of an executable runs in order, and the executable returns non-zero when one
+// of them throws. Checks use CHECK and CHECK_MSG of XrError.h.
+
+#include "pch.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace test {
+    struct TestCase {
+        const char* Name;
+        void (*Function)();
+    };
+
+    inline std::vector<TestCase>& Registry() {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    struct Registration {
+        Registration(const char* name, void (*function)()) {
+            Registry().push_back({name, function});
+        }
+    };
+
+    inline void CheckNear(double actual, double expected, double tolerance, const char* expression, const char* sourceLocation) {
+        if (!(std::abs(actual - expected) <= tolerance)) {
+            xr::detail::_Throw(xr::detail::_Fmt("Check failed: %g is not within %g of %g", actual, tolerance, expected),
+                               expression,
+                               sourceLocation);
+        }
+    }
+} // namespace test
+
+#define TEST_CASE(name)                                                \
+    static void name();                                                \
+    static const test::Registration name##Registration{#name, &name}; \
+    static void name()
+
+#define CHECK_NEAR(actual, expected, tolerance) test::CheckNear((actual), (expected), (tolerance), #actual, FILE_AND_LINE)
@@ -0,0 +1,37 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+#include "Test.h"
+
+// Runs every test case, or only the ones named on the command line.
+int main(int argc, char** argv) {
+    int failedCount = 0;
+    for (const test::TestCase& testCase : test::Registry()) {
+        if (argc > 1 && std::find_if(argv + 1, argv + argc, [&](const char* name) { return std::strcmp(name, testCase.Name) == 0; }) ==
+                            argv + argc) {
+            continue;
+        }
+
+        try {
+            testCase.Function();
+            std::printf("[ OK ] %s\n", testCase.Name);
+        } catch (const std::exception& ex) {
+            std::printf("[FAIL] %s: %s\n", testCase.Name, ex.what());
+            failedCount++;
+        }
+    }
+    return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "VisibilityMask.h"
+
+namespace {
+    const XrFovf Fov{-0.7f, 0.7f, 0.6f, -0.6f};
+
+    // A triangle in the top left corner of the view, cutting a fraction of its width and height.
+    struct CornerMask {
+        XrVector2f Vertices[3];
+        uint32_t Indices[3]{0, 1, 2};
+
+        CornerMask(const XrFovf& fov, float cut) {
+            const float left = std::tan(fov.angleLeft);
+            const float right = std::tan(fov.angleRight);
+            const float up = std::tan(fov.angleUp);
+            const float down = std::tan(fov.angleDown);
+            Vertices[0] = {left, up};
+            Vertices[1] = {left + (right - left) * cut, up};
+            Vertices[2] = {left, up - (up - down) * cut};
+        }
+    };
+
+    void SetView(sample::VisibilityMask& mask, uint32_t view, const CornerMask& corner) {
+        mask.SetView(view, corner.Vertices, 3, corner.Indices, 3);
+    }
+} // namespace
+
+TEST_CASE(ProjectsViewEdgesToNdcEdges) {
+    const XrVector2f topLeft = sample::ProjectToNdc({std::tan(Fov.angleLeft), std::tan(Fov.angleUp)}, Fov);
+    CHECK_NEAR(topLeft.x, -1, 1e-6);
+    CHECK_NEAR(topLeft.y, 1, 1e-6);
+
+    const XrVector2f bottomRight = sample::ProjectToNdc({std::tan(Fov.angleRight), std::tan(Fov.angleDown)}, Fov);
+    CHECK_NEAR(bottomRight.x, 1, 1e-6);
+    CHECK_NEAR(bottomRight.y, -1, 1e-6);
+}
+
+TEST_CASE(UpdatesOnlyOnChange) {
+    sample::VisibilityMask mask;
+    SetView(mask, 0, CornerMask(Fov, 0.2f));
+    SetView(mask, 1, CornerMask(Fov, 0.2f));
+    const XrFovf fovs[] = {Fov, Fov};
+    mask.Update(fovs, 2);
+    const uint64_t version = mask.Version();
+    CHECK(version > 0);
+    CHECK(mask.Vertices().size() == 6);
+
+    // The vertices of each view carry its index, and its indices are offset to its vertices.
+    CHECK(mask.Vertices()[0].z == 0 && mask.Vertices()[3].z == 1);
+    CHECK(mask.Indices()[3] == 3 && mask.Indices()[5] == 5);
+    CHECK_NEAR(mask.Vertices()[1].x, -1 + 2 * 0.2f, 1e-5);
+
+    // Frames with the same masks and fields of view do not project them again.
+    for (int i = 0; i < 10; i++) {
+        mask.Update(fovs, 2);
+    }
+    CHECK(mask.Version() == version);
+}
+
+TEST_CASE(NewMaskIsProjected) {
+    sample::VisibilityMask mask;
+    SetView(mask, 0, CornerMask(Fov, 0.2f));
+    mask.Update(&Fov, 1);
+    const uint64_t version = mask.Version();
+
+    // As after XrEventDataVisibilityMaskChangedKHR, the mask of the view is replaced and projected at the next update.
+    SetView(mask, 0, CornerMask(Fov, 0.1f));
+    CHECK(mask.Version() == version);
+    mask.Update(&Fov, 1);
+    CHECK(mask.Version() == version + 1);
+    CHECK_NEAR(mask.Vertices()[1].x, -1 + 2 * 0.1f, 1e-5);
+}
+
+TEST_CASE(FieldOfViewChangeReprojects) {
+    sample::VisibilityMask mask;
+    SetView(mask, 0, CornerMask(Fov, 0.2f));
+    mask.Update(&Fov, 1);
+    const uint64_t version = mask.Version();
+
+    // The same view space vertices land elsewhere in a wider field of view.
+    const XrFovf wider{-0.8f, 0.8f, 0.7f, -0.7f};
+    mask.Update(&wider, 1);
+    CHECK(mask.Version() == version + 1);
+    CHECK(mask.Vertices()[0].x > -1 && mask.Vertices()[0].y < 1);
+}
+
+TEST_CASE(ClearEmptiesTheMask) {
+    sample::VisibilityMask mask;
+    SetView(mask, 0, CornerMask(Fov, 0.2f));
+    mask.Update(&Fov, 1);
+    CHECK(!mask.Empty());
+    const uint64_t version = mask.Version();
+
+    mask.Clear();
+    mask.Update(&Fov, 1);
+    CHECK(mask.Empty());
+    CHECK(mask.Vertices().empty());
+    CHECK(mask.Version() == version + 1);
+}
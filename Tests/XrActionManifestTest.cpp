@@ -0,0 +1,178 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "HeadlessRuntime/HeadlessRuntime.h"
+#include "XrUtility/XrActionManifest.h"
+
+namespace {
+    constexpr std::string_view SimpleController = "/interaction_profiles/khr/simple_controller";
+    constexpr std::string_view MotionController = "/interaction_profiles/microsoft/motion_controller";
+    constexpr std::string_view LeftSelect = "/user/hand/left/input/select/click";
+    constexpr std::string_view RightSelect = "/user/hand/right/input/select/click";
+
+    constexpr std::array<xr::ActionDeclaration, 3> Actions{{
+        {"select_left", "Select left", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"select_right", "Select right", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"hand_pose", "Hand pose", XR_ACTION_TYPE_POSE_INPUT, {"/user/hand/left", "/user/hand/right"}},
+    }};
+    constexpr std::array<xr::BindingDeclaration, 5> Bindings{{
+        {SimpleController, "select_left", LeftSelect},
+        {MotionController, "select_right", "/user/hand/right/input/trigger/value"},
+        {SimpleController, "select_right", RightSelect},
+        {SimpleController, "hand_pose", "/user/hand/left/input/grip/pose"},
+        {SimpleController, "hand_pose", "/user/hand/right/input/grip/pose"},
+    }};
+    constexpr xr::ActionManifest Manifest = xr::MakeActionManifest("test_action_set", "Test", Actions, Bindings, 1);
+    static_assert(Manifest.IsValid());
+    static_assert(Manifest.FindAction("select_right") == 1 && Manifest.FindAction("hand_pose") == 2);
+    static_assert(Manifest.FindAction("missing") == Manifest.ActionCount);
+
+    constexpr std::array<xr::ActionDeclaration, 2> DuplicateActions{{
+        {"select", "Select", XR_ACTION_TYPE_BOOLEAN_INPUT},
+        {"select", "Select again", XR_ACTION_TYPE_BOOLEAN_INPUT},
+    }};
+    constexpr std::array<xr::BindingDeclaration, 0> NoBindings{};
+    static_assert(!xr::MakeActionManifest("set", "Set", DuplicateActions, NoBindings).IsValid());
+
+    constexpr std::array<xr::ActionDeclaration, 1> UnnamedAction{{{"", "Unnamed", XR_ACTION_TYPE_BOOLEAN_INPUT}}};
+    static_assert(!xr::MakeActionManifest("set", "Set", UnnamedAction, NoBindings).IsValid());
+
+    constexpr std::array<xr::BindingDeclaration, 1> UnknownAction{{{SimpleController, "select", LeftSelect}}};
+    static_assert(!xr::MakeActionManifest("set", "Set", Actions, UnknownAction).IsValid());
+
+    constexpr std::array<xr::BindingDeclaration, 1> NoPath{{{SimpleController, "select_left", ""}}};
+    static_assert(!xr::MakeActionManifest("set", "Set", Actions, NoPath).IsValid());
+
+    // Focused session of the headless runtime whose script holds the left select from the start, destroyed with its instance at
+    // the end of the scope.
+    class TestSession {
+    public:
+        TestSession() {
+            headless::RuntimeOptions options;
+            options.Script.Inputs = {{0, std::string(LeftSelect), true}};
+            headless::SetOptions(std::move(options));
+
+            XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+            strcpy_s(createInfo.applicationInfo.applicationName, "XrActionManifestTest");
+            createInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+            CHECK_XRCMD(xrCreateInstance(&createInfo, &m_instance));
+
+            XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
+            systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+            XrSessionCreateInfo sessionInfo{XR_TYPE_SESSION_CREATE_INFO};
+            CHECK_XRCMD(xrGetSystem(m_instance, &systemInfo, &sessionInfo.systemId));
+            CHECK_XRCMD(xrCreateSession(m_instance, &sessionInfo, &m_session));
+
+            XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+            beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+            CHECK_XRCMD(xrBeginSession(m_session, &beginInfo));
+            XrFrameState frameState{XR_TYPE_FRAME_STATE};
+            CHECK_XRCMD(xrWaitFrame(m_session, nullptr, &frameState));
+        }
+        ~TestSession() {
+            xrDestroySession(m_session);
+            xrDestroyInstance(m_instance);
+        }
+
+        XrInstance Instance() const {
+            return m_instance;
+        }
+        XrSession Session() const {
+            return m_session;
+        }
+
+    private:
+        XrInstance m_instance{XR_NULL_HANDLE};
+        XrSession m_session{XR_NULL_HANDLE};
+    };
+
+    uint64_t RuntimeCalls(headless::EntryPoint entryPoint) {
+        return headless::GetStats().CallCount(entryPoint);
+    }
+
+    bool IsPressed(XrSession session, XrAction action) {
+        XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+        getInfo.action = action;
+        XrActionStateBoolean state{XR_TYPE_ACTION_STATE_BOOLEAN};
+        CHECK_XRCMD(xrGetActionStateBoolean(session, &getInfo, &state));
+        CHECK(state.isActive);
+        return state.currentState;
+    }
+} // namespace
+
+TEST_CASE(ExpandCreatesTheDeclaredActions) {
+    TestSession session;
+    xr::ActionContext context(session.Instance());
+    headless::ResetStats();
+
+    const std::vector<XrAction> actions = xr::ExpandActionManifest(context, Manifest);
+    CHECK(actions.size() == Actions.size());
+    CHECK(RuntimeCalls(headless::EntryPoint::xrCreateActionSet) == 1);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrCreateAction) == Actions.size());
+
+    // Each distinct path is resolved once: 2 subaction paths, 2 profiles and 5 binding paths.
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 9);
+
+    // Bindings are suggested once per profile, when the actions are attached.
+    CHECK(RuntimeCalls(headless::EntryPoint::xrSuggestInteractionProfileBindings) == 0);
+    context.AttachActionsToSession(session.Session());
+    CHECK(RuntimeCalls(headless::EntryPoint::xrSuggestInteractionProfileBindings) == 2);
+}
+
+TEST_CASE(BindingsReachTheirAction) {
+    TestSession session;
+    xr::ActionContext context(session.Instance());
+    const std::vector<XrAction> actions = xr::ExpandActionManifest(context, Manifest);
+    context.AttachActionsToSession(session.Session());
+    context.SyncActions(session.Session());
+
+    CHECK(IsPressed(session.Session(), actions[Manifest.FindAction("select_left")]));
+    CHECK(!IsPressed(session.Session(), actions[Manifest.FindAction("select_right")]));
+}
+
+TEST_CASE(SubactionPathsAreDeclared) {
+    TestSession session;
+    xr::ActionContext context(session.Instance());
+    const std::vector<XrAction> actions = xr::ExpandActionManifest(context, Manifest);
+    context.AttachActionsToSession(session.Session());
+    context.SyncActions(session.Session());
+
+    XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+    getInfo.action = actions[Manifest.FindAction("hand_pose")];
+    getInfo.subactionPath = xr::StringToPath(session.Instance(), "/user/hand/right");
+    XrActionStatePose state{XR_TYPE_ACTION_STATE_POSE};
+    CHECK_XRCMD(xrGetActionStatePose(session.Session(), &getInfo, &state));
+
+    // An action without subaction paths rejects them.
+    getInfo.action = actions[Manifest.FindAction("select_left")];
+    XrActionStateBoolean booleanState{XR_TYPE_ACTION_STATE_BOOLEAN};
+    CHECK(xrGetActionStateBoolean(session.Session(), &getInfo, &booleanState) == XR_ERROR_PATH_UNSUPPORTED);
+}
+
+TEST_CASE(InvalidManifestsAreRejected) {
+    TestSession session;
+    xr::ActionContext context(session.Instance());
+    headless::ResetStats();
+
+    bool threw = false;
+    try {
+        xr::ExpandActionManifest(context, xr::MakeActionManifest("set", "Set", Actions, UnknownAction));
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrCreateActionSet) == 0);
+}
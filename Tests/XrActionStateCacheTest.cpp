@@ -0,0 +1,139 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+#include "Test.h"
+#include "XrUtility/XrActionStateCache.h"
+
+namespace {
+    // Entries of the actions are only fetched by Update(), so Apply() needs no action handle.
+    const XrAction NoAction = XR_NULL_HANDLE;
+
+    struct Recorder {
+        std::vector<xr::ActionStateChange> Changes;
+
+        xr::ActionStateCache::Callback Callback() {
+            return [this](const xr::ActionStateChange& change) { Changes.push_back(change); };
+        }
+    };
+
+    xr::ActionStateSample Active(float value, bool changedSinceLastSync, XrTime time = 0) {
+        return {value, XR_TRUE, static_cast<XrBool32>(changedSinceLastSync ? XR_TRUE : XR_FALSE), time};
+    }
+
+    const xr::ActionStateSample Inactive{0, XR_FALSE, XR_FALSE, 0};
+} // namespace
+
+TEST_CASE(BooleanEdges) {
+    xr::ActionStateCache cache;
+    const uint32_t click = cache.Declare(NoAction, XR_ACTION_TYPE_BOOLEAN_INPUT);
+    Recorder pressed, released, all;
+    cache.Subscribe(click, xr::ActionEdge::Pressed, pressed.Callback());
+    cache.Subscribe(click, xr::ActionEdge::Released, released.Callback());
+    cache.Subscribe(click, xr::ActionEdge::All, all.Callback());
+
+    xr::ActionStateSample sample = Active(1, true, 100);
+    cache.Apply(&sample);
+    CHECK(pressed.Changes.size() == 1 && released.Changes.empty());
+    CHECK(pressed.Changes[0].Edges == (xr::ActionEdge::Pressed | xr::ActionEdge::ValueChanged));
+    CHECK(pressed.Changes[0].LastChangeTime == 100);
+    CHECK(cache.Value(click) == 1);
+
+    // Held: nothing changed.
+    sample = Active(1, false, 100);
+    cache.Apply(&sample);
+    CHECK(cache.ChangedCount() == 0);
+    CHECK(all.Changes.size() == 1);
+
+    sample = Active(0, true, 200);
+    cache.Apply(&sample);
+    CHECK(released.Changes.size() == 1);
+    CHECK(released.Changes[0].Edges == (xr::ActionEdge::Released | xr::ActionEdge::ValueChanged));
+    CHECK(all.Changes.size() == 2);
+}
+
+TEST_CASE(ChangeUndoneWithinAFrame) {
+    xr::ActionStateCache cache;
+    const uint32_t click = cache.Declare(NoAction, XR_ACTION_TYPE_BOOLEAN_INPUT);
+    Recorder pressed, released, valueChanged;
+    cache.Subscribe(click, xr::ActionEdge::Pressed, pressed.Callback());
+    cache.Subscribe(click, xr::ActionEdge::Released, released.Callback());
+    cache.Subscribe(click, xr::ActionEdge::ValueChanged, valueChanged.Callback());
+
+    // Pressed and released between two syncs: the value is back to false, but the runtime saw it change.
+    xr::ActionStateSample sample = Active(0, true, 100);
+    cache.Apply(&sample);
+    CHECK(pressed.Changes.size() == 1);
+    CHECK(released.Changes.size() == 1);
+    CHECK(pressed.Changes[0].Edges == (xr::ActionEdge::Pressed | xr::ActionEdge::Released));
+    CHECK(valueChanged.Changes.empty());
+
+    // Released and pressed again while held.
+    sample = Active(1, true, 200);
+    cache.Apply(&sample);
+    sample = Active(1, true, 300);
+    cache.Apply(&sample);
+    CHECK(pressed.Changes.size() == 3);
+    CHECK(released.Changes.size() == 2);
+    CHECK(valueChanged.Changes.size() == 1);
+}
+
+TEST_CASE(FloatValueChanged) {
+    xr::ActionStateCache cache;
+    const uint32_t trigger = cache.Declare(NoAction, XR_ACTION_TYPE_FLOAT_INPUT);
+    Recorder all;
+    cache.Subscribe(trigger, xr::ActionEdge::All, all.Callback());
+
+    xr::ActionStateSample sample = Active(0.5f, true);
+    cache.Apply(&sample);
+    CHECK(all.Changes.size() == 1 && all.Changes[0].Edges == xr::ActionEdge::ValueChanged);
+
+    // The runtime may flag a change that ends on the same value, which is no value change.
+    sample = Active(0.5f, true);
+    cache.Apply(&sample);
+    CHECK(all.Changes.size() == 1);
+
+    sample = Active(0.75f, true);
+    cache.Apply(&sample);
+    CHECK(all.Changes.size() == 2 && all.Changes[1].Value == 0.75f);
+}
+
+TEST_CASE(BecomingInactiveReleases) {
+    xr::ActionStateCache cache;
+    const uint32_t click = cache.Declare(NoAction, XR_ACTION_TYPE_BOOLEAN_INPUT);
+    Recorder released;
+    cache.Subscribe(click, xr::ActionEdge::Released, released.Callback());
+
+    xr::ActionStateSample sample = Active(1, true, 100);
+    cache.Apply(&sample);
+    cache.Apply(&Inactive);
+    CHECK(released.Changes.size() == 1);
+    CHECK(!cache.IsActive(click) && cache.Value(click) == 0);
+    CHECK(cache.LastChangeTime(click) == 100);
+}
+
+TEST_CASE(SubscribersOfTheirEntryOnly) {
+    xr::ActionStateCache cache;
+    const uint32_t left = cache.Declare(NoAction, XR_ACTION_TYPE_BOOLEAN_INPUT);
+    const uint32_t right = cache.Declare(NoAction, XR_ACTION_TYPE_BOOLEAN_INPUT);
+    Recorder leftChanges, rightChanges;
+    cache.Subscribe(left, xr::ActionEdge::All, leftChanges.Callback());
+    cache.Subscribe(right, xr::ActionEdge::All, rightChanges.Callback());
+
+    const xr::ActionStateSample samples[] = {Active(0, false), Active(1, true)};
+    cache.Apply(samples);
+    CHECK(leftChanges.Changes.empty());
+    CHECK(rightChanges.Changes.size() == 1 && rightChanges.Changes[0].Entry == right);
+}
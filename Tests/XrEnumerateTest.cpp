@@ -0,0 +1,155 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "HeadlessRuntime/HeadlessRuntime.h"
+#include "XrUtility/XrEnumerate.h"
+
+namespace {
+    // Enumeration of count items valued 1..count, recording the capacity of each call.
+    struct FakeEnumeration {
+        uint32_t Count;
+        std::vector<uint32_t> Capacities;
+
+        XrResult operator()(uint32_t capacity, uint32_t* count, XrExtensionProperties* items) {
+            Capacities.push_back(capacity);
+            *count = Count;
+            if (capacity == 0) {
+                return XR_SUCCESS;
+            }
+            if (capacity < Count) {
+                return XR_ERROR_SIZE_INSUFFICIENT;
+            }
+            for (uint32_t i = 0; i < Count; i++) {
+                CHECK(items[i].type == XR_TYPE_EXTENSION_PROPERTIES);
+                items[i].extensionVersion = i + 1;
+            }
+            return XR_SUCCESS;
+        }
+    };
+
+    template <typename TBuffer>
+    void CheckValues(const TBuffer& buffer, uint32_t count) {
+        CHECK(buffer.size() == count);
+        for (uint32_t i = 0; i < count; i++) {
+            CHECK(buffer[i].extensionVersion == i + 1);
+        }
+    }
+} // namespace
+
+TEST_CASE(SmallVectorGrowsPastItsInlineCapacity) {
+    xr::SmallVector<uint32_t, 4> values;
+    CHECK(values.empty() && values.capacity() == 4);
+    const uint32_t* const inlineData = values.data();
+    for (uint32_t i = 0; i < 4; i++) {
+        values.push_back(i);
+    }
+    CHECK(values.data() == inlineData);
+
+    values.push_back(4);
+    CHECK(values.data() != inlineData);
+    CHECK(values.size() == 5 && values.capacity() == 8);
+    for (uint32_t i = 0; i < 5; i++) {
+        CHECK(values[i] == i);
+    }
+
+    // The heap buffer is kept for the next uses.
+    values.clear();
+    CHECK(values.capacity() == 8);
+    values.resize(3, 7);
+    values.resize(6, 9);
+    CHECK(values[2] == 7 && values[3] == 9 && values.size() == 6);
+    values.assign(2, 1);
+    CHECK(values.size() == 2 && values[0] == 1 && values[1] == 1);
+
+    const xr::SmallVector<uint32_t, 4> copy = values;
+    CHECK(copy.size() == 2 && copy[1] == 1 && copy.data() != values.data());
+}
+
+TEST_CASE(EnumerateIntoSkipsTheSizeQueryWhenTheCapacityIsEnough) {
+    xr::SmallVector<XrExtensionProperties, 8> buffer;
+    FakeEnumeration enumeration{5};
+    xr::EnumerateInto(buffer, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", enumeration);
+    CHECK(enumeration.Capacities == std::vector<uint32_t>{8});
+    CheckValues(buffer, 5);
+
+    // The empty value is applied again before each call.
+    enumeration.Capacities.clear();
+    enumeration.Count = 2;
+    xr::EnumerateInto(buffer, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", enumeration);
+    CHECK(enumeration.Capacities == std::vector<uint32_t>{8});
+    CheckValues(buffer, 2);
+}
+
+TEST_CASE(EnumerateIntoGrowsTheBuffer) {
+    xr::SmallVector<XrExtensionProperties, 4> small;
+    FakeEnumeration enumeration{10};
+    xr::EnumerateInto(small, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", enumeration);
+    CHECK((enumeration.Capacities == std::vector<uint32_t>{4, 10}));
+    CheckValues(small, 10);
+
+    std::vector<XrExtensionProperties> vector;
+    enumeration.Capacities.clear();
+    xr::EnumerateInto(vector, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", enumeration);
+    CHECK((enumeration.Capacities == std::vector<uint32_t>{0, 10}));
+    CheckValues(vector, 10);
+
+    // Reused, the buffer is now large enough.
+    enumeration.Capacities.clear();
+    xr::EnumerateInto(vector, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", enumeration);
+    CHECK(enumeration.Capacities.size() == 1);
+}
+
+TEST_CASE(EnumerateIntoRetriesWhenTheCountGrows) {
+    std::vector<XrExtensionProperties> buffer;
+    std::vector<uint32_t> capacities;
+    uint32_t count = 3;
+    xr::EnumerateInto(buffer, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", [&](uint32_t capacity, uint32_t* countOutput, XrExtensionProperties*) {
+        capacities.push_back(capacity);
+        *countOutput = count;
+        if (capacity == 0) {
+            count++; // Another item appears before the next call.
+            return XR_SUCCESS;
+        }
+        return capacity < count ? XR_ERROR_SIZE_INSUFFICIENT : XR_SUCCESS;
+    });
+    CHECK((capacities == std::vector<uint32_t>{0, 3, 4}));
+    CHECK(buffer.size() == 4);
+}
+
+TEST_CASE(EnumerateIntoThrowsOnErrors) {
+    std::vector<XrExtensionProperties> buffer;
+    bool threw = false;
+    try {
+        xr::EnumerateInto(buffer, {XR_TYPE_EXTENSION_PROPERTIES}, "fake", [](uint32_t, uint32_t*, XrExtensionProperties*) {
+            return XR_ERROR_RUNTIME_FAILURE;
+        });
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+TEST_CASE(RuntimeEnumerationsTakeOneCall) {
+    headless::ResetStats();
+    xr::SmallVector<XrExtensionProperties, 32> extensions;
+    xr::EnumerateInstanceExtensionProperties(extensions);
+    CHECK(!extensions.empty());
+    CHECK(headless::GetStats().CallCount(headless::EntryPoint::xrEnumerateInstanceExtensionProperties) == 1);
+
+    const std::vector<XrExtensionProperties> vector = xr::EnumerateInstanceExtensionProperties();
+    CHECK(vector.size() == extensions.size());
+    CHECK(headless::GetStats().CallCount(headless::EntryPoint::xrEnumerateInstanceExtensionProperties) == 3);
+}
@@ -0,0 +1,167 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "HeadlessRuntime/HeadlessRuntime.h"
+#include "XrUtility/XrEventDispatcher.h"
+
+namespace {
+    // Session without graphics of the headless runtime, destroyed with its instance at the end of the scope.
+    // eventsPerFrame reference space change events are queued by every EndFrame().
+    class TestSession {
+    public:
+        explicit TestSession(uint32_t eventsPerFrame = 0) {
+            headless::RuntimeOptions options;
+            options.EventsPerFrame = eventsPerFrame;
+            headless::SetOptions(std::move(options));
+
+            XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+            strcpy_s(createInfo.applicationInfo.applicationName, "XrEventDispatcherTest");
+            createInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+            CHECK_XRCMD(xrCreateInstance(&createInfo, &m_instance));
+
+            XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
+            systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+            XrSessionCreateInfo sessionInfo{XR_TYPE_SESSION_CREATE_INFO};
+            CHECK_XRCMD(xrGetSystem(m_instance, &systemInfo, &sessionInfo.systemId));
+            CHECK_XRCMD(xrCreateSession(m_instance, &sessionInfo, &m_session));
+        }
+        ~TestSession() {
+            xrDestroySession(m_session);
+            xrDestroyInstance(m_instance);
+        }
+
+        XrInstance Instance() const {
+            return m_instance;
+        }
+
+        // Must be called once the session is READY.
+        void Begin() {
+            XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+            beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+            CHECK_XRCMD(xrBeginSession(m_session, &beginInfo));
+        }
+
+        // Runs a frame without layers.
+        void EndFrame() {
+            XrFrameState frameState{XR_TYPE_FRAME_STATE};
+            CHECK_XRCMD(xrWaitFrame(m_session, nullptr, &frameState));
+            CHECK_XRCMD(xrBeginFrame(m_session, nullptr));
+            XrFrameEndInfo endInfo{XR_TYPE_FRAME_END_INFO};
+            endInfo.displayTime = frameState.predictedDisplayTime;
+            endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_ADDITIVE;
+            CHECK_XRCMD(xrEndFrame(m_session, &endInfo));
+        }
+
+    private:
+        XrInstance m_instance{XR_NULL_HANDLE};
+        XrSession m_session{XR_NULL_HANDLE};
+    };
+
+    uint64_t PollCount() {
+        return headless::GetStats().CallCount(headless::EntryPoint::xrPollEvent);
+    }
+} // namespace
+
+TEST_CASE(EventsAreDispatchedInQueueOrder) {
+    TestSession session;
+    xr::EventDispatcher<16> dispatcher;
+    std::vector<XrSessionState> states;
+    dispatcher.Subscribe<XrEventDataSessionStateChanged>(
+        [&](const XrEventDataSessionStateChanged& event) { states.push_back(event.state); });
+
+    CHECK(dispatcher.Drain(session.Instance()) == 2);
+    CHECK(dispatcher.PendingCount() == 2);
+    CHECK(states.empty()); // Handlers only run in Dispatch().
+    dispatcher.Dispatch();
+    CHECK(dispatcher.PendingCount() == 0);
+    CHECK((states == std::vector<XrSessionState>{XR_SESSION_STATE_IDLE, XR_SESSION_STATE_READY}));
+
+    session.Begin();
+    CHECK(dispatcher.Drain(session.Instance()) == 3);
+    dispatcher.Dispatch();
+    CHECK(states.size() == 5 && states.back() == XR_SESSION_STATE_FOCUSED);
+
+    CHECK(dispatcher.Drain(session.Instance()) == 0);
+}
+
+TEST_CASE(ADrainPollsAtMostTheCapacity) {
+    TestSession session(40);
+    xr::EventDispatcher<16> dispatcher;
+    uint32_t changes = 0;
+    dispatcher.Subscribe<XrEventDataReferenceSpaceChangePending>([&](const XrEventDataReferenceSpaceChangePending& event) {
+        CHECK(event.referenceSpaceType == XR_REFERENCE_SPACE_TYPE_STAGE);
+        changes++;
+    });
+    dispatcher.Drain(session.Instance());
+    session.Begin();
+    dispatcher.Dispatch();
+    dispatcher.Drain(session.Instance());
+    dispatcher.Dispatch();
+    session.EndFrame();
+
+    headless::ResetStats();
+    CHECK(dispatcher.Drain(session.Instance()) == 16);
+    CHECK(PollCount() == 16);
+
+    // A full buffer is not polled until it is dispatched.
+    CHECK(dispatcher.Drain(session.Instance()) == 0);
+    CHECK(PollCount() == 16);
+    dispatcher.Dispatch();
+    CHECK(changes == 16);
+
+    CHECK(dispatcher.Drain(session.Instance()) == 16);
+    dispatcher.Dispatch();
+    CHECK(dispatcher.Drain(session.Instance()) == 8);
+    dispatcher.Dispatch();
+    CHECK(changes == 40);
+    CHECK(PollCount() == 16 + 16 + 9); // The last drain stops at XR_EVENT_UNAVAILABLE.
+}
+
+TEST_CASE(HandlersRunInSubscriptionOrder) {
+    TestSession session;
+    xr::EventDispatcher<4> dispatcher;
+    std::vector<std::string> calls;
+    dispatcher.Subscribe<XrEventDataSessionStateChanged>([&](const XrEventDataSessionStateChanged&) { calls.push_back("first"); });
+    dispatcher.Subscribe<XrEventDataSessionStateChanged>([&](const XrEventDataSessionStateChanged&) { calls.push_back("second"); });
+    dispatcher.SetDefaultHandler([&](const XrEventDataBuffer&) { calls.push_back("default"); });
+
+    CHECK(dispatcher.Drain(session.Instance()) == 2);
+    dispatcher.Dispatch();
+    CHECK((calls == std::vector<std::string>{"first", "second", "first", "second"}));
+}
+
+TEST_CASE(UnsubscribedEventsGoToTheDefaultHandler) {
+    TestSession session(3);
+    xr::EventDispatcher<16> dispatcher;
+    uint32_t stateChanges = 0;
+    std::vector<XrStructureType> others;
+    dispatcher.Subscribe<XrEventDataSessionStateChanged>([&](const XrEventDataSessionStateChanged&) { stateChanges++; });
+
+    // Without a default handler, the other events are dropped.
+    dispatcher.Drain(session.Instance());
+    session.Begin();
+    session.EndFrame();
+    dispatcher.Drain(session.Instance());
+    dispatcher.Dispatch();
+    CHECK(stateChanges == 5);
+
+    dispatcher.SetDefaultHandler([&](const XrEventDataBuffer& event) { others.push_back(event.type); });
+    session.EndFrame();
+    CHECK(dispatcher.Drain(session.Instance()) == 3);
+    dispatcher.Dispatch();
+    CHECK(others.size() == 3 && others[0] == XR_TYPE_EVENT_DATA_REFERENCE_SPACE_CHANGE_PENDING);
+    CHECK(stateChanges == 5);
+}
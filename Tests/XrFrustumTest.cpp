@@ -0,0 +1,80 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+#include "Test.h"
+#include "XrUtility/XrFrustum.h"
+
+namespace {
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    const XrFovf Fov{-0.7f, 0.7f, 0.6f, -0.6f};
+
+    // Whether a 10cm cube at the position in the base space of the view is kept.
+    bool IsVisible(const xr::math::Frustum& frustum, const XrVector3f& position) {
+        const xr::math::Box box{{0, 0, 0}, {0.05f, 0.05f, 0.05f}};
+        const XrPosef pose = xr::math::Pose::Translation(position);
+        const XrVector3f scale{1, 1, 1};
+        const uint32_t boxIndex = 0;
+        uint8_t visible = 2;
+        xr::math::CullBoxes(&frustum, 1, &pose, &scale, &box, &boxIndex, 1, &visible);
+        CHECK(visible == 0 || visible == 1);
+        return visible == 1;
+    }
+
+    void CheckPlanesAreFinite(const xr::math::Frustum& frustum) {
+        for (const xr::math::Plane& plane : frustum.Planes) {
+            CHECK(std::isfinite(plane.Normal.x) && std::isfinite(plane.Normal.y) && std::isfinite(plane.Normal.z));
+            CHECK(std::isfinite(plane.Distance));
+        }
+    }
+} // namespace
+
+TEST_CASE(FiniteDepthRange) {
+    const xr::math::NearFar nearFars[] = {{0.1f, 20.0f}, {20.0f, 0.1f}};
+    for (const xr::math::NearFar& nearFar : nearFars) {
+        const xr::math::Frustum frustum = xr::math::ComputeFrustum({xr::math::Pose::Identity(), Fov, nearFar});
+        CheckPlanesAreFinite(frustum);
+        CHECK(IsVisible(frustum, {0, 0, -2}));
+        CHECK(IsVisible(frustum, {0, 0, -19.9f}));
+        CHECK(!IsVisible(frustum, {0, 0, -21}));
+        CHECK(!IsVisible(frustum, {0, 0, 2}));
+        CHECK(!IsVisible(frustum, {3, 0, -1}));
+        CHECK(!IsVisible(frustum, {0, -3, -1}));
+    }
+}
+
+TEST_CASE(InfiniteFarPlane) {
+    // Forward Z with an infinite far plane, and reversed Z with an infinite near value, its far side.
+    const xr::math::NearFar nearFars[] = {{0.1f, Infinity}, {Infinity, 0.1f}};
+    for (const xr::math::NearFar& nearFar : nearFars) {
+        const xr::math::Frustum frustum = xr::math::ComputeFrustum({xr::math::Pose::Identity(), Fov, nearFar});
+        CheckPlanesAreFinite(frustum);
+        CHECK(IsVisible(frustum, {0, 0, -2}));
+        CHECK(IsVisible(frustum, {0, 0, -1e5f}));
+        CHECK(!IsVisible(frustum, {0, 0, 2}));
+        CHECK(!IsVisible(frustum, {0, 0, -0.01f}));
+        CHECK(!IsVisible(frustum, {1e4f, 0, -1}));
+    }
+}
+
+TEST_CASE(PlanesInBaseSpace) {
+    // A view standing at x = 5 and looking down +X: the planes are in the space the view pose is expressed in.
+    const XrPosef viewPose{xr::math::Quaternion::RotationAxisAngle({0, 1, 0}, -xr::math::PiDiv2), {5, 0, 0}};
+    const xr::math::Frustum frustum = xr::math::ComputeFrustum({viewPose, Fov, {0.1f, 20.0f}});
+    CheckPlanesAreFinite(frustum);
+    CHECK(IsVisible(frustum, {7, 0, 0}));
+    CHECK(!IsVisible(frustum, {3, 0, 0}));
+    CHECK(!IsVisible(frustum, {0, 0, -2}));
+}
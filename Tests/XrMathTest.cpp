@@ -0,0 +1,291 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+
+// Compares the xr::math backend the test is built with against double precision references. The same source is built for the
+// SSE, FMA and scalar backends, see CMakeLists.txt.
+
+#include "Test.h"
+#include "XrUtility/XrMathBatch.h"
+
+namespace {
+    constexpr double Tolerance = 1e-5;
+
+    struct Quat {
+        double x, y, z, w;
+    };
+
+    struct Vec3 {
+        double x, y, z;
+    };
+
+    Quat ToQuat(const XrQuaternionf& q) {
+        return {q.x, q.y, q.z, q.w};
+    }
+
+    Vec3 ToVec3(const XrVector3f& v) {
+        return {v.x, v.y, v.z};
+    }
+
+    // Hamilton product a * b, that is b applied first.
+    Quat Multiply(const Quat& a, const Quat& b) {
+        return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+    }
+
+    Vec3 Rotate(const Quat& q, const Vec3& v) {
+        const Quat p = Multiply(Multiply(q, {v.x, v.y, v.z, 0}), {-q.x, -q.y, -q.z, q.w});
+        return {p.x, p.y, p.z};
+    }
+
+    // Poses spread over all quadrants of the rotation space, including the half turns where the matrix trace is negative.
+    std::vector<XrPosef> TestPoses() {
+        std::vector<XrPosef> poses;
+        const XrVector3f axes[] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 2, 3}, {-3, 1, 0.5f}};
+        const float angles[] = {0.0f, 0.3f, 1.5f, 3.0f, 3.14159f, -2.2f};
+        float offset = 0;
+        for (const XrVector3f& axis : axes) {
+            for (const float angle : angles) {
+                offset += 0.25f;
+                poses.push_back({xr::math::Quaternion::RotationAxisAngle(axis, angle), {offset, -2 * offset, 1 - offset}});
+            }
+        }
+        return poses;
+    }
+
+    void CheckQuaternion(const XrQuaternionf& actual, const Quat& expected) {
+        // q and -q are the same rotation.
+        const double sign = actual.x * expected.x + actual.y * expected.y + actual.z * expected.z + actual.w * expected.w < 0 ? -1 : 1;
+        CHECK_NEAR(sign * actual.x, expected.x, Tolerance);
+        CHECK_NEAR(sign * actual.y, expected.y, Tolerance);
+        CHECK_NEAR(sign * actual.z, expected.z, Tolerance);
+        CHECK_NEAR(sign * actual.w, expected.w, Tolerance);
+    }
+
+    void CheckVector(const XrVector3f& actual, const Vec3& expected, double tolerance = Tolerance) {
+        CHECK_NEAR(actual.x, expected.x, tolerance);
+        CHECK_NEAR(actual.y, expected.y, tolerance);
+        CHECK_NEAR(actual.z, expected.z, tolerance);
+    }
+
+    // Row vector times matrix, as the shaders use the stored matrices.
+    std::array<double, 4> Transform(const xr::math::Matrix& matrix, const std::array<double, 4>& v) {
+        xr::math::Float4x4 m;
+        xr::math::StoreFloat4x4(&m, matrix);
+        std::array<double, 4> result{};
+        for (int column = 0; column < 4; column++) {
+            for (int row = 0; row < 4; row++) {
+                result[column] += v[row] * m.m[row][column];
+            }
+        }
+        return result;
+    }
+} // namespace
+
+TEST_CASE(Backend) {
+#if defined(XR_MATH_SCALAR)
+    const char* backend = "scalar";
+#elif defined(XR_MATH_SSE) && (defined(__FMA__) || defined(__AVX2__))
+    const char* backend = "fma";
+#elif defined(XR_MATH_SSE)
+    const char* backend = "sse";
+#else
+    const char* backend = "neon";
+#endif
+    std::printf("Backend: %s\n", backend);
+    CHECK_MSG(std::strcmp(backend, XR_MATH_TEST_BACKEND) == 0, "The test was not built for the expected backend");
+}
+
+TEST_CASE(PoseMultiply) {
+    const std::vector<XrPosef> poses = TestPoses();
+    for (size_t i = 0; i < poses.size(); i++) {
+        const XrPosef& a = poses[i];
+        const XrPosef& b = poses[(i * 7 + 3) % poses.size()];
+        const XrPosef c = xr::math::Pose::Multiply(a, b);
+
+        // a is applied first: Qc = Qb * Qa, Pc = Qb Pa Qb^-1 + Pb.
+        CheckQuaternion(c.orientation, Multiply(ToQuat(b.orientation), ToQuat(a.orientation)));
+        const Vec3 rotated = Rotate(ToQuat(b.orientation), ToVec3(a.position));
+        CheckVector(c.position, {rotated.x + b.position.x, rotated.y + b.position.y, rotated.z + b.position.z});
+    }
+}
+
+TEST_CASE(PoseInvert) {
+    for (const XrPosef& pose : TestPoses()) {
+        const XrPosef inverse = xr::math::Pose::Invert(pose);
+
+        // The inverse undoes the pose whichever side it is applied on.
+        for (const XrPosef& identity : {xr::math::Pose::Multiply(pose, inverse), xr::math::Pose::Multiply(inverse, pose)}) {
+            CheckQuaternion(identity.orientation, ToQuat(xr::math::Quaternion::Identity()));
+            CheckVector(identity.position, {0, 0, 0});
+        }
+    }
+}
+
+TEST_CASE(LoadXrPose) {
+    for (const XrPosef& pose : TestPoses()) {
+        const xr::math::Matrix matrix = xr::math::LoadXrPose(pose);
+        const Quat q = ToQuat(pose.orientation);
+        const Vec3 points[] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0.5, -2, 3}};
+        for (const Vec3& point : points) {
+            const std::array<double, 4> transformed = Transform(matrix, {point.x, point.y, point.z, 1});
+            const Vec3 rotated = Rotate(q, point);
+            CHECK_NEAR(transformed[0], rotated.x + pose.position.x, Tolerance);
+            CHECK_NEAR(transformed[1], rotated.y + pose.position.y, Tolerance);
+            CHECK_NEAR(transformed[2], rotated.z + pose.position.z, Tolerance);
+            CHECK_NEAR(transformed[3], 1, Tolerance);
+        }
+
+        // The inverted pose brings the transformed points back.
+        const xr::math::Matrix roundTrip = matrix * xr::math::LoadInvertedXrPose(pose);
+        xr::math::Float4x4 m;
+        xr::math::StoreFloat4x4(&m, roundTrip);
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                CHECK_NEAR(m.m[row][column], row == column ? 1 : 0, Tolerance);
+            }
+        }
+
+        // Back to a pose through the scalar matrix decomposition.
+        XrPosef stored;
+        CHECK(xr::math::StoreXrPose(&stored, matrix));
+        CheckQuaternion(stored.orientation, q);
+        CheckVector(stored.position, ToVec3(pose.position));
+    }
+}
+
+TEST_CASE(Projection) {
+    const XrFovf fov{-0.7f, 0.6f, 0.5f, -0.55f};
+    const double l = std::tan((double)fov.angleLeft), r = std::tan((double)fov.angleRight);
+    const double t = std::tan((double)fov.angleUp), b = std::tan((double)fov.angleDown);
+
+    // Points on the near and far planes land on the depth range ends, reversed or not.
+    const xr::math::NearFar nearFars[] = {{0.1f, 20.0f}, {20.0f, 0.1f}};
+    for (const xr::math::NearFar& nearFar : nearFars) {
+        const xr::math::Matrix projection = xr::math::ComposeProjectionMatrix(fov, nearFar);
+        const double depths[] = {nearFar.Near, nearFar.Far};
+        for (const double depth : depths) {
+            // The corners of the view at that depth, looking down -Z.
+            const double corners[][2] = {{l, b}, {r, t}, {0.5 * (l + r), 0.5 * (b + t)}};
+            for (const auto& corner : corners) {
+                const std::array<double, 4> clip = Transform(projection, {corner[0] * depth, corner[1] * depth, -depth, 1});
+                CHECK_NEAR(clip[3], depth, Tolerance * depth);
+                CHECK_NEAR(clip[0] / clip[3], 2 * (corner[0] - l) / (r - l) - 1, Tolerance);
+                CHECK_NEAR(clip[1] / clip[3], 2 * (corner[1] - b) / (t - b) - 1, Tolerance);
+                CHECK_NEAR(clip[2] / clip[3], depth == nearFar.Near ? 0 : 1, 1e-4);
+            }
+        }
+    }
+
+    // An infinite far plane sends the points far away to depth 1.
+    const xr::math::Matrix infinite = xr::math::ComposeProjectionMatrix(fov, {0.1f, std::numeric_limits<float>::infinity()});
+    const std::array<double, 4> clip = Transform(infinite, {0, 0, -1e6, 1});
+    CHECK_NEAR(clip[2] / clip[3], 1, 1e-4);
+}
+
+TEST_CASE(LookAt) {
+    const XrVector3f origin{1, 2, 3};
+    const XrVector3f forwards[] = {{0, 0, -1}, {0, 0, 1}, {1, 0, 0}, {1, -1, -2}, {-0.2f, 0.3f, 0.9f}};
+    for (const XrVector3f& forward : forwards) {
+        const XrPosef pose = xr::math::Pose::LookAt(origin, forward, {0, 1, 0});
+        CheckVector(pose.position, ToVec3(origin));
+        CHECK_NEAR(xr::math::Quaternion::Length(pose.orientation), 1, Tolerance);
+
+        // The view looks down -Z, with +X horizontal.
+        const Quat q = ToQuat(pose.orientation);
+        const double length = std::sqrt((double)forward.x * forward.x + (double)forward.y * forward.y + (double)forward.z * forward.z);
+        const Vec3 viewForward = Rotate(q, {0, 0, -1});
+        CHECK_NEAR(viewForward.x, forward.x / length, Tolerance);
+        CHECK_NEAR(viewForward.y, forward.y / length, Tolerance);
+        CHECK_NEAR(viewForward.z, forward.z / length, Tolerance);
+        CHECK_NEAR(Rotate(q, {1, 0, 0}).y, 0, Tolerance);
+        CHECK(Rotate(q, {0, 1, 0}).y > 0);
+    }
+}
+
+TEST_CASE(BatchPoseKernels) {
+    const std::vector<XrPosef> poses = TestPoses();
+    std::vector<XrPosef> origins;
+    std::vector<XrVector3f> scales;
+    for (size_t i = 0; i < poses.size(); i++) {
+        origins.push_back(poses[(i * 7 + 3) % poses.size()]);
+        scales.push_back({0.5f + i * 0.1f, 2.0f, 1.0f / (i + 1)});
+    }
+
+    // Every count up to two batches of 8, so that the last batch is partial.
+    std::vector<XrPosef> products(poses.size());
+    std::vector<XrPosef> inverses(poses.size());
+    std::vector<xr::math::Float4x4> matrices(poses.size());
+    for (size_t count = 1; count <= 16; count++) {
+        xr::math::MultiplyPoses(poses.data(), origins.data(), products.data(), count);
+        xr::math::InvertPoses(poses.data(), inverses.data(), count);
+        xr::math::PosesToMatrices(poses.data(), scales.data(), matrices.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            const XrPosef expected = xr::math::Pose::Multiply(poses[i], origins[i]);
+            CheckQuaternion(products[i].orientation, ToQuat(expected.orientation));
+            CheckVector(products[i].position, ToVec3(expected.position));
+
+            const XrPosef identity = xr::math::Pose::Multiply(poses[i], inverses[i]);
+            CheckQuaternion(identity.orientation, {0, 0, 0, 1});
+            CheckVector(identity.position, {0, 0, 0});
+
+            xr::math::Float4x4 expectedMatrix;
+            const XrVector3f& scale = scales[i];
+            xr::math::StoreFloat4x4(&expectedMatrix, xr::math::MatrixScaling(scale.x, scale.y, scale.z) * xr::math::LoadXrPose(poses[i]));
+            for (int row = 0; row < 4; row++) {
+                for (int column = 0; column < 4; column++) {
+                    CHECK_NEAR(matrices[i].m[row][column], expectedMatrix.m[row][column], Tolerance);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(TransformArraysToMatrices) {
+    const std::vector<XrPosef> poses = TestPoses();
+    std::vector<XrVector3f> scales;
+    xr::math::TransformArrays transforms;
+    transforms.Resize(poses.size());
+    for (size_t i = 0; i < poses.size(); i++) {
+        scales.push_back({0.5f + i * 0.1f, 2.0f, 1.0f / (i + 1)});
+        transforms.Set(i, poses[i], scales[i]);
+    }
+
+    // Ranges starting at every index within a batch, so that the loads are unaligned and the last batch is partial.
+    std::vector<xr::math::Float4x4> matrices(poses.size());
+    std::vector<xr::math::Float4x4> transposed(poses.size());
+    for (size_t first = 0; first < 9; first++) {
+        const size_t count = poses.size() - first;
+        xr::math::PosesToMatrices(transforms, first, count, matrices.data());
+        xr::math::PosesToTransposedMatrices(transforms, first, count, transposed.data());
+        for (size_t i = 0; i < count; i++) {
+            const XrPosef& pose = poses[first + i];
+            const XrVector3f& scale = scales[first + i];
+            xr::math::Float4x4 expected;
+            xr::math::StoreFloat4x4(&expected, xr::math::MatrixScaling(scale.x, scale.y, scale.z) * xr::math::LoadXrPose(pose));
+            for (int row = 0; row < 4; row++) {
+                for (int column = 0; column < 4; column++) {
+                    CHECK_NEAR(matrices[i].m[row][column], expected.m[row][column], Tolerance);
+                    CHECK_NEAR(transposed[i].m[column][row], expected.m[row][column], Tolerance);
+                }
+            }
+        }
+    }
+
+    CheckQuaternion(transforms.Pose(7).orientation, ToQuat(poses[7].orientation));
+    CheckVector(transforms.Scale(7), ToVec3(scales[7]));
+}
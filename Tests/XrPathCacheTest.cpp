@@ -0,0 +1,169 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "Test.h"
+#include "HeadlessRuntime/HeadlessRuntime.h"
+#include "XrUtility/XrPathCache.h"
+
+namespace {
+    // Instance of the headless runtime, destroyed at the end of the scope.
+    class TestInstance {
+    public:
+        TestInstance() {
+            XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+            strcpy_s(createInfo.applicationInfo.applicationName, "XrPathCacheTest");
+            createInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+            CHECK_XRCMD(xrCreateInstance(&createInfo, &m_instance));
+        }
+        ~TestInstance() {
+            xrDestroyInstance(m_instance);
+        }
+
+        XrInstance Get() const {
+            return m_instance;
+        }
+
+    private:
+        XrInstance m_instance{XR_NULL_HANDLE};
+    };
+
+    uint64_t RuntimeCalls(headless::EntryPoint entryPoint) {
+        return headless::GetStats().CallCount(entryPoint);
+    }
+
+    constexpr xr::PathString LeftHand{"/user/hand/left"};
+    static_assert(LeftHand.Hash() == xr::PathHash("/user/hand/left"), "literals are hashed at compile time");
+    static_assert(xr::PathHash("/user/hand/left") != xr::PathHash("/user/hand/right"));
+} // namespace
+
+TEST_CASE(StringsAreResolvedOnce) {
+    TestInstance instance;
+    auto cache = std::make_unique<xr::PathCache>();
+    headless::ResetStats();
+
+    const XrPath left = cache->StringToPath(instance.Get(), LeftHand);
+    const XrPath right = cache->StringToPath(instance.Get(), std::string("/user/hand/right"));
+    CHECK(left != XR_NULL_PATH && right != XR_NULL_PATH && left != right);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 2);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        CHECK(cache->StringToPath(instance.Get(), LeftHand) == left);
+        CHECK(cache->StringToPath(instance.Get(), "/user/hand/right") == right);
+    }
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 2);
+
+    // Resolved strings are also known in the other direction.
+    CHECK(cache->PathToString(instance.Get(), left) == "/user/hand/left");
+    CHECK(RuntimeCalls(headless::EntryPoint::xrPathToString) == 0);
+}
+
+TEST_CASE(PathsAreConvertedOnce) {
+    TestInstance instance;
+    auto cache = std::make_unique<xr::PathCache>();
+    XrPath path;
+    CHECK_XRCMD(xrStringToPath(instance.Get(), "/interaction_profiles/khr/simple_controller", &path));
+    headless::ResetStats();
+
+    CHECK(cache->PathToString(instance.Get(), path) == "/interaction_profiles/khr/simple_controller");
+    CHECK(RuntimeCalls(headless::EntryPoint::xrPathToString) == 2); // Size query, then the string.
+    CHECK(cache->PathToString(instance.Get(), path) == "/interaction_profiles/khr/simple_controller");
+    CHECK(cache->StringToPath(instance.Get(), "/interaction_profiles/khr/simple_controller") == path);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrPathToString) == 2);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 0);
+}
+
+TEST_CASE(ForgetDropsTheEntriesOfAnInstance) {
+    TestInstance instance;
+    auto cache = std::make_unique<xr::PathCache>();
+    const XrPath head = cache->StringToPath(instance.Get(), "/user/head");
+    cache->Forget(instance.Get());
+
+    headless::ResetStats();
+    CHECK(cache->StringToPath(instance.Get(), "/user/head") == head);
+    CHECK(cache->StringToPath(instance.Get(), "/user/head") == head);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 1);
+}
+
+TEST_CASE(InstancesDoNotShareEntries) {
+    auto cache = std::make_unique<xr::PathCache>();
+    XrPath firstPath;
+    {
+        TestInstance instance;
+        firstPath = cache->StringToPath(instance.Get(), "/user/head");
+    }
+
+    // The new instance numbers its paths from the start again, the same value now names another string.
+    TestInstance instance;
+    headless::ResetStats();
+    const XrPath path = cache->StringToPath(instance.Get(), "/user/gamepad");
+    CHECK(path == firstPath);
+    CHECK(cache->PathToString(instance.Get(), path) == "/user/gamepad");
+    CHECK(cache->StringToPath(instance.Get(), "/user/head") != path);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 2);
+}
+
+TEST_CASE(ConcurrentLookupsAgree) {
+    TestInstance instance;
+    auto cache = std::make_unique<xr::PathCache>();
+    std::vector<std::string> strings;
+    for (uint32_t i = 0; i < 200; i++) {
+        strings.push_back("/user/test/path_" + std::to_string(i));
+    }
+
+    std::vector<std::vector<XrPath>> paths(4, std::vector<XrPath>(strings.size()));
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < paths.size(); t++) {
+        threads.emplace_back([&, t] {
+            for (uint32_t loop = 0; loop < 10; loop++) {
+                for (size_t i = 0; i < strings.size(); i++) {
+                    paths[t][i] = cache->StringToPath(instance.Get(), strings[i]);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < strings.size(); i++) {
+        for (const std::vector<XrPath>& threadPaths : paths) {
+            CHECK(threadPaths[i] == paths[0][i]);
+        }
+        CHECK(cache->PathToString(instance.Get(), paths[0][i]) == strings[i]);
+    }
+}
+
+TEST_CASE(FullCacheFallsBackToTheRuntime) {
+    TestInstance instance;
+    auto cache = std::make_unique<xr::PathCache>();
+    for (uint32_t i = 0; i < 1024; i++) {
+        cache->StringToPath(instance.Get(), "/user/fill/path_" + std::to_string(i));
+    }
+
+    headless::ResetStats();
+    const XrPath extra = cache->StringToPath(instance.Get(), "/user/extra");
+    CHECK(cache->StringToPath(instance.Get(), "/user/extra") == extra);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 2);
+    CHECK(cache->StringToPath(instance.Get(), "/user/fill/path_7") != extra);
+    CHECK(RuntimeCalls(headless::EntryPoint::xrStringToPath) == 2);
+
+    bool threw = false;
+    try {
+        cache->PathToString(instance.Get(), extra); // Its string cannot be kept alive.
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
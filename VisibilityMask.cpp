@@ -0,0 +1,82 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#include "pch.h"
+#include "VisibilityMask.h"
+
+namespace {
+    bool operator==(const XrFovf& a, const XrFovf& b) {
+        return a.angleLeft == b.angleLeft && a.angleRight == b.angleRight && a.angleUp == b.angleUp && a.angleDown == b.angleDown;
+    }
+} // namespace
+
+namespace sample {
+    XrVector2f ProjectToNdc(const XrVector2f& pointInView, const XrFovf& fov) {
+        // On the z = -1 plane, the edges of the view are at the tangents of the field of view angles.
+        const float tanLeft = std::tan(fov.angleLeft);
+        const float tanRight = std::tan(fov.angleRight);
+        const float tanUp = std::tan(fov.angleUp);
+        const float tanDown = std::tan(fov.angleDown);
+        return {(2 * pointInView.x - (tanRight + tanLeft)) / (tanRight - tanLeft),
+                (2 * pointInView.y - (tanUp + tanDown)) / (tanUp - tanDown)};
+    }
+
+    void VisibilityMask::SetView(uint32_t view, const XrVector2f* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) {
+        CHECK(indexCount % 3 == 0);
+        for (uint32_t i = 0; i < indexCount; i++) {
+            CHECK_MSG(indices[i] < vertexCount, "Visibility mask index out of range");
+        }
+
+        if (view >= m_views.size()) {
+            m_views.resize(view + 1);
+        }
+        m_views[view].Vertices.assign(vertices, vertices + vertexCount);
+        m_views[view].Indices.assign(indices, indices + indexCount);
+        m_meshChanged = true;
+    }
+
+    void VisibilityMask::Clear() {
+        m_views.clear();
+        m_meshChanged = true;
+    }
+
+    void VisibilityMask::Update(const XrFovf* fovs, uint32_t viewCount) {
+        bool changed = m_meshChanged;
+        for (uint32_t i = 0; i < viewCount && i < m_views.size(); i++) {
+            changed |= !(m_views[i].Fov == fovs[i]);
+        }
+        if (!changed) {
+            return;
+        }
+
+        m_vertices.clear();
+        m_indices.clear();
+        for (uint32_t i = 0; i < viewCount && i < m_views.size(); i++) {
+            View& view = m_views[i];
+            view.Fov = fovs[i];
+
+            const uint32_t firstVertex = (uint32_t)m_vertices.size();
+            for (const XrVector2f& vertex : view.Vertices) {
+                const XrVector2f ndc = ProjectToNdc(vertex, view.Fov);
+                m_vertices.push_back({ndc.x, ndc.y, (float)i});
+            }
+            for (const uint32_t index : view.Indices) {
+                m_indices.push_back(firstVertex + index);
+            }
+        }
+        m_meshChanged = false;
+        m_version++;
+    }
+} // namespace sample
@@ -0,0 +1,66 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+namespace sample {
+    // Point of the z = -1 plane of a view projected to normalized device coordinates with the view field of view.
+    XrVector2f ProjectToNdc(const XrVector2f& pointInView, const XrFovf& fov);
+
+    // Areas of the views hidden by the lenses, from XR_KHR_visibility_mask, as a single triangle list in normalized device
+    // coordinates. Drawn into depth before the scene, it makes the depth test reject the pixels that are never displayed.
+    // The triangles of a view are projected again only when its mask or its field of view changes.
+    class VisibilityMask {
+    public:
+        // Replaces the hidden triangle mesh of a view, vertices in view space on the z = -1 plane as returned by xrGetVisibilityMaskKHR.
+        void SetView(uint32_t view, const XrVector2f* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+        // Drops the masks of all views, e.g. when the runtime has no mask for the view configuration.
+        void Clear();
+
+        // Projects the masks with the fields of view of the frame.
+        void Update(const XrFovf* fovs, uint32_t viewCount);
+
+        // x and y are normalized device coordinates, z the index of the view the vertex belongs to.
+        const std::vector<XrVector3f>& Vertices() const {
+            return m_vertices;
+        }
+        const std::vector<uint32_t>& Indices() const {
+            return m_indices;
+        }
+
+        bool Empty() const {
+            return m_indices.empty();
+        }
+
+        // Incremented whenever the vertices or indices change, so renderers know when to update their buffers.
+        uint64_t Version() const {
+            return m_version;
+        }
+
+    private:
+        struct View {
+            std::vector<XrVector2f> Vertices;
+            std::vector<uint32_t> Indices;
+            XrFovf Fov{};
+        };
+
+        std::vector<View> m_views;
+        bool m_meshChanged{false};
+        std::vector<XrVector3f> m_vertices;
+        std::vector<uint32_t> m_indices;
+        uint64_t m_version{0};
+    };
+} // namespace sample
@@ -36,8 +36,13 @@ namespace xr {
                               const std::string& localizedName,
                               XrActionType actionType,
                               const std::vector<std::string>& subactionPaths) {
-            std::vector<XrPath> subActionXrPaths = xr::StringsToPaths(m_instance, subactionPaths);
+            return CreateAction(actionName, localizedName, actionType, xr::StringsToPaths(m_instance, subactionPaths));
+        }
 
+        XrAction CreateAction(const std::string& actionName,
+                              const std::string& localizedName,
+                              XrActionType actionType,
+                              const std::vector<XrPath>& subActionXrPaths) {
             XrActionCreateInfo actionCreateInfo{XR_TYPE_ACTION_CREATE_INFO};
             actionCreateInfo.actionType = actionType;
             actionCreateInfo.countSubactionPaths = static_cast<uint32_t>(subActionXrPaths.size());
@@ -89,14 +94,22 @@ namespace xr {
         ActionSet& CreateActionSet(const std::string& name, const std::string& localizedName, uint32_t priority = 0);
         void SuggestInteractionProfileBindings(const std::string& interactionProfile,
                                                const std::vector<std::pair<XrAction, std::string>>& suggestedBindings);
+        void SuggestInteractionProfileBindings(XrPath interactionProfile, const std::vector<XrActionSuggestedBinding>& suggestedBindings);
 
+        // Bindings are suggested to the runtime at the first attachment, as they cannot change once action sets are attached.
         void AttachActionsToSession(XrSession session);
         void SyncActions(XrSession session);
 
+        XrInstance Instance() const {
+            return m_instance;
+        }
+
     private:
         XrInstance m_instance;
         std::list<ActionSet> m_actionSets;
         std::unordered_map<XrPath, std::vector<XrActionSuggestedBinding>> m_actionBindings;
+        bool m_bindingsSuggested{false};
+        std::vector<XrActiveActionSet> m_activeActionSets; // Reused by SyncActions() every frame.
     };
 
     inline ActionSet& ActionContext::CreateActionSet(const std::string& name, const std::string& localizedName, uint32_t priority) {
@@ -105,19 +118,28 @@ namespace xr {
 
     inline void ActionContext::SuggestInteractionProfileBindings(const std::string& interactionProfile,
                                                                  const std::vector<std::pair<XrAction, std::string>>& suggestedBindings) {
-        const XrPath profilePath = xr::StringToPath(m_instance, interactionProfile.c_str());
+        const XrPath profilePath = xr::StringToPath(m_instance, interactionProfile);
         for (const auto& [action, suggestedBinding] : suggestedBindings) {
-            m_actionBindings[profilePath].push_back({action, xr::StringToPath(m_instance, suggestedBinding.c_str())});
+            m_actionBindings[profilePath].push_back({action, xr::StringToPath(m_instance, suggestedBinding)});
         }
     }
 
+    inline void ActionContext::SuggestInteractionProfileBindings(XrPath interactionProfile,
+                                                                 const std::vector<XrActionSuggestedBinding>& suggestedBindings) {
+        std::vector<XrActionSuggestedBinding>& bindings = m_actionBindings[interactionProfile];
+        bindings.insert(bindings.end(), suggestedBindings.begin(), suggestedBindings.end());
+    }
+
     inline void ActionContext::AttachActionsToSession(XrSession session) {
-        for (const auto& [interactionProfile, bindingsList] : m_actionBindings) {
-            XrInteractionProfileSuggestedBinding bindings{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
-            bindings.interactionProfile = interactionProfile;
-            bindings.suggestedBindings = bindingsList.data();
-            bindings.countSuggestedBindings = static_cast<uint32_t>(bindingsList.size());
-            CHECK_XRCMD(xrSuggestInteractionProfileBindings(m_instance, &bindings));
+        if (!m_bindingsSuggested) {
+            for (const auto& [interactionProfile, bindingsList] : m_actionBindings) {
+                XrInteractionProfileSuggestedBinding bindings{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+                bindings.interactionProfile = interactionProfile;
+                bindings.suggestedBindings = bindingsList.data();
+                bindings.countSuggestedBindings = static_cast<uint32_t>(bindingsList.size());
+                CHECK_XRCMD(xrSuggestInteractionProfileBindings(m_instance, &bindings));
+            }
+            m_bindingsSuggested = true;
         }
 
         if (!m_actionSets.empty()) {
@@ -133,8 +155,8 @@ namespace xr {
     }
 
     inline void ActionContext::SyncActions(XrSession session) {
-        std::vector<XrActiveActionSet> activeActionSets;
-        activeActionSets.reserve(m_actionSets.size() * 2);
+        std::vector<XrActiveActionSet>& activeActionSets = m_activeActionSets;
+        activeActionSets.clear();
 
         for (const auto& actionSet : m_actionSets) {
             if (!actionSet.Active()) {
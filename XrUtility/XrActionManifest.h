@@ -0,0 +1,165 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <array>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "XrActionContext.h"
+#include "XrPathCache.h"
+
+namespace xr {
+
+    constexpr uint32_t MaxSubactionPathsPerAction = 4;
+
+    struct ActionDeclaration {
+        std::string_view Name;
+        std::string_view LocalizedName;
+        XrActionType Type;
+        std::array<std::string_view, MaxSubactionPathsPerAction> SubactionPaths{}; // Unused paths are left empty.
+    };
+
+    struct BindingDeclaration {
+        std::string_view InteractionProfile;
+        std::string_view Action; // Name of an action of the manifest.
+        std::string_view Path;
+    };
+
+    // Action set, actions and suggested bindings declared as constant tables, e.g.
+    //     constexpr std::array<xr::ActionDeclaration, 1> Actions{{{"select", "Select", XR_ACTION_TYPE_BOOLEAN_INPUT}}};
+    //     constexpr std::array<xr::BindingDeclaration, 1> Bindings{{{"/interaction_profiles/khr/simple_controller", "select",
+    //                                                                "/user/hand/right/input/select/click"}}};
+    //     constexpr xr::ActionManifest Manifest = xr::MakeActionManifest("main", "Main", Actions, Bindings);
+    //     static_assert(Manifest.IsValid());
+    // The tables must outlive the manifest, so declare them at namespace scope.
+    struct ActionManifest {
+        std::string_view ActionSetName;
+        std::string_view LocalizedActionSetName;
+        uint32_t Priority;
+        const ActionDeclaration* Actions;
+        uint32_t ActionCount;
+        const BindingDeclaration* Bindings;
+        uint32_t BindingCount;
+
+        // Index of the action with the given name, or ActionCount if there is none.
+        constexpr uint32_t FindAction(std::string_view name) const {
+            for (uint32_t i = 0; i < ActionCount; i++) {
+                if (Actions[i].Name == name) {
+                    return i;
+                }
+            }
+            return ActionCount;
+        }
+
+        // Every action name is unique and every binding references a declared action.
+        constexpr bool IsValid() const {
+            for (uint32_t i = 0; i < ActionCount; i++) {
+                if (Actions[i].Name.empty() || FindAction(Actions[i].Name) != i) {
+                    return false;
+                }
+            }
+            for (uint32_t i = 0; i < BindingCount; i++) {
+                if (FindAction(Bindings[i].Action) == ActionCount || Bindings[i].InteractionProfile.empty() || Bindings[i].Path.empty()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    template <size_t ActionCount, size_t BindingCount>
+    constexpr ActionManifest MakeActionManifest(std::string_view actionSetName,
+                                                std::string_view localizedActionSetName,
+                                                const std::array<ActionDeclaration, ActionCount>& actions,
+                                                const std::array<BindingDeclaration, BindingCount>& bindings,
+                                                uint32_t priority = 0) {
+        return {actionSetName,
+                localizedActionSetName,
+                priority,
+                actions.data(),
+                static_cast<uint32_t>(ActionCount),
+                bindings.data(),
+                static_cast<uint32_t>(BindingCount)};
+    }
+
+    // Creates the action set and the actions of the manifest in the context, and suggests its bindings.
+    // Returns the actions in the order of their declaration, they are owned by the action set of the context.
+    std::vector<XrAction> ExpandActionManifest(ActionContext& context, const ActionManifest& manifest);
+
+#pragma region Implementation details
+    inline std::vector<XrAction> ExpandActionManifest(ActionContext& context, const ActionManifest& manifest) {
+        CHECK_MSG(manifest.IsValid(), "Invalid action manifest");
+        const XrInstance instance = context.Instance();
+
+        // Resolve every distinct path of the manifest up front, the declarations below only look them up.
+        std::unordered_map<std::string_view, XrPath> paths;
+        auto resolve = [&](std::string_view path) {
+            if (!path.empty() && paths.find(path) == paths.end()) {
+                paths.emplace(path, xr::StringToPath(instance, PathString(path)));
+            }
+        };
+        for (uint32_t i = 0; i < manifest.ActionCount; i++) {
+            for (std::string_view subactionPath : manifest.Actions[i].SubactionPaths) {
+                resolve(subactionPath);
+            }
+        }
+        for (uint32_t i = 0; i < manifest.BindingCount; i++) {
+            resolve(manifest.Bindings[i].InteractionProfile);
+            resolve(manifest.Bindings[i].Path);
+        }
+
+        ActionSet& actionSet = context.CreateActionSet(
+            std::string(manifest.ActionSetName), std::string(manifest.LocalizedActionSetName), manifest.Priority);
+
+        std::vector<XrAction> actions;
+        actions.reserve(manifest.ActionCount);
+        std::vector<XrPath> subactionPaths;
+        for (uint32_t i = 0; i < manifest.ActionCount; i++) {
+            const ActionDeclaration& declaration = manifest.Actions[i];
+            subactionPaths.clear();
+            for (std::string_view subactionPath : declaration.SubactionPaths) {
+                if (!subactionPath.empty()) {
+                    subactionPaths.push_back(paths.at(subactionPath));
+                }
+            }
+            actions.push_back(actionSet.CreateAction(
+                std::string(declaration.Name), std::string(declaration.LocalizedName), declaration.Type, subactionPaths));
+        }
+
+        // Bindings are grouped by interaction profile, in the order of their first appearance in the manifest.
+        std::vector<XrPath> profiles;
+        std::unordered_map<XrPath, std::vector<XrActionSuggestedBinding>> bindingsByProfile;
+        for (uint32_t i = 0; i < manifest.BindingCount; i++) {
+            const BindingDeclaration& binding = manifest.Bindings[i];
+            const XrPath profile = paths.at(binding.InteractionProfile);
+            auto [it, inserted] = bindingsByProfile.try_emplace(profile);
+            if (inserted) {
+                profiles.push_back(profile);
+            }
+            it->second.push_back({actions[manifest.FindAction(binding.Action)], paths.at(binding.Path)});
+        }
+        for (XrPath profile : profiles) {
+            context.SuggestInteractionProfileBindings(profile, bindingsByProfile[profile]);
+        }
+        return actions;
+    }
+#pragma endregion
+
+} // namespace xr
@@ -0,0 +1,198 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <functional>
+#include <vector>
+
+#include "XrError.h"
+
+namespace xr {
+
+    // Edges of an action state, as a bit mask.
+    enum class ActionEdge : uint32_t {
+        None = 0,
+        Pressed = 1,      // A boolean action became true.
+        Released = 2,     // A boolean action became false, which includes becoming inactive.
+        ValueChanged = 4, // The value of a boolean or float action differs from the previous update.
+        All = Pressed | Released | ValueChanged,
+    };
+
+    constexpr ActionEdge operator|(ActionEdge a, ActionEdge b) {
+        return static_cast<ActionEdge>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+    }
+    constexpr ActionEdge operator&(ActionEdge a, ActionEdge b) {
+        return static_cast<ActionEdge>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+    }
+
+    // State of an entry as returned by xrGetActionStateBoolean or xrGetActionStateFloat, with 0 or 1 as the value of a boolean.
+    struct ActionStateSample {
+        float Value;
+        XrBool32 IsActive;
+        XrBool32 ChangedSinceLastSync;
+        XrTime LastChangeTime;
+    };
+
+    struct ActionStateChange {
+        uint32_t Entry;
+        // All the edges of the entry in this update. A boolean pressed and released between two syncs has both Pressed and Released,
+        // without ValueChanged.
+        ActionEdge Edges;
+        float Value;           // 0 or 1 for a boolean action, 0 when the action is inactive.
+        XrTime LastChangeTime; // When the runtime saw the input change, e.g. to locate a hand at the time of a click.
+    };
+
+    // Latest states of boolean and float input actions, fetched together after each xrSyncActions, e.g. the one of
+    // ActionContext::SyncActions(). Gameplay code subscribes to the edges of the states instead of polling them, and the
+    // callbacks only run for the states that changed. Update() does not allocate once the entries are declared.
+    class ActionStateCache {
+    public:
+        using Callback = std::function<void(const ActionStateChange&)>;
+
+        // An entry is the state of an action for a subaction path, or XR_NULL_PATH for the state combining all of them.
+        uint32_t Declare(XrAction action, XrActionType actionType, XrPath subactionPath = XR_NULL_PATH);
+
+        // Callbacks of an entry are called in the order they subscribed, when any of the given edges occurs.
+        void Subscribe(uint32_t entry, ActionEdge edges, Callback callback);
+
+        // Fetches the state of every entry, then applies them.
+        void Update(XrSession session);
+
+        // Sets the state of every entry, samples[i] being the one of entry i, then calls the callbacks of the entries that changed,
+        // in the order of declaration.
+        void Apply(const ActionStateSample* samples);
+
+        uint32_t EntryCount() const {
+            return (uint32_t)m_getInfos.size();
+        }
+        float Value(uint32_t entry) const {
+            return m_values[entry];
+        }
+        bool IsActive(uint32_t entry) const {
+            return m_active[entry] != 0;
+        }
+        XrTime LastChangeTime(uint32_t entry) const {
+            return m_lastChangeTimes[entry];
+        }
+
+        // Number of entries that changed in the last update.
+        uint32_t ChangedCount() const {
+            return (uint32_t)m_changes.size();
+        }
+
+    private:
+        struct Subscriber {
+            ActionEdge Edges;
+            Callback Function;
+        };
+
+        // One element per entry.
+        std::vector<XrActionStateGetInfo> m_getInfos;
+        std::vector<XrActionType> m_actionTypes;
+        std::vector<float> m_values;
+        std::vector<uint8_t> m_active;
+        std::vector<XrTime> m_lastChangeTimes;
+
+        std::vector<std::vector<Subscriber>> m_subscribers;
+
+        // Reserved for all the entries when they are declared.
+        std::vector<ActionStateSample> m_samples;
+        std::vector<ActionStateChange> m_changes;
+    };
+
+#pragma region Implementation details
+    inline uint32_t ActionStateCache::Declare(XrAction action, XrActionType actionType, XrPath subactionPath) {
+        CHECK_MSG(actionType == XR_ACTION_TYPE_BOOLEAN_INPUT || actionType == XR_ACTION_TYPE_FLOAT_INPUT,
+                  "Only boolean and float actions have a cached state");
+
+        XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+        getInfo.action = action;
+        getInfo.subactionPath = subactionPath;
+        m_getInfos.push_back(getInfo);
+        m_actionTypes.push_back(actionType);
+        m_values.push_back(0);
+        m_active.push_back(0);
+        m_lastChangeTimes.push_back(0);
+        m_subscribers.emplace_back();
+        m_samples.reserve(m_getInfos.size());
+        m_changes.reserve(m_getInfos.size());
+        return (uint32_t)m_getInfos.size() - 1;
+    }
+
+    inline void ActionStateCache::Subscribe(uint32_t entry, ActionEdge edges, Callback callback) {
+        CHECK(entry < EntryCount());
+        m_subscribers[entry].push_back({edges, std::move(callback)});
+    }
+
+    inline void ActionStateCache::Update(XrSession session) {
+        m_samples.clear();
+        const uint32_t entryCount = EntryCount();
+        for (uint32_t i = 0; i < entryCount; i++) {
+            if (m_actionTypes[i] == XR_ACTION_TYPE_BOOLEAN_INPUT) {
+                XrActionStateBoolean state{XR_TYPE_ACTION_STATE_BOOLEAN};
+                CHECK_XRCMD(xrGetActionStateBoolean(session, &m_getInfos[i], &state));
+                m_samples.push_back({state.currentState ? 1.0f : 0.0f, state.isActive, state.changedSinceLastSync, state.lastChangeTime});
+            } else {
+                XrActionStateFloat state{XR_TYPE_ACTION_STATE_FLOAT};
+                CHECK_XRCMD(xrGetActionStateFloat(session, &m_getInfos[i], &state));
+                m_samples.push_back({state.currentState, state.isActive, state.changedSinceLastSync, state.lastChangeTime});
+            }
+        }
+        Apply(m_samples.data());
+    }
+
+    inline void ActionStateCache::Apply(const ActionStateSample* samples) {
+        m_changes.clear();
+        const uint32_t entryCount = EntryCount();
+        for (uint32_t i = 0; i < entryCount; i++) {
+            const ActionStateSample& sample = samples[i];
+            const bool active = sample.IsActive != XR_FALSE;
+            const float value = active ? sample.Value : 0;
+            const float previousValue = m_values[i];
+            m_values[i] = value;
+            m_active[i] = active ? 1 : 0;
+            if (active) {
+                m_lastChangeTimes[i] = sample.LastChangeTime;
+            }
+
+            ActionEdge edges = ActionEdge::None;
+            if (value != previousValue) {
+                edges = ActionEdge::ValueChanged;
+                if (m_actionTypes[i] == XR_ACTION_TYPE_BOOLEAN_INPUT) {
+                    edges = edges | (value != 0 ? ActionEdge::Pressed : ActionEdge::Released);
+                }
+            } else if (active && sample.ChangedSinceLastSync && m_actionTypes[i] == XR_ACTION_TYPE_BOOLEAN_INPUT) {
+                // The runtime saw the input change and change back before the sync, e.g. a click shorter than a frame.
+                edges = ActionEdge::Pressed | ActionEdge::Released;
+            }
+            if (edges != ActionEdge::None) {
+                m_changes.push_back({i, edges, value, m_lastChangeTimes[i]});
+            }
+        }
+
+        for (const ActionStateChange& change : m_changes) {
+            for (const Subscriber& subscriber : m_subscribers[change.Entry]) {
+                if ((subscriber.Edges & change.Edges) != ActionEdge::None) {
+                    subscriber.Function(change);
+                }
+            }
+        }
+    }
+#pragma endregion
+
+} // namespace xr
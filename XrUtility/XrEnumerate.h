@@ -16,61 +16,126 @@
 #pragma once
 
 #include <openxr/openxr.h>
+#include <algorithm>
 #include <vector>
 #include "XrError.h"
+#include "XrSmallVector.h"
 
 namespace xr {
+    // Two-call idiom into a caller owned buffer, e.g. a std::vector or an xr::SmallVector, whose capacity is kept across calls.
+    // The first call offers the whole capacity of the buffer, so the size query is skipped when it is already large enough.
+    // enumerate(capacityInput, countOutput, items) forwards to the xrEnumerate function named by originator.
+    template <typename TBuffer, typename TEnumerate>
+    void EnumerateInto(TBuffer& buffer, const typename TBuffer::value_type& emptyValue, const char* originator, TEnumerate&& enumerate) {
+        uint32_t capacity = static_cast<uint32_t>(buffer.capacity());
+        for (;;) {
+            buffer.assign(capacity, emptyValue);
+            uint32_t count = 0;
+            const XrResult result = enumerate(capacity, &count, buffer.data());
+            if (result == XR_ERROR_SIZE_INSUFFICIENT || (capacity == 0 && count > 0)) {
+                capacity = count; // The count may still grow between the two calls, in which case this loops again.
+                continue;
+            }
+            CHECK_XRRESULT(result, originator);
+            buffer.resize(count);
+            return;
+        }
+    }
+
+    template <typename TBuffer>
+    void EnumerateInstanceExtensionProperties(TBuffer& extensionProperties, const char* layerName = nullptr) {
+        EnumerateInto(extensionProperties,
+                      {XR_TYPE_EXTENSION_PROPERTIES},
+                      "xrEnumerateInstanceExtensionProperties",
+                      [&](uint32_t capacity, uint32_t* count, XrExtensionProperties* items) {
+                          return xrEnumerateInstanceExtensionProperties(layerName, capacity, count, items);
+                      });
+    }
+
+    template <typename TBuffer>
+    void EnumerateViewConfigurations(XrInstance instance, XrSystemId systemId, TBuffer& viewConfigs) {
+        EnumerateInto(viewConfigs,
+                      {},
+                      "xrEnumerateViewConfigurations",
+                      [&](uint32_t capacity, uint32_t* count, XrViewConfigurationType* items) {
+                          return xrEnumerateViewConfigurations(instance, systemId, capacity, count, items);
+                      });
+    }
+
+    template <typename TBuffer>
+    void EnumerateViewConfigurationViews(XrInstance instance,
+                                         XrSystemId systemId,
+                                         XrViewConfigurationType viewConfigurationType,
+                                         TBuffer& viewConfigViews) {
+        EnumerateInto(viewConfigViews,
+                      {XR_TYPE_VIEW_CONFIGURATION_VIEW},
+                      "xrEnumerateViewConfigurationViews",
+                      [&](uint32_t capacity, uint32_t* count, XrViewConfigurationView* items) {
+                          return xrEnumerateViewConfigurationViews(instance, systemId, viewConfigurationType, capacity, count, items);
+                      });
+    }
+
+    template <typename TBuffer>
+    void EnumerateEnvironmentBlendModes(XrInstance instance,
+                                        XrSystemId systemId,
+                                        XrViewConfigurationType viewConfigType,
+                                        TBuffer& blendModes) {
+        EnumerateInto(blendModes,
+                      {},
+                      "xrEnumerateEnvironmentBlendModes",
+                      [&](uint32_t capacity, uint32_t* count, XrEnvironmentBlendMode* items) {
+                          return xrEnumerateEnvironmentBlendModes(instance, systemId, viewConfigType, capacity, count, items);
+                      });
+    }
+
+    template <typename TBuffer>
+    void EnumerateSwapchainFormats(XrSession session, TBuffer& formats) {
+        EnumerateInto(formats, {}, "xrEnumerateSwapchainFormats", [&](uint32_t capacity, uint32_t* count, int64_t* items) {
+            return xrEnumerateSwapchainFormats(session, capacity, count, items);
+        });
+    }
+
+    // emptyImage is the graphics API specific image structure with its type set, e.g. {XR_TYPE_SWAPCHAIN_IMAGE_D3D11_KHR}.
+    template <typename TBuffer>
+    void EnumerateSwapchainImages(XrSwapchain swapchain, const typename TBuffer::value_type& emptyImage, TBuffer& images) {
+        using Image = typename TBuffer::value_type;
+        EnumerateInto(images, emptyImage, "xrEnumerateSwapchainImages", [&](uint32_t capacity, uint32_t* count, Image* items) {
+            return xrEnumerateSwapchainImages(swapchain, capacity, count, reinterpret_cast<XrSwapchainImageBaseHeader*>(items));
+        });
+    }
+
     inline std::vector<XrExtensionProperties> EnumerateInstanceExtensionProperties(const char* layerName = nullptr) {
-        uint32_t extensionCount;
-        CHECK_XRCMD(xrEnumerateInstanceExtensionProperties(layerName, 0, &extensionCount, nullptr));
-        std::vector<XrExtensionProperties> extensionProperties(extensionCount, {XR_TYPE_EXTENSION_PROPERTIES});
-        CHECK_XRCMD(xrEnumerateInstanceExtensionProperties(layerName, extensionCount, &extensionCount, extensionProperties.data()));
-        extensionProperties.resize(extensionCount);
+        std::vector<XrExtensionProperties> extensionProperties;
+        EnumerateInstanceExtensionProperties(extensionProperties, layerName);
         return extensionProperties;
     }
 
     inline std::vector<XrViewConfigurationType> EnumerateViewConfigurations(XrInstance instance, XrSystemId systemId) {
-        uint32_t viewConfigurationCount = 0;
-        CHECK_XRCMD(xrEnumerateViewConfigurations(instance, systemId, 0, &viewConfigurationCount, nullptr));
-
-        std::vector<XrViewConfigurationType> viewConfigs(viewConfigurationCount);
-        CHECK_XRCMD(xrEnumerateViewConfigurations(instance, systemId, viewConfigurationCount, &viewConfigurationCount, viewConfigs.data()));
+        std::vector<XrViewConfigurationType> viewConfigs;
+        EnumerateViewConfigurations(instance, systemId, viewConfigs);
         return viewConfigs;
     }
 
     inline std::vector<XrViewConfigurationView> EnumerateViewConfigurationViews(XrInstance instance,
                                                                                 XrSystemId systemId,
                                                                                 XrViewConfigurationType viewConfigurationType) {
-        uint32_t viewCount;
-        CHECK_XRCMD(xrEnumerateViewConfigurationViews(instance, systemId, viewConfigurationType, 0, &viewCount, nullptr));
-
-        std::vector<XrViewConfigurationView> viewConfigViews(viewCount, {XR_TYPE_VIEW_CONFIGURATION_VIEW});
-        CHECK_XRCMD(xrEnumerateViewConfigurationViews(
-            instance, systemId, viewConfigurationType, (uint32_t)viewConfigViews.size(), &viewCount, viewConfigViews.data()));
-
+        std::vector<XrViewConfigurationView> viewConfigViews;
+        EnumerateViewConfigurationViews(instance, systemId, viewConfigurationType, viewConfigViews);
         return viewConfigViews;
     }
 
     inline std::vector<XrEnvironmentBlendMode> EnumerateEnvironmentBlendModes(XrInstance instance,
                                                                               XrSystemId systemId,
                                                                               XrViewConfigurationType viewConfigType) {
-        uint32_t blendModeCount;
-        CHECK_XRCMD(xrEnumerateEnvironmentBlendModes(instance, systemId, viewConfigType, 0, &blendModeCount, nullptr));
-
-        std::vector<XrEnvironmentBlendMode> blendModes(blendModeCount);
-        CHECK_XRCMD(
-            xrEnumerateEnvironmentBlendModes(instance, systemId, viewConfigType, blendModeCount, &blendModeCount, blendModes.data()));
-
+        std::vector<XrEnvironmentBlendMode> blendModes;
+        EnumerateEnvironmentBlendModes(instance, systemId, viewConfigType, blendModes);
         return blendModes;
     }
 
     inline std::vector<int64_t> EnumerateSwapchainFormats(XrSession session) {
-        uint32_t swapchainFormatsCount;
-        CHECK_XRCMD(xrEnumerateSwapchainFormats(session, 0, &swapchainFormatsCount, nullptr));
-
-        std::vector<int64_t> runtimeFormats(swapchainFormatsCount);
-        CHECK_XRCMD(xrEnumerateSwapchainFormats(session, (uint32_t)runtimeFormats.size(), &swapchainFormatsCount, runtimeFormats.data()));
-        return runtimeFormats;
+        std::vector<int64_t> formats;
+        EnumerateSwapchainFormats(session, formats);
+        return formats;
     }
 
     // Pick the first supported EnvironmentBlendMode from runtime's supported list.
@@ -87,6 +152,7 @@ namespace xr {
         return *blendModeIt;
     }
 
+#ifdef _WIN32
     // Pick the first supported swapchain format from runtime's supported format list.
     inline DXGI_FORMAT PickSwapchainFormat(const std::vector<int64_t>& systemSupportedFormats,
                                            const std::vector<DXGI_FORMAT>& appSupportedFormats) {
@@ -100,5 +166,6 @@ namespace xr {
 
         return (DXGI_FORMAT)*swapchainFormatIt;
     }
+#endif
 
 } // namespace xr
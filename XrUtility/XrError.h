@@ -15,15 +15,25 @@
 //*********************************************************
 #pragma once
 
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
 #include "XrToString.h"
 
 #define CHECK_XRCMD(cmd) xr::detail::_CheckXrResult(cmd, #cmd, FILE_AND_LINE)
 #define CHECK_XRRESULT(res, cmdStr) xr::detail::_CheckXrResult(res, cmdStr, FILE_AND_LINE)
 
+#ifdef _WIN32
 #define CHECK_HRCMD(cmd) xr::detail::_CheckHResult(cmd, #cmd, FILE_AND_LINE)
 #define CHECK_HRESULT(res, cmdStr) xr::detail::_CheckHResult(res, cmdStr, FILE_AND_LINE)
 
 #define DEBUG_PRINT(...) ::OutputDebugStringA((xr::detail::_Fmt(__VA_ARGS__) + "\n").c_str())
+#else
+#define DEBUG_PRINT(...) std::fputs((xr::detail::_Fmt(__VA_ARGS__) + "\n").c_str(), stderr)
+#endif
 
 namespace xr::detail {
 #define CHK_STRINGIFY(x) #x
@@ -87,6 +97,7 @@ namespace xr::detail {
         return res;
     }
 
+#ifdef _WIN32
     [[noreturn]] inline void _ThrowHResult(HRESULT hr, const char* originator = nullptr, const char* sourceLocation = nullptr) {
         xr::detail::_Throw(xr::detail::_Fmt("HRESULT failure [%x]", hr), originator, sourceLocation);
     }
@@ -98,4 +109,5 @@ namespace xr::detail {
 
         return hr;
     }
+#endif
 } // namespace xr::detail
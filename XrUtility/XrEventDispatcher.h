@@ -0,0 +1,107 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "XrError.h"
+#include "XrStruct.h"
+
+namespace xr {
+
+    // Drains the events pending on an instance into a fixed buffer, then hands them to the handlers subscribed to their type.
+    // A drain polls at most Capacity events, the others stay queued in the runtime until the next drain, so the cost of a drain
+    // is bounded however many events the runtime queues. Draining and dispatching do not allocate, only Subscribe() does.
+    template <uint32_t Capacity>
+    class EventDispatcher {
+    public:
+        // Handlers of an event type are called in the order they subscribed, e.g.
+        //     dispatcher.Subscribe<XrEventDataSessionStateChanged>([&](const XrEventDataSessionStateChanged& event) { ... });
+        template <typename XrEventData, typename Handler>
+        void Subscribe(Handler&& handler) {
+            static_assert(event_type_v<XrEventData> != XR_TYPE_UNKNOWN, "Unknown event data structure");
+            m_subscribers.push_back({event_type_v<XrEventData>, [handler = std::forward<Handler>(handler)](const XrEventDataBuffer& event) {
+                                         handler(*reinterpret_cast<const XrEventData*>(&event));
+                                     }});
+        }
+
+        // Called with the events that no handler subscribed to.
+        void SetDefaultHandler(std::function<void(const XrEventDataBuffer&)> handler) {
+            m_defaultHandler = std::move(handler);
+        }
+
+        // Polls the events of the instance until none is left or the buffer is full. Returns the number of events drained.
+        uint32_t Drain(XrInstance instance);
+
+        // Calls the handlers of the drained events in the order the runtime queued them, and empties the buffer.
+        void Dispatch();
+
+        uint32_t PendingCount() const {
+            return m_eventCount;
+        }
+
+    private:
+        struct Subscriber {
+            XrStructureType Type;
+            std::function<void(const XrEventDataBuffer&)> Handler;
+        };
+
+        std::vector<Subscriber> m_subscribers;
+        std::function<void(const XrEventDataBuffer&)> m_defaultHandler;
+        std::array<XrEventDataBuffer, Capacity> m_events;
+        uint32_t m_eventCount{0};
+    };
+
+#pragma region Implementation details
+    template <uint32_t Capacity>
+    uint32_t EventDispatcher<Capacity>::Drain(XrInstance instance) {
+        const uint32_t firstEvent = m_eventCount;
+        while (m_eventCount < Capacity) {
+            XrEventDataBuffer& event = m_events[m_eventCount];
+            event.type = XR_TYPE_EVENT_DATA_BUFFER;
+            event.next = nullptr;
+            if (CHECK_XRCMD(xrPollEvent(instance, &event)) != XR_SUCCESS) {
+                break;
+            }
+            m_eventCount++;
+        }
+        return m_eventCount - firstEvent;
+    }
+
+    template <uint32_t Capacity>
+    void EventDispatcher<Capacity>::Dispatch() {
+        for (uint32_t i = 0; i < m_eventCount; i++) {
+            const XrEventDataBuffer& event = m_events[i];
+            bool handled = false;
+            for (const Subscriber& subscriber : m_subscribers) {
+                if (subscriber.Type == event.type) {
+                    subscriber.Handler(event);
+                    handled = true;
+                }
+            }
+            if (!handled && m_defaultHandler) {
+                m_defaultHandler(event);
+            }
+        }
+        m_eventCount = 0;
+    }
+#pragma endregion
+
+} // namespace xr
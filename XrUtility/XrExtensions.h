@@ -15,20 +15,68 @@
 //*********************************************************
 #pragma once
 
-#define FOR_EACH_EXTENSION_FUNCTION(_)           \
-    _(xrCreateSpatialAnchorMSFT)                 \
-    _(xrCreateSpatialAnchorSpaceMSFT)            \
-    _(xrDestroySpatialAnchorMSFT)                \
-    _(xrCreateHandTrackerMSFT)                   \
-    _(xrDestroyHandTrackerMSFT)                  \
-    _(xrGetHandTrackerStateMSFT)                 \
-    _(xrCreateHandJointSpaceMSFT)                \
-    _(xrCreateHandMeshSpaceMSFT)                 \
-    _(xrUpdateHandMeshMSFT)                      \
-    _(xrConvertWin32PerformanceCounterToTimeKHR) \
-    _(xrCreateSpaceFromSpatialGraphNodeMSFT)     \
-    _(xrGetD3D11GraphicsRequirementsKHR)         \
-    _(xrGetVisibilityMaskKHR)
+// XR_KHR_locate_spaces is newer than the OpenXR headers of this project, so declare what is used from it.
+#ifndef XR_KHR_locate_spaces
+#define XR_KHR_locate_spaces 1
+#define XR_KHR_locate_spaces_SPEC_VERSION 1
+#define XR_KHR_LOCATE_SPACES_EXTENSION_NAME "XR_KHR_locate_spaces"
+constexpr XrStructureType XR_TYPE_SPACES_LOCATE_INFO_KHR = static_cast<XrStructureType>(1000471000);
+constexpr XrStructureType XR_TYPE_SPACE_LOCATIONS_KHR = static_cast<XrStructureType>(1000471001);
+
+typedef struct XrSpacesLocateInfoKHR {
+    XrStructureType type;
+    const void* XR_MAY_ALIAS next;
+    XrSpace baseSpace;
+    XrTime time;
+    uint32_t spaceCount;
+    const XrSpace* spaces;
+} XrSpacesLocateInfoKHR;
+
+typedef struct XrSpaceLocationDataKHR {
+    XrSpaceLocationFlags locationFlags;
+    XrPosef pose;
+} XrSpaceLocationDataKHR;
+
+typedef struct XrSpaceLocationsKHR {
+    XrStructureType type;
+    void* XR_MAY_ALIAS next;
+    uint32_t locationCount;
+    XrSpaceLocationDataKHR* locations;
+} XrSpaceLocationsKHR;
+
+typedef XrResult(XRAPI_PTR* PFN_xrLocateSpacesKHR)(XrSession session,
+                                                   const XrSpacesLocateInfoKHR* locateInfo,
+                                                   XrSpaceLocationsKHR* spaceLocations);
+#endif
+
+// Platform and graphics API specific functions are only declared when the matching XR_USE_* macro is defined.
+#ifdef XR_USE_PLATFORM_WIN32
+#define FOR_EACH_WIN32_EXTENSION_FUNCTION(_) _(xrConvertWin32PerformanceCounterToTimeKHR)
+#else
+#define FOR_EACH_WIN32_EXTENSION_FUNCTION(_)
+#endif
+
+#ifdef XR_USE_GRAPHICS_API_D3D11
+#define FOR_EACH_D3D11_EXTENSION_FUNCTION(_) _(xrGetD3D11GraphicsRequirementsKHR)
+#else
+#define FOR_EACH_D3D11_EXTENSION_FUNCTION(_)
+#endif
+
+#define FOR_EACH_EXTENSION_FUNCTION(_)       \
+    _(xrCreateSpatialAnchorMSFT)             \
+    _(xrCreateSpatialAnchorSpaceMSFT)        \
+    _(xrDestroySpatialAnchorMSFT)            \
+    _(xrCreateHandTrackerMSFT)               \
+    _(xrDestroyHandTrackerMSFT)              \
+    _(xrGetHandTrackerStateMSFT)             \
+    _(xrCreateHandJointSpaceMSFT)            \
+    _(xrCreateHandMeshSpaceMSFT)             \
+    _(xrUpdateHandMeshMSFT)                  \
+    FOR_EACH_WIN32_EXTENSION_FUNCTION(_)     \
+    _(xrCreateSpaceFromSpatialGraphNodeMSFT) \
+    FOR_EACH_D3D11_EXTENSION_FUNCTION(_)     \
+    _(xrGetVisibilityMaskKHR)                \
+    _(xrLocateSpacesKHR)
 
 #define GET_INSTANCE_PROC_ADDRESS(name) \
     (void)xrGetInstanceProcAddr(instance, #name, reinterpret_cast<PFN_xrVoidFunction*>(const_cast<PFN_##name*>(&name)));
@@ -48,5 +96,7 @@ namespace xr {
 #undef DEFINE_PROC_MEMBER
 #undef GET_INSTANCE_PROC_ADDRESS
 #undef FOR_EACH_EXTENSION_FUNCTION
+#undef FOR_EACH_D3D11_EXTENSION_FUNCTION
+#undef FOR_EACH_WIN32_EXTENSION_FUNCTION
 
 
@@ -0,0 +1,131 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <openxr/openxr.h>
+#include <cmath>
+
+#include "XrMath.h"
+
+namespace xr::math {
+    // Points inside the plane satisfy Dot(Normal, point) + Distance >= 0.
+    struct Plane {
+        XrVector3f Normal;
+        float Distance;
+    };
+
+    // Left, right, bottom, top, near and far clip planes of a view, in the base space of the view pose (e.g. the scene space the views
+    // were located in), as the inverted view pose is folded into them. With an infinite far plane, its plane keeps every point inside.
+    struct Frustum {
+        Plane Planes[6];
+    };
+
+    // Axis aligned box in the local space of an object.
+    struct Box {
+        XrVector3f Center;
+        XrVector3f HalfExtents;
+    };
+
+    Frustum ComputeFrustum(const ViewProjection& viewProjection);
+
+    // Set visible[i] to 1 if the box i intersects at least one of the frustums, and to 0 otherwise.
+    // Box i is localBoxes[boxIndices[i]] scaled by scales[i] and placed at poses[i], e.g. the bounds of the mesh drawn by object i.
+    // Passing the frustums of both stereo views keeps everything seen by either eye.
+    void CullBoxes(const Frustum* frustums,
+                   uint32_t frustumCount,
+                   const XrPosef* poses,
+                   const XrVector3f* scales,
+                   const Box* localBoxes,
+                   const uint32_t* boxIndices,
+                   size_t count,
+                   uint8_t* visible);
+} // namespace xr::math
+
+#pragma region Implementation
+
+namespace xr::math {
+    inline Frustum ComputeFrustum(const ViewProjection& viewProjection) {
+        Float4x4 m;
+        StoreFloat4x4(&m, LoadInvertedXrPose(viewProjection.Pose) * ComposeProjectionMatrix(viewProjection.Fov, viewProjection.NearFar));
+
+        // Points are row vectors (clip = point * m), so each clip coordinate is the dot product with a column of m.
+        // The visible volume is -w <= x <= w, -w <= y <= w and 0 <= z <= w, which also holds for reversed Z.
+        auto column = [&m](int c) { return XrVector4f{m.m[0][c], m.m[1][c], m.m[2][c], m.m[3][c]}; };
+        const XrVector4f x = column(0);
+        const XrVector4f y = column(1);
+        const XrVector4f z = column(2);
+        const XrVector4f w = column(3);
+
+        auto makePlane = [](const XrVector4f& a, float sign, const XrVector4f& b) {
+            const XrVector3f normal{a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z};
+            const float length = std::sqrt(Dot(normal, normal));
+            return Plane{normal / length, (a.w + sign * b.w) / length};
+        };
+
+        Frustum frustum;
+        frustum.Planes[0] = makePlane(w, 1, x);
+        frustum.Planes[1] = makePlane(w, -1, x);
+        frustum.Planes[2] = makePlane(w, 1, y);
+        frustum.Planes[3] = makePlane(w, -1, y);
+        // The depth planes map to z = 0 and z = w, swapped for reversed Z. An infinite one has a vanishing normal, it is replaced by a
+        // plane every point is inside of.
+        const Plane everywhere{{0, 0, 0}, 1};
+        frustum.Planes[4] = std::isinf(viewProjection.NearFar.Near) ? everywhere : makePlane(z, 0, z);
+        frustum.Planes[5] = std::isinf(viewProjection.NearFar.Far) ? everywhere : makePlane(w, -1, z);
+        return frustum;
+    }
+
+    inline void CullBoxes(const Frustum* frustums,
+                          uint32_t frustumCount,
+                          const XrPosef* poses,
+                          const XrVector3f* scales,
+                          const Box* localBoxes,
+                          const uint32_t* boxIndices,
+                          size_t count,
+                          uint8_t* visible) {
+        for (size_t i = 0; i < count; i++) {
+            const XrQuaternionf& q = poses[i].orientation;
+            const Box& box = localBoxes[boxIndices[i]];
+            const XrVector3f extents = box.HalfExtents * scales[i];
+
+            // Box axes in scene space, the columns of the rotation matrix of the pose orientation.
+            const XrVector3f axisX{1 - 2 * (q.y * q.y + q.z * q.z), 2 * (q.x * q.y + q.w * q.z), 2 * (q.x * q.z - q.w * q.y)};
+            const XrVector3f axisY{2 * (q.x * q.y - q.w * q.z), 1 - 2 * (q.x * q.x + q.z * q.z), 2 * (q.y * q.z + q.w * q.x)};
+            const XrVector3f axisZ{2 * (q.x * q.z + q.w * q.y), 2 * (q.y * q.z - q.w * q.x), 1 - 2 * (q.x * q.x + q.y * q.y)};
+            const XrVector3f localCenter = box.Center * scales[i];
+            const XrVector3f center = poses[i].position + axisX * localCenter.x + axisY * localCenter.y + axisZ * localCenter.z;
+
+            bool insideAny = false;
+            for (uint32_t f = 0; f < frustumCount && !insideAny; f++) {
+                bool inside = true;
+                for (const Plane& plane : frustums[f].Planes) {
+                    // The box is outside when even its corner furthest along the plane normal is behind the plane.
+                    const float distance = Dot(plane.Normal, center) + plane.Distance;
+                    const float radius = extents.x * std::abs(Dot(plane.Normal, axisX)) + extents.y * std::abs(Dot(plane.Normal, axisY)) +
+                                         extents.z * std::abs(Dot(plane.Normal, axisZ));
+                    if (distance + radius < 0) {
+                        inside = false;
+                        break;
+                    }
+                }
+                insideAny = inside;
+            }
+            visible[i] = insideAny;
+        }
+    }
+} // namespace xr::math
+
+#pragma endregion
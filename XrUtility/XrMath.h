@@ -16,9 +16,13 @@
 #pragma once
 
 #include <openxr/openxr.h>
-#include <DirectXMath.h>
-#include <stdexcept>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "XrMathBackend.h"
 
 namespace xr::math {
     constexpr float QuaternionEpsilon = 0.01f;
@@ -32,6 +36,7 @@ namespace xr::math {
 
         XrPosef LookAt(const XrVector3f& origin, const XrVector3f& forward, const XrVector3f& up);
         XrPosef Multiply(const XrPosef& a, const XrPosef& b);
+        XrPosef Invert(const XrPosef& pose);
         XrPosef Slerp(const XrPosef& a, const XrPosef& b, float alpha);
 
         constexpr bool IsPoseValid(const XrSpaceLocation& location);
@@ -59,34 +64,34 @@ namespace xr::math {
     struct ViewProjection {
         XrPosef Pose;
         XrFovf Fov;
-        NearFar NearFar;
+        xr::math::NearFar NearFar;
     };
 
     // Type conversion between math types
     template <typename X, typename Y>
     constexpr const X& cast(const Y& value);
 
-    // Convert XR types to DX
-    DirectX::XMVECTOR XM_CALLCONV LoadXrVector2(const XrVector2f& vector);
-    DirectX::XMVECTOR XM_CALLCONV LoadXrVector3(const XrVector3f& vector);
-    DirectX::XMVECTOR XM_CALLCONV LoadXrVector4(const XrVector4f& vector);
-    DirectX::XMVECTOR XM_CALLCONV LoadXrQuaternion(const XrQuaternionf& quaternion);
-    DirectX::XMMATRIX XM_CALLCONV LoadXrPose(const XrPosef& rigidTransform);
-    DirectX::XMMATRIX XM_CALLCONV LoadInvertedXrPose(const XrPosef& rigidTransform);
-    DirectX::XMVECTOR XM_CALLCONV LoadXrExtent(const XrExtent2Df& extend);
-
-    // Convert DX types to XR
-    void XM_CALLCONV StoreXrVector2(XrVector2f* outVec, DirectX::FXMVECTOR inVec);
-    void XM_CALLCONV StoreXrVector3(XrVector3f* outVec, DirectX::FXMVECTOR inVec);
-    void XM_CALLCONV StoreXrVector4(XrVector4f* outVec, DirectX::FXMVECTOR inVec);
-    void XM_CALLCONV StoreXrQuaternion(XrQuaternionf* outQuat, DirectX::FXMVECTOR inQuat);
-    bool XM_CALLCONV StoreXrPose(XrPosef* out, DirectX::FXMMATRIX matrix);
-    void XM_CALLCONV StoreXrExtent(XrExtent2Df* extend, DirectX::FXMVECTOR inVec);
+    // Convert XR types to math backend types
+    Vector XR_MATH_CALLCONV LoadXrVector2(const XrVector2f& vector);
+    Vector XR_MATH_CALLCONV LoadXrVector3(const XrVector3f& vector);
+    Vector XR_MATH_CALLCONV LoadXrVector4(const XrVector4f& vector);
+    Vector XR_MATH_CALLCONV LoadXrQuaternion(const XrQuaternionf& quaternion);
+    Matrix XR_MATH_CALLCONV LoadXrPose(const XrPosef& rigidTransform);
+    Matrix XR_MATH_CALLCONV LoadInvertedXrPose(const XrPosef& rigidTransform);
+    Vector XR_MATH_CALLCONV LoadXrExtent(const XrExtent2Df& extend);
+
+    // Convert math backend types to XR
+    void XR_MATH_CALLCONV StoreXrVector2(XrVector2f* outVec, Vector inVec);
+    void XR_MATH_CALLCONV StoreXrVector3(XrVector3f* outVec, Vector inVec);
+    void XR_MATH_CALLCONV StoreXrVector4(XrVector4f* outVec, Vector inVec);
+    void XR_MATH_CALLCONV StoreXrQuaternion(XrQuaternionf* outQuat, Vector inQuat);
+    bool XR_MATH_CALLCONV StoreXrPose(XrPosef* out, const Matrix& matrix);
+    void XR_MATH_CALLCONV StoreXrExtent(XrExtent2Df* extend, Vector inVec);
 
     // Projection matrix math
-    DirectX::XMMATRIX ComposeProjectionMatrix(const XrFovf& fov, const NearFar& nearFar);
-    NearFar GetProjectionNearFar(const DirectX::XMFLOAT4X4& projectionMatrix);
-    XrFovf DecomposeProjectionMatrix(const DirectX::XMFLOAT4X4& projectionMatrix);
+    Matrix ComposeProjectionMatrix(const XrFovf& fov, const NearFar& nearFar);
+    NearFar GetProjectionNearFar(const Float4x4& projectionMatrix);
+    XrFovf DecomposeProjectionMatrix(const Float4x4& projectionMatrix);
 } // namespace xr::math
 
 #pragma region Implementation
@@ -116,7 +121,7 @@ namespace xr::math {
 
     template <typename X, typename Y>
     constexpr const X& cast(const Y& value) {
-        static_assert(false, "Undefined cast from Y to type X");
+        static_assert(sizeof(X) == 0, "Undefined cast from Y to type X");
     }
 
 #define DEFINE_CAST(X, Y)                             \
@@ -125,47 +130,47 @@ namespace xr::math {
         return detail::implement_math_cast<X>(value); \
     }
 
-    static_assert(offsetof(DirectX::XMFLOAT2, x) == offsetof(XrVector2f, x));
-    static_assert(offsetof(DirectX::XMFLOAT2, y) == offsetof(XrVector2f, y));
-    DEFINE_CAST(XrVector2f, DirectX::XMFLOAT2);
-    DEFINE_CAST(DirectX::XMFLOAT2, XrVector2f);
-
-    static_assert(offsetof(DirectX::XMFLOAT3, x) == offsetof(XrVector3f, x));
-    static_assert(offsetof(DirectX::XMFLOAT3, y) == offsetof(XrVector3f, y));
-    static_assert(offsetof(DirectX::XMFLOAT3, z) == offsetof(XrVector3f, z));
-    DEFINE_CAST(XrVector3f, DirectX::XMFLOAT3);
-    DEFINE_CAST(DirectX::XMFLOAT3, XrVector3f);
-
-    static_assert(offsetof(DirectX::XMFLOAT4, x) == offsetof(XrVector4f, x));
-    static_assert(offsetof(DirectX::XMFLOAT4, y) == offsetof(XrVector4f, y));
-    static_assert(offsetof(DirectX::XMFLOAT4, z) == offsetof(XrVector4f, z));
-    static_assert(offsetof(DirectX::XMFLOAT4, w) == offsetof(XrVector4f, w));
-    DEFINE_CAST(XrVector4f, DirectX::XMFLOAT4);
-    DEFINE_CAST(DirectX::XMFLOAT4, XrVector4f);
-
-    static_assert(offsetof(DirectX::XMFLOAT4, x) == offsetof(XrQuaternionf, x));
-    static_assert(offsetof(DirectX::XMFLOAT4, y) == offsetof(XrQuaternionf, y));
-    static_assert(offsetof(DirectX::XMFLOAT4, z) == offsetof(XrQuaternionf, z));
-    static_assert(offsetof(DirectX::XMFLOAT4, w) == offsetof(XrQuaternionf, w));
-    DEFINE_CAST(XrQuaternionf, DirectX::XMFLOAT4);
-    DEFINE_CAST(DirectX::XMFLOAT4, XrQuaternionf);
-
-    static_assert(offsetof(DirectX::XMINT2, x) == offsetof(XrExtent2Di, width));
-    static_assert(offsetof(DirectX::XMINT2, y) == offsetof(XrExtent2Di, height));
-    DEFINE_CAST(XrExtent2Di, DirectX::XMINT2);
-    DEFINE_CAST(DirectX::XMINT2, XrExtent2Di);
-
-    static_assert(offsetof(DirectX::XMFLOAT2, x) == offsetof(XrExtent2Df, width));
-    static_assert(offsetof(DirectX::XMFLOAT2, y) == offsetof(XrExtent2Df, height));
-    DEFINE_CAST(XrExtent2Df, DirectX::XMFLOAT2);
-    DEFINE_CAST(DirectX::XMFLOAT2, XrExtent2Df);
-
-    static_assert(offsetof(DirectX::XMFLOAT4, x) == offsetof(XrColor4f, r));
-    static_assert(offsetof(DirectX::XMFLOAT4, y) == offsetof(XrColor4f, g));
-    static_assert(offsetof(DirectX::XMFLOAT4, z) == offsetof(XrColor4f, b));
-    static_assert(offsetof(DirectX::XMFLOAT4, w) == offsetof(XrColor4f, a));
-    DEFINE_CAST(XrColor4f, DirectX::XMFLOAT4);
-    DEFINE_CAST(DirectX::XMFLOAT4, XrColor4f);
+    static_assert(offsetof(Float2, x) == offsetof(XrVector2f, x));
+    static_assert(offsetof(Float2, y) == offsetof(XrVector2f, y));
+    DEFINE_CAST(XrVector2f, Float2);
+    DEFINE_CAST(Float2, XrVector2f);
+
+    static_assert(offsetof(Float3, x) == offsetof(XrVector3f, x));
+    static_assert(offsetof(Float3, y) == offsetof(XrVector3f, y));
+    static_assert(offsetof(Float3, z) == offsetof(XrVector3f, z));
+    DEFINE_CAST(XrVector3f, Float3);
+    DEFINE_CAST(Float3, XrVector3f);
+
+    static_assert(offsetof(Float4, x) == offsetof(XrVector4f, x));
+    static_assert(offsetof(Float4, y) == offsetof(XrVector4f, y));
+    static_assert(offsetof(Float4, z) == offsetof(XrVector4f, z));
+    static_assert(offsetof(Float4, w) == offsetof(XrVector4f, w));
+    DEFINE_CAST(XrVector4f, Float4);
+    DEFINE_CAST(Float4, XrVector4f);
+
+    static_assert(offsetof(Float4, x) == offsetof(XrQuaternionf, x));
+    static_assert(offsetof(Float4, y) == offsetof(XrQuaternionf, y));
+    static_assert(offsetof(Float4, z) == offsetof(XrQuaternionf, z));
+    static_assert(offsetof(Float4, w) == offsetof(XrQuaternionf, w));
+    DEFINE_CAST(XrQuaternionf, Float4);
+    DEFINE_CAST(Float4, XrQuaternionf);
+
+    static_assert(offsetof(Int2, x) == offsetof(XrExtent2Di, width));
+    static_assert(offsetof(Int2, y) == offsetof(XrExtent2Di, height));
+    DEFINE_CAST(XrExtent2Di, Int2);
+    DEFINE_CAST(Int2, XrExtent2Di);
+
+    static_assert(offsetof(Float2, x) == offsetof(XrExtent2Df, width));
+    static_assert(offsetof(Float2, y) == offsetof(XrExtent2Df, height));
+    DEFINE_CAST(XrExtent2Df, Float2);
+    DEFINE_CAST(Float2, XrExtent2Df);
+
+    static_assert(offsetof(Float4, x) == offsetof(XrColor4f, r));
+    static_assert(offsetof(Float4, y) == offsetof(XrColor4f, g));
+    static_assert(offsetof(Float4, z) == offsetof(XrColor4f, b));
+    static_assert(offsetof(Float4, w) == offsetof(XrColor4f, a));
+    DEFINE_CAST(XrColor4f, Float4);
+    DEFINE_CAST(Float4, XrColor4f);
 
 #undef DEFINE_CAST
 
@@ -178,11 +183,11 @@ namespace xr::math {
         return detail::implement_math_cast<X>(value); \
     }
 
-    DEFINE_CAST(DirectX::XMFLOAT2, XrVector2f);
-    DEFINE_CAST(DirectX::XMFLOAT3, XrVector3f);
-    DEFINE_CAST(DirectX::XMFLOAT4, XrVector4f);
-    DEFINE_CAST(DirectX::XMFLOAT4, XrQuaternionf);
-    DEFINE_CAST(DirectX::XMFLOAT2, XrExtent2Df);
+    DEFINE_CAST(Float2, XrVector2f);
+    DEFINE_CAST(Float3, XrVector3f);
+    DEFINE_CAST(Float4, XrVector4f);
+    DEFINE_CAST(Float4, XrQuaternionf);
+    DEFINE_CAST(Float2, XrExtent2Df);
 #undef DEFINE_CAST
 
 #define VECTOR3F_OPERATOR(op)                                                    \
@@ -215,72 +220,84 @@ namespace xr::math {
     VECTOR3F_OPERATOR(/);
 #undef VECTOR3F_OPERATOR
 
-    inline DirectX::XMVECTOR XM_CALLCONV LoadXrVector2(const XrVector2f& vector) {
-        return DirectX::XMLoadFloat2(&xr::math::cast(vector));
+    inline float Dot(const XrVector3f& a, const XrVector3f& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline XrVector3f Cross(const XrVector3f& a, const XrVector3f& b) {
+        return XrVector3f{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+
+    inline XrVector3f Normalize(const XrVector3f& a) {
+        return a / std::sqrt(Dot(a, a));
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadXrVector2(const XrVector2f& vector) {
+        return LoadFloat2(&xr::math::cast(vector));
     }
 
-    inline DirectX::XMVECTOR XM_CALLCONV LoadXrVector3(const XrVector3f& vector) {
-        return DirectX::XMLoadFloat3(&xr::math::cast(vector));
+    inline Vector XR_MATH_CALLCONV LoadXrVector3(const XrVector3f& vector) {
+        return LoadFloat3(&xr::math::cast(vector));
     }
 
-    inline DirectX::XMVECTOR XM_CALLCONV LoadXrVector4(const XrVector4f& vector) {
-        return DirectX::XMLoadFloat4(&xr::math::cast(vector));
+    inline Vector XR_MATH_CALLCONV LoadXrVector4(const XrVector4f& vector) {
+        return LoadFloat4(&xr::math::cast(vector));
     }
 
-    inline DirectX::XMVECTOR XM_CALLCONV LoadXrQuaternion(const XrQuaternionf& quaternion) {
-        return DirectX::XMLoadFloat4(&xr::math::cast(quaternion));
+    inline Vector XR_MATH_CALLCONV LoadXrQuaternion(const XrQuaternionf& quaternion) {
+        return LoadFloat4(&xr::math::cast(quaternion));
     }
 
-    inline DirectX::XMVECTOR XM_CALLCONV LoadXrExtent(const XrExtent2Df& extend) {
-        return DirectX::XMLoadFloat2(&xr::math::cast(extend));
+    inline Vector XR_MATH_CALLCONV LoadXrExtent(const XrExtent2Df& extend) {
+        return LoadFloat2(&xr::math::cast(extend));
     }
 
-    inline DirectX::XMMATRIX XM_CALLCONV LoadXrPose(const XrPosef& pose) {
-        const DirectX::XMVECTOR orientation = LoadXrQuaternion(pose.orientation);
-        const DirectX::XMVECTOR position = LoadXrVector3(pose.position);
-        DirectX::XMMATRIX matrix = DirectX::XMMatrixRotationQuaternion(orientation);
-        matrix.r[3] = DirectX::XMVectorAdd(matrix.r[3], position);
+    inline Matrix XR_MATH_CALLCONV LoadXrPose(const XrPosef& pose) {
+        const Vector orientation = LoadXrQuaternion(pose.orientation);
+        const Vector position = LoadXrVector3(pose.position);
+        Matrix matrix = MatrixRotationQuaternion(orientation);
+        matrix.r[3] = VectorAdd(matrix.r[3], position);
         return matrix;
     }
 
-    inline DirectX::XMMATRIX XM_CALLCONV LoadInvertedXrPose(const XrPosef& pose) {
-        const DirectX::XMVECTOR orientation = LoadXrQuaternion(pose.orientation);
-        const DirectX::XMVECTOR invertOrientation = DirectX::XMQuaternionConjugate(orientation);
+    inline Matrix XR_MATH_CALLCONV LoadInvertedXrPose(const XrPosef& pose) {
+        const Vector orientation = LoadXrQuaternion(pose.orientation);
+        const Vector invertOrientation = QuaternionConjugate(orientation);
 
-        const DirectX::XMVECTOR position = LoadXrVector3(pose.position);
-        const DirectX::XMVECTOR invertPosition = DirectX::XMVector3Rotate(DirectX::XMVectorNegate(position), invertOrientation);
+        const Vector position = LoadXrVector3(pose.position);
+        const Vector invertPosition = Vector3Rotate(VectorNegate(position), invertOrientation);
 
-        DirectX::XMMATRIX matrix = DirectX::XMMatrixRotationQuaternion(invertOrientation);
-        matrix.r[3] = DirectX::XMVectorAdd(matrix.r[3], invertPosition);
+        Matrix matrix = MatrixRotationQuaternion(invertOrientation);
+        matrix.r[3] = VectorAdd(matrix.r[3], invertPosition);
         return matrix;
     }
 
-    inline void XM_CALLCONV StoreXrVector2(XrVector2f* outVec, DirectX::FXMVECTOR inVec) {
-        DirectX::XMStoreFloat2(&detail::implement_math_cast<DirectX::XMFLOAT2>(*outVec), inVec);
+    inline void XR_MATH_CALLCONV StoreXrVector2(XrVector2f* outVec, Vector inVec) {
+        StoreFloat2(&detail::implement_math_cast<Float2>(*outVec), inVec);
     }
 
-    inline void XM_CALLCONV StoreXrVector3(XrVector3f* outVec, DirectX::FXMVECTOR inVec) {
-        DirectX::XMStoreFloat3(&detail::implement_math_cast<DirectX::XMFLOAT3>(*outVec), inVec);
+    inline void XR_MATH_CALLCONV StoreXrVector3(XrVector3f* outVec, Vector inVec) {
+        StoreFloat3(&detail::implement_math_cast<Float3>(*outVec), inVec);
     }
 
-    inline void XM_CALLCONV StoreXrVector4(XrVector4f* outVec, DirectX::FXMVECTOR inVec) {
-        DirectX::XMStoreFloat4(&detail::implement_math_cast<DirectX::XMFLOAT4>(*outVec), inVec);
+    inline void XR_MATH_CALLCONV StoreXrVector4(XrVector4f* outVec, Vector inVec) {
+        StoreFloat4(&detail::implement_math_cast<Float4>(*outVec), inVec);
     }
 
-    inline void XM_CALLCONV StoreXrQuaternion(XrQuaternionf* outQuat, DirectX::FXMVECTOR inQuat) {
-        DirectX::XMStoreFloat4(&detail::implement_math_cast<DirectX::XMFLOAT4>(*outQuat), inQuat);
+    inline void XR_MATH_CALLCONV StoreXrQuaternion(XrQuaternionf* outQuat, Vector inQuat) {
+        StoreFloat4(&detail::implement_math_cast<Float4>(*outQuat), inQuat);
     }
 
-    inline void XM_CALLCONV StoreXrExtent(XrExtent2Df* outVec, DirectX::FXMVECTOR inVec) {
-        DirectX::XMStoreFloat2(&detail::implement_math_cast<DirectX::XMFLOAT2>(*outVec), inVec);
+    inline void XR_MATH_CALLCONV StoreXrExtent(XrExtent2Df* outVec, Vector inVec) {
+        StoreFloat2(&detail::implement_math_cast<Float2>(*outVec), inVec);
     }
 
-    inline bool XM_CALLCONV StoreXrPose(XrPosef* out, DirectX::FXMMATRIX matrix) {
-        DirectX::XMVECTOR position;
-        DirectX::XMVECTOR orientation;
-        DirectX::XMVECTOR scale;
+    inline bool XR_MATH_CALLCONV StoreXrPose(XrPosef* out, const Matrix& matrix) {
+        Vector position;
+        Vector orientation;
+        Vector scale;
 
-        if (!DirectX::XMMatrixDecompose(&scale, &orientation, &position, matrix)) {
+        if (!MatrixDecompose(&scale, &orientation, &position, matrix)) {
             return false; // Non-SRT matrix encountered
         }
 
@@ -301,11 +318,18 @@ namespace xr::math {
         }
 
         inline XrPosef LookAt(const XrVector3f& origin, const XrVector3f& forward, const XrVector3f& up) {
-            DirectX::XMMATRIX virtualToGazeOrientation =
-                DirectX::XMMatrixLookToRH(xr::math::LoadXrVector3(origin), xr::math::LoadXrVector3(forward), xr::math::LoadXrVector3(up));
-            XrPosef pose;
-            xr::math::StoreXrPose(&pose, DirectX::XMMatrixInverse(nullptr, virtualToGazeOrientation));
+            // Right-handed view basis, looking down -Z with +Y up, as in a view matrix built with a look-to direction.
+            const XrVector3f zAxis = Normalize(forward) * -1.0f;
+            const XrVector3f xAxis = Normalize(Cross(up, zAxis));
+            const XrVector3f yAxis = Cross(zAxis, xAxis);
+            const Matrix orientation{{VectorSet(xAxis.x, xAxis.y, xAxis.z, 0),
+                                      VectorSet(yAxis.x, yAxis.y, yAxis.z, 0),
+                                      VectorSet(zAxis.x, zAxis.y, zAxis.z, 0),
+                                      VectorSet(0, 0, 0, 1)}};
 
+            XrPosef pose;
+            StoreXrQuaternion(&pose.orientation, QuaternionRotationMatrix(orientation));
+            pose.position = origin;
             return pose;
         }
 
@@ -322,19 +346,29 @@ namespace xr::math {
             // => Rc = Ra * RotationOf(Ta * Rb)
             //    Qc = Qa * Qb;
             // => Tc = TranslationOf(Ta * Rb) * Tb
-            //    Pc = XMVector3Rotate(Pa, Qb) + Pb;
+            //    Pc = Vector3Rotate(Pa, Qb) + Pb;
 
-            const DirectX::XMVECTOR pa = LoadXrVector3(a.position);
-            const DirectX::XMVECTOR qa = LoadXrQuaternion(a.orientation);
-            const DirectX::XMVECTOR pb = LoadXrVector3(b.position);
-            const DirectX::XMVECTOR qb = LoadXrQuaternion(b.orientation);
+            const Vector pa = LoadXrVector3(a.position);
+            const Vector qa = LoadXrQuaternion(a.orientation);
+            const Vector pb = LoadXrVector3(b.position);
+            const Vector qb = LoadXrQuaternion(b.orientation);
 
             XrPosef c;
-            StoreXrQuaternion(&c.orientation, DirectX::XMQuaternionMultiply(qa, qb));
-            StoreXrVector3(&c.position, DirectX::XMVectorAdd(DirectX::XMVector3Rotate(pa, qb), pb));
+            StoreXrQuaternion(&c.orientation, QuaternionMultiply(qa, qb));
+            StoreXrVector3(&c.position, VectorAdd(Vector3Rotate(pa, qb), pb));
             return c;
         }
 
+        inline XrPosef Invert(const XrPosef& pose) {
+            // Q^-1 = conjugate of Q for a unit quaternion, P^-1 = -P rotated by Q^-1.
+            const Vector inverseOrientation = QuaternionConjugate(LoadXrQuaternion(pose.orientation));
+
+            XrPosef inverse;
+            StoreXrQuaternion(&inverse.orientation, inverseOrientation);
+            StoreXrVector3(&inverse.position, Vector3Rotate(VectorNegate(LoadXrVector3(pose.position)), inverseOrientation));
+            return inverse;
+        }
+
         constexpr bool IsPoseValid(const XrSpaceLocation& spaceLocation) {
             constexpr XrSpaceLocationFlags PoseValidFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
             return (spaceLocation.locationFlags & PoseValidFlags) == PoseValidFlags;
@@ -368,30 +402,30 @@ namespace xr::math {
         }
 
         inline float Length(const XrQuaternionf& quaternion) {
-            DirectX::XMVECTOR vector = LoadXrQuaternion(quaternion);
-            return DirectX::XMVectorGetX(DirectX::XMVector4Length(vector));
+            Vector vector = LoadXrQuaternion(quaternion);
+            return VectorGetX(Vector4Length(vector));
         }
 
         inline bool IsNormalized(const XrQuaternionf& quaternion) {
-            return fabs(1 - Length(quaternion)) <= QuaternionEpsilon;
+            return std::abs(1 - Length(quaternion)) <= QuaternionEpsilon;
         }
 
         inline XrQuaternionf RotationAxisAngle(const XrVector3f& axis, float angleInRadians) {
             XrQuaternionf q;
-            StoreXrQuaternion(&q, DirectX::XMQuaternionRotationAxis(LoadXrVector3(axis), angleInRadians));
+            StoreXrQuaternion(&q, QuaternionRotationAxis(LoadXrVector3(axis), angleInRadians));
             return q;
         }
 
         inline XrQuaternionf RotationRollPitchYaw(const XrVector3f& anglesInRadians) {
             XrQuaternionf q;
-            StoreXrQuaternion(&q, DirectX::XMQuaternionRotationRollPitchYaw(anglesInRadians.x, anglesInRadians.y, anglesInRadians.z));
+            StoreXrQuaternion(&q, QuaternionRotationRollPitchYaw(anglesInRadians.x, anglesInRadians.y, anglesInRadians.z));
             return q;
         }
 
         inline XrQuaternionf Slerp(const XrQuaternionf& a, const XrQuaternionf& b, float alpha) {
-            DirectX::XMVECTOR qa = LoadXrQuaternion(a);
-            DirectX::XMVECTOR qb = LoadXrQuaternion(b);
-            DirectX::XMVECTOR qr = DirectX::XMQuaternionSlerp(qa, qb, alpha);
+            Vector qa = LoadXrQuaternion(a);
+            Vector qb = LoadXrQuaternion(b);
+            Vector qr = QuaternionSlerp(qa, qb, alpha);
             XrQuaternionf result;
             StoreXrQuaternion(&result, qr);
             return result;
@@ -403,20 +437,12 @@ namespace xr::math {
         return Pose::Multiply(a, b);
     }
 
-    inline float Dot(const XrVector3f& a, const XrVector3f& b) {
-        return a.x * b.x + a.y * b.y + a.z * b.z;
-    }
-
-    inline XrVector3f Normalize(const XrVector3f& a) {
-        return a / std::sqrt(Dot(a, a));
-    }
-
     inline bool IsValidFov(const XrFovf& fov) {
-        if (fov.angleRight >= DirectX::XM_PIDIV2 || fov.angleLeft <= -DirectX::XM_PIDIV2) {
+        if (fov.angleRight >= PiDiv2 || fov.angleLeft <= -PiDiv2) {
             return false;
         }
 
-        if (fov.angleUp >= DirectX::XM_PIDIV2 || fov.angleDown <= -DirectX::XM_PIDIV2) {
+        if (fov.angleUp >= PiDiv2 || fov.angleDown <= -PiDiv2) {
             return false;
         }
 
@@ -427,20 +453,20 @@ namespace xr::math {
     // 0                  2 * n / (t - b)    0                    0
     // (r + l) / (r - l)  (t + b) / (t - b)  f / (n - f)         -1
     // 0                  0                  n*f / (n - f)        0
-    inline DirectX::XMMATRIX ComposeProjectionMatrix(const XrFovf& fov, const NearFar& nearFar) {
+    inline Matrix ComposeProjectionMatrix(const XrFovf& fov, const NearFar& nearFar) {
         if (!IsValidFov(fov)) {
             throw std::runtime_error("Invalid projection specification");
         }
 
         const float nearPlane = nearFar.Near;
         const float farPlane = nearFar.Far;
-        const bool infNearPlane = isinf(nearPlane);
-        const bool infFarPlane = isinf(farPlane);
+        const bool infNearPlane = std::isinf(nearPlane);
+        const bool infFarPlane = std::isinf(farPlane);
 
-        float l = tan(fov.angleLeft);
-        float r = tan(fov.angleRight);
-        float b = tan(fov.angleDown);
-        float t = tan(fov.angleUp);
+        float l = std::tan(fov.angleLeft);
+        float r = std::tan(fov.angleRight);
+        float b = std::tan(fov.angleDown);
+        float t = std::tan(fov.angleUp);
         if (!infNearPlane) {
             l *= nearPlane;
             r *= nearPlane;
@@ -460,7 +486,7 @@ namespace xr::math {
             const float reciprocalWidth = 1.0f / (r - l);
             const float reciprocalHeight = 1.0f / (t - b);
 
-            DirectX::XMFLOAT4X4 projectionMatrix;
+            Float4x4 projectionMatrix;
 
             float twoNearZ;
             if (infNearPlane) {
@@ -493,21 +519,21 @@ namespace xr::math {
             projectionMatrix._42 = 0.0f;
             projectionMatrix._44 = 0.0f;
 
-            return DirectX::XMLoadFloat4x4(&projectionMatrix);
+            return LoadFloat4x4(&projectionMatrix);
         } else {
-            return DirectX::XMMatrixPerspectiveOffCenterRH(l, r, b, t, nearPlane, farPlane);
+            return MatrixPerspectiveOffCenterRH(l, r, b, t, nearPlane, farPlane);
         }
     }
 
-    inline bool IsInfiniteNearPlaneProjectionMatrix(const DirectX::XMFLOAT4X4& p) {
+    inline bool IsInfiniteNearPlaneProjectionMatrix(const Float4x4& p) {
         return (p._33 == 0);
     }
 
-    inline bool IsInfiniteFarPlaneProjectionMatrix(const DirectX::XMFLOAT4X4& p) {
+    inline bool IsInfiniteFarPlaneProjectionMatrix(const Float4x4& p) {
         return (p._33 == -1);
     }
 
-    inline void ValidateProjectionMatrix(const DirectX::XMFLOAT4X4& p) {
+    inline void ValidateProjectionMatrix(const Float4x4& p) {
         // Reference equations on top of ComposeProjectionMatrix() above.
         if (p._12 != 0 || p._13 != 0 || p._14 != 0 ||
             // p._21 is not 0 on old MR devices, but small enough to be ignored. For future MR devices, it should be 0 (no shear)
@@ -518,7 +544,7 @@ namespace xr::math {
         }
     }
 
-    inline NearFar GetProjectionNearFar(const DirectX::XMFLOAT4X4& p) {
+    inline NearFar GetProjectionNearFar(const Float4x4& p) {
         ValidateProjectionMatrix(p);
 
         NearFar d;
@@ -538,20 +564,20 @@ namespace xr::math {
         return d;
     }
 
-    inline XrFovf DecomposeProjectionMatrix(const DirectX::XMFLOAT4X4& p) {
+    inline XrFovf DecomposeProjectionMatrix(const Float4x4& p) {
         ValidateProjectionMatrix(p);
 
         // n = m43 / m33
         // f = m43 / (1 + m33)
-        // l = n * (m31 - 1) / m11  => angle left = atan2(l, n) => atan2(m31 - 1, m11)
+        // l = n * (m31 - 1) / m11  => angle left = std::atan2(l, n) => std::atan2(m31 - 1, m11)
         // r = n * (m31 + 1) / m11  => so on
         // b = n * (m32 - 1) / m22  => and
         // t = n * (m32 + 1) / m22  => so forth
         XrFovf fov;
-        fov.angleLeft = atan2(p._31 - 1, p._11);
-        fov.angleRight = atan2(p._31 + 1, p._11);
-        fov.angleDown = atan2(p._32 - 1, p._22);
-        fov.angleUp = atan2(p._32 + 1, p._22);
+        fov.angleLeft = std::atan2(p._31 - 1, p._11);
+        fov.angleRight = std::atan2(p._31 + 1, p._11);
+        fov.angleDown = std::atan2(p._32 - 1, p._22);
+        fov.angleUp = std::atan2(p._32 + 1, p._22);
         return fov;
     }
 
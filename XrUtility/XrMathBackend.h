@@ -0,0 +1,582 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+// Vector and matrix primitives behind xr::math, following the DirectXMath conventions:
+// row vectors, row-major matrices and right-handed projections.
+// The backend is selected at compile time: SSE (with FMA when available) on x86-64, NEON on arm64,
+// and a scalar reference otherwise. Define XR_MATH_FORCE_SCALAR to build the scalar reference on any target.
+
+#include <cmath>
+#include <cstdint>
+
+#if !defined(XR_MATH_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define XR_MATH_SSE 1
+#include <immintrin.h>
+#elif !defined(XR_MATH_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define XR_MATH_NEON 1
+#include <arm_neon.h>
+#else
+#define XR_MATH_SCALAR 1
+#endif
+
+#if defined(_MSC_VER) && defined(XR_MATH_SSE) && !defined(_M_ARM64EC)
+#define XR_MATH_CALLCONV __vectorcall
+#else
+#define XR_MATH_CALLCONV
+#endif
+
+namespace xr::math {
+    constexpr float Pi = 3.141592654f;
+    constexpr float PiDiv2 = 1.570796327f;
+
+    // Unaligned storage types, layout compatible with the corresponding OpenXR and HLSL types.
+    struct Float2 {
+        float x;
+        float y;
+    };
+
+    struct Float3 {
+        float x;
+        float y;
+        float z;
+    };
+
+    struct Float4 {
+        float x;
+        float y;
+        float z;
+        float w;
+    };
+
+    struct Int2 {
+        int32_t x;
+        int32_t y;
+    };
+
+    struct Float4x4 {
+        union {
+            struct {
+                float _11, _12, _13, _14;
+                float _21, _22, _23, _24;
+                float _31, _32, _33, _34;
+                float _41, _42, _43, _44;
+            };
+            float m[4][4];
+        };
+    };
+
+    // Register types, only meant to live on the stack.
+#if defined(XR_MATH_SSE)
+    using Vector = __m128;
+#elif defined(XR_MATH_NEON)
+    using Vector = float32x4_t;
+#else
+    struct alignas(16) Vector {
+        float v[4];
+    };
+#endif
+
+    struct Matrix {
+        Vector r[4];
+    };
+
+    // Backend specific primitives
+    Vector XR_MATH_CALLCONV VectorSet(float x, float y, float z, float w);
+    Vector XR_MATH_CALLCONV VectorReplicate(float value);
+    Vector XR_MATH_CALLCONV LoadFloat2(const Float2* source);
+    Vector XR_MATH_CALLCONV LoadFloat3(const Float3* source);
+    Vector XR_MATH_CALLCONV LoadFloat4(const Float4* source);
+    void XR_MATH_CALLCONV StoreFloat2(Float2* destination, Vector v);
+    void XR_MATH_CALLCONV StoreFloat3(Float3* destination, Vector v);
+    void XR_MATH_CALLCONV StoreFloat4(Float4* destination, Vector v);
+    template <uint32_t Index>
+    float XR_MATH_CALLCONV VectorGet(Vector v);
+    template <uint32_t X, uint32_t Y, uint32_t Z, uint32_t W>
+    Vector XR_MATH_CALLCONV VectorSwizzle(Vector v);
+    Vector XR_MATH_CALLCONV VectorAdd(Vector a, Vector b);
+    Vector XR_MATH_CALLCONV VectorSubtract(Vector a, Vector b);
+    Vector XR_MATH_CALLCONV VectorMultiply(Vector a, Vector b);
+    Vector XR_MATH_CALLCONV VectorMultiplyAdd(Vector a, Vector b, Vector c); // a * b + c
+    Vector XR_MATH_CALLCONV VectorNegate(Vector v);
+    Matrix XR_MATH_CALLCONV MatrixTranspose(const Matrix& m);
+
+    // Operations shared by all backends
+    float XR_MATH_CALLCONV VectorGetX(Vector v);
+    Vector XR_MATH_CALLCONV Vector4Dot(Vector a, Vector b);
+    Vector XR_MATH_CALLCONV Vector4Length(Vector v);
+    Vector XR_MATH_CALLCONV Vector3Rotate(Vector v, Vector quaternion);
+    Vector XR_MATH_CALLCONV QuaternionConjugate(Vector q);
+    Vector XR_MATH_CALLCONV QuaternionMultiply(Vector q1, Vector q2); // Rotation q1 followed by rotation q2
+    Vector XR_MATH_CALLCONV QuaternionRotationAxis(Vector axis, float angle);
+    Vector XR_MATH_CALLCONV QuaternionRotationRollPitchYaw(float pitch, float yaw, float roll);
+    Vector XR_MATH_CALLCONV QuaternionRotationMatrix(const Matrix& m);
+    Vector XR_MATH_CALLCONV QuaternionSlerp(Vector q0, Vector q1, float t);
+    Matrix XR_MATH_CALLCONV LoadFloat4x4(const Float4x4* source);
+    void XR_MATH_CALLCONV StoreFloat4x4(Float4x4* destination, const Matrix& m);
+    Matrix XR_MATH_CALLCONV MatrixIdentity();
+    Matrix XR_MATH_CALLCONV MatrixScaling(float x, float y, float z);
+    Matrix XR_MATH_CALLCONV MatrixRotationQuaternion(Vector quaternion);
+    Matrix XR_MATH_CALLCONV MatrixMultiply(const Matrix& a, const Matrix& b);
+    Matrix XR_MATH_CALLCONV MatrixPerspectiveOffCenterRH(float left, float right, float bottom, float top, float nearZ, float farZ);
+    bool XR_MATH_CALLCONV MatrixDecompose(Vector* outScale, Vector* outRotationQuaternion, Vector* outTranslation, const Matrix& m);
+    Matrix XR_MATH_CALLCONV operator*(const Matrix& a, const Matrix& b);
+} // namespace xr::math
+
+#pragma region Implementation
+
+namespace xr::math {
+#if defined(XR_MATH_SSE)
+    inline Vector XR_MATH_CALLCONV VectorSet(float x, float y, float z, float w) {
+        return _mm_setr_ps(x, y, z, w);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorReplicate(float value) {
+        return _mm_set1_ps(value);
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat2(const Float2* source) {
+        return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&source->x));
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat3(const Float3* source) {
+        const Vector xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&source->x));
+        return _mm_movelh_ps(xy, _mm_load_ss(&source->z));
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat4(const Float4* source) {
+        return _mm_loadu_ps(&source->x);
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat2(Float2* destination, Vector v) {
+        _mm_storel_pi(reinterpret_cast<__m64*>(&destination->x), v);
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat3(Float3* destination, Vector v) {
+        _mm_storel_pi(reinterpret_cast<__m64*>(&destination->x), v);
+        _mm_store_ss(&destination->z, _mm_movehl_ps(v, v));
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat4(Float4* destination, Vector v) {
+        _mm_storeu_ps(&destination->x, v);
+    }
+
+    template <uint32_t Index>
+    inline float XR_MATH_CALLCONV VectorGet(Vector v) {
+        static_assert(Index < 4);
+        return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(Index, Index, Index, Index)));
+    }
+
+    template <uint32_t X, uint32_t Y, uint32_t Z, uint32_t W>
+    inline Vector XR_MATH_CALLCONV VectorSwizzle(Vector v) {
+        static_assert(X < 4 && Y < 4 && Z < 4 && W < 4);
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorAdd(Vector a, Vector b) {
+        return _mm_add_ps(a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorSubtract(Vector a, Vector b) {
+        return _mm_sub_ps(a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorMultiply(Vector a, Vector b) {
+        return _mm_mul_ps(a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorMultiplyAdd(Vector a, Vector b, Vector c) {
+#if defined(__FMA__) || defined(__AVX2__)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorNegate(Vector v) {
+        return _mm_sub_ps(_mm_setzero_ps(), v);
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixTranspose(const Matrix& m) {
+        Matrix result = m;
+        _MM_TRANSPOSE4_PS(result.r[0], result.r[1], result.r[2], result.r[3]);
+        return result;
+    }
+#elif defined(XR_MATH_NEON)
+    inline Vector XR_MATH_CALLCONV VectorSet(float x, float y, float z, float w) {
+        const float values[4] = {x, y, z, w};
+        return vld1q_f32(values);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorReplicate(float value) {
+        return vdupq_n_f32(value);
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat2(const Float2* source) {
+        return vcombine_f32(vld1_f32(&source->x), vdup_n_f32(0));
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat3(const Float3* source) {
+        return vcombine_f32(vld1_f32(&source->x), vld1_lane_f32(&source->z, vdup_n_f32(0), 0));
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat4(const Float4* source) {
+        return vld1q_f32(&source->x);
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat2(Float2* destination, Vector v) {
+        vst1_f32(&destination->x, vget_low_f32(v));
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat3(Float3* destination, Vector v) {
+        vst1_f32(&destination->x, vget_low_f32(v));
+        vst1q_lane_f32(&destination->z, v, 2);
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat4(Float4* destination, Vector v) {
+        vst1q_f32(&destination->x, v);
+    }
+
+    template <uint32_t Index>
+    inline float XR_MATH_CALLCONV VectorGet(Vector v) {
+        static_assert(Index < 4);
+        return vgetq_lane_f32(v, Index);
+    }
+
+    template <uint32_t X, uint32_t Y, uint32_t Z, uint32_t W>
+    inline Vector XR_MATH_CALLCONV VectorSwizzle(Vector v) {
+        static_assert(X < 4 && Y < 4 && Z < 4 && W < 4);
+        if constexpr (X == Y && Y == Z && Z == W) {
+            return vdupq_n_f32(vgetq_lane_f32(v, X));
+        } else {
+            Vector result = vdupq_n_f32(vgetq_lane_f32(v, X));
+            result = vsetq_lane_f32(vgetq_lane_f32(v, Y), result, 1);
+            result = vsetq_lane_f32(vgetq_lane_f32(v, Z), result, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(v, W), result, 3);
+        }
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorAdd(Vector a, Vector b) {
+        return vaddq_f32(a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorSubtract(Vector a, Vector b) {
+        return vsubq_f32(a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorMultiply(Vector a, Vector b) {
+        return vmulq_f32(a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorMultiplyAdd(Vector a, Vector b, Vector c) {
+        return vmlaq_f32(c, a, b);
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorNegate(Vector v) {
+        return vnegq_f32(v);
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixTranspose(const Matrix& m) {
+        const float32x4x2_t p0 = vzipq_f32(m.r[0], m.r[2]); // 00 20 01 21, 02 22 03 23
+        const float32x4x2_t p1 = vzipq_f32(m.r[1], m.r[3]); // 10 30 11 31, 12 32 13 33
+        const float32x4x2_t t0 = vzipq_f32(p0.val[0], p1.val[0]);
+        const float32x4x2_t t1 = vzipq_f32(p0.val[1], p1.val[1]);
+        return Matrix{{t0.val[0], t0.val[1], t1.val[0], t1.val[1]}};
+    }
+#else
+    inline Vector XR_MATH_CALLCONV VectorSet(float x, float y, float z, float w) {
+        return Vector{{x, y, z, w}};
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorReplicate(float value) {
+        return Vector{{value, value, value, value}};
+    }
+
+    // The storage types alias XR types through xr::math::cast, so only access them as float arrays.
+    inline Vector XR_MATH_CALLCONV LoadFloat2(const Float2* source) {
+        const float* f = &source->x;
+        return Vector{{f[0], f[1], 0, 0}};
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat3(const Float3* source) {
+        const float* f = &source->x;
+        return Vector{{f[0], f[1], f[2], 0}};
+    }
+
+    inline Vector XR_MATH_CALLCONV LoadFloat4(const Float4* source) {
+        const float* f = &source->x;
+        return Vector{{f[0], f[1], f[2], f[3]}};
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat2(Float2* destination, Vector v) {
+        float* f = &destination->x;
+        f[0] = v.v[0];
+        f[1] = v.v[1];
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat3(Float3* destination, Vector v) {
+        float* f = &destination->x;
+        f[0] = v.v[0];
+        f[1] = v.v[1];
+        f[2] = v.v[2];
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat4(Float4* destination, Vector v) {
+        float* f = &destination->x;
+        f[0] = v.v[0];
+        f[1] = v.v[1];
+        f[2] = v.v[2];
+        f[3] = v.v[3];
+    }
+
+    template <uint32_t Index>
+    inline float XR_MATH_CALLCONV VectorGet(Vector v) {
+        static_assert(Index < 4);
+        return v.v[Index];
+    }
+
+    template <uint32_t X, uint32_t Y, uint32_t Z, uint32_t W>
+    inline Vector XR_MATH_CALLCONV VectorSwizzle(Vector v) {
+        static_assert(X < 4 && Y < 4 && Z < 4 && W < 4);
+        return Vector{{v.v[X], v.v[Y], v.v[Z], v.v[W]}};
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorAdd(Vector a, Vector b) {
+        return Vector{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorSubtract(Vector a, Vector b) {
+        return Vector{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorMultiply(Vector a, Vector b) {
+        return Vector{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorMultiplyAdd(Vector a, Vector b, Vector c) {
+        return Vector{{a.v[0] * b.v[0] + c.v[0], a.v[1] * b.v[1] + c.v[1], a.v[2] * b.v[2] + c.v[2], a.v[3] * b.v[3] + c.v[3]}};
+    }
+
+    inline Vector XR_MATH_CALLCONV VectorNegate(Vector v) {
+        return Vector{{-v.v[0], -v.v[1], -v.v[2], -v.v[3]}};
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixTranspose(const Matrix& m) {
+        Matrix result;
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                result.r[row].v[column] = m.r[column].v[row];
+            }
+        }
+        return result;
+    }
+#endif
+
+    inline float XR_MATH_CALLCONV VectorGetX(Vector v) {
+        return VectorGet<0>(v);
+    }
+
+    inline Vector XR_MATH_CALLCONV Vector4Dot(Vector a, Vector b) {
+        const Vector product = VectorMultiply(a, b);
+        const Vector pairs = VectorAdd(product, VectorSwizzle<1, 0, 3, 2>(product));
+        return VectorAdd(pairs, VectorSwizzle<2, 3, 0, 1>(pairs));
+    }
+
+    inline Vector XR_MATH_CALLCONV Vector4Length(Vector v) {
+        return VectorReplicate(std::sqrt(VectorGetX(Vector4Dot(v, v))));
+    }
+
+    inline Vector XR_MATH_CALLCONV QuaternionConjugate(Vector q) {
+        return VectorMultiply(q, VectorSet(-1, -1, -1, 1));
+    }
+
+    inline Vector XR_MATH_CALLCONV QuaternionMultiply(Vector q1, Vector q2) {
+        // Returns q2 * q1 in Hamilton notation, so that q1 is applied first.
+        Vector result = VectorMultiply(VectorSwizzle<3, 3, 3, 3>(q2), q1);
+        result = VectorMultiplyAdd(VectorMultiply(VectorSwizzle<0, 0, 0, 0>(q2), VectorSwizzle<3, 2, 1, 0>(q1)), VectorSet(1, -1, 1, -1), result);
+        result = VectorMultiplyAdd(VectorMultiply(VectorSwizzle<1, 1, 1, 1>(q2), VectorSwizzle<2, 3, 0, 1>(q1)), VectorSet(1, 1, -1, -1), result);
+        result = VectorMultiplyAdd(VectorMultiply(VectorSwizzle<2, 2, 2, 2>(q2), VectorSwizzle<1, 0, 3, 2>(q1)), VectorSet(-1, 1, 1, -1), result);
+        return result;
+    }
+
+    inline Vector XR_MATH_CALLCONV Vector3Rotate(Vector v, Vector quaternion) {
+        const Vector pure = VectorMultiply(v, VectorSet(1, 1, 1, 0));
+        const Vector result = QuaternionMultiply(QuaternionConjugate(quaternion), pure);
+        return QuaternionMultiply(result, quaternion);
+    }
+
+    inline Vector XR_MATH_CALLCONV QuaternionRotationAxis(Vector axis, float angle) {
+        const float x = VectorGet<0>(axis);
+        const float y = VectorGet<1>(axis);
+        const float z = VectorGet<2>(axis);
+        const float scale = std::sin(0.5f * angle) / std::sqrt(x * x + y * y + z * z);
+        return VectorSet(x * scale, y * scale, z * scale, std::cos(0.5f * angle));
+    }
+
+    inline Vector XR_MATH_CALLCONV QuaternionRotationRollPitchYaw(float pitch, float yaw, float roll) {
+        // Roll around z first, then pitch around x, then yaw around y.
+        const float cp = std::cos(0.5f * pitch);
+        const float sp = std::sin(0.5f * pitch);
+        const float cy = std::cos(0.5f * yaw);
+        const float sy = std::sin(0.5f * yaw);
+        const float cr = std::cos(0.5f * roll);
+        const float sr = std::sin(0.5f * roll);
+        return VectorSet(cr * sp * cy + sr * cp * sy,
+                         cr * cp * sy - sr * sp * cy,
+                         sr * cp * cy - cr * sp * sy,
+                         cr * cp * cy + sr * sp * sy);
+    }
+
+    // Stays scalar: it branches on the largest diagonal term for precision, and only runs when a matrix is converted back to a pose
+    // (LookAt, StoreXrPose), never per object and frame.
+    inline Vector XR_MATH_CALLCONV QuaternionRotationMatrix(const Matrix& m) {
+        Float4x4 r;
+        StoreFloat4x4(&r, m);
+        const float trace = r._11 + r._22 + r._33;
+        if (trace > 0) {
+            const float s = 2 * std::sqrt(trace + 1);
+            return VectorSet((r._23 - r._32) / s, (r._31 - r._13) / s, (r._12 - r._21) / s, 0.25f * s);
+        } else if (r._11 > r._22 && r._11 > r._33) {
+            const float s = 2 * std::sqrt(1 + r._11 - r._22 - r._33);
+            return VectorSet(0.25f * s, (r._12 + r._21) / s, (r._13 + r._31) / s, (r._23 - r._32) / s);
+        } else if (r._22 > r._33) {
+            const float s = 2 * std::sqrt(1 + r._22 - r._11 - r._33);
+            return VectorSet((r._12 + r._21) / s, 0.25f * s, (r._23 + r._32) / s, (r._31 - r._13) / s);
+        } else {
+            const float s = 2 * std::sqrt(1 + r._33 - r._11 - r._22);
+            return VectorSet((r._13 + r._31) / s, (r._23 + r._32) / s, 0.25f * s, (r._12 - r._21) / s);
+        }
+    }
+
+    inline Vector XR_MATH_CALLCONV QuaternionSlerp(Vector q0, Vector q1, float t) {
+        constexpr float OneMinusEpsilon = 1.0f - 0.00001f;
+
+        float cosOmega = VectorGetX(Vector4Dot(q0, q1));
+        const float sign = (cosOmega < 0) ? -1.0f : 1.0f;
+        cosOmega *= sign;
+
+        float scale0 = 1 - t;
+        float scale1 = t;
+        if (cosOmega < OneMinusEpsilon) {
+            const float sinOmega = std::sqrt(1 - cosOmega * cosOmega);
+            const float omega = std::atan2(sinOmega, cosOmega);
+            scale0 = std::sin(scale0 * omega) / sinOmega;
+            scale1 = std::sin(scale1 * omega) / sinOmega;
+        }
+
+        return VectorMultiplyAdd(q1, VectorReplicate(scale1 * sign), VectorMultiply(q0, VectorReplicate(scale0)));
+    }
+
+    inline Matrix XR_MATH_CALLCONV LoadFloat4x4(const Float4x4* source) {
+        const Float4* rows = reinterpret_cast<const Float4*>(source->m);
+        return Matrix{{LoadFloat4(&rows[0]), LoadFloat4(&rows[1]), LoadFloat4(&rows[2]), LoadFloat4(&rows[3])}};
+    }
+
+    inline void XR_MATH_CALLCONV StoreFloat4x4(Float4x4* destination, const Matrix& m) {
+        Float4* rows = reinterpret_cast<Float4*>(destination->m);
+        for (int i = 0; i < 4; i++) {
+            StoreFloat4(&rows[i], m.r[i]);
+        }
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixIdentity() {
+        return Matrix{{VectorSet(1, 0, 0, 0), VectorSet(0, 1, 0, 0), VectorSet(0, 0, 1, 0), VectorSet(0, 0, 0, 1)}};
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixScaling(float x, float y, float z) {
+        return Matrix{{VectorSet(x, 0, 0, 0), VectorSet(0, y, 0, 0), VectorSet(0, 0, z, 0), VectorSet(0, 0, 0, 1)}};
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixRotationQuaternion(Vector quaternion) {
+        // Each row is the sum of two lane-wise products of swizzled components, with the signs and the factor of 2 folded into a
+        // constant whose w lane is zero:
+        //   r0 = (1 - 2(yy + zz), 2(xy + zw), 2(xz - yw), 0)
+        //   r1 = (2(xy - zw), 1 - 2(xx + zz), 2(yz + xw), 0)
+        //   r2 = (2(xz + yw), 2(yz - xw), 1 - 2(xx + yy), 0)
+        const Vector q = quaternion;
+        Vector r0 = VectorMultiply(VectorMultiply(VectorSwizzle<1, 0, 0, 3>(q), VectorSwizzle<1, 1, 2, 3>(q)), VectorSet(-2, 2, 2, 0));
+        r0 = VectorMultiplyAdd(VectorMultiply(VectorSwizzle<2, 2, 1, 3>(q), VectorSwizzle<2, 3, 3, 3>(q)), VectorSet(-2, 2, -2, 0), r0);
+        Vector r1 = VectorMultiply(VectorMultiply(VectorSwizzle<0, 0, 1, 3>(q), VectorSwizzle<1, 0, 2, 3>(q)), VectorSet(2, -2, 2, 0));
+        r1 = VectorMultiplyAdd(VectorMultiply(VectorSwizzle<2, 2, 0, 3>(q), VectorSwizzle<3, 2, 3, 3>(q)), VectorSet(-2, -2, 2, 0), r1);
+        Vector r2 = VectorMultiply(VectorMultiply(VectorSwizzle<0, 1, 0, 3>(q), VectorSwizzle<2, 2, 0, 3>(q)), VectorSet(2, 2, -2, 0));
+        r2 = VectorMultiplyAdd(VectorMultiply(VectorSwizzle<1, 0, 1, 3>(q), VectorSwizzle<3, 3, 1, 3>(q)), VectorSet(2, -2, -2, 0), r2);
+        return Matrix{{VectorAdd(r0, VectorSet(1, 0, 0, 0)),
+                       VectorAdd(r1, VectorSet(0, 1, 0, 0)),
+                       VectorAdd(r2, VectorSet(0, 0, 1, 0)),
+                       VectorSet(0, 0, 0, 1)}};
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixMultiply(const Matrix& a, const Matrix& b) {
+        Matrix result;
+        for (int i = 0; i < 4; i++) {
+            const Vector row = a.r[i];
+            Vector sum = VectorMultiply(VectorSwizzle<0, 0, 0, 0>(row), b.r[0]);
+            sum = VectorMultiplyAdd(VectorSwizzle<1, 1, 1, 1>(row), b.r[1], sum);
+            sum = VectorMultiplyAdd(VectorSwizzle<2, 2, 2, 2>(row), b.r[2], sum);
+            result.r[i] = VectorMultiplyAdd(VectorSwizzle<3, 3, 3, 3>(row), b.r[3], sum);
+        }
+        return result;
+    }
+
+    inline Matrix XR_MATH_CALLCONV operator*(const Matrix& a, const Matrix& b) {
+        return MatrixMultiply(a, b);
+    }
+
+    inline Matrix XR_MATH_CALLCONV MatrixPerspectiveOffCenterRH(float left, float right, float bottom, float top, float nearZ, float farZ) {
+        const float twoNearZ = nearZ + nearZ;
+        const float reciprocalWidth = 1.0f / (right - left);
+        const float reciprocalHeight = 1.0f / (top - bottom);
+        const float range = farZ / (nearZ - farZ);
+        return Matrix{{VectorSet(twoNearZ * reciprocalWidth, 0, 0, 0),
+                       VectorSet(0, twoNearZ * reciprocalHeight, 0, 0),
+                       VectorSet((left + right) * reciprocalWidth, (top + bottom) * reciprocalHeight, range, -1),
+                       VectorSet(0, 0, range * nearZ, 0)}};
+    }
+
+    // Stays scalar for the same reason as QuaternionRotationMatrix, its only caller is StoreXrPose.
+    inline bool XR_MATH_CALLCONV MatrixDecompose(Vector* outScale, Vector* outRotationQuaternion, Vector* outTranslation, const Matrix& m) {
+        constexpr float ScaleEpsilon = 1.0e-4f;
+
+        Float4x4 r;
+        StoreFloat4x4(&r, m);
+        float scale[3];
+        for (int i = 0; i < 3; i++) {
+            scale[i] = std::sqrt(r.m[i][0] * r.m[i][0] + r.m[i][1] * r.m[i][1] + r.m[i][2] * r.m[i][2]);
+            if (scale[i] < ScaleEpsilon) {
+                return false; // Degenerate matrix, the rotation cannot be recovered
+            }
+        }
+
+        // Normalize the basis and flip the last axis of a mirrored basis so that it is a pure rotation.
+        Matrix rotation = MatrixIdentity();
+        for (int i = 0; i < 3; i++) {
+            rotation.r[i] = VectorSet(r.m[i][0] / scale[i], r.m[i][1] / scale[i], r.m[i][2] / scale[i], 0);
+        }
+        const float determinant = r._11 * (r._22 * r._33 - r._23 * r._32) - r._12 * (r._21 * r._33 - r._23 * r._31) +
+                                  r._13 * (r._21 * r._32 - r._22 * r._31);
+        if (determinant < 0) {
+            scale[2] = -scale[2];
+            rotation.r[2] = VectorNegate(rotation.r[2]);
+        }
+
+        *outScale = VectorSet(scale[0], scale[1], scale[2], 0);
+        *outRotationQuaternion = QuaternionRotationMatrix(rotation);
+        *outTranslation = VectorSet(r._41, r._42, r._43, 0);
+        return true;
+    }
+} // namespace xr::math
+
+#pragma endregion
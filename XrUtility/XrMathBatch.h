@@ -0,0 +1,483 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+// Pose kernels over arrays. Poses are transposed into structure of arrays form, a batch of 8 (AVX) or 4 (SSE, NEON, scalar)
+// at a time, so each operation processes a whole batch per instruction. Results match the single pose xr::math functions.
+// Transforms kept in TransformArrays are already in that form, and are loaded without transposition.
+
+#include <openxr/openxr.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "XrMath.h"
+
+namespace xr::math {
+    // out[i] = Pose::Multiply(a[i], b[i]), that is the pose a[i] expressed in the space where b[i] is expressed.
+    void MultiplyPoses(const XrPosef* a, const XrPosef* b, XrPosef* out, size_t count);
+
+    // out[i] is the inverse of poses[i], so that Pose::Multiply(poses[i], out[i]) is identity.
+    void InvertPoses(const XrPosef* poses, XrPosef* out, size_t count);
+
+    // matrices[i * matrixStride] = MatrixScaling(scales[i]) * LoadXrPose(poses[i]).
+    void PosesToMatrices(const XrPosef* poses, const XrVector3f* scales, Float4x4* matrices, size_t count, size_t matrixStride = 1);
+
+    // Same as PosesToMatrices with each matrix transposed, as expected by HLSL constant and structured buffers.
+    void PosesToTransposedMatrices(
+        const XrPosef* poses, const XrVector3f* scales, Float4x4* matrices, size_t count, size_t matrixStride = 1);
+
+    // Poses and scales in structure of arrays form, one array per component. Each array is followed by identity transforms up
+    // to a whole batch, so that a batch can be loaded from any index.
+    class TransformArrays {
+    public:
+        size_t Size() const {
+            return m_size;
+        }
+
+        // Keeps the capacity, so that the arrays stop allocating once they reached the largest size.
+        void Resize(size_t size);
+        void Reserve(size_t capacity);
+
+        void Set(size_t i, const XrPosef& pose, const XrVector3f& scale);
+        XrPosef Pose(size_t i) const;
+        XrVector3f Scale(size_t i) const;
+
+        // Orientation x, y, z, w, position x, y, z and scale x, y, z.
+        static constexpr size_t ComponentCount = 10;
+        const float* Component(size_t component) const {
+            return m_components[component].data();
+        }
+
+    private:
+        size_t m_size{0};
+        std::vector<float> m_components[ComponentCount];
+    };
+
+    // matrices[i * matrixStride] = MatrixScaling(Scale(first + i)) * LoadXrPose(Pose(first + i)), for i < count.
+    void PosesToMatrices(const TransformArrays& transforms, size_t first, size_t count, Float4x4* matrices, size_t matrixStride = 1);
+
+    // Same as PosesToMatrices with each matrix transposed, as expected by HLSL constant and structured buffers.
+    void PosesToTransposedMatrices(
+        const TransformArrays& transforms, size_t first, size_t count, Float4x4* matrices, size_t matrixStride = 1);
+} // namespace xr::math
+
+#pragma region Implementation
+
+namespace xr::math {
+    namespace detail {
+#if defined(__AVX__) && defined(XR_MATH_SSE)
+        struct Lanes {
+            static constexpr size_t Width = 8;
+            __m256 v;
+        };
+
+        // Unaligned, as the batches of TransformArrays start at any index.
+        inline Lanes LoadLanes(const float* values) {
+            return {_mm256_loadu_ps(values)};
+        }
+
+        inline void StoreLanes(float* values, Lanes a) {
+            _mm256_storeu_ps(values, a.v);
+        }
+
+        inline Lanes ReplicateLanes(float value) {
+            return {_mm256_set1_ps(value)};
+        }
+
+        inline Lanes operator+(Lanes a, Lanes b) {
+            return {_mm256_add_ps(a.v, b.v)};
+        }
+
+        inline Lanes operator-(Lanes a, Lanes b) {
+            return {_mm256_sub_ps(a.v, b.v)};
+        }
+
+        inline Lanes operator*(Lanes a, Lanes b) {
+            return {_mm256_mul_ps(a.v, b.v)};
+        }
+#elif defined(XR_MATH_SSE) || defined(XR_MATH_NEON)
+        struct Lanes {
+            static constexpr size_t Width = 4;
+            Vector v;
+        };
+
+        inline Lanes LoadLanes(const float* values) {
+            return {LoadFloat4(reinterpret_cast<const Float4*>(values))};
+        }
+
+        inline void StoreLanes(float* values, Lanes a) {
+            StoreFloat4(reinterpret_cast<Float4*>(values), a.v);
+        }
+
+        inline Lanes ReplicateLanes(float value) {
+            return {VectorReplicate(value)};
+        }
+
+        inline Lanes operator+(Lanes a, Lanes b) {
+            return {VectorAdd(a.v, b.v)};
+        }
+
+        inline Lanes operator-(Lanes a, Lanes b) {
+            return {VectorSubtract(a.v, b.v)};
+        }
+
+        inline Lanes operator*(Lanes a, Lanes b) {
+            return {VectorMultiply(a.v, b.v)};
+        }
+
+
+        // The lanes are a vector of the backend, which the kernels transpose in registers with MatrixTranspose.
+#define XR_MATH_BATCH_VECTOR_LANES
+#else
+        // Plain loops over fixed size arrays, left for the compiler to vectorize.
+        struct Lanes {
+            static constexpr size_t Width = 4;
+            float v[Width];
+        };
+
+        inline Lanes LoadLanes(const float* values) {
+            Lanes a;
+            for (size_t i = 0; i < Lanes::Width; i++) {
+                a.v[i] = values[i];
+            }
+            return a;
+        }
+
+        inline void StoreLanes(float* values, Lanes a) {
+            for (size_t i = 0; i < Lanes::Width; i++) {
+                values[i] = a.v[i];
+            }
+        }
+
+        inline Lanes ReplicateLanes(float value) {
+            Lanes a;
+            for (size_t i = 0; i < Lanes::Width; i++) {
+                a.v[i] = value;
+            }
+            return a;
+        }
+
+#define LANES_OPERATOR(op)                          \
+    inline Lanes operator op(Lanes a, Lanes b) {    \
+        for (size_t i = 0; i < Lanes::Width; i++) { \
+            a.v[i] = a.v[i] op b.v[i];              \
+        }                                           \
+        return a;                                   \
+    }
+        LANES_OPERATOR(+);
+        LANES_OPERATOR(-);
+        LANES_OPERATOR(*);
+#undef LANES_OPERATOR
+#endif
+
+#ifdef XR_MATH_BATCH_VECTOR_LANES
+        // Stores the row of 4 matrices held by the lanes, lane i of a, b, c and d being the row of matrix i.
+        inline void StoreMatrixRows(Float4x4* matrices, size_t count, size_t matrixStride, size_t row, Lanes a, Lanes b, Lanes c, Lanes d) {
+            const Matrix rows = MatrixTranspose(Matrix{{a.v, b.v, c.v, d.v}});
+            for (size_t i = 0; i < count; i++) {
+                StoreFloat4(reinterpret_cast<Float4*>(matrices[i * matrixStride].m[row]), rows.r[i]);
+            }
+        }
+#else
+        inline void StoreMatrixRows(Float4x4* matrices, size_t count, size_t matrixStride, size_t row, Lanes a, Lanes b, Lanes c, Lanes d) {
+            alignas(32) float values[4][Lanes::Width];
+            StoreLanes(values[0], a);
+            StoreLanes(values[1], b);
+            StoreLanes(values[2], c);
+            StoreLanes(values[3], d);
+            for (size_t i = 0; i < count; i++) {
+                for (size_t column = 0; column < 4; column++) {
+                    matrices[i * matrixStride].m[row][column] = values[column][i];
+                }
+            }
+        }
+#endif
+
+        constexpr size_t BatchSize = Lanes::Width;
+
+        struct Vector3Lanes {
+            Lanes x, y, z;
+        };
+
+        struct PoseLanes {
+            Lanes qx, qy, qz, qw;
+            Vector3Lanes p;
+        };
+
+        inline Vector3Lanes Cross(const Vector3Lanes& a, const Vector3Lanes& b) {
+            return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+        }
+
+        // Rotate v by the unit quaternion q: v + 2w (u x v) + 2u x (u x v), with u the vector part of q.
+        inline Vector3Lanes Rotate(const PoseLanes& q, const Vector3Lanes& v) {
+            const Vector3Lanes u{q.qx, q.qy, q.qz};
+            const Lanes two = ReplicateLanes(2);
+            const Vector3Lanes c = Cross(u, v);
+            const Vector3Lanes t{two * c.x, two * c.y, two * c.z};
+            const Vector3Lanes d = Cross(u, t);
+            return {v.x + q.qw * t.x + d.x, v.y + q.qw * t.y + d.y, v.z + q.qw * t.z + d.z};
+        }
+
+#ifdef XR_MATH_BATCH_VECTOR_LANES
+        // Load up to BatchSize poses, padding the batch with identity poses. The poses are transposed in registers.
+        inline PoseLanes LoadPoses(const XrPosef* poses, size_t count) {
+            static const XrPosef identity{{0, 0, 0, 1}, {0, 0, 0}};
+            Matrix orientations, positions;
+            for (size_t i = 0; i < BatchSize; i++) {
+                const XrPosef& pose = (i < count) ? poses[i] : identity;
+                orientations.r[i] = LoadFloat4(reinterpret_cast<const Float4*>(&pose.orientation));
+                positions.r[i] = LoadFloat3(reinterpret_cast<const Float3*>(&pose.position));
+            }
+            orientations = MatrixTranspose(orientations);
+            positions = MatrixTranspose(positions);
+            return {{orientations.r[0]}, {orientations.r[1]}, {orientations.r[2]}, {orientations.r[3]},
+                    {{positions.r[0]}, {positions.r[1]}, {positions.r[2]}}};
+        }
+
+        // Load up to BatchSize vectors, padding the batch with the given vector.
+        inline Vector3Lanes LoadVectors(const XrVector3f* vectors, size_t count, const XrVector3f& padding) {
+            Matrix rows;
+            for (size_t i = 0; i < BatchSize; i++) {
+                rows.r[i] = LoadFloat3(reinterpret_cast<const Float3*>((i < count) ? &vectors[i] : &padding));
+            }
+            rows = MatrixTranspose(rows);
+            return {{rows.r[0]}, {rows.r[1]}, {rows.r[2]}};
+        }
+
+        inline void StorePoses(XrPosef* poses, size_t count, const PoseLanes& lanes) {
+            const Matrix orientations = MatrixTranspose(Matrix{{lanes.qx.v, lanes.qy.v, lanes.qz.v, lanes.qw.v}});
+            const Matrix positions = MatrixTranspose(Matrix{{lanes.p.x.v, lanes.p.y.v, lanes.p.z.v, VectorReplicate(0)}});
+            for (size_t i = 0; i < count; i++) {
+                StoreFloat4(reinterpret_cast<Float4*>(&poses[i].orientation), orientations.r[i]);
+                StoreFloat3(reinterpret_cast<Float3*>(&poses[i].position), positions.r[i]);
+            }
+        }
+
+#else
+        // Load up to BatchSize poses, padding the batch with identity poses.
+        inline PoseLanes LoadPoses(const XrPosef* poses, size_t count) {
+            alignas(32) float soa[7][BatchSize];
+            for (size_t i = 0; i < BatchSize; i++) {
+                const XrPosef& pose = (i < count) ? poses[i] : XrPosef{{0, 0, 0, 1}, {0, 0, 0}};
+                soa[0][i] = pose.orientation.x;
+                soa[1][i] = pose.orientation.y;
+                soa[2][i] = pose.orientation.z;
+                soa[3][i] = pose.orientation.w;
+                soa[4][i] = pose.position.x;
+                soa[5][i] = pose.position.y;
+                soa[6][i] = pose.position.z;
+            }
+            return {LoadLanes(soa[0]), LoadLanes(soa[1]), LoadLanes(soa[2]), LoadLanes(soa[3]),
+                    {LoadLanes(soa[4]), LoadLanes(soa[5]), LoadLanes(soa[6])}};
+        }
+
+        inline void StorePoses(XrPosef* poses, size_t count, const PoseLanes& lanes) {
+            alignas(32) float soa[7][BatchSize];
+            StoreLanes(soa[0], lanes.qx);
+            StoreLanes(soa[1], lanes.qy);
+            StoreLanes(soa[2], lanes.qz);
+            StoreLanes(soa[3], lanes.qw);
+            StoreLanes(soa[4], lanes.p.x);
+            StoreLanes(soa[5], lanes.p.y);
+            StoreLanes(soa[6], lanes.p.z);
+            for (size_t i = 0; i < count; i++) {
+                poses[i] = {{soa[0][i], soa[1][i], soa[2][i], soa[3][i]}, {soa[4][i], soa[5][i], soa[6][i]}};
+            }
+        }
+
+        inline Vector3Lanes LoadVectors(const XrVector3f* vectors, size_t count, const XrVector3f& padding) {
+            alignas(32) float soa[3][BatchSize];
+            for (size_t i = 0; i < BatchSize; i++) {
+                const XrVector3f& v = (i < count) ? vectors[i] : padding;
+                soa[0][i] = v.x;
+                soa[1][i] = v.y;
+                soa[2][i] = v.z;
+            }
+            return {LoadLanes(soa[0]), LoadLanes(soa[1]), LoadLanes(soa[2])};
+        }
+
+#endif
+#undef XR_MATH_BATCH_VECTOR_LANES
+
+        // Stores the matrices of a batch of poses and scales, as in PosesToMatrices.
+        template <bool Transpose>
+        void StoreMatrices(const PoseLanes& q, Lanes sx, Lanes sy, Lanes sz, Float4x4* matrices, size_t count, size_t matrixStride) {
+            // Rows of the rotation matrix, as in MatrixRotationQuaternion, scaled per row.
+            const Lanes one = ReplicateLanes(1);
+            const Lanes two = ReplicateLanes(2);
+            const Lanes xx = q.qx * q.qx, yy = q.qy * q.qy, zz = q.qz * q.qz;
+            const Lanes xy = q.qx * q.qy, xz = q.qx * q.qz, yz = q.qy * q.qz;
+            const Lanes xw = q.qx * q.qw, yw = q.qy * q.qw, zw = q.qz * q.qw;
+
+            const Lanes m[12] = {sx * (one - two * (yy + zz)),
+                                 sx * (two * (xy + zw)),
+                                 sx * (two * (xz - yw)),
+                                 sy * (two * (xy - zw)),
+                                 sy * (one - two * (xx + zz)),
+                                 sy * (two * (yz + xw)),
+                                 sz * (two * (xz + yw)),
+                                 sz * (two * (yz - xw)),
+                                 sz * (one - two * (xx + yy)),
+                                 q.p.x,
+                                 q.p.y,
+                                 q.p.z};
+
+            // The lanes are transposed in registers where the lanes are a 4-wide vector, instead of scattered from memory.
+            const Lanes zero = ReplicateLanes(0);
+            if (Transpose) {
+                for (size_t column = 0; column < 3; column++) {
+                    StoreMatrixRows(matrices, count, matrixStride, column, m[column], m[3 + column], m[6 + column], m[9 + column]);
+                }
+                StoreMatrixRows(matrices, count, matrixStride, 3, zero, zero, zero, one);
+            } else {
+                for (size_t row = 0; row < 4; row++) {
+                    StoreMatrixRows(matrices, count, matrixStride, row, m[row * 3], m[row * 3 + 1], m[row * 3 + 2], row == 3 ? one : zero);
+                }
+            }
+        }
+
+        template <bool Transpose>
+        void PosesToMatrices(const XrPosef* poses, const XrVector3f* scales, Float4x4* matrices, size_t count, size_t matrixStride) {
+            for (size_t first = 0; first < count; first += BatchSize) {
+                const size_t batchCount = std::min(BatchSize, count - first);
+                const PoseLanes q = LoadPoses(poses + first, batchCount);
+                const Vector3Lanes s = LoadVectors(scales + first, batchCount, {1, 1, 1});
+                StoreMatrices<Transpose>(q, s.x, s.y, s.z, matrices + first * matrixStride, batchCount, matrixStride);
+            }
+        }
+
+        template <bool Transpose>
+        void PosesToMatrices(const TransformArrays& transforms, size_t first, size_t count, Float4x4* matrices, size_t matrixStride) {
+            assert(first + count <= transforms.Size());
+            const float* c[TransformArrays::ComponentCount];
+            for (size_t component = 0; component < TransformArrays::ComponentCount; component++) {
+                c[component] = transforms.Component(component) + first;
+            }
+            for (size_t i = 0; i < count; i += BatchSize) {
+                const PoseLanes q{LoadLanes(c[0] + i), LoadLanes(c[1] + i), LoadLanes(c[2] + i), LoadLanes(c[3] + i),
+                                  {LoadLanes(c[4] + i), LoadLanes(c[5] + i), LoadLanes(c[6] + i)}};
+                StoreMatrices<Transpose>(q,
+                                         LoadLanes(c[7] + i),
+                                         LoadLanes(c[8] + i),
+                                         LoadLanes(c[9] + i),
+                                         matrices + i * matrixStride,
+                                         std::min(BatchSize, count - i),
+                                         matrixStride);
+            }
+        }
+    } // namespace detail
+
+    inline void MultiplyPoses(const XrPosef* a, const XrPosef* b, XrPosef* out, size_t count) {
+        for (size_t first = 0; first < count; first += detail::BatchSize) {
+            const size_t batchCount = std::min(detail::BatchSize, count - first);
+            const detail::PoseLanes pa = detail::LoadPoses(a + first, batchCount);
+            const detail::PoseLanes pb = detail::LoadPoses(b + first, batchCount);
+
+            // Qc = Qb * Qa (Hamilton product) and Pc = Qb * Pa + Pb, as in Pose::Multiply.
+            detail::PoseLanes c;
+            c.qx = pb.qw * pa.qx + pb.qx * pa.qw + pb.qy * pa.qz - pb.qz * pa.qy;
+            c.qy = pb.qw * pa.qy - pb.qx * pa.qz + pb.qy * pa.qw + pb.qz * pa.qx;
+            c.qz = pb.qw * pa.qz + pb.qx * pa.qy - pb.qy * pa.qx + pb.qz * pa.qw;
+            c.qw = pb.qw * pa.qw - pb.qx * pa.qx - pb.qy * pa.qy - pb.qz * pa.qz;
+            const detail::Vector3Lanes rotated = detail::Rotate(pb, pa.p);
+            c.p = {rotated.x + pb.p.x, rotated.y + pb.p.y, rotated.z + pb.p.z};
+
+            detail::StorePoses(out + first, batchCount, c);
+        }
+    }
+
+    inline void InvertPoses(const XrPosef* poses, XrPosef* out, size_t count) {
+        const detail::Lanes zero = detail::ReplicateLanes(0);
+        for (size_t first = 0; first < count; first += detail::BatchSize) {
+            const size_t batchCount = std::min(detail::BatchSize, count - first);
+            const detail::PoseLanes p = detail::LoadPoses(poses + first, batchCount);
+
+            // The inverse orientation is the conjugate, and the inverse position is -P rotated by it.
+            detail::PoseLanes inverse;
+            inverse.qx = zero - p.qx;
+            inverse.qy = zero - p.qy;
+            inverse.qz = zero - p.qz;
+            inverse.qw = p.qw;
+            inverse.p = detail::Rotate(inverse, {zero - p.p.x, zero - p.p.y, zero - p.p.z});
+
+            detail::StorePoses(out + first, batchCount, inverse);
+        }
+    }
+
+    inline void PosesToMatrices(const XrPosef* poses, const XrVector3f* scales, Float4x4* matrices, size_t count, size_t matrixStride) {
+        detail::PosesToMatrices<false>(poses, scales, matrices, count, matrixStride);
+    }
+
+    inline void PosesToTransposedMatrices(
+        const XrPosef* poses, const XrVector3f* scales, Float4x4* matrices, size_t count, size_t matrixStride) {
+        detail::PosesToMatrices<true>(poses, scales, matrices, count, matrixStride);
+    }
+
+    inline void TransformArrays::Resize(size_t size) {
+        // The identity transforms following the last one, loaded by its batch.
+        constexpr float Padding[ComponentCount] = {0, 0, 0, 1, 0, 0, 0, 1, 1, 1};
+        for (size_t component = 0; component < ComponentCount; component++) {
+            std::vector<float>& values = m_components[component];
+            values.resize(size);
+            values.resize(size + detail::BatchSize - 1, Padding[component]);
+        }
+        m_size = size;
+    }
+
+    inline void TransformArrays::Reserve(size_t capacity) {
+        for (std::vector<float>& values : m_components) {
+            values.reserve(capacity + detail::BatchSize - 1);
+        }
+    }
+
+    inline void TransformArrays::Set(size_t i, const XrPosef& pose, const XrVector3f& scale) {
+        assert(i < m_size);
+        m_components[0][i] = pose.orientation.x;
+        m_components[1][i] = pose.orientation.y;
+        m_components[2][i] = pose.orientation.z;
+        m_components[3][i] = pose.orientation.w;
+        m_components[4][i] = pose.position.x;
+        m_components[5][i] = pose.position.y;
+        m_components[6][i] = pose.position.z;
+        m_components[7][i] = scale.x;
+        m_components[8][i] = scale.y;
+        m_components[9][i] = scale.z;
+    }
+
+    inline XrPosef TransformArrays::Pose(size_t i) const {
+        assert(i < m_size);
+        return {{m_components[0][i], m_components[1][i], m_components[2][i], m_components[3][i]},
+                {m_components[4][i], m_components[5][i], m_components[6][i]}};
+    }
+
+    inline XrVector3f TransformArrays::Scale(size_t i) const {
+        assert(i < m_size);
+        return {m_components[7][i], m_components[8][i], m_components[9][i]};
+    }
+
+    inline void PosesToMatrices(const TransformArrays& transforms, size_t first, size_t count, Float4x4* matrices, size_t matrixStride) {
+        detail::PosesToMatrices<false>(transforms, first, count, matrices, matrixStride);
+    }
+
+    inline void PosesToTransposedMatrices(
+        const TransformArrays& transforms, size_t first, size_t count, Float4x4* matrices, size_t matrixStride) {
+        detail::PosesToMatrices<true>(transforms, first, count, matrices, matrixStride);
+    }
+} // namespace xr::math
+
+#pragma endregion
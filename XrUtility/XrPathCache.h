@@ -0,0 +1,227 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <openxr/openxr.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "XrError.h"
+
+namespace xr {
+
+    // 64-bit FNV-1a hash of a path string, usable at compile time.
+    constexpr uint64_t PathHash(std::string_view path) noexcept {
+        uint64_t hash = 14695981039346656037ull;
+        for (const char c : path) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // A path string with its hash. Declare it constexpr to hash a literal at compile time, e.g.
+    //     constexpr xr::PathString LeftHand{"/user/hand/left"};
+    // The referenced characters must outlive the PathString.
+    class PathString {
+    public:
+        constexpr PathString(const char* path)
+            : PathString(std::string_view(path)) {
+        }
+        PathString(const std::string& path)
+            : PathString(std::string_view(path)) {
+        }
+        constexpr explicit PathString(std::string_view path)
+            : m_string(path)
+            , m_hash(PathHash(path)) {
+        }
+
+        constexpr std::string_view View() const {
+            return m_string;
+        }
+        constexpr uint64_t Hash() const {
+            return m_hash;
+        }
+
+    private:
+        std::string_view m_string;
+        uint64_t m_hash;
+    };
+
+    // Process-wide table of the paths resolved by the runtime, in both directions.
+    // Lookups of resolved paths are lock-free and do not call into the runtime. Resolving a new path takes a lock.
+    // Entries are never moved or freed, so the strings returned by PathToString() stay valid for the process lifetime.
+    class PathCache {
+    public:
+        static PathCache& Global() {
+            static PathCache cache;
+            return cache;
+        }
+
+        XrPath StringToPath(XrInstance instance, const PathString& path);
+        std::string_view PathToString(XrInstance instance, XrPath path);
+
+        // Paths are only valid for the instance that resolved them, drop them before the instance is destroyed.
+        void Forget(XrInstance instance);
+
+    private:
+        constexpr static uint32_t EntryCapacity = 1024;
+        constexpr static uint32_t IndexCapacity = EntryCapacity * 2; // Power of two, at most half full.
+
+        struct Entry {
+            std::atomic<XrInstance> Instance{XR_NULL_HANDLE};
+            XrPath Path{XR_NULL_PATH};
+            uint64_t StringHash{0};
+            std::string String;
+        };
+
+        // Slots hold an entry index plus one, 0 for an empty slot.
+        using Index = std::array<std::atomic<uint32_t>, IndexCapacity>;
+
+        static uint64_t HashOfPath(XrInstance instance, XrPath path) {
+            return (path ^ reinterpret_cast<uint64_t>(instance)) * 0x9E3779B97F4A7C15ull;
+        }
+
+        const Entry* FindByString(XrInstance instance, const PathString& path) const;
+        const Entry* FindByPath(XrInstance instance, XrPath path) const;
+        const Entry* Insert(XrInstance instance, XrPath path, std::string_view string);
+        static void Publish(Index& index, uint64_t hash, uint32_t entryIndex);
+
+        std::mutex m_insertMutex;
+        std::atomic<uint32_t> m_entryCount{0};
+        std::array<Entry, EntryCapacity> m_entries;
+        Index m_stringIndex{};
+        Index m_pathIndex{};
+    };
+
+    // Resolved once per instance and path string, then served from PathCache::Global().
+    inline XrPath StringToPath(XrInstance instance, const PathString& path) {
+        return PathCache::Global().StringToPath(instance, path);
+    }
+
+    inline std::string_view PathToString(XrInstance instance, XrPath path) {
+        return PathCache::Global().PathToString(instance, path);
+    }
+
+#pragma region Implementation details
+    inline XrPath PathCache::StringToPath(XrInstance instance, const PathString& path) {
+        if (const Entry* entry = FindByString(instance, path)) {
+            return entry->Path;
+        }
+
+        const std::string string(path.View());
+        XrPath result;
+        CHECK_XRCMD(xrStringToPath(instance, string.c_str(), &result));
+        Insert(instance, result, string);
+        return result;
+    }
+
+    inline std::string_view PathCache::PathToString(XrInstance instance, XrPath path) {
+        if (const Entry* entry = FindByPath(instance, path)) {
+            return entry->String;
+        }
+
+        uint32_t count;
+        CHECK_XRCMD(xrPathToString(instance, path, 0, &count, nullptr));
+        std::string string(count, '\0');
+        CHECK_XRCMD(xrPathToString(instance, path, count, &count, string.data()));
+        string.resize(count > 0 ? count - 1 : 0); // Drop the null terminator.
+
+        if (const Entry* entry = Insert(instance, path, string)) {
+            return entry->String;
+        }
+        THROW("The path cache is full");
+    }
+
+    inline void PathCache::Forget(XrInstance instance) {
+        std::lock_guard lock(m_insertMutex);
+        const uint32_t entryCount = m_entryCount.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < entryCount; i++) {
+            if (m_entries[i].Instance.load(std::memory_order_relaxed) == instance) {
+                m_entries[i].Instance.store(XR_NULL_HANDLE, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline const PathCache::Entry* PathCache::FindByString(XrInstance instance, const PathString& path) const {
+        for (uint32_t probe = 0, slot = path.Hash() & (IndexCapacity - 1); probe < IndexCapacity;
+             probe++, slot = (slot + 1) & (IndexCapacity - 1)) {
+            const uint32_t entryIndex = m_stringIndex[slot].load(std::memory_order_acquire);
+            if (entryIndex == 0) {
+                return nullptr;
+            }
+            const Entry& entry = m_entries[entryIndex - 1];
+            if (entry.StringHash == path.Hash() && entry.Instance.load(std::memory_order_relaxed) == instance &&
+                entry.String == path.View()) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    inline const PathCache::Entry* PathCache::FindByPath(XrInstance instance, XrPath path) const {
+        for (uint32_t probe = 0, slot = HashOfPath(instance, path) & (IndexCapacity - 1); probe < IndexCapacity;
+             probe++, slot = (slot + 1) & (IndexCapacity - 1)) {
+            const uint32_t entryIndex = m_pathIndex[slot].load(std::memory_order_acquire);
+            if (entryIndex == 0) {
+                return nullptr;
+            }
+            const Entry& entry = m_entries[entryIndex - 1];
+            if (entry.Path == path && entry.Instance.load(std::memory_order_relaxed) == instance) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns nullptr when the cache is full, the path is then resolved by the runtime at every lookup.
+    inline const PathCache::Entry* PathCache::Insert(XrInstance instance, XrPath path, std::string_view string) {
+        std::lock_guard lock(m_insertMutex);
+        if (const Entry* entry = FindByPath(instance, path)) {
+            return entry; // Resolved by another thread in the meantime.
+        }
+
+        const uint32_t entryIndex = m_entryCount.load(std::memory_order_relaxed);
+        if (entryIndex == EntryCapacity) {
+            return nullptr;
+        }
+
+        // The entry is complete before the release stores of Publish() make it visible to readers.
+        Entry& entry = m_entries[entryIndex];
+        entry.Path = path;
+        entry.StringHash = PathHash(string);
+        entry.String = string;
+        entry.Instance.store(instance, std::memory_order_relaxed);
+        m_entryCount.store(entryIndex + 1, std::memory_order_relaxed);
+
+        Publish(m_stringIndex, entry.StringHash, entryIndex);
+        Publish(m_pathIndex, HashOfPath(instance, path), entryIndex);
+        return &entry;
+    }
+
+    inline void PathCache::Publish(Index& index, uint64_t hash, uint32_t entryIndex) {
+        uint32_t slot = hash & (IndexCapacity - 1);
+        while (index[slot].load(std::memory_order_relaxed) != 0) {
+            slot = (slot + 1) & (IndexCapacity - 1);
+        }
+        index[slot].store(entryIndex + 1, std::memory_order_release);
+    }
+#pragma endregion
+
+} // namespace xr
@@ -0,0 +1,130 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace xr {
+
+    // Vector of trivially copyable values, e.g. OpenXR structures, stored inline up to InlineCapacity.
+    // It only touches the heap to grow past its capacity, and never shrinks, so a reused buffer settles without further allocations.
+    template <typename T, uint32_t InlineCapacity>
+    class SmallVector {
+        static_assert(std::is_trivially_copyable_v<T>, "SmallVector copies its values with memcpy");
+
+    public:
+        using value_type = T;
+
+        SmallVector() = default;
+
+        SmallVector(const SmallVector& other) {
+            *this = other;
+        }
+
+        SmallVector& operator=(const SmallVector& other) {
+            if (this != &other) {
+                reserve(other.m_size);
+                std::memcpy(data(), other.data(), other.m_size * sizeof(T));
+                m_size = other.m_size;
+            }
+            return *this;
+        }
+
+        T* data() {
+            return m_heap ? m_heap.get() : m_inline.data();
+        }
+        const T* data() const {
+            return m_heap ? m_heap.get() : m_inline.data();
+        }
+
+        uint32_t size() const {
+            return m_size;
+        }
+        uint32_t capacity() const {
+            return m_capacity;
+        }
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        T* begin() {
+            return data();
+        }
+        T* end() {
+            return data() + m_size;
+        }
+        const T* begin() const {
+            return data();
+        }
+        const T* end() const {
+            return data() + m_size;
+        }
+
+        T& operator[](uint32_t index) {
+            return data()[index];
+        }
+        const T& operator[](uint32_t index) const {
+            return data()[index];
+        }
+
+        void clear() {
+            m_size = 0;
+        }
+
+        void reserve(uint32_t capacity) {
+            if (capacity > m_capacity) {
+                std::unique_ptr<T[]> heap(new T[capacity]);
+                std::memcpy(heap.get(), data(), m_size * sizeof(T));
+                m_heap = std::move(heap);
+                m_capacity = capacity;
+            }
+        }
+
+        // New values are copies of value, existing ones are kept.
+        void resize(uint32_t size, const T& value = T{}) {
+            reserve(size);
+            if (size > m_size) {
+                std::fill(data() + m_size, data() + size, value);
+            }
+            m_size = size;
+        }
+
+        // Replaces all the values with copies of value.
+        void assign(uint32_t size, const T& value) {
+            reserve(size);
+            std::fill(data(), data() + size, value);
+            m_size = size;
+        }
+
+        void push_back(const T& value) {
+            if (m_size == m_capacity) {
+                reserve(std::max(m_capacity * 2, 1u));
+            }
+            data()[m_size++] = value;
+        }
+
+    private:
+        std::array<T, InlineCapacity> m_inline{};
+        std::unique_ptr<T[]> m_heap;
+        uint32_t m_size{0};
+        uint32_t m_capacity{InlineCapacity};
+    };
+
+} // namespace xr
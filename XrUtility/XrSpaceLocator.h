@@ -0,0 +1,101 @@
+//*********************************************************
+//    Copyright (c) Microsoft. All rights reserved.
+//
+//    Apache 2.0 License
+//
+//    You may obtain a copy of the License at
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+//    implied. See the License for the specific language governing
+//    permissions and limitations under the License.
+//
+//*********************************************************
+#pragma once
+
+#include <openxr/openxr.h>
+#include <vector>
+
+#include "XrError.h"
+#include "XrExtensions.h"
+#include "XrMath.h"
+
+namespace xr {
+
+    // Locate a list of spaces relative to a base space in one pass.
+    // Uses xrLocateSpacesKHR when the runtime provides it, and falls back to one xrLocateSpace per space otherwise.
+    class SpaceLocator {
+    public:
+        SpaceLocator() = default;
+        explicit SpaceLocator(PFN_xrLocateSpacesKHR locateSpaces)
+            : m_locateSpaces(locateSpaces) {
+        }
+
+        void Locate(XrSession session, XrSpace baseSpace, XrTime time, const std::vector<XrSpace>& spaces);
+
+        // One entry per located space, in the order of the spaces given to Locate().
+        // Invalid poses are reported as identity, with a zero in the mask.
+        const std::vector<XrPosef>& Poses() const {
+            return m_poses;
+        }
+        const std::vector<uint8_t>& ValidMask() const {
+            return m_validMask;
+        }
+
+        bool UsesBatchedLocate() const {
+            return m_locateSpaces != nullptr;
+        }
+
+    private:
+        PFN_xrLocateSpacesKHR m_locateSpaces{nullptr};
+        std::vector<XrSpaceLocationDataKHR> m_locations;
+        std::vector<XrPosef> m_poses;
+        std::vector<uint8_t> m_validMask;
+    };
+
+#pragma region Implementation details
+    inline void SpaceLocator::Locate(XrSession session, XrSpace baseSpace, XrTime time, const std::vector<XrSpace>& spaces) {
+        // The results are reserved for the capacity of spaces, so they do not reallocate while spaces does not.
+        const uint32_t spaceCount = (uint32_t)spaces.size();
+        m_locations.reserve(spaces.capacity());
+        m_poses.reserve(spaces.capacity());
+        m_validMask.reserve(spaces.capacity());
+        m_locations.resize(spaceCount);
+        m_poses.resize(spaceCount);
+        m_validMask.resize(spaceCount);
+        if (spaceCount == 0) {
+            return;
+        }
+
+        if (m_locateSpaces != nullptr) {
+            XrSpacesLocateInfoKHR locateInfo{XR_TYPE_SPACES_LOCATE_INFO_KHR};
+            locateInfo.baseSpace = baseSpace;
+            locateInfo.time = time;
+            locateInfo.spaceCount = spaceCount;
+            locateInfo.spaces = spaces.data();
+
+            XrSpaceLocationsKHR locations{XR_TYPE_SPACE_LOCATIONS_KHR};
+            locations.locationCount = spaceCount;
+            locations.locations = m_locations.data();
+            CHECK_XRCMD(m_locateSpaces(session, &locateInfo, &locations));
+        } else {
+            for (uint32_t i = 0; i < spaceCount; i++) {
+                XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+                CHECK_XRCMD(xrLocateSpace(spaces[i], baseSpace, time, &location));
+                m_locations[i] = {location.locationFlags, location.pose};
+            }
+        }
+
+        constexpr XrSpaceLocationFlags PoseValidFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+        constexpr XrPosef Identity = xr::math::Pose::Identity();
+        for (uint32_t i = 0; i < spaceCount; i++) {
+            const bool valid = (m_locations[i].locationFlags & PoseValidFlags) == PoseValidFlags;
+            m_validMask[i] = valid;
+            m_poses[i] = valid ? m_locations[i].pose : Identity;
+        }
+    }
+#pragma endregion
+
+} // namespace xr
@@ -23,25 +23,21 @@
 
 #include "XrToString.h"
 #include "XrError.h"
+#include "XrPathCache.h"
 
 namespace xr {
 
-    inline XrPath StringToPath(XrInstance instance, const char* str) {
-        XrPath path;
-        CHECK_XRCMD(xrStringToPath(instance, str, &path));
-        return path;
-    }
-
     inline std::vector<XrPath> StringsToPaths(XrInstance instance, const std::vector<std::string>& strings) {
         std::vector<XrPath> paths;
 
         for (auto string : strings) {
-            paths.push_back(StringToPath(instance, string.c_str()));
+            paths.push_back(StringToPath(instance, string));
         }
 
         return paths;
     }
 
+#ifdef _WIN32
     inline std::wstring utf8_to_wide(std::string_view utf8Text) {
         if (utf8Text.empty()) {
             return {};
@@ -88,5 +84,6 @@ namespace xr {
 
         return narrowText;
     }
+#endif
 
 } // namespace xr
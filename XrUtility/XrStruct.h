@@ -15,10 +15,26 @@
 //*********************************************************
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <string>
 #include <string_view>
 #include <openxr/openxr.h>
 
 namespace xr {
+    namespace detail {
+        template <size_t Size>
+        void CopyName(char (&destination)[Size], const std::string& source) {
+#ifdef _WIN32
+            strncpy_s(destination, Size, source.data(), source.size());
+#else
+            const size_t length = std::min(source.size(), Size - 1);
+            std::memcpy(destination, source.data(), length);
+            destination[length] = '\0';
+#endif
+        }
+    } // namespace detail
+
     struct NameVersion {
         NameVersion(std::string name, uint32_t version)
             : Name(std::move(name))
@@ -32,9 +48,9 @@ namespace xr {
                                    const xr::NameVersion& appNameVersion,
                                    const xr::NameVersion& engineNameVersion,
                                    XrVersion apiVersion = XR_CURRENT_API_VERSION) {
-        strncpy_s(appInfo.applicationName, XR_MAX_APPLICATION_NAME_SIZE, appNameVersion.Name.data(), appNameVersion.Name.size());
+        detail::CopyName(appInfo.applicationName, appNameVersion.Name);
         appInfo.applicationVersion = appNameVersion.Version;
-        strncpy_s(appInfo.engineName, XR_MAX_ENGINE_NAME_SIZE, engineNameVersion.Name.data(), engineNameVersion.Name.size());
+        detail::CopyName(appInfo.engineName, engineNameVersion.Name);
         appInfo.engineVersion = engineNameVersion.Version;
         appInfo.apiVersion = apiVersion;
     }
@@ -55,6 +71,10 @@ namespace xr {
     template <typename XrEventData>
     const XrEventData* event_cast(const XrEventDataBuffer* eventData) = delete;
 
+    // Structure type of a strongly typed event data, XR_TYPE_UNKNOWN for other structures.
+    template <typename XrEventData>
+    constexpr XrStructureType event_type_v = XR_TYPE_UNKNOWN;
+
 #define DEFINE_EVENT_TYPE(XrEventData, XR_TYPE_EVENT_DATA)                                  \
     template <>                                                                             \
     inline const XrEventData* event_cast<XrEventData>(const XrEventDataBuffer* eventData) { \
@@ -62,7 +82,9 @@ namespace xr {
             return reinterpret_cast<const XrEventData*>(eventData);                         \
         }                                                                                   \
         return nullptr;                                                                     \
-    }
+    }                                                                                       \
+    template <>                                                                             \
+    constexpr XrStructureType event_type_v<XrEventData> = XR_TYPE_EVENT_DATA
 
     DEFINE_EVENT_TYPE(XrEventDataEventsLost, XR_TYPE_EVENT_DATA_EVENTS_LOST);
     DEFINE_EVENT_TYPE(XrEventDataInteractionProfileChanged, XR_TYPE_EVENT_DATA_INTERACTION_PROFILE_CHANGED);
@@ -0,0 +1,48 @@
+# Compiles the shaders with bgfx's shaderc at build time when BGFX_SHADERC is set, instead of packing the binaries of Assets/
+# written by build_bgfx_shader.bat. The D3D profiles need a shaderc built for Windows.
+set(BGFX_SHADERC "" CACHE FILEPATH "bgfx shaderc executable, to compile the shaders at build time")
+set(BGFX_SHADER_INCLUDE_DIR "" CACHE PATH "bgfx src directory, where shaderc finds bgfx_shader.sh")
+
+# Compiles SHADER.sc of the source directory into OUTPUT, as a vertex or fragment shader depending on its vs_ or fs_ prefix.
+function(add_bgfx_shader OUTPUT SHADER)
+	if(SHADER MATCHES "^vs_")
+		set(SHADER_ARGS --type vertex --profile vs_5_0)
+	else()
+		set(SHADER_ARGS --type fragment --profile ps_5_0)
+	endif()
+	set(SHADER_SOURCE ${PROJECT_SOURCE_DIR}/${SHADER}.sc)
+
+	get_filename_component(OUTPUT_DIR ${OUTPUT} DIRECTORY)
+	add_custom_command(OUTPUT ${OUTPUT}
+		COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_DIR}
+		COMMAND ${BGFX_SHADERC} -f ${SHADER_SOURCE} -i ${BGFX_SHADER_INCLUDE_DIR} --varyingdef ${PROJECT_SOURCE_DIR}/varying.def.sc
+			-o ${OUTPUT} --platform windows ${SHADER_ARGS} -O 3
+		DEPENDS ${BGFX_SHADERC} ${SHADER_SOURCE} ${PROJECT_SOURCE_DIR}/varying.def.sc
+		COMMENT "Compiling shader ${SHADER}"
+	)
+endfunction()
+
+# Packs the shader binaries and the cube mesh into OUTPUT with the AssetPacker tool.
+# PACKER_DEPENDS is the packer target or file, so the archive is rebuilt when the packer changes.
+function(add_asset_archive OUTPUT PACKER PACKER_DEPENDS)
+	set(PACKER_ARGS)
+	set(ARCHIVE_DEPENDS ${PACKER_DEPENDS} ${PROJECT_SOURCE_DIR}/CubeMesh.h)
+	foreach(SHADER vs_instancing vs_instancing_batched fs_instancing vs_visibility_mask fs_visibility_mask)
+		if(BGFX_SHADERC)
+			set(SHADER_FILE ${CMAKE_CURRENT_BINARY_DIR}/shaders/${SHADER}.bin)
+			add_bgfx_shader(${SHADER_FILE} ${SHADER})
+		else()
+			set(SHADER_FILE ${PROJECT_SOURCE_DIR}/Assets/${SHADER}.bin)
+		endif()
+		if(BGFX_SHADERC OR EXISTS ${SHADER_FILE})
+			list(APPEND PACKER_ARGS --shader shaders/${SHADER} ${SHADER_FILE})
+			list(APPEND ARCHIVE_DEPENDS ${SHADER_FILE})
+		endif()
+	endforeach()
+
+	add_custom_command(OUTPUT ${OUTPUT}
+		COMMAND ${PACKER} ${OUTPUT} ${PACKER_ARGS} --cube-mesh meshes/cube
+		DEPENDS ${ARCHIVE_DEPENDS}
+		COMMENT "Packing assets into ${OUTPUT}"
+	)
+endfunction()
@@ -0,0 +1,7 @@
+#include "common.sh"
+
+// Only depth is written, color writes are disabled by the render state.
+void main()
+{
+	gl_FragColor = vec4(0.0, 0.0, 0.0, 0.0);
+}
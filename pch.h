@@ -8,11 +8,15 @@
 #include <atomic>
 #include <array>
 #include <map>
+#include <memory_resource>
 #include <list>
+#include <optional>
 #include <unordered_map>
 #include <algorithm>
+#include <cstring>
 #include <assert.h>
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
@@ -21,6 +25,8 @@
 
 #define XR_USE_PLATFORM_WIN32
 #define XR_USE_GRAPHICS_API_D3D11
+#endif
+
 #include <openxr/openxr.h>
 #include <openxr/openxr_platform.h>
 
@@ -28,6 +34,17 @@
 #include "XrUtility/XrHandle.h"
 #include "XrUtility/XrMath.h"
 #include "XrUtility/XrString.h"
+#include "XrUtility/XrEnumerate.h"
 #include "XrUtility/XrExtensions.h"
 
-#include <winrt/base.h> // winrt::com_ptr
\ No newline at end of file
+#ifdef _WIN32
+#include <winrt/base.h> // winrt::com_ptr
+#else
+// Replacement for the CRT secure copy on other platforms, used to fill the fixed size name fields of OpenXR structures.
+template <size_t N>
+inline int strcpy_s(char (&dest)[N], const char* src) {
+    std::strncpy(dest, src, N - 1);
+    dest[N - 1] = '\0';
+    return 0;
+}
+#endif
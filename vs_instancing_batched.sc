@@ -0,0 +1,27 @@
+$input a_position, a_color0, i_data0, i_data1, i_data2, i_data3
+$output v_color0
+
+/*
+ * Copyright 2011-2020 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "common.sh"
+
+uniform mat4 u_viewProjStereo[2];
+
+void main()
+{
+	// Each cube is drawn as two consecutive instances (left and right view) carrying the same model matrix.
+	mat4 model;
+	model[0] = i_data0;
+	model[1] = i_data1;
+	model[2] = i_data2;
+	model[3] = i_data3;
+
+	vec4 worldPos = instMul(model, vec4(a_position, 1.0));
+	gl_Position = mul(u_viewProjStereo[gl_InstanceID % 2], worldPos);
+	v_color0 = a_color0;
+
+	gl_Layer = gl_InstanceID % 2;
+}
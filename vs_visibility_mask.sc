@@ -0,0 +1,22 @@
+$input a_position
+
+#include "common.sh"
+
+// x: depth of the near plane in normalized device coordinates.
+uniform vec4 u_visibilityMaskDepth;
+
+void main()
+{
+	// x and y are normalized device coordinates, z is the index of the view the vertex belongs to. The vertices of the other
+	// views collapse to a point outside of the viewport, so their triangles are dropped.
+	if (abs(a_position.z - float(gl_InstanceID)) < 0.5)
+	{
+		gl_Position = vec4(a_position.xy, u_visibilityMaskDepth.x, 1.0);
+	}
+	else
+	{
+		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+	}
+
+	gl_Layer = gl_InstanceID;
+}